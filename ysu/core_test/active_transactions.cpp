@@ -273,7 +273,7 @@ TEST (active_transactions, inactive_votes_cache_existing_vote)
 	ASSERT_EQ (1, last_vote1.sequence);
 	// Attempt to change vote with inactive_votes_cache
 	{
-		ysu::lock_guard<std::mutex> active_guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> active_guard (node.active.mutex);
 		node.active.add_inactive_votes_cache (send->hash (), key.pub);
 		ASSERT_EQ (1, node.active.find_inactive_votes_cache (send->hash ()).voters.size ());
 		election->insert_inactive_votes_cache (send->hash ());
@@ -332,7 +332,7 @@ TEST (active_transactions, inactive_votes_cache_multiple_votes)
 	while (true)
 	{
 		{
-			ysu::lock_guard<std::mutex> active_guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> active_guard (node.active.mutex);
 			if (node.active.find_inactive_votes_cache (send1->hash ()).voters.size () == 2)
 			{
 				break;
@@ -566,13 +566,13 @@ TEST (active_transactions, update_difficulty)
 	{
 		{
 			// node1
-			ysu::lock_guard<std::mutex> guard1 (node1.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard1 (node1.active.mutex);
 			auto const existing1 (node1.active.roots.find (send1->qualified_root ()));
 			ASSERT_NE (existing1, node1.active.roots.end ());
 			auto const existing2 (node1.active.roots.find (send2->qualified_root ()));
 			ASSERT_NE (existing2, node1.active.roots.end ());
 			// node2
-			ysu::lock_guard<std::mutex> guard2 (node2.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard2 (node2.active.mutex);
 			auto const existing3 (node2.active.roots.find (send1->qualified_root ()));
 			ASSERT_NE (existing3, node2.active.roots.end ());
 			auto const existing4 (node2.active.roots.find (send2->qualified_root ()));
@@ -669,7 +669,7 @@ TEST (active_transactions, vote_replays)
 
 	// Removing blocks as recently confirmed makes every vote indeterminate
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		node.active.recently_confirmed.clear ();
 	}
 	ASSERT_EQ (ysu::vote_code::indeterminate, node.active.vote (vote_send1));
@@ -745,7 +745,7 @@ TEST (active_transactions, confirmation_consistency)
 			ASSERT_NO_ERROR (system.poll (5ms));
 		}
 		ASSERT_NO_ERROR (system.poll_until_true (1s, [&node, &block, i] {
-			ysu::lock_guard<std::mutex> guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 			EXPECT_EQ (i + 1, node.active.recently_confirmed.size ());
 			EXPECT_EQ (block->qualified_root (), node.active.recently_confirmed.back ().first);
 			return i + 1 == node.active.recently_cemented.size (); // done after a callback
@@ -836,7 +836,7 @@ TEST (active_transactions, insertion_prioritization)
 	std::sort (blocks.begin (), blocks.end (), [](auto const & blockl, auto const & blockr) { return blockl->difficulty () > blockr->difficulty (); });
 
 	auto update_active_multiplier = [&node] {
-		ysu::unique_lock<std::mutex> lock (node.active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node.active.mutex);
 		node.active.update_active_multiplier (lock);
 	};
 
@@ -862,7 +862,7 @@ TEST (active_multiplier, less_than_one)
 {
 	ysu::system system (1);
 	auto & node (*system.nodes[0]);
-	ysu::unique_lock<std::mutex> lock (node.active.mutex);
+	ysu::unique_lock<ysu::mutex> lock (node.active.mutex);
 	auto base_active_difficulty = node.network_params.network.publish_thresholds.epoch_1;
 	auto base_active_multiplier = 1.0;
 	auto min_active_difficulty = node.network_params.network.publish_thresholds.entry;
@@ -971,7 +971,7 @@ TEST (active_transactions, election_difficulty_update_old)
 	ASSERT_EQ (1, node.active.size ());
 	auto multiplier = node.active.roots.begin ()->multiplier;
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		ASSERT_EQ (node.active.normalized_multiplier (*send1), multiplier);
 	}
 	// Should not update with a lower difficulty
@@ -1405,7 +1405,7 @@ TEST (active_transactions, difficulty_update_observer)
 	auto & node (*system.nodes[0]);
 	std::atomic<bool> update_received (false);
 	node.observers.difficulty.add ([& mutex = node.active.mutex, &update_received](uint64_t difficulty_a) {
-		ysu::unique_lock<std::mutex> lock (mutex, std::defer_lock);
+		ysu::unique_lock<ysu::mutex> lock (mutex, std::defer_lock);
 		EXPECT_TRUE (lock.try_lock ());
 		update_received = true;
 	});
@@ -1464,7 +1464,7 @@ TEST (active_transactions, pessimistic_elections)
 	uint64_t election_count = 0;
 	// Make dummy election with winner.
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		ysu::election election1 (
 		node, send, [](auto const & block) {}, false, ysu::election_behavior::normal);
 		ysu::election election2 (
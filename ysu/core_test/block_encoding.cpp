@@ -0,0 +1,129 @@
+#include <ysu/lib/numbers.hpp>
+#include <ysu/secure/block_encoding.hpp>
+#include <ysu/secure/buffer.hpp>
+#include <ysu/secure/common.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+std::vector<uint8_t> encode (ysu::block const & block_a)
+{
+	std::vector<uint8_t> result;
+	{
+		ysu::vectorstream stream (result);
+		ysu::serialize_block_value (stream, block_a);
+	}
+	return result;
+}
+
+std::vector<uint8_t> encode_legacy (ysu::block const & block_a)
+{
+	std::vector<uint8_t> result;
+	{
+		ysu::vectorstream stream (result);
+		ysu::serialize_block (stream, block_a);
+		block_a.sideband ().serialize (stream, block_a.type ());
+	}
+	return result;
+}
+
+ysu::block_hash successor (std::vector<uint8_t> const & value_a)
+{
+	ysu::block_hash result;
+	auto begin (value_a.begin () + ysu::block_value_successor_offset (value_a.data (), value_a.size ()));
+	std::copy (begin, begin + result.bytes.size (), result.bytes.begin ());
+	return result;
+}
+
+void check_round_trip (ysu::block & block_a, ysu::block_sideband const & sideband_a)
+{
+	block_a.sideband_set (sideband_a);
+	auto value (encode (block_a));
+	ASSERT_EQ (value.size (), ysu::block_value_size (block_a));
+	ASSERT_LT (value.size (), encode_legacy (block_a).size ());
+	ASSERT_TRUE (ysu::block_value_compact (value.data ()));
+	ASSERT_EQ (block_a.type (), ysu::block_value_type (value.data ()));
+	auto block (ysu::deserialize_block_value (value.data (), value.size ()));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (block_a, *block);
+	ASSERT_EQ (block_a.hash (), block->hash ());
+	auto const & sideband (block->sideband ());
+	ASSERT_EQ (sideband_a.successor, sideband.successor);
+	ASSERT_EQ (sideband_a.height, sideband.height);
+	ASSERT_EQ (sideband_a.timestamp, sideband.timestamp);
+	// Only stored for the types which need them, as in the legacy encoding
+	auto type (block_a.type ());
+	if (type == ysu::block_type::state)
+	{
+		ASSERT_EQ (sideband_a.details, sideband.details);
+		ASSERT_EQ (sideband_a.source_epoch, sideband.source_epoch);
+	}
+	if (type != ysu::block_type::state && type != ysu::block_type::open)
+	{
+		ASSERT_EQ (sideband_a.account, sideband.account);
+	}
+	if (type == ysu::block_type::receive || type == ysu::block_type::change || type == ysu::block_type::open)
+	{
+		ASSERT_EQ (sideband_a.balance, sideband.balance);
+	}
+	auto no_sideband (ysu::deserialize_block_value (value.data (), value.size (), false));
+	ASSERT_NE (nullptr, no_sideband);
+	ASSERT_FALSE (no_sideband->has_sideband ());
+	ASSERT_EQ (block_a, *no_sideband);
+}
+}
+
+TEST (block_encoding, round_trip)
+{
+	ysu::keypair key;
+	ysu::block_sideband sideband (key.pub, 5, 1000, 300, 1600000000, ysu::epoch::epoch_1, true, false, false, ysu::epoch::epoch_0);
+	ysu::send_block send (1, 2, 3, key.prv, key.pub, 4);
+	check_round_trip (send, sideband);
+	ysu::receive_block receive (1, 2, key.prv, key.pub, 4);
+	check_round_trip (receive, sideband);
+	ysu::open_block open (1, 2, key.pub, key.prv, key.pub, 4);
+	check_round_trip (open, ysu::block_sideband (key.pub, 0, 1000, 1, 1600000000, ysu::epoch::epoch_0, false, false, false, ysu::epoch::epoch_0));
+	ysu::change_block change (1, 2, key.prv, key.pub, 4);
+	check_round_trip (change, sideband);
+	ysu::state_block state (key.pub, 1, 2, ysu::uint128_t (1) << 100, 3, key.prv, key.pub, 4);
+	check_round_trip (state, ysu::block_sideband (0, 5, 0, std::numeric_limits<uint64_t>::max (), 1600000000, ysu::epoch::epoch_2, false, true, false, ysu::epoch::epoch_1));
+}
+
+TEST (block_encoding, elided_fields)
+{
+	ysu::keypair key;
+	ysu::block_sideband sideband (0, 0, 0, 1, 1600000000, ysu::epoch::epoch_0, false, false, false, ysu::epoch::epoch_0);
+	// Zero previous and link, representative equal to the account
+	ysu::state_block state (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 4);
+	check_round_trip (state, sideband);
+	ysu::state_block full (key.pub, 1, 2, 0, 3, key.prv, key.pub, 4);
+	full.sideband_set (sideband);
+	ASSERT_EQ (encode (full).size (), encode (state).size () + 3 * sizeof (ysu::block_hash));
+	ysu::open_block open (1, key.pub, key.pub, key.prv, key.pub, 4);
+	check_round_trip (open, sideband);
+}
+
+TEST (block_encoding, legacy)
+{
+	ysu::keypair key;
+	ysu::state_block state (key.pub, 1, 2, 3, 4, key.prv, key.pub, 5);
+	state.sideband_set (ysu::block_sideband (0, 6, 0, 7, 1600000000, ysu::epoch::epoch_1, true, false, false, ysu::epoch::epoch_0));
+	auto legacy (encode_legacy (state));
+	ASSERT_FALSE (ysu::block_value_compact (legacy.data ()));
+	ASSERT_EQ (ysu::block_type::state, ysu::block_value_type (legacy.data ()));
+	auto block (ysu::deserialize_block_value (legacy.data (), legacy.size ()));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (state, *block);
+	ASSERT_EQ (7, block->sideband ().height);
+	ASSERT_EQ (ysu::block_hash (6), block->sideband ().successor);
+	// The successor can be found in both encodings
+	auto compact (encode (state));
+	ASSERT_EQ (ysu::block_hash (6), successor (legacy));
+	ASSERT_EQ (ysu::block_hash (6), successor (compact));
+	// Truncated values are rejected
+	ASSERT_EQ (nullptr, ysu::deserialize_block_value (compact.data (), compact.size () - 1));
+	ASSERT_EQ (nullptr, ysu::deserialize_block_value (legacy.data (), legacy.size () - 1));
+}
@@ -161,6 +161,55 @@ TEST (block_store, clear_successor)
 	}
 }
 
+TEST (block_store, cold_tier)
+{
+	ysu::logger_mt logger;
+	auto path (ysu::unique_path ());
+	ysu::keypair key;
+	ysu::state_block block1 (key.pub, 0, key.pub, 10, 0, key.prv, key.pub, 0);
+	block1.sideband_set (ysu::block_sideband (0, 0, 0, 1, 0, ysu::epoch::epoch_0, false, false, false, ysu::epoch::epoch_0));
+	ysu::state_block block2 (key.pub, block1.hash (), key.pub, 5, 0, key.prv, key.pub, 0);
+	block2.sideband_set (ysu::block_sideband (0, 0, 0, 2, 0, ysu::epoch::epoch_0, true, false, false, ysu::epoch::epoch_0));
+	{
+		auto store = ysu::make_store (logger, path);
+		ASSERT_FALSE (store->init_error ());
+		ASSERT_EQ (nullptr, store->get_cold_store ());
+		{
+			auto transaction (store->tx_begin_write ());
+			store->block_put (transaction, block1.hash (), block1);
+			store->block_put (transaction, block2.hash (), block2);
+		}
+		ASSERT_FALSE (store->cold_open ());
+		ASSERT_FALSE (store->cold_put (store->tx_begin_read (), { block1.hash () }));
+		// Blocks in both tiers are only counted once
+		ASSERT_EQ (2, store->block_count (store->tx_begin_read ()));
+		auto transaction (store->tx_begin_write ());
+		store->cold_release (transaction, block1.hash ());
+		ASSERT_FALSE (store->block_exists_hot (transaction, block1.hash ()));
+		ASSERT_TRUE (store->block_exists (transaction, block1.hash ()));
+		ASSERT_EQ (2, store->block_count (transaction));
+	}
+	// Once it exists the cold tier is opened along with the store
+	auto store = ysu::make_store (logger, path);
+	ASSERT_FALSE (store->init_error ());
+	ASSERT_NE (nullptr, store->get_cold_store ());
+	auto transaction (store->tx_begin_write ());
+	auto block (store->block_get (transaction, block1.hash ()));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (block1, *block);
+	ASSERT_EQ (1, block->sideband ().height);
+	ASSERT_EQ (block2.hash (), store->block_successor (transaction, block1.hash ()));
+	ASSERT_EQ (block1.hash (), store->account_height_get (transaction, key.pub, 1));
+	ASSERT_TRUE (store->block_exists_hot (transaction, block2.hash ()));
+	ASSERT_FALSE (store->block_exists_hot (transaction, block1.hash ()));
+	// Deleting a block which was moved masks it in the cold tier
+	store->block_del (transaction, block2.hash ());
+	store->block_del (transaction, block1.hash ());
+	ASSERT_FALSE (store->block_exists (transaction, block1.hash ()));
+	ASSERT_EQ (nullptr, store->block_get (transaction, block1.hash ()));
+	ASSERT_EQ (0, store->block_count (transaction));
+}
+
 TEST (block_store, add_nonempty_block)
 {
 	ysu::logger_mt logger;
@@ -455,6 +504,38 @@ TEST (unchecked, multiple_get)
 	ASSERT_EQ (unchecked5.size (), 0);
 }
 
+TEST (unchecked, del_before)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	auto block1 (std::make_shared<ysu::send_block> (4, 1, 2, ysu::keypair ().prv, 4, 5));
+	auto block2 (std::make_shared<ysu::send_block> (3, 1, 2, ysu::keypair ().prv, 4, 5));
+	auto block3 (std::make_shared<ysu::send_block> (5, 1, 2, ysu::keypair ().prv, 4, 5));
+	ysu::unchecked_key key1 (block1->previous (), block1->hash ());
+	ysu::unchecked_key key2 (block2->previous (), block2->hash ());
+	ysu::unchecked_key key3 (block3->previous (), block3->hash ());
+	auto transaction (store->tx_begin_write ());
+	ASSERT_TRUE (store->unchecked_put (transaction, key1, ysu::unchecked_info (block1, block1->account (), 30)));
+	ASSERT_TRUE (store->unchecked_put (transaction, key2, ysu::unchecked_info (block2, block2->account (), 10)));
+	ASSERT_TRUE (store->unchecked_put (transaction, key3, ysu::unchecked_info (block3, block3->account (), 20)));
+	// Updating an entry moves it in the time index
+	ASSERT_FALSE (store->unchecked_put (transaction, key1, ysu::unchecked_info (block1, block1->account (), 5)));
+	ASSERT_EQ (3, store->unchecked_count (transaction));
+	auto deleted (store->unchecked_del_before (transaction, 20, 1));
+	ASSERT_EQ (1, deleted.size ());
+	ASSERT_EQ (block1->hash (), deleted[0].block->hash ());
+	deleted = store->unchecked_del_before (transaction, 20, 10);
+	ASSERT_EQ (1, deleted.size ());
+	ASSERT_EQ (block2->hash (), deleted[0].block->hash ());
+	ASSERT_TRUE (store->unchecked_del_before (transaction, 20, 10).empty ());
+	ASSERT_EQ (1, store->unchecked_count (transaction));
+	ASSERT_TRUE (store->unchecked_exists (transaction, key3));
+	store->unchecked_del (transaction, key3);
+	ASSERT_TRUE (store->unchecked_del_before (transaction, 100, 10).empty ());
+	ASSERT_EQ (0, store->unchecked_count (transaction));
+}
+
 TEST (block_store, empty_accounts)
 {
 	ysu::logger_mt logger;
@@ -757,6 +838,190 @@ TEST (block_store, pending_exists)
 	ASSERT_FALSE (store->pending_exists (transaction, one));
 }
 
+TEST (block_store, pending_summary)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	auto transaction (store->tx_begin_write ());
+	// Sends with local timestamps 300, 100 and 200 and amounts 10, 30 and 20
+	std::vector<ysu::block_hash> hashes;
+	for (auto timestamp : { 300, 100, 200 })
+	{
+		ysu::open_block block (timestamp, 1, timestamp, ysu::keypair ().prv, 0, 0);
+		block.sideband_set (ysu::block_sideband (timestamp, 0, 0, 1, timestamp, ysu::epoch::epoch_0, false, false, false, ysu::epoch::epoch_0));
+		store->block_put (transaction, block.hash (), block);
+		hashes.push_back (block.hash ());
+	}
+	ysu::account account (5);
+	ASSERT_EQ (0, store->pending_summary_get (transaction, account).count);
+	store->pending_put (transaction, ysu::pending_key (account, hashes[0]), { 1, 10, ysu::epoch::epoch_0 });
+	store->pending_put (transaction, ysu::pending_key (account, hashes[1]), { 1, 30, ysu::epoch::epoch_0 });
+	store->pending_put (transaction, ysu::pending_key (account, hashes[2]), { 1, 20, ysu::epoch::epoch_0 });
+	auto summary (store->pending_summary_get (transaction, account));
+	ASSERT_EQ (3, summary.count);
+	ASSERT_EQ (60, summary.total.number ());
+	ASSERT_EQ (30, summary.max.number ());
+	ASSERT_EQ (hashes[1], summary.oldest);
+	ASSERT_EQ (100, summary.oldest_timestamp);
+	// Removing the largest and oldest entry finds the next ones
+	store->pending_del (transaction, ysu::pending_key (account, hashes[1]));
+	summary = store->pending_summary_get (transaction, account);
+	ASSERT_EQ (2, summary.count);
+	ASSERT_EQ (30, summary.total.number ());
+	ASSERT_EQ (20, summary.max.number ());
+	ASSERT_EQ (hashes[2], summary.oldest);
+	// Replacing an entry does not count it twice
+	store->pending_put (transaction, ysu::pending_key (account, hashes[0]), { 1, 15, ysu::epoch::epoch_0 });
+	summary = store->pending_summary_get (transaction, account);
+	ASSERT_EQ (2, summary.count);
+	ASSERT_EQ (35, summary.total.number ());
+	store->pending_del (transaction, ysu::pending_key (account, hashes[0]));
+	store->pending_del (transaction, ysu::pending_key (account, hashes[2]));
+	ASSERT_EQ (0, store->pending_summary_get (transaction, account).count);
+	ASSERT_TRUE (store->pending_summary_begin (transaction) == store->pending_summary_end ());
+}
+
+TEST (block_store, store_cache)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	auto & cache (store->get_store_cache ());
+	ysu::keypair key1;
+	ysu::account_info info1 (1, 2, 3, 4, 5, 6, ysu::epoch::epoch_0);
+	ysu::account_info info;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->confirmation_height_put (transaction, key1.pub, { 1, ysu::block_hash (1) });
+		store->account_put (transaction, key1.pub, info1);
+		// Records written by a transaction which has not committed are not cached
+		ASSERT_FALSE (store->account_get (transaction, key1.pub, info));
+		ASSERT_EQ (info1, info);
+		ASSERT_EQ (0, cache.accounts.hits.load ());
+		ASSERT_EQ (1, cache.accounts.misses.load ());
+		ASSERT_EQ (0, cache.accounts.size ());
+	}
+	// Committing installs the written values
+	ASSERT_EQ (1, cache.accounts.size ());
+	ASSERT_EQ (1, cache.confirmation_heights.size ());
+	auto transaction (store->tx_begin_read ());
+	ASSERT_FALSE (store->account_get (transaction, key1.pub, info));
+	ASSERT_EQ (info1, info);
+	ysu::confirmation_height_info confirmation_height_info;
+	ASSERT_FALSE (store->confirmation_height_get (transaction, key1.pub, confirmation_height_info));
+	ASSERT_EQ (1, confirmation_height_info.height);
+	ASSERT_EQ (1, cache.accounts.hits.load ());
+	ASSERT_EQ (1, cache.confirmation_heights.hits.load ());
+	ysu::account_info info2 (info1);
+	info2.balance = 7;
+	store->account_put (store->tx_begin_write (), key1.pub, info2);
+	// Transactions started before the commit keep reading their snapshot
+	ASSERT_FALSE (store->account_get (transaction, key1.pub, info));
+	ASSERT_EQ (info1, info);
+	ASSERT_EQ (2, cache.accounts.misses.load ());
+	transaction.refresh ();
+	ASSERT_FALSE (store->account_get (transaction, key1.pub, info));
+	ASSERT_EQ (info2, info);
+	ASSERT_EQ (2, cache.accounts.hits.load ());
+	store->account_del (store->tx_begin_write (), key1.pub);
+	transaction.refresh ();
+	ASSERT_TRUE (store->account_get (transaction, key1.pub, info));
+	ASSERT_EQ (0, cache.accounts.size ());
+	// Values read from the database are cached when no commit happened meanwhile
+	cache.confirmation_heights.clear ();
+	ASSERT_FALSE (store->confirmation_height_get (transaction, key1.pub, confirmation_height_info));
+	ASSERT_EQ (1, cache.confirmation_heights.size ());
+	ASSERT_EQ (0, cache.pending_size ());
+}
+
+TEST (block_store, block_filter)
+{
+	ysu::logger_mt logger;
+	auto path (ysu::unique_path ());
+	auto filter_path (ysu::using_rocksdb_in_tests () ? path / "block_filter" : boost::filesystem::path (path.string () + "-filter"));
+	ysu::genesis genesis;
+	ysu::block_hash pruned (1);
+	{
+		auto store = ysu::make_store (logger, path);
+		ASSERT_TRUE (!store->init_error ());
+		ysu::ledger_cache ledger_cache;
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger_cache);
+		store->pruned_put (transaction, pruned);
+	}
+	// Closing the store persists the filter
+	ASSERT_TRUE (boost::filesystem::exists (filter_path));
+	{
+		auto store = ysu::make_store (logger, path);
+		ASSERT_TRUE (!store->init_error ());
+		// Loading removes the file, so the filter is rebuilt if the store isn't closed cleanly
+		ASSERT_FALSE (boost::filesystem::exists (filter_path));
+		auto transaction (store->tx_begin_read ());
+		ASSERT_TRUE (store->block_exists (transaction, genesis.hash ()));
+		ASSERT_TRUE (store->pruned_exists (transaction, pruned));
+		ASSERT_TRUE (store->block_or_pruned_exists (transaction, pruned));
+		ASSERT_FALSE (store->block_or_pruned_exists (transaction, ysu::block_hash (2)));
+	}
+	// Rebuilding finds the stored hashes
+	boost::filesystem::remove (filter_path);
+	auto store = ysu::make_store (logger, path);
+	ASSERT_TRUE (!store->init_error ());
+	auto transaction (store->tx_begin_read ());
+	ASSERT_TRUE (store->block_exists (transaction, genesis.hash ()));
+	ASSERT_TRUE (store->block_or_pruned_exists (transaction, pruned));
+	ASSERT_FALSE (store->block_exists (transaction, ysu::block_hash (2)));
+}
+
+TEST (mdb_block_store, read_txn_cache)
+{
+	if (ysu::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	ysu::logger_mt logger;
+	ysu::mdb_store store (logger, ysu::unique_path ());
+	ASSERT_FALSE (store.init_error ());
+	void * handle (nullptr);
+	{
+		auto transaction (store.tx_begin_read ());
+		handle = transaction.get_handle ();
+	}
+	ysu::block_hash pruned (1);
+	{
+		auto transaction (store.tx_begin_write ());
+		store.pruned_put (transaction, pruned);
+	}
+	{
+		// The handle is renewed and sees the commit made since it was reset
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (handle, transaction.get_handle ());
+		ASSERT_TRUE (store.pruned_exists (transaction, pruned));
+		// Nested transactions on the same thread get their own handle
+		auto nested (store.tx_begin_read ());
+		ASSERT_NE (handle, nested.get_handle ());
+	}
+	// Other threads get their own cached handle
+	std::thread ([&store, handle]() {
+		void * thread_handle (nullptr);
+		{
+			auto transaction (store.tx_begin_read ());
+			thread_handle = transaction.get_handle ();
+			ASSERT_NE (handle, thread_handle);
+		}
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (thread_handle, transaction.get_handle ());
+	})
+	.join ();
+	// The handle of the exited thread was released
+	ASSERT_EQ (1, store.env.read_txn_cache->size ());
+	// Cached handles have reader slots of their own
+	unsigned max_readers (0);
+	ASSERT_EQ (0, mdb_env_get_maxreaders (store.env, &max_readers));
+	ASSERT_EQ (ysu::mdb_read_txn_cache::default_max_readers + ysu::mdb_read_txn_cache::max_slots, max_readers);
+}
+
 TEST (block_store, latest_exists)
 {
 	ysu::logger_mt logger;
@@ -1637,10 +1902,11 @@ TEST (mdb_block_store, upgrade_v17_v18)
 	ASSERT_FALSE (store.init_error ());
 	auto transaction (store.tx_begin_read ());
 
-	// Size of state block should equal that set in db (no change)
+	// Later upgrades encode the block compactly
 	ysu::mdb_val value;
 	ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, ysu::mdb_val (state_send.hash ()), value));
-	ASSERT_EQ (value.size (), sizeof (ysu::block_type) + ysu::state_block::size + ysu::block_sideband::size (ysu::block_type::state));
+	ASSERT_TRUE (ysu::block_value_compact (reinterpret_cast<uint8_t const *> (value.data ())));
+	ASSERT_EQ (value.size (), ysu::block_value_size (*store.block_get (transaction, state_send.hash ())));
 
 	// Check that sidebands are correctly populated
 	{
@@ -1879,6 +2145,195 @@ TEST (mdb_block_store, upgrade_v19_v20)
 	ASSERT_LT (19, store.version_get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v20_v21)
+{
+	if (ysu::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (ysu::unique_path ());
+	ysu::genesis genesis;
+	ysu::logger_mt logger;
+	ysu::stat stats;
+	auto block (std::make_shared<ysu::send_block> (4, 1, 2, ysu::keypair ().prv, 4, 5));
+	{
+		ysu::mdb_store store (logger, path);
+		ysu::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		store.unchecked_put (transaction, block->previous (), block);
+		// Delete unchecked time index
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.unchecked_time, 1));
+		store.version_put (transaction, 20);
+	}
+	// Upgrading should create and fill the index
+	ysu::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.unchecked_time, 0);
+	auto transaction (store.tx_begin_write ());
+	ASSERT_LT (20, store.version_get (transaction));
+	auto deleted (store.unchecked_del_before (transaction, std::numeric_limits<uint64_t>::max (), 10));
+	ASSERT_EQ (1, deleted.size ());
+	ASSERT_EQ (block->hash (), deleted[0].block->hash ());
+}
+
+TEST (mdb_block_store, upgrade_v21_v22)
+{
+	if (ysu::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (ysu::unique_path ());
+	ysu::genesis genesis;
+	ysu::logger_mt logger;
+	ysu::stat stats;
+	ysu::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ysu::send_block send (genesis.hash (), ysu::dev_genesis_key.pub, ysu::genesis_amount - ysu::Gxrb_ratio, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	{
+		ysu::mdb_store store (logger, path);
+		ysu::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send).code);
+		// Delete account height index
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.account_height, 1));
+		store.version_put (transaction, 21);
+	}
+	// Upgrading should create and fill the index
+	ysu::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.account_height, 0);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (21, store.version_get (transaction));
+	ASSERT_EQ (genesis.hash (), store.account_height_get (transaction, ysu::genesis_account, 1));
+	ASSERT_EQ (send.hash (), store.account_height_get (transaction, ysu::genesis_account, 2));
+	ASSERT_TRUE (store.account_height_get (transaction, ysu::genesis_account, 3).is_zero ());
+}
+
+TEST (mdb_block_store, upgrade_v22_v23)
+{
+	if (ysu::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (ysu::unique_path ());
+	ysu::genesis genesis;
+	ysu::logger_mt logger;
+	ysu::stat stats;
+	{
+		ysu::mdb_store store (logger, path);
+		ysu::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		// Delete account balance index
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.account_balance, 1));
+		store.version_put (transaction, 22);
+	}
+	// Upgrading should create the index, which stays empty until enabled
+	ysu::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.account_balance, 0);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (22, store.version_get (transaction));
+	ASSERT_TRUE (store.account_balance_begin (transaction) == store.account_balance_end ());
+}
+
+TEST (mdb_block_store, upgrade_v23_v24)
+{
+	if (ysu::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (ysu::unique_path ());
+	ysu::genesis genesis;
+	ysu::logger_mt logger;
+	ysu::stat stats;
+	ysu::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ysu::keypair key;
+	ysu::send_block send1 (genesis.hash (), key.pub, ysu::genesis_amount - 100, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ysu::send_block send2 (send1.hash (), key.pub, ysu::genesis_amount - 300, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (send1.hash ()));
+	{
+		ysu::mdb_store store (logger, path);
+		ysu::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send2).code);
+		// Delete pending summaries
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.pending_summary, 1));
+		store.version_put (transaction, 23);
+	}
+	// Upgrading should create and fill the summaries
+	ysu::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.pending_summary, 0);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (23, store.version_get (transaction));
+	auto summary (store.pending_summary_get (transaction, key.pub));
+	ASSERT_EQ (2, summary.count);
+	ASSERT_EQ (300, summary.total.number ());
+	ASSERT_EQ (200, summary.max.number ());
+}
+
+TEST (mdb_block_store, upgrade_v24_v25)
+{
+	if (ysu::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (ysu::unique_path ());
+	ysu::genesis genesis;
+	ysu::logger_mt logger;
+	ysu::stat stats;
+	ysu::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ysu::keypair key;
+	ysu::send_block send (genesis.hash (), key.pub, ysu::genesis_amount - 100, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ysu::state_block open (key.pub, 0, key.pub, 100, send.hash (), key.prv, key.pub, *pool.generate (key.pub));
+	{
+		ysu::mdb_store store (logger, path);
+		ysu::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send).code);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, open).code);
+		// Rewrite the blocks in the previous encoding
+		for (auto const & hash : { genesis.hash (), send.hash (), open.hash () })
+		{
+			auto block (store.block_get (transaction, hash));
+			std::vector<uint8_t> data;
+			{
+				ysu::vectorstream stream (data);
+				ysu::serialize_block (stream, *block);
+				block->sideband ().serialize (stream, block->type ());
+			}
+			ASSERT_FALSE (mdb_put (store.env.tx (transaction), store.blocks, ysu::mdb_val (hash), ysu::mdb_val (data.size (), data.data ()), 0));
+		}
+		store.version_put (transaction, 24);
+	}
+	ysu::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (24, store.version_get (transaction));
+	for (auto const & block : std::vector<std::shared_ptr<ysu::block>>{ genesis.open, std::make_shared<ysu::send_block> (send), std::make_shared<ysu::state_block> (open) })
+	{
+		ysu::mdb_val value;
+		ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, ysu::mdb_val (block->hash ()), value));
+		ASSERT_TRUE (ysu::block_value_compact (reinterpret_cast<uint8_t const *> (value.data ())));
+		auto stored (store.block_get (transaction, block->hash ()));
+		ASSERT_EQ (*block, *stored);
+	}
+	ASSERT_EQ (send.hash (), store.block_successor (transaction, genesis.hash ()));
+	ASSERT_EQ (2, store.block_account_height (transaction, send.hash ()));
+	auto stored_open (store.block_get (transaction, open.hash ()));
+	ASSERT_TRUE (stored_open->sideband ().details.is_receive);
+	ASSERT_EQ (1, stored_open->sideband ().height);
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	if (ysu::using_rocksdb_in_tests ())
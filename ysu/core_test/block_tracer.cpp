@@ -0,0 +1,132 @@
+#include <ysu/lib/diagnosticsconfig.hpp>
+#include <ysu/node/block_tracer.hpp>
+#include <ysu/node/testing.hpp>
+#include <ysu/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::vector<std::string> stages (ysu::block_tracer & tracer_a, ysu::block_hash const & hash_a)
+{
+	std::vector<std::string> result;
+	auto events (tracer_a.events ());
+	std::stable_sort (events.begin (), events.end (), [](auto const & lhs, auto const & rhs) {
+		return lhs.time < rhs.time;
+	});
+	for (auto const & event : events)
+	{
+		if (event.hash == hash_a)
+		{
+			result.push_back (ysu::block_tracer::stage_name (event.stage));
+		}
+	}
+	return result;
+}
+}
+
+TEST (block_tracer, disabled)
+{
+	ysu::block_tracing_config config;
+	ysu::block_tracer tracer (config);
+	ASSERT_FALSE (tracer.enabled ());
+	tracer.trace (ysu::block_hash (0), ysu::block_tracer::stage::arrival);
+	ASSERT_EQ (0, tracer.size ());
+}
+
+TEST (block_tracer, sampling)
+{
+	ysu::block_tracing_config config;
+	config.enable = true;
+	config.sample_rate = 2;
+	ysu::block_tracer tracer (config);
+	ASSERT_TRUE (tracer.sampled (ysu::block_hash (2)));
+	ASSERT_FALSE (tracer.sampled (ysu::block_hash (3)));
+	tracer.trace (ysu::block_hash (2), ysu::block_tracer::stage::arrival);
+	tracer.trace (ysu::block_hash (3), ysu::block_tracer::stage::arrival);
+	ASSERT_EQ (1, tracer.size ());
+	tracer.clear ();
+	ASSERT_EQ (0, tracer.size ());
+	ASSERT_TRUE (tracer.events ().empty ());
+}
+
+TEST (block_tracer, wrap_around)
+{
+	ysu::block_tracing_config config;
+	config.enable = true;
+	config.sample_rate = 1;
+	config.buffer_size = 4;
+	ysu::block_tracer tracer (config);
+	for (auto i (0); i < 10; ++i)
+	{
+		tracer.trace (ysu::block_hash (i), ysu::block_tracer::stage::queued);
+	}
+	auto events (tracer.events ());
+	ASSERT_EQ (4, events.size ());
+	// Only the newest events are kept
+	ASSERT_EQ (ysu::block_hash (6), events.front ().hash);
+	ASSERT_EQ (ysu::block_hash (9), events.back ().hash);
+}
+
+TEST (block_tracer, export_json)
+{
+	ysu::block_tracing_config config;
+	config.enable = true;
+	config.sample_rate = 1;
+	ysu::block_tracer tracer (config);
+	ysu::block_hash hash (1);
+	tracer.trace (hash, ysu::block_tracer::stage::arrival);
+	std::thread thread ([&tracer, &hash]() {
+		tracer.trace (hash, ysu::block_tracer::stage::processed);
+	});
+	thread.join ();
+	tracer.trace (hash, ysu::block_tracer::stage::cemented);
+	ASSERT_EQ (3, tracer.size ());
+
+	std::stringstream stream (tracer.export_json ());
+	boost::property_tree::ptree trace;
+	boost::property_tree::read_json (stream, trace);
+	std::vector<std::string> phases;
+	std::vector<std::string> threads;
+	for (auto const & event : trace.get_child ("traceEvents"))
+	{
+		auto phase (event.second.get<std::string> ("ph"));
+		if (phase == "M")
+		{
+			threads.push_back (event.second.get<std::string> ("tid"));
+		}
+		else
+		{
+			ASSERT_EQ (hash.to_string (), event.second.get<std::string> ("id"));
+			phases.push_back (event.second.get<std::string> ("name") + ":" + phase);
+		}
+	}
+	ASSERT_EQ (2, threads.size ());
+	std::vector<std::string> expected{ "block:b", "arrival:n", "processed:b", "processed:e", "cemented:b", "cemented:e", "block:e" };
+	ASSERT_EQ (expected, phases);
+}
+
+TEST (block_tracer, node_lifecycle)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.diagnostics_config.block_tracing.enable = true;
+	node_config.diagnostics_config.block_tracing.sample_rate = 1;
+	auto node (system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	ysu::keypair key;
+	auto send (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key.pub, ysu::Gxrb_ratio));
+	ASSERT_NE (nullptr, send);
+	ASSERT_TIMELY (10s, !stages (node->block_tracer, send->hash ()).empty () && stages (node->block_tracer, send->hash ()).back () == "cemented");
+	auto stages_l (stages (node->block_tracer, send->hash ()));
+	for (auto stage : { "processed", "election_started", "confirmed", "cemented" })
+	{
+		ASSERT_NE (stages_l.end (), std::find (stages_l.begin (), stages_l.end (), stage));
+	}
+}
@@ -0,0 +1,88 @@
+#include <ysu/crypto_lib/random_pool.hpp>
+#include <ysu/lib/bloom_filter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+std::vector<ysu::block_hash> random_hashes (size_t count_a)
+{
+	std::vector<ysu::block_hash> result (count_a);
+	for (auto & hash : result)
+	{
+		ysu::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+	}
+	return result;
+}
+}
+
+TEST (bloom_filter, insert)
+{
+	ysu::bloom_filter filter;
+	auto hashes (random_hashes (1000));
+	for (auto const & hash : hashes)
+	{
+		ASSERT_FALSE (filter.may_contain (hash));
+		filter.insert (hash);
+		ASSERT_TRUE (filter.may_contain (hash));
+	}
+	ASSERT_EQ (hashes.size (), filter.size ());
+	// Inserting again is not counted
+	filter.insert (hashes[0]);
+	ASSERT_EQ (hashes.size (), filter.size ());
+	filter.reset (0);
+	ASSERT_EQ (0, filter.size ());
+	ASSERT_FALSE (filter.may_contain (hashes[0]));
+}
+
+// Segments are added once the capacity is exceeded, without losing earlier numbers or raising the false positive rate much
+TEST (bloom_filter, grow)
+{
+	ysu::bloom_filter filter;
+	auto memory_usage (filter.memory_usage ());
+	auto hashes (random_hashes (ysu::bloom_filter::default_capacity + 100000));
+	for (auto const & hash : hashes)
+	{
+		filter.insert (hash);
+	}
+	ASSERT_GT (filter.memory_usage (), memory_usage);
+	for (auto const & hash : hashes)
+	{
+		ASSERT_TRUE (filter.may_contain (hash));
+	}
+	size_t false_positives (0);
+	for (auto const & hash : random_hashes (100000))
+	{
+		false_positives += filter.may_contain (hash);
+	}
+	ASSERT_LT (false_positives, 5000);
+}
+
+TEST (bloom_filter, serialization)
+{
+	ysu::bloom_filter filter1;
+	auto hashes (random_hashes (1000));
+	for (auto const & hash : hashes)
+	{
+		filter1.insert (hash);
+	}
+	std::stringstream stream;
+	filter1.serialize (stream);
+	ysu::bloom_filter filter2;
+	ASSERT_FALSE (filter2.deserialize (stream));
+	ASSERT_EQ (filter1.size (), filter2.size ());
+	for (auto const & hash : hashes)
+	{
+		ASSERT_TRUE (filter2.may_contain (hash));
+	}
+	// Truncated input leaves the filter unchanged
+	auto truncated (stream.str ());
+	truncated.resize (truncated.size () / 2);
+	std::stringstream stream2 (truncated);
+	ysu::bloom_filter filter3;
+	ASSERT_TRUE (filter3.deserialize (stream2));
+	ASSERT_EQ (0, filter3.size ());
+}
@@ -1,10 +1,13 @@
 #include <ysu/node/bootstrap/bootstrap_frontier.hpp>
 #include <ysu/node/bootstrap/bootstrap_lazy.hpp>
+#include <ysu/node/bootstrap/bootstrap_peer_scores.hpp>
 #include <ysu/node/testing.hpp>
 #include <ysu/test_common/testutil.hpp>
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 using namespace std::chrono_literals;
 
 // If the account doesn't exist, current == end so there's no iteration
@@ -170,6 +173,63 @@ TEST (bulk_pull, count_limit)
 	ASSERT_EQ (nullptr, block);
 }
 
+TEST (bulk_pull, ascending)
+{
+	ysu::system system (1);
+	ysu::genesis genesis;
+
+	auto send1 (std::make_shared<ysu::send_block> (system.nodes[0]->latest (ysu::dev_genesis_key.pub), ysu::dev_genesis_key.pub, 1, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *system.work.generate (system.nodes[0]->latest (ysu::dev_genesis_key.pub))));
+	ASSERT_EQ (ysu::process_result::progress, system.nodes[0]->process (*send1).code);
+	auto receive1 (std::make_shared<ysu::receive_block> (send1->hash (), send1->hash (), ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *system.work.generate (send1->hash ())));
+	ASSERT_EQ (ysu::process_result::progress, system.nodes[0]->process (*receive1).code);
+
+	// Starting from an account begins with its open block
+	auto connection (std::make_shared<ysu::bootstrap_server> (nullptr, system.nodes[0]));
+	auto req = std::make_unique<ysu::bulk_pull> ();
+	req->start = ysu::dev_genesis_key.pub;
+	req->set_ascending (true);
+	req->set_count_present (true);
+	req->count = 2;
+	connection->requests.push (std::unique_ptr<ysu::message>{});
+	auto request (std::make_shared<ysu::bulk_pull_server> (connection, std::move (req)));
+	ASSERT_EQ (genesis.hash (), request->get_next ()->hash ());
+	ASSERT_EQ (send1->hash (), request->get_next ()->hash ());
+	ASSERT_EQ (nullptr, request->get_next ());
+
+	// Starting from a block continues with its successor up to the frontier
+	auto req2 = std::make_unique<ysu::bulk_pull> ();
+	req2->start = send1->hash ();
+	req2->set_ascending (true);
+	connection->requests.push (std::unique_ptr<ysu::message>{});
+	auto request2 (std::make_shared<ysu::bulk_pull_server> (connection, std::move (req2)));
+	ASSERT_EQ (receive1->hash (), request2->get_next ()->hash ());
+	ASSERT_EQ (nullptr, request2->get_next ());
+}
+
+// Chains longer than a send buffer are streamed in several chunks
+TEST (bulk_pull, chunked)
+{
+	ysu::system system;
+	ysu::node_config config (ysu::get_available_port (), system.logging);
+	config.frontiers_confirmation = ysu::frontiers_confirmation_mode::disabled;
+	ysu::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	auto count (3 * ysu::bulk_pull_server::send_buffer_size / ysu::block::size (ysu::block_type::state));
+	auto latest (node0->latest (ysu::dev_genesis_key.pub));
+	for (auto i (0u); i < count; ++i)
+	{
+		auto block (std::make_shared<ysu::state_block> (ysu::dev_genesis_key.pub, latest, ysu::dev_genesis_key.pub, ysu::genesis_amount - i - 1, ysu::dev_genesis_key.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *system.work.generate (latest)));
+		ASSERT_EQ (ysu::process_result::progress, node0->process (*block).code);
+		latest = block->hash ();
+	}
+	auto node1 (std::make_shared<ysu::node> (system.io_ctx, ysu::get_available_port (), ysu::unique_path (), system.alarm, system.logging, system.work));
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	ASSERT_TIMELY (20s, node1->latest (ysu::dev_genesis_key.pub) == latest);
+	ASSERT_GE (node0->stats.count (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_blocks, ysu::stat::dir::out), count);
+	node1->stop ();
+}
+
 TEST (bootstrap_processor, DISABLED_process_none)
 {
 	ysu::system system (1);
@@ -262,6 +322,39 @@ TEST (bootstrap_processor, process_state)
 	node1->stop ();
 }
 
+// The account space is split between several frontier requests
+TEST (bootstrap_processor, frontier_ranges)
+{
+	ysu::system system;
+	ysu::node_config config (ysu::get_available_port (), system.logging);
+	config.frontiers_confirmation = ysu::frontiers_confirmation_mode::disabled;
+	ysu::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	auto latest (node0->latest (ysu::dev_genesis_key.pub));
+	std::vector<ysu::keypair> keys (16);
+	for (auto i (0u); i < keys.size (); ++i)
+	{
+		auto send (std::make_shared<ysu::state_block> (ysu::dev_genesis_key.pub, latest, ysu::dev_genesis_key.pub, ysu::genesis_amount - i - 1, keys[i].pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *system.work.generate (latest)));
+		ASSERT_EQ (ysu::process_result::progress, node0->process (*send).code);
+		auto open (std::make_shared<ysu::state_block> (keys[i].pub, 0, keys[i].pub, 1, send->hash (), keys[i].prv, keys[i].pub, *system.work.generate (keys[i].pub)));
+		ASSERT_EQ (ysu::process_result::progress, node0->process (*open).code);
+		latest = send->hash ();
+	}
+	ysu::node_config config1 (ysu::get_available_port (), system.logging);
+	config1.bootstrap_connections = 4;
+	auto node1 (std::make_shared<ysu::node> (system.io_ctx, ysu::unique_path (), system.alarm, config1, system.work, node_flags));
+	ASSERT_FALSE (node1->init_error ());
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	ASSERT_TIMELY (10s, node1->ledger.cache.account_count == node0->ledger.cache.account_count && node1->latest (ysu::dev_genesis_key.pub) == latest);
+	for (auto const & key : keys)
+	{
+		ASSERT_FALSE (node1->latest (key.pub).is_zero ());
+	}
+	ASSERT_GE (node0->stats.count (ysu::stat::type::bootstrap, ysu::stat::detail::frontier_req, ysu::stat::dir::in), config1.bootstrap_connections);
+	node1->stop ();
+}
+
 TEST (bootstrap_processor, process_new)
 {
 	ysu::system system;
@@ -748,6 +841,65 @@ TEST (bootstrap_processor, lazy_destinations)
 	ASSERT_TRUE (node2->ledger.block_exists (state_open->hash ()));
 }
 
+TEST (bootstrap_processor, ascending)
+{
+	ysu::system system;
+	ysu::node_config config (ysu::get_available_port (), system.logging);
+	config.frontiers_confirmation = ysu::frontiers_confirmation_mode::disabled;
+	ysu::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	ysu::genesis genesis;
+	ysu::keypair key1;
+	auto send1 (std::make_shared<ysu::state_block> (ysu::dev_genesis_key.pub, genesis.hash (), ysu::dev_genesis_key.pub, ysu::genesis_amount - ysu::Gxrb_ratio, key1.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *node0->work_generate_blocking (genesis.hash ())));
+	auto receive1 (std::make_shared<ysu::state_block> (key1.pub, 0, key1.pub, ysu::Gxrb_ratio, send1->hash (), key1.prv, key1.pub, *node0->work_generate_blocking (key1.pub)));
+	auto send2 (std::make_shared<ysu::state_block> (key1.pub, receive1->hash (), key1.pub, 0, ysu::dev_genesis_key.pub, key1.prv, key1.pub, *node0->work_generate_blocking (receive1->hash ())));
+	node0->block_processor.add (send1);
+	node0->block_processor.add (receive1);
+	node0->block_processor.add (send2);
+	node0->block_processor.flush ();
+	ysu::node_flags node_flags1;
+	node_flags1.enable_ascending_bootstrap = true;
+	auto node1 (std::make_shared<ysu::node> (system.io_ctx, ysu::unique_path (), system.alarm, ysu::node_config (ysu::get_available_port (), system.logging), system.work, node_flags1));
+	node1->network.udp_channels.insert (node0->network.endpoint (), node1->network_params.protocol.protocol_version);
+	// Both accounts are pulled forward from what node1 already has, the dependency on send1 is resolved once genesis is pulled
+	node1->bootstrap_initiator.ascending_prioritize (key1.pub);
+	node1->bootstrap_initiator.ascending_prioritize (ysu::dev_genesis_key.pub);
+	ASSERT_TIMELY (10s, node1->bootstrap_initiator.current_ascending_attempt () != nullptr);
+	ASSERT_EQ ("ascending", node1->bootstrap_initiator.current_ascending_attempt ()->mode_text ());
+	ASSERT_TIMELY (10s, node1->ledger.cache.block_count == 4);
+	ASSERT_TRUE (node1->ledger.block_exists (send2->hash ()));
+	node1->stop ();
+}
+
+// Peers which don't support ascending pulls are asked for the missing blocks newest first
+TEST (bootstrap_processor, ascending_legacy_peer)
+{
+	ysu::system system;
+	ysu::node_config config (ysu::get_available_port (), system.logging);
+	config.frontiers_confirmation = ysu::frontiers_confirmation_mode::disabled;
+	ysu::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	ysu::genesis genesis;
+	ysu::keypair key1;
+	auto send1 (std::make_shared<ysu::state_block> (ysu::dev_genesis_key.pub, genesis.hash (), ysu::dev_genesis_key.pub, ysu::genesis_amount - ysu::Gxrb_ratio, key1.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *node0->work_generate_blocking (genesis.hash ())));
+	auto receive1 (std::make_shared<ysu::state_block> (key1.pub, 0, key1.pub, ysu::Gxrb_ratio, send1->hash (), key1.prv, key1.pub, *node0->work_generate_blocking (key1.pub)));
+	node0->block_processor.add (send1);
+	node0->block_processor.add (receive1);
+	node0->block_processor.flush ();
+	ysu::node_flags node_flags1;
+	node_flags1.enable_ascending_bootstrap = true;
+	auto node1 (std::make_shared<ysu::node> (system.io_ctx, ysu::unique_path (), system.alarm, ysu::node_config (ysu::get_available_port (), system.logging), system.work, node_flags1));
+	auto legacy_version (node1->network_params.protocol.bulk_pull_ascending_protocol_version_min - 1);
+	node1->network.udp_channels.insert (node0->network.endpoint (), legacy_version);
+	node1->bootstrap_initiator.ascending_prioritize (key1.pub);
+	node1->bootstrap_initiator.ascending_prioritize (ysu::dev_genesis_key.pub);
+	ASSERT_TIMELY (10s, node1->ledger.cache.block_count == 3);
+	ASSERT_TRUE (node1->ledger.block_exists (receive1->hash ()));
+	node1->stop ();
+}
+
 TEST (bootstrap_processor, wallet_lazy_frontier)
 {
 	ysu::system system;
@@ -1129,3 +1281,81 @@ TEST (bulk_pull_account, basics)
 		ASSERT_EQ (nullptr, block_data.second.get ());
 	}
 }
+
+TEST (bootstrap_peer_scores, select)
+{
+	ysu::bootstrap_peer_scores scores;
+	ysu::tcp_endpoint fast (boost::asio::ip::address_v6::loopback (), 10000);
+	ysu::tcp_endpoint slow (boost::asio::ip::address_v6::loopback (), 10001);
+	ysu::tcp_endpoint unknown (boost::asio::ip::address_v6::loopback (), 10002);
+	ASSERT_FALSE (scores.score (fast));
+	scores.sample (fast, 1000);
+	scores.sample (slow, 100);
+	ASSERT_EQ (2, scores.size ());
+	ASSERT_EQ (fast, scores.select ({ slow, fast }));
+	// Unknown peers rank as the average of all scored peers
+	ASSERT_EQ (unknown, scores.select ({ slow, unknown }));
+	ASSERT_EQ (fast, scores.select ({ unknown, fast }));
+	// Failures and connection latency discount the block rate
+	for (auto i (0); i < 20; ++i)
+	{
+		scores.failed (fast);
+	}
+	ASSERT_LT (*scores.score (fast), *scores.score (slow));
+	ASSERT_TRUE (scores.poor (fast));
+	ASSERT_FALSE (scores.poor (slow));
+	scores.connected (slow, std::chrono::seconds (1));
+	ASSERT_NEAR (25, *scores.score (slow), 0.01);
+	scores.sample (slow, ysu::bootstrap_limits::bootstrap_minimum_blocks_per_sec / 2);
+	scores.sample (slow, ysu::bootstrap_limits::bootstrap_minimum_blocks_per_sec / 2);
+	scores.sample (slow, 0);
+	scores.sample (slow, 0);
+	scores.sample (slow, 0);
+	scores.sample (slow, 0);
+	scores.sample (slow, 0);
+	ASSERT_TRUE (scores.poor (slow));
+	ASSERT_FALSE (scores.poor (unknown));
+}
+
+TEST (bootstrap_peer_scores, serialize)
+{
+	ysu::bootstrap_peer_scores scores;
+	ysu::tcp_endpoint fast (boost::asio::ip::address_v6::loopback (), 10000);
+	ysu::tcp_endpoint slow (boost::asio::ip::address_v6::loopback (), 10001);
+	scores.sample (fast, 1000);
+	scores.connected (fast, std::chrono::milliseconds (100));
+	scores.succeeded (fast);
+	scores.sample (slow, 100);
+	scores.failed (slow);
+	std::stringstream stream;
+	scores.serialize (stream);
+	ysu::bootstrap_peer_scores scores2;
+	ASSERT_FALSE (scores2.deserialize (stream));
+	ASSERT_EQ (2, scores2.size ());
+	ASSERT_EQ (*scores.score (fast), *scores2.score (fast));
+	ASSERT_EQ (*scores.score (slow), *scores2.score (slow));
+	// Truncated input leaves the scores unchanged
+	std::stringstream truncated (stream.str ().substr (0, 20));
+	ASSERT_TRUE (scores2.deserialize (truncated));
+	ASSERT_EQ (2, scores2.size ());
+}
+
+TEST (bootstrap_peer_scores, pulls)
+{
+	ysu::system system;
+	ysu::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (node_flags));
+	ysu::keypair key;
+	ASSERT_NE (nullptr, system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv));
+	ASSERT_NE (nullptr, system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key.pub, ysu::Gxrb_ratio));
+	auto node1 (std::make_shared<ysu::node> (system.io_ctx, ysu::unique_path (), system.alarm, ysu::node_config (ysu::get_available_port (), system.logging), system.work, node_flags));
+	node1->start ();
+	system.nodes.push_back (node1);
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	ASSERT_TIMELY (10s, node1->ledger.cache.block_count == node0->ledger.cache.block_count);
+	auto & connections (*node1->bootstrap_initiator.connections);
+	ASSERT_GT (connections.blocks_received.load (), 0);
+	ASSERT_GE (connections.peer_scores.size (), 1);
+	ASSERT_FALSE (connections.peer_scores.poor (ysu::transport::map_endpoint_to_tcp (node0->network.endpoint ())));
+}
@@ -0,0 +1,128 @@
+#include <ysu/crypto_lib/random_pool.hpp>
+#include <ysu/secure/cold_store.hpp>
+#include <ysu/secure/utility.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+
+namespace
+{
+std::vector<std::pair<ysu::block_hash, std::vector<uint8_t>>> make_records (size_t count_a)
+{
+	std::vector<std::pair<ysu::block_hash, std::vector<uint8_t>>> result;
+	for (size_t i (0); i < count_a; ++i)
+	{
+		ysu::block_hash hash;
+		ysu::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		// Values of different sizes, including empty ones
+		result.emplace_back (hash, std::vector<uint8_t> (i % 200, static_cast<uint8_t> (i)));
+	}
+	return result;
+}
+}
+
+TEST (cold_store, put_get)
+{
+	auto path (ysu::unique_path ());
+	bool error (false);
+	ysu::cold_store store (error, path);
+	ASSERT_FALSE (error);
+	ASSERT_EQ (nullptr, store.get (ysu::block_hash (1)));
+	ASSERT_FALSE (store.may_contain (ysu::block_hash (1)));
+	// Enough records for several fences
+	auto records1 (make_records (1000));
+	auto records2 (make_records (10));
+	ASSERT_FALSE (store.put (records1));
+	ASSERT_FALSE (store.put (records2));
+	ASSERT_EQ (2, store.segment_count ());
+	ASSERT_EQ (1010, store.size ());
+	// Filters are sized for the records of their segment
+	ASSERT_LT (store.memory_usage (), 16 * 1024);
+	for (auto const & records : { records1, records2 })
+	{
+		for (auto const & record : records)
+		{
+			ASSERT_TRUE (store.may_contain (record.first));
+			auto value (store.get (record.first));
+			ASSERT_NE (nullptr, value);
+			ASSERT_EQ (record.second, *value);
+		}
+	}
+	ASSERT_EQ (nullptr, store.get (ysu::block_hash (1)));
+}
+
+TEST (cold_store, sequential)
+{
+	auto path (ysu::unique_path ());
+	bool error (false);
+	ysu::cold_store store (error, path);
+	ASSERT_FALSE (error);
+	auto records (make_records (100));
+	ASSERT_FALSE (store.put (records));
+	// Records read in the order they were written only search the index for the first one
+	for (auto const & record : records)
+	{
+		auto value (store.get (record.first));
+		ASSERT_NE (nullptr, value);
+		ASSERT_EQ (record.second, *value);
+	}
+	ASSERT_EQ (1, store.index_hits);
+	ASSERT_EQ (99, store.sequential_hits);
+	// Out of order reads fall back to the index
+	ASSERT_NE (nullptr, store.get (records[10].first));
+	ASSERT_EQ (2, store.index_hits);
+}
+
+TEST (cold_store, reopen)
+{
+	auto path (ysu::unique_path ());
+	auto records (make_records (100));
+	{
+		bool error (false);
+		ysu::cold_store store (error, path);
+		ASSERT_FALSE (error);
+		ASSERT_FALSE (store.put (records));
+	}
+	// Left behind by an interrupted put
+	std::ofstream (path / "1.tmp") << "partial";
+	bool error (false);
+	ysu::cold_store store (error, path);
+	ASSERT_FALSE (error);
+	ASSERT_FALSE (boost::filesystem::exists (path / "1.tmp"));
+	ASSERT_EQ (1, store.segment_count ());
+	ASSERT_EQ (100, store.size ());
+	for (auto const & record : records)
+	{
+		auto value (store.get (record.first));
+		ASSERT_NE (nullptr, value);
+		ASSERT_EQ (record.second, *value);
+	}
+	// New segments don't reuse the id of existing ones
+	ASSERT_FALSE (store.put (make_records (1)));
+	ASSERT_EQ (2, store.segment_count ());
+	ASSERT_NE (nullptr, store.get (records[0].first));
+}
+
+TEST (cold_store, copy)
+{
+	auto path (ysu::unique_path ());
+	bool error (false);
+	ysu::cold_store store (error, path);
+	ASSERT_FALSE (error);
+	auto records (make_records (100));
+	ASSERT_FALSE (store.put (records));
+	auto destination (ysu::unique_path ());
+	ASSERT_FALSE (store.copy (destination));
+	ysu::cold_store copy (error, destination);
+	ASSERT_FALSE (error);
+	ASSERT_EQ (1, copy.segment_count ());
+	for (auto const & record : records)
+	{
+		auto value (copy.get (record.first));
+		ASSERT_NE (nullptr, value);
+		ASSERT_EQ (record.second, *value);
+	}
+}
@@ -698,7 +698,7 @@ TEST (confirmation_height, conflict_rollback_cemented)
 		}
 		auto transaction1 (node1->store.tx_begin_read ());
 		auto transaction2 (node2->store.tx_begin_read ());
-		ysu::unique_lock<std::mutex> lock (node2->active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node2->active.mutex);
 		auto winner (*election->tally ().begin ());
 		ASSERT_EQ (*publish1.block, *winner.second);
 		ASSERT_EQ (ysu::genesis_amount - 100, winner.first);
@@ -1018,7 +1018,7 @@ TEST (confirmation_height, callback_confirmed_history)
 			ASSERT_TIMELY (10s, node->active.size () == 0);
 			ASSERT_EQ (0, node->active.list_recently_cemented ().size ());
 			{
-				ysu::lock_guard<std::mutex> guard (node->active.mutex);
+				ysu::lock_guard<ysu::mutex> guard (node->active.mutex);
 				ASSERT_EQ (0, node->active.blocks.size ());
 			}
 
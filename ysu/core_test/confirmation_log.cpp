@@ -0,0 +1,161 @@
+#include <ysu/lib/logger_mt.hpp>
+#include <ysu/node/confirmation_log.hpp>
+#include <ysu/node/testing.hpp>
+#include <ysu/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::shared_ptr<ysu::state_block> log_block (uint64_t height_a)
+{
+	auto block (std::make_shared<ysu::state_block> (ysu::dev_genesis_key.pub, ysu::block_hash (height_a), ysu::dev_genesis_key.pub, ysu::genesis_amount - height_a, ysu::dev_genesis_key.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, 0));
+	block->sideband_set (ysu::block_sideband (ysu::dev_genesis_key.pub, 0, ysu::genesis_amount - height_a, height_a, ysu::seconds_since_epoch (), ysu::epoch::epoch_0, true, false, false, ysu::epoch::epoch_0));
+	return block;
+}
+}
+
+TEST (confirmation_log, append_read)
+{
+	auto path (ysu::unique_path ());
+	ysu::logger_mt logger;
+	ysu::confirmation_log_config config;
+	config.enabled = true;
+	config.segment_size = 4096;
+	config.max_size = 0;
+	ysu::confirmation_log log (path, config, logger);
+	ASSERT_EQ (0, log.first_sequence ());
+	ASSERT_EQ (0, log.last_sequence ());
+	ASSERT_TRUE (log.read (0, 10).empty ());
+
+	std::vector<std::shared_ptr<ysu::state_block>> blocks;
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		blocks.push_back (log_block (i));
+		ASSERT_EQ (i, log.append (*blocks.back ()));
+	}
+	ASSERT_GT (log.segment_count (), 1);
+	ASSERT_EQ (1, log.first_sequence ());
+	ASSERT_EQ (1000, log.last_sequence ());
+
+	auto all (log.read (0, 2000));
+	ASSERT_EQ (1000, all.size ());
+	for (size_t i (0); i < all.size (); ++i)
+	{
+		ASSERT_EQ (i + 1, all[i].sequence);
+		ASSERT_EQ (*blocks[i], *all[i].block);
+		ASSERT_EQ (blocks[i]->sideband ().height, all[i].block->sideband ().height);
+		ASSERT_TRUE (all[i].block->sideband ().details.is_send);
+	}
+
+	// Reads starting in the middle of a segment and spanning segments
+	auto middle (log.read (777, 300));
+	ASSERT_EQ (224, middle.size ());
+	ASSERT_EQ (777, middle.front ().sequence);
+	ASSERT_EQ (1000, middle.back ().sequence);
+	ASSERT_EQ (blocks[776]->hash (), middle.front ().block->hash ());
+	ASSERT_TRUE (log.read (1001, 10).empty ());
+}
+
+TEST (confirmation_log, recovery)
+{
+	auto path (ysu::unique_path ());
+	ysu::logger_mt logger;
+	ysu::confirmation_log_config config;
+	config.enabled = true;
+	{
+		ysu::confirmation_log log (path, config, logger);
+		for (uint64_t i (1); i <= 10; ++i)
+		{
+			log.append (*log_block (i));
+		}
+	}
+	// Simulate a torn write at the end of the last segment
+	auto segment (*boost::filesystem::directory_iterator (path));
+	auto size (boost::filesystem::file_size (segment.path ()));
+	{
+		std::ofstream stream (segment.path ().string (), std::ios::binary | std::ios::app);
+		stream << "torn";
+	}
+	ysu::confirmation_log log (path, config, logger);
+	ASSERT_EQ (size, boost::filesystem::file_size (segment.path ()));
+	ASSERT_EQ (1, log.first_sequence ());
+	ASSERT_EQ (10, log.last_sequence ());
+	ASSERT_EQ (11, log.append (*log_block (11)));
+	auto entries (log.read (9, 10));
+	ASSERT_EQ (3, entries.size ());
+	ASSERT_EQ (log_block (11)->hash (), entries.back ().block->hash ());
+}
+
+TEST (confirmation_log, retention)
+{
+	auto path (ysu::unique_path ());
+	ysu::logger_mt logger;
+	ysu::confirmation_log_config config;
+	config.enabled = true;
+	config.segment_size = 4096;
+	config.max_size = 3 * 4096;
+	ysu::confirmation_log log (path, config, logger);
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		log.append (*log_block (i));
+	}
+	ASSERT_LE (log.segment_count (), 4);
+	ASSERT_LE (log.size (), config.max_size + config.segment_size);
+	auto first (log.first_sequence ());
+	ASSERT_GT (first, 1);
+	ASSERT_EQ (1000, log.last_sequence ());
+	// Reading from a deleted position resumes at the oldest retained entry
+	auto entries (log.read (1, 1));
+	ASSERT_EQ (1, entries.size ());
+	ASSERT_EQ (first, entries.front ().sequence);
+}
+
+TEST (confirmation_log, retention_age)
+{
+	auto path (ysu::unique_path ());
+	ysu::logger_mt logger;
+	ysu::confirmation_log_config config;
+	config.enabled = true;
+	config.segment_size = 4096;
+	ysu::confirmation_log log (path, config, logger);
+	for (uint64_t i (1); i <= 100; ++i)
+	{
+		log.append (*log_block (i));
+	}
+	log.sync ();
+	auto segments (log.segment_count ());
+	ASSERT_GT (segments, 1);
+	// Segments age out without further appends
+	std::vector<boost::filesystem::path> files (boost::filesystem::directory_iterator (path), boost::filesystem::directory_iterator{});
+	auto oldest (*std::min_element (files.begin (), files.end ()));
+	boost::filesystem::last_write_time (oldest, std::time (nullptr) - std::chrono::duration_cast<std::chrono::seconds> (config.max_age).count () - 60);
+	log.apply_retention ();
+	ASSERT_EQ (segments - 1, log.segment_count ());
+	ASSERT_GT (log.first_sequence (), 1);
+}
+
+TEST (confirmation_log, node_cemented)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.confirmation_log_config.enabled = true;
+	auto node (system.add_node (node_config));
+	ASSERT_NE (nullptr, node->confirmation_log);
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	ysu::keypair key1;
+	auto send (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key1.pub, ysu::Gxrb_ratio));
+	ASSERT_NE (nullptr, send);
+	ASSERT_TIMELY (10s, node->confirmation_log->last_sequence () == 1);
+	auto entries (node->confirmation_log->read (0, 10));
+	ASSERT_EQ (1, entries.size ());
+	ASSERT_EQ (1, entries[0].sequence);
+	ASSERT_EQ (send->hash (), entries[0].block->hash ());
+	ASSERT_EQ (2, entries[0].block->sideband ().height);
+}
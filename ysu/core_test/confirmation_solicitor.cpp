@@ -31,7 +31,7 @@ TEST (confirmation_solicitor, batches)
 	auto send (std::make_shared<ysu::send_block> (ysu::genesis_hash, ysu::keypair ().pub, ysu::genesis_amount - 100, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *system.work.generate (ysu::genesis_hash)));
 	send->sideband_set ({});
 	{
-		ysu::lock_guard<std::mutex> guard (node2.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node2.active.mutex);
 		for (size_t i (0); i < ysu::network::confirm_req_hashes_max; ++i)
 		{
 			auto election (std::make_shared<ysu::election> (node2, send, nullptr, false, ysu::election_behavior::normal));
@@ -115,7 +115,7 @@ TEST (confirmation_solicitor, bypass_max_requests_cap)
 	// Add a vote for something else, not the winner
 	for (auto const & rep : representatives)
 	{
-		ysu::lock_guard<std::mutex> guard (node1.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node1.active.mutex);
 		election->last_votes[rep.account] = { std::chrono::steady_clock::now (), 1, 1 };
 	}
 	ASSERT_FALSE (solicitor.add (*election));
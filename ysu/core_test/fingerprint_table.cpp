@@ -0,0 +1,104 @@
+#include <ysu/crypto_lib/random_pool.hpp>
+#include <ysu/lib/fingerprint_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+TEST (fingerprint_table, set)
+{
+	ysu::fingerprint_set set;
+	ASSERT_TRUE (set.empty ());
+	ASSERT_EQ (0, set.memory_usage ());
+	ysu::block_hash hash1 (1);
+	ysu::block_hash hash2 (2);
+	ASSERT_FALSE (set.contains (hash1));
+	ASSERT_TRUE (set.insert (hash1));
+	ASSERT_FALSE (set.insert (hash1));
+	ASSERT_TRUE (set.insert (hash2));
+	ASSERT_EQ (2, set.size ());
+	ASSERT_TRUE (set.contains (hash1));
+	ASSERT_TRUE (set.erase (hash1));
+	ASSERT_FALSE (set.erase (hash1));
+	ASSERT_FALSE (set.contains (hash1));
+	ASSERT_TRUE (set.contains (hash2));
+	ASSERT_EQ (1, set.size ());
+	// The zero fingerprint is reserved for empty slots
+	ASSERT_TRUE (set.insert (ysu::block_hash (0)));
+	ASSERT_TRUE (set.contains (ysu::block_hash (0)));
+	set.clear ();
+	ASSERT_TRUE (set.empty ());
+	ASSERT_FALSE (set.contains (hash2));
+}
+
+// Fingerprints are keyed, numbers colliding under std::hash stay distinct and each table fingerprints differently
+TEST (fingerprint_table, keyed)
+{
+	ysu::fingerprint_set set1;
+	ysu::fingerprint_set set2;
+	ysu::block_hash hash1;
+	ysu::block_hash hash2;
+	hash1.qwords = { 1, 2, 0, 0 };
+	hash2.qwords = { 2, 1, 0, 0 };
+	ASSERT_EQ (std::hash<ysu::block_hash> () (hash1), std::hash<ysu::block_hash> () (hash2));
+	ASSERT_TRUE (set1.insert (hash1));
+	ASSERT_TRUE (set1.insert (hash2));
+	ASSERT_EQ (2, set1.size ());
+	ASSERT_NE (set1.fingerprint (hash1), set2.fingerprint (hash1));
+}
+
+TEST (fingerprint_table, map)
+{
+	ysu::fingerprint_map<ysu::uint128_t> map;
+	ysu::block_hash hash (1);
+	ASSERT_EQ (nullptr, map.find (hash));
+	ASSERT_TRUE (map.insert (hash, 10));
+	ASSERT_FALSE (map.insert (hash, 20));
+	ASSERT_NE (nullptr, map.find (hash));
+	ASSERT_EQ (10, *map.find (hash));
+	*map.find (hash) = 30;
+	ASSERT_EQ (30, *map.find (hash));
+	size_t visited (0);
+	map.for_each ([&visited](ysu::uint128_t const & value_a) {
+		++visited;
+		return true;
+	});
+	ASSERT_EQ (1, visited);
+	ASSERT_TRUE (map.erase (hash));
+	ASSERT_EQ (nullptr, map.find (hash));
+}
+
+// Erasing has to keep every other entry reachable through its probe sequence, including across growth
+TEST (fingerprint_table, many)
+{
+	ysu::fingerprint_map<uint64_t> map;
+	std::unordered_set<ysu::block_hash> hashes;
+	for (uint64_t i (0); i < 10000; ++i)
+	{
+		ysu::block_hash hash;
+		ysu::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		hashes.insert (hash);
+		ASSERT_TRUE (map.insert (hash, i));
+	}
+	ASSERT_EQ (hashes.size (), map.size ());
+	size_t erased (0);
+	for (auto i (hashes.begin ()); i != hashes.end ();)
+	{
+		if (erased++ % 2 == 0)
+		{
+			ASSERT_TRUE (map.erase (*i));
+			i = hashes.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+	ASSERT_EQ (hashes.size (), map.size ());
+	for (auto const & hash : hashes)
+	{
+		ASSERT_TRUE (map.contains (hash));
+	}
+	// Slots stay within a small factor of the stored element size
+	ASSERT_LE (map.memory_usage (), 4 * map.size () * ysu::fingerprint_map<uint64_t>::slot_size);
+}
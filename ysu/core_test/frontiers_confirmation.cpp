@@ -138,7 +138,7 @@ TEST (frontiers_confirmation, prioritize_frontiers)
 	std::array<ysu::qualified_root, num_accounts> frontiers{ send17.qualified_root (), send6.qualified_root (), send7.qualified_root (), open2.qualified_root (), send11.qualified_root () };
 	for (auto & frontier : frontiers)
 	{
-		ysu::lock_guard<std::mutex> guard (node->active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node->active.mutex);
 		ASSERT_NE (node->active.roots.find (frontier), node->active.roots.end ());
 	}
 }
@@ -169,7 +169,7 @@ TEST (frontiers_confirmation, prioritize_frontiers_max_optimistic_elections)
 	}
 
 	{
-		ysu::unique_lock<std::mutex> lk (node->active.mutex);
+		ysu::unique_lock<ysu::mutex> lk (node->active.mutex);
 		node->active.frontiers_confirmation (lk);
 	}
 
@@ -180,7 +180,7 @@ TEST (frontiers_confirmation, prioritize_frontiers_max_optimistic_elections)
 
 	// Call frontiers confirmation again and confirm that next_frontier_account hasn't changed
 	{
-		ysu::unique_lock<std::mutex> lk (node->active.mutex);
+		ysu::unique_lock<ysu::mutex> lk (node->active.mutex);
 		node->active.frontiers_confirmation (lk);
 	}
 
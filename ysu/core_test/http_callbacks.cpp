@@ -0,0 +1,252 @@
+#include <ysu/lib/logger_mt.hpp>
+#include <ysu/node/http_callbacks.hpp>
+#include <ysu/node/nodeconfig.hpp>
+#include <ysu/node/testing.hpp>
+#include <ysu/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+/** Minimal HTTP server recording callback requests, answering the first \p failures requests with an error */
+class callback_server final
+{
+public:
+	enum class mode
+	{
+		respond,
+		/** Closes each connection after responding although the response allows keeping it alive */
+		close_idle,
+		/** Reads requests without ever responding */
+		silent
+	};
+	explicit callback_server (unsigned failures_a = 0, mode mode_a = mode::respond) :
+	acceptor (io_ctx, boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v4::loopback (), 0)),
+	failures (failures_a),
+	mode_m (mode_a)
+	{
+		accept ();
+		thread = std::thread ([this]() {
+			io_ctx.run ();
+		});
+	}
+	~callback_server ()
+	{
+		io_ctx.stop ();
+		thread.join ();
+	}
+	uint16_t port () const
+	{
+		return acceptor.local_endpoint ().port ();
+	}
+	std::vector<std::string> bodies ()
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		return received;
+	}
+	std::atomic<unsigned> connections{ 0 };
+
+private:
+	class session final
+	{
+	public:
+		explicit session (boost::asio::io_context & io_ctx_a) :
+		socket (io_ctx_a)
+		{
+		}
+		boost::asio::ip::tcp::socket socket;
+		boost::beast::flat_buffer buffer;
+		boost::beast::http::request<boost::beast::http::string_body> request;
+		boost::beast::http::response<boost::beast::http::string_body> response;
+	};
+	void accept ()
+	{
+		auto session_l (std::make_shared<session> (io_ctx));
+		acceptor.async_accept (session_l->socket, [this, session_l](boost::system::error_code const & ec) {
+			if (!ec)
+			{
+				++connections;
+				read (session_l);
+				accept ();
+			}
+		});
+	}
+	void read (std::shared_ptr<session> const & session_a)
+	{
+		session_a->request = {};
+		boost::beast::http::async_read (session_a->socket, session_a->buffer, session_a->request, [this, session_a](boost::system::error_code const & ec, size_t) {
+			if (!ec)
+			{
+				auto fail (false);
+				{
+					ysu::lock_guard<std::mutex> guard (mutex);
+					fail = failures > 0;
+					if (fail)
+					{
+						--failures;
+					}
+					else
+					{
+						received.push_back (session_a->request.body ());
+					}
+				}
+				if (mode_m == mode::silent)
+				{
+					return;
+				}
+				session_a->response = {};
+				session_a->response.version (11);
+				session_a->response.result (fail ? boost::beast::http::status::internal_server_error : boost::beast::http::status::ok);
+				session_a->response.keep_alive (session_a->request.keep_alive ());
+				session_a->response.prepare_payload ();
+				boost::beast::http::async_write (session_a->socket, session_a->response, [this, session_a](boost::system::error_code const & ec, size_t) {
+					if (!ec && mode_m == mode::close_idle)
+					{
+						boost::system::error_code ignored;
+						session_a->socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both, ignored);
+						session_a->socket.close (ignored);
+					}
+					else if (!ec)
+					{
+						read (session_a);
+					}
+				});
+			}
+		});
+	}
+	boost::asio::io_context io_ctx;
+	boost::asio::ip::tcp::acceptor acceptor;
+	std::mutex mutex;
+	unsigned failures;
+	mode mode_m;
+	std::vector<std::string> received;
+	std::thread thread;
+};
+}
+
+TEST (http_callbacks, keep_alive_batching)
+{
+	ysu::system system;
+	callback_server server;
+	ysu::logging logging;
+	ysu::node_config config (ysu::get_available_port (), logging);
+	config.callback_address = "127.0.0.1";
+	config.callback_port = server.port ();
+	config.callback_target = "/";
+	config.callback_max_connections = 1;
+	config.callback_batch_size = 10;
+	ysu::stat stats;
+	ysu::logger_mt logger;
+	ysu::http_callbacks callbacks (config, stats, logger);
+	for (auto i (0); i < 20; ++i)
+	{
+		ASSERT_FALSE (callbacks.add ("{}"));
+	}
+	callbacks.start ();
+	ASSERT_TIMELY (10s, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out) == 20);
+	ASSERT_EQ (2, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::callback_batch, ysu::stat::dir::out));
+	auto bodies (server.bodies ());
+	ASSERT_EQ (2, bodies.size ());
+	ASSERT_EQ ("{\"blocks\": [{},{},{},{},{},{},{},{},{},{}]}", bodies.front ());
+	// Both requests were sent over the same connection
+	ASSERT_EQ (1, server.connections.load ());
+	callbacks.add ("{\"single\": true}");
+	ASSERT_TIMELY (10s, server.bodies ().size () == 3);
+	ASSERT_EQ ("{\"single\": true}", server.bodies ().back ());
+	ASSERT_EQ (1, server.connections.load ());
+	ASSERT_EQ (0, stats.count (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out));
+}
+
+TEST (http_callbacks, retry)
+{
+	ysu::system system;
+	callback_server server (2);
+	ysu::logging logging;
+	ysu::node_config config (ysu::get_available_port (), logging);
+	config.callback_address = "127.0.0.1";
+	config.callback_port = server.port ();
+	config.callback_target = "/";
+	config.callback_max_retries = 2;
+	config.callback_retry_backoff = 1ms;
+	ysu::stat stats;
+	ysu::logger_mt logger;
+	ysu::http_callbacks callbacks (config, stats, logger);
+	callbacks.start ();
+	ASSERT_FALSE (callbacks.add ("{}"));
+	ASSERT_TIMELY (10s, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out) == 1);
+	ASSERT_EQ (2, stats.count (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out));
+	ASSERT_EQ (2, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::callback_retry, ysu::stat::dir::out));
+	ASSERT_EQ (1, server.bodies ().size ());
+}
+
+// A kept alive connection closed by the receiver is replaced without counting as a failed delivery
+TEST (http_callbacks, reconnect_stale)
+{
+	ysu::system system;
+	callback_server server (0, callback_server::mode::close_idle);
+	ysu::logging logging;
+	ysu::node_config config (ysu::get_available_port (), logging);
+	config.callback_address = "127.0.0.1";
+	config.callback_port = server.port ();
+	config.callback_target = "/";
+	config.callback_max_connections = 1;
+	config.callback_max_retries = 0;
+	ysu::stat stats;
+	ysu::logger_mt logger;
+	ysu::http_callbacks callbacks (config, stats, logger);
+	callbacks.start ();
+	ASSERT_FALSE (callbacks.add ("{}"));
+	ASSERT_TIMELY (10s, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out) == 1);
+	// Give the server time to close the idle connection
+	std::this_thread::sleep_for (100ms);
+	ASSERT_FALSE (callbacks.add ("{}"));
+	ASSERT_TIMELY (10s, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out) == 2);
+	ASSERT_EQ (2, server.connections.load ());
+	ASSERT_EQ (0, stats.count (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out));
+	ASSERT_EQ (0, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::callback_retry, ysu::stat::dir::out));
+}
+
+TEST (http_callbacks, timeout)
+{
+	ysu::system system;
+	callback_server server (0, callback_server::mode::silent);
+	ysu::logging logging;
+	ysu::node_config config (ysu::get_available_port (), logging);
+	config.callback_address = "127.0.0.1";
+	config.callback_port = server.port ();
+	config.callback_target = "/";
+	config.callback_max_retries = 0;
+	config.callback_timeout = 100ms;
+	ysu::stat stats;
+	ysu::logger_mt logger;
+	ysu::http_callbacks callbacks (config, stats, logger);
+	callbacks.start ();
+	ASSERT_FALSE (callbacks.add ("{}"));
+	ASSERT_TIMELY (10s, stats.count (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out) == 1);
+	ASSERT_EQ (1, server.bodies ().size ());
+	ASSERT_EQ (0, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out));
+}
+
+TEST (http_callbacks, overflow)
+{
+	ysu::logging logging;
+	ysu::node_config config (ysu::get_available_port (), logging);
+	config.callback_address = "127.0.0.1";
+	config.callback_max_queued = 2;
+	ysu::stat stats;
+	ysu::logger_mt logger;
+	ysu::http_callbacks callbacks (config, stats, logger);
+	ASSERT_FALSE (callbacks.add ("{}"));
+	ASSERT_FALSE (callbacks.add ("{}"));
+	ASSERT_TRUE (callbacks.add ("{}"));
+	ASSERT_EQ (2, callbacks.size ());
+	ASSERT_EQ (1, stats.count (ysu::stat::type::http_callback, ysu::stat::detail::overflow, ysu::stat::dir::out));
+}
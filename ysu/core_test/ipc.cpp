@@ -1,5 +1,7 @@
 #include <ysu/lib/ipc_client.hpp>
+#include <ysu/lib/ipc_ring.hpp>
 #include <ysu/lib/tomlconfig.hpp>
+#include <ysu/node/ipc/flatbuffers_handler.hpp>
 #include <ysu/node/ipc/ipc_access_config.hpp>
 #include <ysu/node/ipc/ipc_server.hpp>
 #include <ysu/node/testing.hpp>
@@ -189,3 +191,186 @@ TEST (ipc, permissions_default_user_order)
 	ysu::ipc::access access;
 	ASSERT_TRUE (access.deserialize_toml (toml));
 }
+
+namespace
+{
+/** Runs a request through the Flatbuffers handler and returns the response envelope buffer */
+template <typename T>
+std::shared_ptr<flatbuffers::FlatBufferBuilder> flatbuffers_query (ysu::ipc::flatbuffers_handler & handler_a, T & request_a)
+{
+	auto request (ysu::ipc::flatbuffer_producer::make_buffer (request_a));
+	std::shared_ptr<flatbuffers::FlatBufferBuilder> response;
+	handler_a.process (request->GetBufferPointer (), request->GetSize (), [&response](std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb_a) {
+		response = fbb_a;
+	});
+	return response;
+}
+}
+
+TEST (ipc, flatbuffers_ledger_queries)
+{
+	ysu::system system (1);
+	auto node (system.nodes[0]);
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc (*node, node_rpc_config);
+	ysu::ipc::flatbuffers_handler handler (*node, ipc, nullptr, node->config.ipc_config);
+	ysu::keypair key;
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	auto send (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key.pub, 100));
+	ASSERT_NE (nullptr, send);
+	ysu::genesis genesis;
+
+	ysuapi::AccountInfoT account_info;
+	account_info.account = ysu::dev_genesis_key.pub.to_account ();
+	account_info.include_pending = true;
+	auto info_envelope (ysuapi::GetEnvelope (flatbuffers_query (handler, account_info)->GetBufferPointer ()));
+	auto info (info_envelope->message_as_AccountInfoResponse ());
+	ASSERT_NE (nullptr, info);
+	ASSERT_EQ (send->hash ().to_string (), info->frontier ()->str ());
+	ASSERT_EQ (genesis.hash ().to_string (), info->open_block ()->str ());
+	ASSERT_EQ (2, info->block_count ());
+	ASSERT_EQ ("0", info->pending ()->str ());
+	ASSERT_EQ (nullptr, info->voting_weight ());
+
+	ysuapi::PendingT pending;
+	pending.account = key.pub.to_account ();
+	auto pending_response (ysuapi::GetEnvelope (flatbuffers_query (handler, pending)->GetBufferPointer ())->message_as_PendingResponse ());
+	ASSERT_NE (nullptr, pending_response);
+	ASSERT_EQ (1, pending_response->blocks ()->size ());
+	ASSERT_EQ (send->hash ().to_string (), pending_response->blocks ()->Get (0)->hash ()->str ());
+	ASSERT_EQ ("100", pending_response->blocks ()->Get (0)->amount ()->str ());
+
+	// Page through the history one entry at a time using the cursor
+	ysuapi::AccountHistoryT history;
+	history.account = ysu::dev_genesis_key.pub.to_account ();
+	history.count = 1;
+	auto history_response (ysuapi::GetEnvelope (flatbuffers_query (handler, history)->GetBufferPointer ())->message_as_AccountHistoryResponse ());
+	ASSERT_NE (nullptr, history_response);
+	ASSERT_EQ (1, history_response->history ()->size ());
+	auto entry (history_response->history ()->Get (0));
+	ASSERT_EQ (send->hash ().to_string (), entry->hash ()->str ());
+	ASSERT_EQ (ysuapi::BlockSubType::BlockSubType_send, entry->subtype ());
+	ASSERT_EQ (key.pub.to_account (), entry->account ()->str ());
+	ASSERT_EQ ("100", entry->amount ()->str ());
+	ASSERT_EQ (2, entry->height ());
+	ASSERT_EQ (genesis.hash ().to_string (), history_response->next ()->str ());
+	history.head = history_response->next ()->str ();
+	auto history_response2 (ysuapi::GetEnvelope (flatbuffers_query (handler, history)->GetBufferPointer ())->message_as_AccountHistoryResponse ());
+	ASSERT_NE (nullptr, history_response2);
+	ASSERT_EQ (1, history_response2->history ()->size ());
+	ASSERT_EQ (genesis.hash ().to_string (), history_response2->history ()->Get (0)->hash ()->str ());
+	ASSERT_TRUE (history_response2->history ()->Get (0)->confirmed ());
+	ASSERT_EQ (nullptr, history_response2->next ());
+
+	ysuapi::BlocksInfoT blocks_info;
+	blocks_info.hashes.push_back (send->hash ().to_string ());
+	blocks_info.hashes.push_back (ysu::block_hash (1).to_string ());
+	blocks_info.include_not_found = true;
+	auto blocks_response (ysuapi::GetEnvelope (flatbuffers_query (handler, blocks_info)->GetBufferPointer ())->message_as_BlocksInfoResponse ());
+	ASSERT_NE (nullptr, blocks_response);
+	ASSERT_EQ (1, blocks_response->blocks ()->size ());
+	ASSERT_EQ ("100", blocks_response->blocks ()->Get (0)->amount ()->str ());
+	ASSERT_EQ (ysu::dev_genesis_key.pub.to_account (), blocks_response->blocks ()->Get (0)->account ()->str ());
+	ASSERT_EQ (ysuapi::Block::Block_BlockState, blocks_response->blocks ()->Get (0)->block_type ());
+	ASSERT_EQ (1, blocks_response->blocks_not_found ()->size ());
+
+	ysuapi::FrontiersT frontiers;
+	frontiers.start = ysu::account (0).to_account ();
+	auto frontiers_response (ysuapi::GetEnvelope (flatbuffers_query (handler, frontiers)->GetBufferPointer ())->message_as_FrontiersResponse ());
+	ASSERT_NE (nullptr, frontiers_response);
+	ASSERT_EQ (1, frontiers_response->frontiers ()->size ());
+	ASSERT_EQ (send->hash ().to_string (), frontiers_response->frontiers ()->Get (0)->hash ()->str ());
+
+	ysuapi::AccountsBalancesT balances;
+	balances.accounts.push_back (key.pub.to_account ());
+	auto balances_response (ysuapi::GetEnvelope (flatbuffers_query (handler, balances)->GetBufferPointer ())->message_as_AccountsBalancesResponse ());
+	ASSERT_NE (nullptr, balances_response);
+	ASSERT_EQ ("0", balances_response->balances ()->Get (0)->balance ()->str ());
+	ASSERT_EQ ("100", balances_response->balances ()->Get (0)->pending ()->str ());
+
+	// Counts are limited by the node
+	node->config.ipc_config.flatbuffers.max_count = 1;
+	history.head.clear ();
+	history.count = 100;
+	auto history_response3 (ysuapi::GetEnvelope (flatbuffers_query (handler, history)->GetBufferPointer ())->message_as_AccountHistoryResponse ());
+	ASSERT_NE (nullptr, history_response3);
+	ASSERT_EQ (1, history_response3->history ()->size ());
+	ASSERT_EQ (genesis.hash ().to_string (), history_response3->next ()->str ());
+
+	// Unopened accounts produce an error response
+	account_info.account = key.pub.to_account ();
+	auto error (ysuapi::GetEnvelope (flatbuffers_query (handler, account_info)->GetBufferPointer ())->message_as_Error ());
+	ASSERT_NE (nullptr, error);
+	ipc.stop ();
+}
+
+TEST (ipc, shared_memory_ring)
+{
+	ysu::ipc::ring_writer writer ("ysu_dev_ring_test", 4096);
+	ysu::ipc::ring_reader reader ("ysu_dev_ring_test");
+	ASSERT_FALSE (reader.get_error ());
+	std::vector<uint8_t> message;
+	ASSERT_FALSE (reader.poll (message));
+	std::vector<uint8_t> payload (100, 0x42);
+	ASSERT_FALSE (writer.write (payload.data (), payload.size ()));
+	ASSERT_TRUE (reader.poll (message));
+	ASSERT_EQ (payload, message);
+	ASSERT_EQ (1, reader.sequence ());
+	ASSERT_FALSE (reader.poll (message));
+
+	// Wrap around several times while the reader keeps up
+	for (auto i (0); i < 200; ++i)
+	{
+		payload[0] = static_cast<uint8_t> (i);
+		ASSERT_FALSE (writer.write (payload.data (), payload.size ()));
+		ASSERT_TRUE (reader.poll (message));
+		ASSERT_EQ (payload, message);
+	}
+	ASSERT_EQ (201, reader.sequence ());
+	ASSERT_EQ (0, reader.overruns ());
+
+	// A reader falling behind by more than the capacity is overrun and skips ahead
+	for (auto i (0); i < 100; ++i)
+	{
+		ASSERT_FALSE (writer.write (payload.data (), payload.size ()));
+	}
+	ASSERT_EQ (1, writer.last_overwritten_readers ());
+	ASSERT_FALSE (reader.poll (message));
+	ASSERT_EQ (1, reader.overruns ());
+	ASSERT_FALSE (writer.write (payload.data (), payload.size ()));
+	ASSERT_TRUE (reader.poll (message));
+	ASSERT_EQ (302, reader.sequence ());
+	ASSERT_EQ (100, reader.lost ());
+
+	// Messages must fit in half the ring
+	std::vector<uint8_t> large (writer.capacity () / 2);
+	ASSERT_TRUE (writer.write (large.data (), large.size ()));
+}
+
+TEST (ipc, shared_memory_confirmations)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.ipc_config.shared_memory.enabled = true;
+	node_config.ipc_config.shared_memory.confirmation_ring_name = "ysu_dev_confirmations_test";
+	auto node (system.add_node (node_config));
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc (*node, node_rpc_config);
+	ASSERT_NE (nullptr, ipc.get_broker ().get_confirmation_ring ());
+	ysu::ipc::ring_reader reader (node_config.ipc_config.shared_memory.confirmation_ring_name);
+	ASSERT_FALSE (reader.get_error ());
+
+	ysu::keypair key;
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	auto send (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key.pub, 100));
+	ASSERT_NE (nullptr, send);
+	std::vector<uint8_t> message;
+	ASSERT_TIMELY (10s, reader.poll (message));
+	flatbuffers::Verifier verifier (message.data (), message.size ());
+	ASSERT_TRUE (ysuapi::VerifyEnvelopeBuffer (verifier));
+	auto confirmation (ysuapi::GetEnvelope (message.data ())->message_as_EventConfirmation ());
+	ASSERT_NE (nullptr, confirmation);
+	ASSERT_EQ (send->hash ().to_string (), confirmation->hash ()->str ());
+	ASSERT_EQ (1, node->stats.count (ysu::stat::type::ipc, ysu::stat::detail::shared_memory_publish, ysu::stat::dir::out));
+	ipc.stop ();
+}
@@ -797,7 +797,7 @@ TEST (votes, add_one)
 	auto existing1 (votes1.find (ysu::dev_genesis_key.pub));
 	ASSERT_NE (votes1.end (), existing1);
 	ASSERT_EQ (send1->hash (), existing1->second.hash);
-	ysu::lock_guard<std::mutex> guard (node1.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node1.active.mutex);
 	auto winner (*election1.election->tally ().begin ());
 	ASSERT_EQ (*send1, *winner.second);
 	ASSERT_EQ (ysu::genesis_amount - 100, winner.first);
@@ -858,7 +858,7 @@ TEST (votes, add_existing)
 	node1.work_generate_blocking (*send2);
 	auto vote2 (std::make_shared<ysu::vote> (ysu::dev_genesis_key.pub, ysu::dev_genesis_key.prv, 2, send2));
 	// Pretend we've waited the timeout
-	ysu::unique_lock<std::mutex> lock (node1.active.mutex);
+	ysu::unique_lock<ysu::mutex> lock (node1.active.mutex);
 	election1.election->last_votes[ysu::dev_genesis_key.pub].time = std::chrono::steady_clock::now () - std::chrono::seconds (20);
 	lock.unlock ();
 	ASSERT_EQ (ysu::vote_code::vote, node1.active.vote (vote2));
@@ -898,7 +898,7 @@ TEST (votes, add_old)
 	node1.work_generate_blocking (*send2);
 	auto vote2 (std::make_shared<ysu::vote> (ysu::dev_genesis_key.pub, ysu::dev_genesis_key.prv, 1, send2));
 	{
-		ysu::lock_guard<std::mutex> lock (node1.active.mutex);
+		ysu::lock_guard<ysu::mutex> lock (node1.active.mutex);
 		election1.election->last_votes[ysu::dev_genesis_key.pub].time = std::chrono::steady_clock::now () - std::chrono::seconds (20);
 	}
 	node1.vote_processor.vote_blocking (vote2, channel);
@@ -994,6 +994,91 @@ TEST (ledger, successor)
 	ASSERT_EQ (nullptr, node1.ledger.successor (transaction, ysu::qualified_root (0)));
 }
 
+TEST (ledger, account_blocks)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	ysu::stat stats;
+	ysu::ledger ledger (*store, stats);
+	ysu::genesis genesis;
+	auto transaction (store->tx_begin_write ());
+	store->initialize (transaction, genesis, ledger.cache);
+	ysu::work_pool pool (std::numeric_limits<unsigned>::max ());
+	std::vector<ysu::block_hash> hashes{ genesis.hash () };
+	for (auto i (0); i < 4; ++i)
+	{
+		ysu::send_block send (hashes.back (), ysu::genesis_account, ysu::genesis_amount - (i + 1) * 100, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (hashes.back ()));
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send).code);
+		hashes.push_back (send.hash ());
+	}
+	for (size_t i (0); i < hashes.size (); ++i)
+	{
+		ASSERT_EQ (hashes[i], store->account_height_get (transaction, ysu::genesis_account, i + 1));
+	}
+	ASSERT_TRUE (store->account_height_get (transaction, ysu::genesis_account, hashes.size () + 1).is_zero ());
+	auto descending (ledger.account_blocks (transaction, ysu::genesis_account, 4, 3, false));
+	ASSERT_EQ (3, descending.size ());
+	ASSERT_EQ (hashes[3], descending[0]->hash ());
+	ASSERT_EQ (hashes[2], descending[1]->hash ());
+	ASSERT_EQ (hashes[1], descending[2]->hash ());
+	// Ranges are cut at the ends of the chain
+	auto ascending (ledger.account_blocks (transaction, ysu::genesis_account, 3, 10, true));
+	ASSERT_EQ (3, ascending.size ());
+	ASSERT_EQ (hashes[2], ascending[0]->hash ());
+	ASSERT_EQ (hashes[4], ascending[2]->hash ());
+	ASSERT_EQ (2, ledger.account_blocks (transaction, ysu::genesis_account, 2, 10, false).size ());
+	ASSERT_TRUE (ledger.account_blocks (transaction, ysu::genesis_account, 6, 10, false).empty ());
+	ASSERT_TRUE (ledger.account_blocks (transaction, ysu::keypair ().pub, 1, 10, true).empty ());
+	// Rolling back removes the index entries of the blocks
+	ASSERT_FALSE (ledger.rollback (transaction, hashes[3]));
+	ASSERT_TRUE (store->account_height_get (transaction, ysu::genesis_account, 4).is_zero ());
+	ASSERT_TRUE (store->account_height_get (transaction, ysu::genesis_account, 5).is_zero ());
+	ASSERT_EQ (3, ledger.account_blocks (transaction, ysu::genesis_account, 1, 10, true).size ());
+}
+
+TEST (ledger, balance_index)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	ysu::stat stats;
+	ysu::ledger ledger (*store, stats);
+	ysu::genesis genesis;
+	auto transaction (store->tx_begin_write ());
+	store->initialize (transaction, genesis, ledger.cache);
+	ysu::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ysu::keypair key1;
+	ysu::keypair key2;
+	ysu::state_block send1 (ysu::genesis_account, genesis.hash (), ysu::genesis_account, ysu::genesis_amount - 100, key1.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send1).code);
+	// Enabling the index builds it from the existing accounts
+	ledger.balance_index_set (transaction, true);
+	ASSERT_TRUE (ledger.balance_index);
+	ysu::state_block open1 (key1.pub, 0, key1.pub, 100, send1.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, open1).code);
+	ysu::state_block send2 (ysu::genesis_account, send1.hash (), ysu::genesis_account, ysu::genesis_amount - 150, key2.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (send1.hash ()));
+	ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send2).code);
+	ysu::state_block open2 (key2.pub, 0, key2.pub, 50, send2.hash (), key2.prv, key2.pub, *pool.generate (key2.pub));
+	ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, open2).code);
+	auto ordered = [&store, &transaction]() {
+		std::vector<std::pair<ysu::account, ysu::uint128_t>> result;
+		for (auto i (store->account_balance_begin (transaction)), n (store->account_balance_end ()); i != n; ++i)
+		{
+			result.emplace_back (i->first.account (), i->first.balance ().number ());
+		}
+		return result;
+	};
+	std::vector<std::pair<ysu::account, ysu::uint128_t>> expected{ { ysu::genesis_account, ysu::genesis_amount - 150 }, { key1.pub, 100 }, { key2.pub, 50 } };
+	ASSERT_EQ (expected, ordered ());
+	// Rolling back moves and removes entries
+	ASSERT_FALSE (ledger.rollback (transaction, send2.hash ()));
+	expected = { { ysu::genesis_account, ysu::genesis_amount - 100 }, { key1.pub, 100 } };
+	ASSERT_EQ (expected, ordered ());
+	ledger.balance_index_set (transaction, false);
+	ASSERT_TRUE (store->account_balance_begin (transaction) == store->account_balance_end ());
+}
+
 TEST (ledger, fail_change_old)
 {
 	ysu::logger_mt logger;
@@ -3273,6 +3358,35 @@ TEST (ledger, block_confirmed)
 	ASSERT_TRUE (ledger.block_confirmed (transaction, send1->hash ()));
 }
 
+TEST (ledger, unchecked_count_cache)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	ysu::stat stats;
+	ysu::ledger ledger (*store, stats);
+	ysu::keypair key;
+	auto block1 (std::make_shared<ysu::send_block> (1, key.pub, 2, key.prv, key.pub, 0));
+	auto block2 (std::make_shared<ysu::send_block> (2, key.pub, 3, key.prv, key.pub, 0));
+	auto transaction (store->tx_begin_write ());
+	ASSERT_TRUE (ledger.unchecked_put (transaction, block1->previous (), block1));
+	// Updating an existing entry doesn't change the count
+	ASSERT_FALSE (ledger.unchecked_put (transaction, block1->previous (), block1));
+	ASSERT_TRUE (ledger.unchecked_put (transaction, ysu::unchecked_key (block2->previous (), block2->hash ()), ysu::unchecked_info (block2, key.pub, 10)));
+	ASSERT_EQ (2, ledger.cache.unchecked_count);
+	ASSERT_TRUE (ledger.unchecked_del (transaction, ysu::unchecked_key (block1->previous (), block1->hash ())));
+	ASSERT_EQ (1, ledger.cache.unchecked_count);
+	// Deleting a missing key doesn't change the count
+	ASSERT_FALSE (ledger.unchecked_del (transaction, ysu::unchecked_key (block1->previous (), block1->hash ())));
+	ASSERT_EQ (1, ledger.cache.unchecked_count);
+	ASSERT_EQ (1, ledger.unchecked_del_before (transaction, 20, 10).size ());
+	ASSERT_EQ (0, ledger.cache.unchecked_count);
+	ASSERT_TRUE (ledger.unchecked_put (transaction, block1->previous (), block1));
+	ledger.unchecked_clear (transaction);
+	ASSERT_EQ (0, ledger.cache.unchecked_count);
+	ASSERT_EQ (store->unchecked_count (transaction), ledger.cache.unchecked_count);
+}
+
 TEST (ledger, cache)
 {
 	ysu::logger_mt logger;
@@ -3598,4 +3712,4 @@ TEST (ledger, hash_root_random)
 		done = (root_hash.first == send2.hash ()) && (root_hash.second == send2.root ().as_block_hash ());
 		ASSERT_LE (iteration, 1000);
 	}
-}
\ No newline at end of file
+}
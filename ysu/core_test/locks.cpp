@@ -4,7 +4,9 @@
 #include <gtest/gtest.h>
 
 #include <future>
+#include <numeric>
 #include <regex>
+#include <thread>
 
 #if YSU_TIMED_LOCKS > 0
 namespace
@@ -190,3 +192,85 @@ TEST (locks, defer_lock)
 	ASSERT_FALSE (lock.owns_lock ());
 }
 #endif
+
+TEST (locks, contention_profile)
+{
+	ysu::mutex mutex{ "contention_profile" };
+	auto profile = [] {
+		std::vector<ysu::lock_profile> result;
+		for (auto const & profile : ysu::lock_profiler::collect ())
+		{
+			if (profile.mutex_name == "contention_profile")
+			{
+				result.push_back (profile);
+			}
+		}
+		return result;
+	};
+	ysu::lock_profiler::enable (true);
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+	}
+	std::promise<void> promise;
+	std::thread thread ([&mutex, &promise] {
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		promise.set_value ();
+		std::this_thread::sleep_for (std::chrono::milliseconds (50));
+	});
+	promise.get_future ().wait ();
+	{
+		ysu::unique_lock<ysu::mutex> lock (mutex);
+	}
+	thread.join ();
+	ysu::lock_profiler::enable (false);
+	{
+		// Not recorded
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+	}
+
+	auto profiles (profile ());
+#if YSU_TIMED_LOCKS == 0
+	// One entry per call site
+	ASSERT_EQ (3, profiles.size ());
+	for (auto const & profile : profiles)
+	{
+		ASSERT_NE (std::string::npos, profile.file.find ("locks.cpp"));
+		ASSERT_EQ (1, profile.stats.acquisitions);
+	}
+#endif
+	ysu::lock_site_stats total;
+	for (auto const & profile : profiles)
+	{
+		total.merge (profile.stats);
+	}
+	ASSERT_EQ (3, total.acquisitions);
+	ASSERT_EQ (1, total.contended);
+	ASSERT_GE (total.wait_max, std::chrono::milliseconds (10));
+	ASSERT_GE (total.hold_max, std::chrono::milliseconds (40));
+	ASSERT_EQ (3, std::accumulate (total.hold.buckets.begin (), total.hold.buckets.end (), uint64_t{ 0 }));
+
+	ysu::lock_profiler::clear ();
+	ASSERT_TRUE (profile ().empty ());
+}
+
+// Collecting doesn't wait for holders of a mutex, which may themselves be constructing another mutex
+TEST (locks, contention_profile_collect_while_held)
+{
+	ysu::mutex mutex{ "contention_profile_held" };
+	ysu::lock_profiler::enable (true);
+	std::promise<void> locked;
+	std::promise<void> collected;
+	std::thread thread ([&mutex, &locked, &collected] {
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		locked.set_value ();
+		collected.get_future ().wait ();
+		ysu::mutex other{ "contention_profile_other" };
+	});
+	locked.get_future ().wait ();
+	auto profiles (std::async (std::launch::async, [] { return ysu::lock_profiler::collect (); }));
+	ASSERT_EQ (std::future_status::ready, profiles.wait_for (std::chrono::seconds (5)));
+	collected.set_value ();
+	thread.join ();
+	ysu::lock_profiler::enable (false);
+	ysu::lock_profiler::clear ();
+}
@@ -2,6 +2,7 @@
 #include <ysu/node/election.hpp>
 #include <ysu/node/testing.hpp>
 #include <ysu/node/transport/udp.hpp>
+#include <ysu/secure/cold_store.hpp>
 #include <ysu/test_common/testutil.hpp>
 
 #include <gtest/gtest.h>
@@ -432,7 +433,7 @@ TEST (node, search_pending_confirmed)
 	system.wallet (0)->insert_adhoc (key2.prv);
 	ASSERT_FALSE (system.wallet (0)->search_pending ());
 	{
-		ysu::lock_guard<std::mutex> guard (node->active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node->active.mutex);
 		auto existing1 (node->active.blocks.find (send1->hash ()));
 		ASSERT_EQ (node->active.blocks.end (), existing1);
 		auto existing2 (node->active.blocks.find (send2->hash ()));
@@ -1031,7 +1032,7 @@ TEST (node, fork_publish)
 		auto existing1 (votes1.find (ysu::dev_genesis_key.pub));
 		ASSERT_NE (votes1.end (), existing1);
 		ASSERT_EQ (send1->hash (), existing1->second.hash);
-		ysu::lock_guard<std::mutex> guard (node1.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node1.active.mutex);
 		auto winner (*election->tally ().begin ());
 		ASSERT_EQ (*send1, *winner.second);
 		ASSERT_EQ (ysu::genesis_amount - 100, winner.first);
@@ -1119,7 +1120,7 @@ TEST (node, fork_keep)
 	auto transaction0 (node1.store.tx_begin_read ());
 	auto transaction1 (node2.store.tx_begin_read ());
 	// The vote should be in agreement with what we already have.
-	ysu::lock_guard<std::mutex> guard (node2.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node2.active.mutex);
 	auto winner (*election1->tally ().begin ());
 	ASSERT_EQ (*send1, *winner.second);
 	ASSERT_EQ (ysu::genesis_amount - 100, winner.first);
@@ -1172,7 +1173,7 @@ TEST (node, fork_flip)
 	ASSERT_NE (nullptr, node1.block (publish1.block->hash ()));
 	ASSERT_NE (nullptr, node2.block (publish2.block->hash ()));
 	ASSERT_TIMELY (10s, node2.ledger.block_exists (publish1.block->hash ()));
-	ysu::unique_lock<std::mutex> lock (node2.active.mutex);
+	ysu::unique_lock<ysu::mutex> lock (node2.active.mutex);
 	auto winner (*election1->tally ().begin ());
 	ASSERT_EQ (*publish1.block, *winner.second);
 	ASSERT_EQ (ysu::genesis_amount - 100, winner.first);
@@ -1248,7 +1249,7 @@ TEST (node, fork_multi_flip)
 		ASSERT_TRUE (node2.ledger.block_exists (publish2.block->hash ()));
 		ASSERT_TRUE (node2.ledger.block_exists (publish3.block->hash ()));
 		ASSERT_TIMELY (10s, node2.ledger.block_exists (publish1.block->hash ()));
-		ysu::unique_lock<std::mutex> lock (node2.active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node2.active.mutex);
 		auto winner (*election1->tally ().begin ());
 		ASSERT_EQ (*publish1.block, *winner.second);
 		ASSERT_EQ (ysu::genesis_amount - 100, winner.first);
@@ -1439,7 +1440,7 @@ TEST (node, fork_open_flip)
 	node2.block_processor.flush ();
 	auto transaction1 (node1.store.tx_begin_read ());
 	auto transaction2 (node2.store.tx_begin_read ());
-	ysu::lock_guard<std::mutex> guard (node1.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node1.active.mutex);
 	auto winner (*election1->tally ().begin ());
 	ASSERT_EQ (*open1, *winner.second);
 	ASSERT_EQ (ysu::genesis_amount - 1, winner.first);
@@ -1990,7 +1991,7 @@ TEST (node, bootstrap_confirm_frontiers)
 		ASSERT_NO_ERROR (system1.poll ());
 	}
 	{
-		ysu::lock_guard<std::mutex> guard (node1->active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node1->active.mutex);
 		auto existing1 (node1->active.blocks.find (send0.hash ()));
 		ASSERT_NE (node1->active.blocks.end (), existing1);
 	}
@@ -3000,7 +3001,7 @@ TEST (node, epoch_conflict_confirm)
 	ysu::blocks_confirm (*node0, { change, epoch_open });
 	ASSERT_EQ (2, node0->active.size ());
 	{
-		ysu::lock_guard<std::mutex> lock (node0->active.mutex);
+		ysu::lock_guard<ysu::mutex> lock (node0->active.mutex);
 		ASSERT_TRUE (node0->active.blocks.find (change->hash ()) != node0->active.blocks.end ());
 		ASSERT_TRUE (node0->active.blocks.find (epoch_open->hash ()) != node0->active.blocks.end ());
 	}
@@ -3167,7 +3168,7 @@ TEST (node, block_processor_signatures)
 	// Invalid signature to unchecked
 	{
 		auto transaction (node1.store.tx_begin_write ());
-		node1.store.unchecked_put (transaction, send5->previous (), send5);
+		ASSERT_TRUE (node1.ledger.unchecked_put (transaction, send5->previous (), send5));
 	}
 	auto receive1 = builder.make_block ()
 	                .account (key1.pub)
@@ -3529,6 +3530,7 @@ TEST (node, unchecked_cleanup)
 		auto unchecked_count (node.store.unchecked_count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node.ledger.cache.unchecked_count);
 	}
 	std::this_thread::sleep_for (std::chrono::seconds (1));
 	node.unchecked_cleanup ();
@@ -3547,6 +3549,7 @@ TEST (node, unchecked_cleanup)
 		auto unchecked_count (node.store.unchecked_count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 		ASSERT_EQ (unchecked_count, node.store.unchecked_count (transaction));
+		ASSERT_EQ (unchecked_count, node.ledger.cache.unchecked_count);
 	}
 }
 
@@ -3809,7 +3812,7 @@ TEST (active_difficulty, recalculate_work)
 	ASSERT_TIMELY (2s, !node1.active.empty ());
 	auto sum (std::accumulate (node1.active.multipliers_cb.begin (), node1.active.multipliers_cb.end (), double(0)));
 	ASSERT_EQ (node1.active.active_difficulty (), ysu::difficulty::from_multiplier (sum / node1.active.multipliers_cb.size (), node1.network_params.network.publish_thresholds.epoch_1));
-	ysu::unique_lock<std::mutex> lock (node1.active.mutex);
+	ysu::unique_lock<ysu::mutex> lock (node1.active.mutex);
 	// Fake history records to force work recalculation
 	for (auto i (0); i < node1.active.multipliers_cb.size (); i++)
 	{
@@ -3894,7 +3897,7 @@ TEST (node, rollback_vote_self)
 		auto write_guard = node.write_database_queue.wait (ysu::writer::testing);
 		{
 			ASSERT_EQ (1, election->votes ().size ());
-			ysu::unique_lock<std::mutex> lock (node.active.mutex);
+			ysu::unique_lock<ysu::mutex> lock (node.active.mutex);
 			// Vote with key to switch the winner
 			election->vote (key.pub, 0, fork->hash ());
 			lock.unlock ();
@@ -4095,7 +4098,7 @@ TEST (node, dependency_graph)
 	ASSERT_NO_ERROR (system.poll_until_true (15s, [&] {
 		// Not many blocks should be active simultaneously
 		EXPECT_LT (node.active.size (), 6);
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 
 		// Ensure that active blocks have their ancestors confirmed
 		auto error = std::any_of (dependency_graph.cbegin (), dependency_graph.cend (), [&](auto entry) {
@@ -4373,7 +4376,7 @@ TEST (node, deferred_dependent_elections)
 
 	// Frontier confirmation also starts elections
 	ASSERT_NO_ERROR (system.poll_until_true (5s, [&node, &send2] {
-		ysu::unique_lock<std::mutex> lock (node.active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node.active.mutex);
 		node.active.frontiers_confirmation (lock);
 		lock.unlock ();
 		return node.active.election (send2->qualified_root ()) != nullptr;
@@ -4442,6 +4445,56 @@ TEST (node, default_difficulty)
 	ASSERT_EQ (thresholds.epoch_2_receive, node.default_receive_difficulty (ysu::work_version::work_1));
 }
 
+TEST (node, cold_storage)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.frontiers_confirmation = ysu::frontiers_confirmation_mode::disabled;
+	node_config.cold_storage_depth = 1;
+	auto & node (*system.add_node (node_config));
+	ASSERT_NE (nullptr, node.cold_storage);
+	ysu::genesis genesis;
+	auto send1 = ysu::state_block_builder ()
+	             .account (ysu::dev_genesis_key.pub)
+	             .previous (genesis.hash ())
+	             .representative (ysu::dev_genesis_key.pub)
+	             .balance (ysu::genesis_amount - ysu::Gxrb_ratio)
+	             .link (ysu::dev_genesis_key.pub)
+	             .sign (ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub)
+	             .work (*node.work_generate_blocking (genesis.hash ()))
+	             .build_shared ();
+	auto send2 = ysu::state_block_builder ()
+	             .account (ysu::dev_genesis_key.pub)
+	             .previous (send1->hash ())
+	             .representative (ysu::dev_genesis_key.pub)
+	             .balance (ysu::genesis_amount - 2 * ysu::Gxrb_ratio)
+	             .link (ysu::dev_genesis_key.pub)
+	             .sign (ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub)
+	             .work (*node.work_generate_blocking (send1->hash ()))
+	             .build_shared ();
+	ASSERT_EQ (ysu::process_result::progress, node.process (*send1).code);
+	ASSERT_EQ (ysu::process_result::progress, node.process (*send2).code);
+	{
+		auto transaction (node.store.tx_begin_write ());
+		node.store.confirmation_height_put (transaction, ysu::dev_genesis_key.pub, { 3, send2->hash () });
+	}
+	// Only blocks more than cold_storage_depth below the confirmed frontier are moved
+	node.cold_storage->trigger ();
+	ASSERT_TIMELY (5s, node.cold_storage->status ().blocks_moved == 2);
+	auto transaction (node.store.tx_begin_read ());
+	ASSERT_FALSE (node.store.block_exists_hot (transaction, genesis.hash ()));
+	ASSERT_FALSE (node.store.block_exists_hot (transaction, send1->hash ()));
+	ASSERT_TRUE (node.store.block_exists_hot (transaction, send2->hash ()));
+	ASSERT_EQ (*send1, *node.store.block_get (transaction, send1->hash ()));
+	ASSERT_EQ (send2->hash (), node.store.block_successor (transaction, send1->hash ()));
+	ASSERT_EQ (3, node.store.block_count (transaction));
+	// Later passes find nothing more to move
+	node.cold_storage->trigger ();
+	ASSERT_TIMELY (5s, node.cold_storage->status ().passes >= 3);
+	ASSERT_EQ (2, node.cold_storage->status ().blocks_moved);
+	ASSERT_EQ (1, node.store.get_cold_store ()->segment_count ());
+}
+
 TEST (rep_crawler, recently_confirmed)
 {
 	ysu::system system (1);
@@ -4449,7 +4502,7 @@ TEST (rep_crawler, recently_confirmed)
 	ASSERT_EQ (1, node1.ledger.cache.block_count);
 	auto const block = ysu::genesis ().open;
 	{
-		ysu::lock_guard<std::mutex> guard (node1.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node1.active.mutex);
 		node1.active.add_recently_confirmed (block->qualified_root (), block->hash ());
 	}
 	auto & node2 (*system.add_node ());
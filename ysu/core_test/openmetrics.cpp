@@ -0,0 +1,82 @@
+#include <ysu/lib/stats.hpp>
+#include <ysu/node/testing.hpp>
+#include <ysu/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/asio/connect.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace
+{
+boost::beast::http::response<boost::beast::http::string_body> get (uint16_t port_a, std::string const & target_a)
+{
+	boost::asio::io_context io_ctx;
+	boost::asio::ip::tcp::socket socket (io_ctx);
+	socket.connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), port_a));
+	boost::beast::http::request<boost::beast::http::empty_body> request (boost::beast::http::verb::get, target_a, 11);
+	boost::beast::http::write (socket, request);
+	boost::beast::flat_buffer buffer;
+	boost::beast::http::response<boost::beast::http::string_body> response;
+	boost::beast::http::read (socket, buffer, response);
+	return response;
+}
+}
+
+TEST (openmetrics, stat_counters)
+{
+	ysu::stat_config config;
+	config.sampling_enabled = true;
+	ysu::stat stats (config);
+	stats.configure (ysu::stat::type::ledger, ysu::stat::detail::send, ysu::stat::dir::in, 1, 2);
+	stats.add (ysu::stat::type::ledger, ysu::stat::detail::send, ysu::stat::dir::in, 2);
+	std::this_thread::sleep_for (std::chrono::milliseconds (5));
+	stats.add (ysu::stat::type::ledger, ysu::stat::detail::send, ysu::stat::dir::in, 1);
+	std::ostringstream stream;
+	// Series written before are not repeated
+	std::unordered_set<std::string> series{ "ysu_stat_total{type=\"ledger\",detail=\"all\",dir=\"in\"}" };
+	stats.write_openmetrics (stream, series);
+	auto text (stream.str ());
+	ASSERT_EQ (0, text.find ("# TYPE ysu_stat counter\n"));
+	ASSERT_NE (std::string::npos, text.find ("ysu_stat_total{type=\"ledger\",detail=\"send\",dir=\"in\"} 3\n"));
+	ASSERT_EQ (std::string::npos, text.find ("ysu_stat_total{type=\"ledger\",detail=\"all\",dir=\"in\"}"));
+	ASSERT_EQ (1, series.count ("ysu_stat_total{type=\"ledger\",detail=\"send\",dir=\"in\"}"));
+	// The sample interval ends with the second update
+	ASSERT_NE (std::string::npos, text.find ("ysu_stat_sample{type=\"ledger\",detail=\"send\",dir=\"in\"} "));
+}
+
+TEST (openmetrics, endpoint)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.openmetrics_config.enabled = true;
+	node_config.openmetrics_config.port = ysu::get_available_port ();
+	node_config.openmetrics_config.containers = true;
+	auto node (system.add_node (node_config));
+	ASSERT_NE (nullptr, node->openmetrics);
+	node->stats.inc (ysu::stat::type::ledger, ysu::stat::detail::send);
+	auto response (get (node_config.openmetrics_config.port, "/metrics"));
+	ASSERT_EQ (boost::beast::http::status::ok, response.result ());
+	ASSERT_EQ ("application/openmetrics-text; version=1.0.0; charset=utf-8", response[boost::beast::http::field::content_type]);
+	auto const & text (response.body ());
+	ASSERT_NE (std::string::npos, text.find ("ysu_stat_total{type=\"ledger\",detail=\"send\",dir=\"in\"} 1\n"));
+	ASSERT_NE (std::string::npos, text.find ("ysu_ledger_blocks 1\n"));
+	ASSERT_NE (std::string::npos, text.find ("ysu_container_count{container=\"node/active/roots\"} "));
+	ASSERT_EQ (text.size () - 6, text.rfind ("# EOF\n"));
+	// Each series appears once
+	std::istringstream lines (text);
+	std::unordered_set<std::string> series;
+	for (std::string line; std::getline (lines, line);)
+	{
+		if (line[0] != '#')
+		{
+			ASSERT_TRUE (series.insert (line.substr (0, line.rfind (' '))).second) << line;
+		}
+	}
+	ASSERT_EQ (boost::beast::http::status::not_found, get (node_config.openmetrics_config.port, "/").result ());
+}
@@ -0,0 +1,152 @@
+#include <ysu/crypto/blake2/blake2.h>
+#include <ysu/lib/stats.hpp>
+#include <ysu/lib/stream.hpp>
+#include <ysu/lib/work.hpp>
+#include <ysu/secure/ledger.hpp>
+#include <ysu/secure/snapshot.hpp>
+#include <ysu/secure/utility.hpp>
+#include <ysu/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <fstream>
+
+TEST (snapshot, export_import)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	ysu::stat stats;
+	ysu::ledger ledger (*store, stats);
+	ysu::genesis genesis;
+	ysu::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ysu::keypair key1;
+	ysu::send_block send1 (genesis.hash (), key1.pub, ysu::genesis_amount - 100, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ysu::state_block open (key1.pub, 0, key1.pub, 100, send1.hash (), key1.prv, key1.pub, *pool.generate (key1.pub));
+	ysu::send_block send2 (send1.hash (), key1.pub, ysu::genesis_amount - 150, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *pool.generate (send1.hash ()));
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, open).code);
+		ASSERT_EQ (ysu::process_result::progress, ledger.process (transaction, send2).code);
+	}
+	auto path (ysu::unique_path ());
+	// Small chunks so that tables span several of them
+	ASSERT_FALSE (ysu::snapshot_export (*store, path, 256));
+	ASSERT_TRUE (ysu::snapshot_export (*store, path));
+	auto hash (ysu::snapshot_hash (path));
+	ASSERT_FALSE (hash.is_zero ());
+
+	auto store2 = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store2->init_error ());
+	// Untrusted manifests are refused before anything is written
+	ysu::uint256_union other_hash (hash.number () + 1);
+	ASSERT_TRUE (ysu::snapshot_import (*store2, path, other_hash, 2));
+	ASSERT_FALSE (ysu::snapshot_import (*store2, path, hash, 2));
+	auto transaction1 (store->tx_begin_read ());
+	auto transaction2 (store2->tx_begin_read ());
+	ASSERT_EQ (4, store2->block_count (transaction2));
+	ASSERT_EQ (2, store2->account_count (transaction2));
+	for (auto i (store->accounts_begin (transaction1)), n (store->accounts_end ()); i != n; ++i)
+	{
+		ysu::account_info info;
+		ASSERT_FALSE (store2->account_get (transaction2, i->first, info));
+		ASSERT_EQ (i->second, info);
+		ysu::confirmation_height_info confirmation_height_info;
+		ASSERT_FALSE (store2->confirmation_height_get (transaction2, i->first, confirmation_height_info));
+		ASSERT_EQ (i->first == ysu::dev_genesis_key.pub ? 1 : 0, confirmation_height_info.height);
+	}
+	ASSERT_TRUE (store2->pending_exists (transaction2, ysu::pending_key (key1.pub, send2.hash ())));
+	ASSERT_FALSE (store2->pending_exists (transaction2, ysu::pending_key (key1.pub, send1.hash ())));
+	// Sidebands are restored as stored
+	auto block (store2->block_get (transaction2, send1.hash ()));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (send2.hash (), block->sideband ().successor);
+	ASSERT_EQ (2, block->sideband ().height);
+	// Frontiers are only rebuilt for legacy heads
+	ASSERT_EQ (ysu::dev_genesis_key.pub, store2->frontier_get (transaction2, send2.hash ()));
+	ASSERT_TRUE (store2->frontier_get (transaction2, open.hash ()).is_zero ());
+	// Only empty ledgers can be imported into
+	ASSERT_TRUE (ysu::snapshot_import (*store2, path, hash, 2));
+}
+
+TEST (snapshot, corrupt_chunk)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	ysu::stat stats;
+	ysu::ledger ledger (*store, stats);
+	ysu::genesis genesis;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+	}
+	auto path (ysu::unique_path ());
+	ASSERT_FALSE (ysu::snapshot_export (*store, path));
+	{
+		std::fstream chunk ((path / "000000.chunk").string (), std::ios::in | std::ios::out | std::ios::binary);
+		ASSERT_TRUE (chunk.is_open ());
+		chunk.seekp (40);
+		chunk.put ('x');
+	}
+	auto store2 = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store2->init_error ());
+	auto error (ysu::snapshot_import (*store2, path, ysu::snapshot_hash (path), 1));
+	ASSERT_TRUE (error);
+	ASSERT_NE (std::string::npos, error.get_message ().find ("does not match the hash"));
+	ASSERT_EQ (0, store2->block_count (store2->tx_begin_read ()));
+}
+
+TEST (snapshot, invalid_records)
+{
+	ysu::logger_mt logger;
+	auto store = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	ysu::stat stats;
+	ysu::ledger ledger (*store, stats);
+	ysu::genesis genesis;
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+	}
+	auto path (ysu::unique_path ());
+	ASSERT_FALSE (ysu::snapshot_export (*store, path));
+	// Shorten the key of the genesis account record, keeping the chunk well formed and its hash in the manifest valid
+	auto chunk_path ((path / "000000.chunk").string ());
+	std::vector<uint8_t> bytes;
+	{
+		std::ifstream chunk (chunk_path, std::ios::binary);
+		bytes.assign (std::istreambuf_iterator<char> (chunk), std::istreambuf_iterator<char> ());
+	}
+	ASSERT_GT (bytes.size (), sizeof (uint32_t) + sizeof (ysu::account));
+	std::vector<uint8_t> modified;
+	{
+		ysu::vectorstream stream (modified);
+		ysu::write (stream, uint32_t (sizeof (ysu::account) - 1));
+		stream.sputn (bytes.data () + sizeof (uint32_t) + 1, bytes.size () - sizeof (uint32_t) - 1);
+	}
+	{
+		std::ofstream chunk (chunk_path, std::ios::binary | std::ios::trunc);
+		chunk.write (reinterpret_cast<char const *> (modified.data ()), modified.size ());
+	}
+	ysu::uint256_union chunk_hash;
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (chunk_hash.bytes));
+	blake2b_update (&hash, modified.data (), modified.size ());
+	blake2b_final (&hash, chunk_hash.bytes.data (), sizeof (chunk_hash.bytes));
+	boost::property_tree::ptree manifest;
+	boost::property_tree::read_json ((path / ysu::snapshot_manifest_name).string (), manifest);
+	manifest.get_child ("chunks").begin ()->second.put ("hash", chunk_hash.to_string ());
+	boost::property_tree::write_json ((path / ysu::snapshot_manifest_name).string (), manifest);
+
+	auto store2 = ysu::make_store (logger, ysu::unique_path ());
+	ASSERT_TRUE (!store2->init_error ());
+	auto error (ysu::snapshot_import (*store2, path, ysu::snapshot_hash (path), 1));
+	ASSERT_TRUE (error);
+	ASSERT_NE (std::string::npos, error.get_message ().find ("holds invalid records"));
+	ASSERT_EQ (0, store2->account_count (store2->tx_begin_read ()));
+}
@@ -114,6 +114,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	std::stringstream ss;
 	ss << R"toml(
 	[node]
+	[node.confirmation_log]
+	[node.diagnostics.block_tracing]
 	[node.diagnostics.txn_tracking]
 	[node.httpcallback]
 	[node.ipc.local]
@@ -121,6 +123,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	[node.logging]
 	[node.statistics.log]
 	[node.statistics.sampling]
+	[node.openmetrics]
 	[node.websocket]
 	[node.lmdb]
 	[node.rocksdb]
@@ -219,10 +222,20 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_EQ (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_EQ (conf.node.websocket_config.port, defaults.node.websocket_config.port);
+	ASSERT_EQ (conf.node.openmetrics_config.enabled, defaults.node.openmetrics_config.enabled);
+	ASSERT_EQ (conf.node.openmetrics_config.address, defaults.node.openmetrics_config.address);
+	ASSERT_EQ (conf.node.openmetrics_config.port, defaults.node.openmetrics_config.port);
+	ASSERT_EQ (conf.node.openmetrics_config.containers, defaults.node.openmetrics_config.containers);
 
 	ASSERT_EQ (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_EQ (conf.node.callback_port, defaults.node.callback_port);
 	ASSERT_EQ (conf.node.callback_target, defaults.node.callback_target);
+	ASSERT_EQ (conf.node.callback_max_connections, defaults.node.callback_max_connections);
+	ASSERT_EQ (conf.node.callback_max_queued, defaults.node.callback_max_queued);
+	ASSERT_EQ (conf.node.callback_batch_size, defaults.node.callback_batch_size);
+	ASSERT_EQ (conf.node.callback_max_retries, defaults.node.callback_max_retries);
+	ASSERT_EQ (conf.node.callback_retry_backoff, defaults.node.callback_retry_backoff);
+	ASSERT_EQ (conf.node.callback_timeout, defaults.node.callback_timeout);
 
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.allow_unsafe, defaults.node.ipc_config.transport_domain.allow_unsafe);
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.enabled, defaults.node.ipc_config.transport_domain.enabled);
@@ -235,7 +248,19 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
-
+	ASSERT_EQ (conf.node.ipc_config.flatbuffers.max_count, defaults.node.ipc_config.flatbuffers.max_count);
+	ASSERT_EQ (conf.node.ipc_config.shared_memory.enabled, defaults.node.ipc_config.shared_memory.enabled);
+	ASSERT_EQ (conf.node.ipc_config.shared_memory.confirmation_ring_name, defaults.node.ipc_config.shared_memory.confirmation_ring_name);
+	ASSERT_EQ (conf.node.ipc_config.shared_memory.capacity, defaults.node.ipc_config.shared_memory.capacity);
+
+	ASSERT_EQ (conf.node.confirmation_log_config.enabled, defaults.node.confirmation_log_config.enabled);
+	ASSERT_EQ (conf.node.confirmation_log_config.segment_size, defaults.node.confirmation_log_config.segment_size);
+	ASSERT_EQ (conf.node.confirmation_log_config.max_size, defaults.node.confirmation_log_config.max_size);
+	ASSERT_EQ (conf.node.confirmation_log_config.max_age, defaults.node.confirmation_log_config.max_age);
+
+	ASSERT_EQ (conf.node.diagnostics_config.block_tracing.enable, defaults.node.diagnostics_config.block_tracing.enable);
+	ASSERT_EQ (conf.node.diagnostics_config.block_tracing.sample_rate, defaults.node.diagnostics_config.block_tracing.sample_rate);
+	ASSERT_EQ (conf.node.diagnostics_config.block_tracing.buffer_size, defaults.node.diagnostics_config.block_tracing.buffer_size);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.enable, defaults.node.diagnostics_config.txn_tracking.enable);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time, defaults.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.min_read_txn_time, defaults.node.diagnostics_config.txn_tracking.min_read_txn_time);
@@ -426,6 +451,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
 	frontiers_confirmation = "always"
+	[node.confirmation_log]
+	enable = true
+	max_age = 999
+	max_size = 999
+	segment_size = 9999
+	[node.diagnostics.block_tracing]
+	buffer_size = 999
+	enable = true
+	sample_rate = 999
 	[node.diagnostics.txn_tracking]
 	enable = true
 	ignore_writes_below_block_processor_max_time = false
@@ -434,8 +468,14 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 
 	[node.httpcallback]
 	address = "dev.org"
+	batch_size = 999
+	max_connections = 999
+	max_queued = 999
+	max_retries = 999
 	port = 999
+	retry_backoff = 999
 	target = "/dev"
+	timeout = 999
 
 	[node.ipc.local]
 	allow_unsafe = true
@@ -451,9 +491,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	port = 999
 
 	[node.ipc.flatbuffers]
+	max_count = 999
 	skip_unexpected_fields_in_json = false
 	verify_buffers = false
 
+	[node.ipc.shared_memory]
+	capacity = 999
+	confirmation_ring_name = "dev_confirmations"
+	enable = true
+
 	[node.logging]
 	bulk_pull = true
 	flush = false
@@ -496,6 +542,12 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	enable = true
 	interval = 999
 
+	[node.openmetrics]
+	address = "0:0:0:0:0:ffff:7f01:101"
+	enable = true
+	port = 999
+	containers = true
+
 	[node.websocket]
 	address = "0:0:0:0:0:ffff:7f01:101"
 	enable = true
@@ -515,6 +567,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	secondary_work_peers = ["dev.org:998"]
 	max_pruning_age = 999
 	max_pruning_depth = 999
+	cold_storage_depth = 999
 
 	[opencl]
 	device = 999
@@ -571,6 +624,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
 	ASSERT_NE (conf.node.max_pruning_age, defaults.node.max_pruning_age);
 	ASSERT_NE (conf.node.max_pruning_depth, defaults.node.max_pruning_depth);
+	ASSERT_NE (conf.node.cold_storage_depth, defaults.node.cold_storage_depth);
 	ASSERT_NE (conf.node.work_watcher_period, defaults.node.work_watcher_period);
 	ASSERT_NE (conf.node.online_weight_minimum, defaults.node.online_weight_minimum);
 	ASSERT_NE (conf.node.online_weight_quorum, defaults.node.online_weight_quorum);
@@ -624,10 +678,20 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_NE (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_NE (conf.node.websocket_config.port, defaults.node.websocket_config.port);
+	ASSERT_NE (conf.node.openmetrics_config.enabled, defaults.node.openmetrics_config.enabled);
+	ASSERT_NE (conf.node.openmetrics_config.address, defaults.node.openmetrics_config.address);
+	ASSERT_NE (conf.node.openmetrics_config.port, defaults.node.openmetrics_config.port);
+	ASSERT_NE (conf.node.openmetrics_config.containers, defaults.node.openmetrics_config.containers);
 
 	ASSERT_NE (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_NE (conf.node.callback_port, defaults.node.callback_port);
 	ASSERT_NE (conf.node.callback_target, defaults.node.callback_target);
+	ASSERT_NE (conf.node.callback_max_connections, defaults.node.callback_max_connections);
+	ASSERT_NE (conf.node.callback_max_queued, defaults.node.callback_max_queued);
+	ASSERT_NE (conf.node.callback_batch_size, defaults.node.callback_batch_size);
+	ASSERT_NE (conf.node.callback_max_retries, defaults.node.callback_max_retries);
+	ASSERT_NE (conf.node.callback_retry_backoff, defaults.node.callback_retry_backoff);
+	ASSERT_NE (conf.node.callback_timeout, defaults.node.callback_timeout);
 
 	ASSERT_NE (conf.node.ipc_config.transport_domain.allow_unsafe, defaults.node.ipc_config.transport_domain.allow_unsafe);
 	ASSERT_NE (conf.node.ipc_config.transport_domain.enabled, defaults.node.ipc_config.transport_domain.enabled);
@@ -640,7 +704,19 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
-
+	ASSERT_NE (conf.node.ipc_config.flatbuffers.max_count, defaults.node.ipc_config.flatbuffers.max_count);
+	ASSERT_NE (conf.node.ipc_config.shared_memory.enabled, defaults.node.ipc_config.shared_memory.enabled);
+	ASSERT_NE (conf.node.ipc_config.shared_memory.confirmation_ring_name, defaults.node.ipc_config.shared_memory.confirmation_ring_name);
+	ASSERT_NE (conf.node.ipc_config.shared_memory.capacity, defaults.node.ipc_config.shared_memory.capacity);
+
+	ASSERT_NE (conf.node.confirmation_log_config.enabled, defaults.node.confirmation_log_config.enabled);
+	ASSERT_NE (conf.node.confirmation_log_config.segment_size, defaults.node.confirmation_log_config.segment_size);
+	ASSERT_NE (conf.node.confirmation_log_config.max_size, defaults.node.confirmation_log_config.max_size);
+	ASSERT_NE (conf.node.confirmation_log_config.max_age, defaults.node.confirmation_log_config.max_age);
+
+	ASSERT_NE (conf.node.diagnostics_config.block_tracing.enable, defaults.node.diagnostics_config.block_tracing.enable);
+	ASSERT_NE (conf.node.diagnostics_config.block_tracing.sample_rate, defaults.node.diagnostics_config.block_tracing.sample_rate);
+	ASSERT_NE (conf.node.diagnostics_config.block_tracing.buffer_size, defaults.node.diagnostics_config.block_tracing.buffer_size);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.enable, defaults.node.diagnostics_config.txn_tracking.enable);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time, defaults.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.min_read_txn_time, defaults.node.diagnostics_config.txn_tracking.min_read_txn_time);
@@ -673,6 +749,7 @@ TEST (toml, daemon_config_no_required)
 	// A config with no values, only categories
 	ss << R"toml(
 	[node]
+	[node.diagnostics.block_tracing]
 	[node.diagnostics.txn_tracking]
 	[node.httpcallback]
 	[node.ipc.local]
@@ -680,6 +757,7 @@ TEST (toml, daemon_config_no_required)
 	[node.logging]
 	[node.statistics.log]
 	[node.statistics.sampling]
+	[node.openmetrics]
 	[node.websocket]
 	[node.rocksdb]
 	[opencl]
@@ -1017,14 +1017,14 @@ TEST (work_watcher, update)
 	auto multiplier2 (ysu::normalized_multiplier (ysu::difficulty::to_multiplier (difficulty2, ysu::work_threshold (block2->work_version (), ysu::block_details (ysu::epoch::epoch_0, true, false, false))), node.network_params.network.publish_thresholds.epoch_1));
 	double updated_multiplier1{ multiplier1 }, updated_multiplier2{ multiplier2 }, target_multiplier{ std::max (multiplier1, multiplier2) + 1e-6 };
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		node.active.trended_active_multiplier = target_multiplier;
 	}
 	system.deadline_set (20s);
 	while (updated_multiplier1 == multiplier1 || updated_multiplier2 == multiplier2)
 	{
 		{
-			ysu::lock_guard<std::mutex> guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 			{
 				auto const existing (node.active.roots.find (block1->qualified_root ()));
 				//if existing is junk the block has been confirmed already
@@ -1065,7 +1065,7 @@ TEST (work_watcher, propagate)
 	auto updated_multiplier{ multiplier };
 	auto propagated_multiplier{ multiplier };
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		node.active.trended_active_multiplier = multiplier * 1.001;
 	}
 	bool updated{ false };
@@ -1074,7 +1074,7 @@ TEST (work_watcher, propagate)
 	while (!(updated && propagated))
 	{
 		{
-			ysu::lock_guard<std::mutex> guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 			{
 				auto const existing (node.active.roots.find (block->qualified_root ()));
 				ASSERT_NE (existing, node.active.roots.end ());
@@ -1082,7 +1082,7 @@ TEST (work_watcher, propagate)
 			}
 		}
 		{
-			ysu::lock_guard<std::mutex> guard (node_passive.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node_passive.active.mutex);
 			{
 				auto const existing (node_passive.active.roots.find (block->qualified_root ()));
 				ASSERT_NE (existing, node_passive.active.roots.end ());
@@ -1156,13 +1156,13 @@ TEST (work_watcher, generation_disabled)
 	auto multiplier = ysu::normalized_multiplier (ysu::difficulty::to_multiplier (difficulty, ysu::work_threshold (block->work_version (), ysu::block_details (ysu::epoch::epoch_0, true, false, false))), node.network_params.network.publish_thresholds.epoch_1);
 	double updated_multiplier{ multiplier };
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		node.active.trended_active_multiplier = multiplier * 10;
 	}
 	std::this_thread::sleep_for (2s);
 	ASSERT_TRUE (node.wallets.watcher->is_watched (block->qualified_root ()));
 	{
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		auto const existing (node.active.roots.find (block->qualified_root ()));
 		ASSERT_NE (existing, node.active.roots.end ());
 		updated_multiplier = existing->multiplier;
@@ -1185,7 +1185,7 @@ TEST (work_watcher, cancel)
 	auto work1 (node.work_generate_blocking (ysu::dev_genesis_key.pub));
 	auto const block1 (wallet.send_action (ysu::dev_genesis_key.pub, key.pub, 100, *work1, false));
 	{
-		ysu::unique_lock<std::mutex> lock (node.active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node.active.mutex);
 		// Prevent active difficulty repopulating multipliers
 		node.network_params.network.request_interval_ms = 10000;
 		// Fill multipliers_cb and update active difficulty;
@@ -1232,7 +1232,7 @@ TEST (work_watcher, confirm_while_generating)
 	auto work1 (node.work_generate_blocking (ysu::dev_genesis_key.pub));
 	auto const block1 (wallet.send_action (ysu::dev_genesis_key.pub, key.pub, 100, *work1, false));
 	{
-		ysu::unique_lock<std::mutex> lock (node.active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node.active.mutex);
 		// Prevent active difficulty repopulating multipliers
 		node.network_params.network.request_interval_ms = 10000;
 		// Fill multipliers_cb and update active difficulty;
@@ -1279,7 +1279,7 @@ TEST (wallet, limited_difficulty)
 	wallet.insert_adhoc (ysu::dev_genesis_key.prv, false);
 	{
 		// Force active difficulty to an impossibly high value
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		node.active.trended_active_multiplier = 1024 * 1024 * 1024;
 	}
 	ASSERT_EQ (node.max_work_generate_difficulty (ysu::work_version::work_1), node.active.limited_active_difficulty (*genesis.open));
@@ -1367,7 +1367,7 @@ TEST (wallet, epoch_2_receive_propagation)
 
 		// Receiving should use the lower difficulty
 		{
-			ysu::lock_guard<std::mutex> guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 			node.active.trended_active_multiplier = 1.0;
 		}
 		auto receive2 = wallet.receive_action (*send2, key.pub, amount, 1);
@@ -1417,7 +1417,7 @@ TEST (wallet, epoch_2_receive_unopened)
 
 		// Receiving should use the lower difficulty
 		{
-			ysu::lock_guard<std::mutex> guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 			node.active.trended_active_multiplier = 1.0;
 		}
 		auto receive1 = wallet.receive_action (*send1, key.pub, amount, 1);
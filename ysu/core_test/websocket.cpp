@@ -81,7 +81,7 @@ TEST (websocket, active_difficulty)
 
 	// Fake history records and force a trended_active_multiplier change
 	{
-		ysu::unique_lock<std::mutex> lock (node1->active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node1->active.mutex);
 		node1->active.multipliers_cb.push_front (10.);
 		node1->active.update_active_multiplier (lock);
 	}
@@ -178,6 +178,45 @@ TEST (websocket, confirmation)
 	ASSERT_TIMELY (5s, future.wait_for (0s) == std::future_status::ready);
 }
 
+// Tests replaying cemented blocks from the confirmation log with the "from_seq" option
+TEST (websocket, confirmation_replay)
+{
+	ysu::system system;
+	ysu::node_config config (ysu::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = ysu::get_available_port ();
+	config.confirmation_log_config.enabled = true;
+	auto node1 (system.add_node (config));
+
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	ysu::keypair key;
+	auto send (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key.pub, ysu::Gxrb_ratio));
+	ASSERT_NE (nullptr, send);
+	ASSERT_TIMELY (10s, node1->confirmation_log->last_sequence () == 1);
+
+	auto task = ([config]() {
+		fake_websocket_client client (config.websocket_config.port);
+		client.send_message (R"json({"action": "subscribe", "topic": "confirmation", "ack": true, "options": {"from_seq": "1", "include_block": "false"}})json");
+		client.await_ack ();
+		return client.get_response ();
+	});
+	auto future = std::async (std::launch::async, task);
+	ASSERT_TIMELY (5s, future.wait_for (0s) == std::future_status::ready);
+
+	auto response (future.get ());
+	ASSERT_TRUE (response);
+	boost::property_tree::ptree event;
+	std::stringstream stream;
+	stream << response.get ();
+	boost::property_tree::read_json (stream, event);
+	ASSERT_EQ ("confirmation", event.get<std::string> ("topic"));
+	auto message_contents (event.get_child ("message"));
+	ASSERT_EQ ("replay", message_contents.get<std::string> ("confirmation_type"));
+	ASSERT_EQ ("1", message_contents.get<std::string> ("sequence"));
+	ASSERT_EQ (send->hash ().to_string (), message_contents.get<std::string> ("hash"));
+	ASSERT_FALSE (message_contents.get_child_optional ("block"));
+}
+
 // Tests getting notification of an erased election
 TEST (websocket, stopped_election)
 {
@@ -0,0 +1,150 @@
+#include <ysu/lib/bloom_filter.hpp>
+#include <ysu/lib/locks.hpp>
+#include <ysu/lib/utility.hpp>
+
+#include <istream>
+#include <ostream>
+
+ysu::bloom_filter::segment::segment (size_t capacity_a) :
+capacity (capacity_a),
+block_count (std::max<size_t> (capacity_a * bits_per_element / (block_words * 64), 1)),
+words (std::make_unique<std::atomic<uint64_t>[]> (block_count * block_words))
+{
+}
+
+void ysu::bloom_filter::segment::insert (ysu::uint256_union const & number_a)
+{
+	auto block (words.get () + (number_a.qwords[0] % block_count) * block_words);
+	auto bits (number_a.qwords[1]);
+	auto step (number_a.qwords[2] | 1);
+	for (unsigned i (0); i < hash_count; ++i, bits += step)
+	{
+		auto bit (bits & (block_words * 64 - 1));
+		block[bit / 64].fetch_or (uint64_t (1) << (bit % 64), std::memory_order_relaxed);
+	}
+}
+
+bool ysu::bloom_filter::segment::may_contain (ysu::uint256_union const & number_a) const
+{
+	auto block (words.get () + (number_a.qwords[0] % block_count) * block_words);
+	auto bits (number_a.qwords[1]);
+	auto step (number_a.qwords[2] | 1);
+	auto result (true);
+	for (unsigned i (0); result && i < hash_count; ++i, bits += step)
+	{
+		auto bit (bits & (block_words * 64 - 1));
+		result = (block[bit / 64].load (std::memory_order_relaxed) & (uint64_t (1) << (bit % 64))) != 0;
+	}
+	return result;
+}
+
+ysu::bloom_filter::bloom_filter (size_t capacity_a)
+{
+	reset (capacity_a);
+}
+
+void ysu::bloom_filter::reset (size_t capacity_a)
+{
+	for (auto & segment_l : segments)
+	{
+		segment_l.reset ();
+	}
+	segments[0] = std::make_unique<segment> (std::min<uint64_t> (std::max<size_t> (capacity_a, 1), maximum_capacity));
+	segment_count = 1;
+}
+
+ysu::bloom_filter::segment & ysu::bloom_filter::last_segment ()
+{
+	auto count (segment_count.load ());
+	auto & result (*segments[count - 1]);
+	if (result.count.load () >= result.capacity && count < max_segments)
+	{
+		ysu::lock_guard<std::mutex> guard (grow_mutex);
+		// Another thread may have added the segment while waiting for the lock
+		if (segment_count.load () == count)
+		{
+			segments[count] = std::make_unique<segment> (result.capacity * 2);
+			segment_count = count + 1;
+		}
+		return *segments[count];
+	}
+	return result;
+}
+
+void ysu::bloom_filter::insert (ysu::uint256_union const & number_a)
+{
+	if (!may_contain (number_a))
+	{
+		auto & segment_l (last_segment ());
+		segment_l.insert (number_a);
+		++segment_l.count;
+	}
+}
+
+bool ysu::bloom_filter::may_contain (ysu::uint256_union const & number_a) const
+{
+	auto result (false);
+	for (size_t i (0), n (segment_count.load ()); !result && i < n; ++i)
+	{
+		result = segments[i]->may_contain (number_a);
+	}
+	return result;
+}
+
+size_t ysu::bloom_filter::size () const
+{
+	size_t result (0);
+	for (size_t i (0), n (segment_count.load ()); i < n; ++i)
+	{
+		result += segments[i]->count.load ();
+	}
+	return result;
+}
+
+size_t ysu::bloom_filter::memory_usage () const
+{
+	size_t result (0);
+	for (size_t i (0), n (segment_count.load ()); i < n; ++i)
+	{
+		result += segments[i]->block_count * segment::block_words * sizeof (uint64_t);
+	}
+	return result;
+}
+
+void ysu::bloom_filter::serialize (std::ostream & stream_a) const
+{
+	uint64_t count (segment_count.load ());
+	stream_a.write (reinterpret_cast<char const *> (&count), sizeof (count));
+	for (size_t i (0); i < count; ++i)
+	{
+		auto const & segment_l (*segments[i]);
+		uint64_t header[] = { segment_l.capacity, segment_l.count.load () };
+		stream_a.write (reinterpret_cast<char const *> (header), sizeof (header));
+		static_assert (sizeof (std::atomic<uint64_t>) == sizeof (uint64_t), "Words are written as they are stored");
+		stream_a.write (reinterpret_cast<char const *> (segment_l.words.get ()), segment_l.block_count * segment::block_words * sizeof (uint64_t));
+	}
+}
+
+bool ysu::bloom_filter::deserialize (std::istream & stream_a)
+{
+	uint64_t count (0);
+	auto error (!stream_a.read (reinterpret_cast<char *> (&count), sizeof (count)) || count == 0 || count > max_segments);
+	std::array<std::unique_ptr<segment>, max_segments> segments_l;
+	for (size_t i (0); !error && i < count; ++i)
+	{
+		uint64_t header[2];
+		error = !stream_a.read (reinterpret_cast<char *> (header), sizeof (header)) || header[0] == 0 || header[0] > maximum_capacity;
+		if (!error)
+		{
+			segments_l[i] = std::make_unique<segment> (header[0]);
+			segments_l[i]->count = header[1];
+			error = !stream_a.read (reinterpret_cast<char *> (segments_l[i]->words.get ()), segments_l[i]->block_count * segment::block_words * sizeof (uint64_t));
+		}
+	}
+	if (!error)
+	{
+		segments = std::move (segments_l);
+		segment_count = count;
+	}
+	return error;
+}
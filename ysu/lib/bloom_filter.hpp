@@ -0,0 +1,67 @@
+#pragma once
+
+#include <ysu/lib/numbers.hpp>
+
+#include <array>
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+
+namespace ysu
+{
+/**
+ * Bloom filter over uniformly distributed 256-bit numbers such as block hashes, which can only answer that a number is
+ * definitely absent or may be present.
+ *
+ * The bits probed for a number all lie in a single 64 byte block, so a lookup touches one cache line. Numbers are used
+ * as their own hashes. When more numbers than the capacity were inserted, a segment twice as large is added instead of
+ * rebuilding, which keeps the false positive rate close to the target as the filter grows.
+ * @note Inserting and querying are thread-safe and lock free except when a segment is added.
+ */
+class bloom_filter final
+{
+public:
+	explicit bloom_filter (size_t capacity_a = default_capacity);
+	/** Removes every number and resizes for \p capacity_a. Must not be called while the filter is used by other threads */
+	void reset (size_t capacity_a);
+	void insert (ysu::uint256_union const & number_a);
+	/** Returns false if \p number_a was never inserted */
+	bool may_contain (ysu::uint256_union const & number_a) const;
+	/** Approximate number of distinct numbers inserted */
+	size_t size () const;
+	size_t memory_usage () const;
+	void serialize (std::ostream & stream_a) const;
+	/** Replaces the contents with the ones written by serialize. Must not be called while the filter is used by other threads */
+	bool deserialize (std::istream & stream_a);
+
+	/** Filters which are expected to grow start at least this large, so that lookups don't probe many small segments */
+	static size_t constexpr default_capacity = 1024 * 1024;
+	/** About 1% false positives */
+	static size_t constexpr bits_per_element = 10;
+	static unsigned constexpr hash_count = 7;
+
+private:
+	class segment final
+	{
+	public:
+		explicit segment (size_t capacity_a);
+		void insert (ysu::uint256_union const & number_a);
+		bool may_contain (ysu::uint256_union const & number_a) const;
+		static size_t constexpr block_words = 8;
+		size_t const capacity;
+		size_t const block_count;
+		std::unique_ptr<std::atomic<uint64_t>[]> words;
+		std::atomic<size_t> count{ 0 };
+	};
+
+	segment & last_segment ();
+
+	static size_t constexpr max_segments = 48;
+	/** Bounds segments read by deserialize */
+	static uint64_t constexpr maximum_capacity = uint64_t (1) << 40;
+	std::array<std::unique_ptr<segment>, max_segments> segments;
+	std::atomic<size_t> segment_count{ 0 };
+	std::mutex grow_mutex;
+};
+}
@@ -113,6 +113,7 @@ public:
 		default_rpc_port = is_live_network () ? 7076 : is_beta_network () ? 55000 : is_test_network () ? 17076 : 45000;
 		default_ipc_port = is_live_network () ? 7077 : is_beta_network () ? 56000 : is_test_network () ? 17077 : 46000;
 		default_websocket_port = is_live_network () ? 7078 : is_beta_network () ? 57000 : is_test_network () ? 17078 : 47000;
+		default_openmetrics_port = is_live_network () ? 7079 : is_beta_network () ? 58000 : is_test_network () ? 17079 : 48000;
 		request_interval_ms = is_dev_network () ? 20 : 500;
 	}
 
@@ -133,6 +134,7 @@ public:
 	uint16_t default_rpc_port;
 	uint16_t default_ipc_port;
 	uint16_t default_websocket_port;
+	uint16_t default_openmetrics_port;
 	unsigned request_interval_ms;
 
 	/** Returns the network this object contains values for */
@@ -10,6 +10,12 @@ ysu::error ysu::diagnostics_config::serialize_json (ysu::jsonconfig & json) cons
 	txn_tracking_l.put ("min_write_txn_time", txn_tracking.min_write_txn_time.count ());
 	txn_tracking_l.put ("ignore_writes_below_block_processor_max_time", txn_tracking.ignore_writes_below_block_processor_max_time);
 	json.put_child ("txn_tracking", txn_tracking_l);
+
+	ysu::jsonconfig block_tracing_l;
+	block_tracing_l.put ("enable", block_tracing.enable);
+	block_tracing_l.put ("sample_rate", block_tracing.sample_rate);
+	block_tracing_l.put ("buffer_size", block_tracing.buffer_size);
+	json.put_child ("block_tracing", block_tracing_l);
 	return json.get_error ();
 }
 
@@ -29,6 +35,14 @@ ysu::error ysu::diagnostics_config::deserialize_json (ysu::jsonconfig & json)
 
 		txn_tracking_l->get_optional<bool> ("ignore_writes_below_block_processor_max_time", txn_tracking.ignore_writes_below_block_processor_max_time);
 	}
+
+	auto block_tracing_l (json.get_optional_child ("block_tracing"));
+	if (block_tracing_l)
+	{
+		block_tracing_l->get_optional<bool> ("enable", block_tracing.enable);
+		block_tracing_l->get_optional<unsigned> ("sample_rate", block_tracing.sample_rate);
+		block_tracing_l->get_optional<size_t> ("buffer_size", block_tracing.buffer_size);
+	}
 	return json.get_error ();
 }
 
@@ -40,6 +54,12 @@ ysu::error ysu::diagnostics_config::serialize_toml (ysu::tomlconfig & toml) cons
 	txn_tracking_l.put ("min_write_txn_time", txn_tracking.min_write_txn_time.count (), "Log stacktrace when write transactions are held longer than this duration.\ntype:milliseconds");
 	txn_tracking_l.put ("ignore_writes_below_block_processor_max_time", txn_tracking.ignore_writes_below_block_processor_max_time, "Ignore any block processor writes less than block_processor_batch_max_time.\ntype:bool");
 	toml.put_child ("txn_tracking", txn_tracking_l);
+
+	ysu::tomlconfig block_tracing_l;
+	block_tracing_l.put ("enable", block_tracing.enable, "Enable or disable tracing of block latencies from arrival to cementing, exported with the block_trace RPC.\ntype:bool");
+	block_tracing_l.put ("sample_rate", block_tracing.sample_rate, "Trace one in this many blocks, selected by hash so every stage of a traced block is recorded.\ntype:uint32");
+	block_tracing_l.put ("buffer_size", block_tracing.buffer_size, "Number of trace events kept per thread. Older events are overwritten.\ntype:uint64");
+	toml.put_child ("block_tracing", block_tracing_l);
 	return toml.get_error ();
 }
 
@@ -59,5 +79,13 @@ ysu::error ysu::diagnostics_config::deserialize_toml (ysu::tomlconfig & toml)
 
 		txn_tracking_l->get_optional<bool> ("ignore_writes_below_block_processor_max_time", txn_tracking.ignore_writes_below_block_processor_max_time);
 	}
+
+	auto block_tracing_l (toml.get_optional_child ("block_tracing"));
+	if (block_tracing_l)
+	{
+		block_tracing_l->get_optional<bool> ("enable", block_tracing.enable);
+		block_tracing_l->get_optional<unsigned> ("sample_rate", block_tracing.sample_rate);
+		block_tracing_l->get_optional<size_t> ("buffer_size", block_tracing.buffer_size);
+	}
 	return toml.get_error ();
 }
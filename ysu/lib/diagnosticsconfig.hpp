@@ -18,6 +18,17 @@ public:
 	bool ignore_writes_below_block_processor_max_time{ true };
 };
 
+class block_tracing_config final
+{
+public:
+	/** If true, record when sampled blocks pass each stage from arrival to cementing */
+	bool enable{ false };
+	/** Trace one in this many blocks, chosen by hash */
+	unsigned sample_rate{ 100 };
+	/** Number of events buffered per thread, older events are overwritten */
+	size_t buffer_size{ 4096 };
+};
+
 /** Configuration options for diagnostics information */
 class diagnostics_config final
 {
@@ -28,5 +39,6 @@ public:
 	ysu::error deserialize_toml (ysu::tomlconfig &);
 
 	txn_tracking_config txn_tracking;
+	block_tracing_config block_tracing;
 };
 }
@@ -129,6 +129,8 @@ std::string ysu::error_rpc_messages::message (int ev) const
 			return "Unknown error";
 		case ysu::error_rpc::empty_response:
 			return "Empty response";
+		case ysu::error_rpc::bad_cursor:
+			return "Bad cursor";
 		case ysu::error_rpc::bad_destination:
 			return "Bad destination account";
 		case ysu::error_rpc::bad_difficulty_format:
@@ -167,12 +169,16 @@ std::string ysu::error_rpc_messages::message (int ev) const
 			return "Destination account, previous hash, current balance and amount required";
 		case ysu::error_rpc::block_root_mismatch:
 			return "Root mismatch for block";
+		case ysu::error_rpc::block_tracing_disabled:
+			return "Block tracing is disabled";
 		case ysu::error_rpc::block_work_enough:
 			return "Provided work is already enough for given difficulty";
 		case ysu::error_rpc::block_work_version_mismatch:
 			return "Work version mismatch for block";
 		case ysu::error_rpc::confirmation_height_not_processing:
 			return "There are no blocks currently being processed for adding confirmation height";
+		case ysu::error_rpc::confirmation_log_disabled:
+			return "Confirmation log is disabled";
 		case ysu::error_rpc::confirmation_not_found:
 			return "Active confirmation not found";
 		case ysu::error_rpc::difficulty_limit:
@@ -215,6 +221,8 @@ std::string ysu::error_rpc_messages::message (int ev) const
 			return "Unable to create transaction account";
 		case ysu::error_rpc::peer_not_found:
 			return "Peer not found";
+		case ysu::error_rpc::pruning_disabled:
+			return "Pruning is disabled";
 		case ysu::error_rpc::requires_port_and_address:
 			return "Both port and address required";
 		case ysu::error_rpc::rpc_control_disabled:
@@ -77,6 +77,7 @@ enum class error_rpc
 {
 	generic = 1,
 	empty_response,
+	bad_cursor,
 	bad_destination,
 	bad_difficulty_format,
 	bad_key,
@@ -96,9 +97,11 @@ enum class error_rpc
 	block_create_requirements_change,
 	block_create_requirements_send,
 	block_root_mismatch,
+	block_tracing_disabled,
 	block_work_enough,
 	block_work_version_mismatch,
 	confirmation_height_not_processing,
+	confirmation_log_disabled,
 	confirmation_not_found,
 	difficulty_limit,
 	disabled_bootstrap_lazy,
@@ -120,6 +123,7 @@ enum class error_rpc
 	payment_account_balance,
 	payment_unable_create_account,
 	peer_not_found,
+	pruning_disabled,
 	requires_port_and_address,
 	rpc_control_disabled,
 	sign_hash_disabled,
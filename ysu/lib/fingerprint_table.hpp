@@ -0,0 +1,229 @@
+#pragma once
+
+#include <ysu/crypto_lib/random_pool.hpp>
+#include <ysu/lib/numbers.hpp>
+
+#include <crypto/cryptopp/seckey.h>
+#include <crypto/cryptopp/siphash.h>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ysu
+{
+/**
+ * Open addressing hash table keyed by 64-bit fingerprints of 256-bit numbers, optionally mapping each to a value.
+ *
+ * Fingerprints and values are kept in two flat arrays which are only reallocated when the table grows, so there is
+ * no per element allocation or pointer overhead. Collisions are resolved with linear probing and erased slots are
+ * filled by shifting back the following entries, which leaves no tombstones behind.
+ * Numbers sharing a fingerprint are treated as the same key, which has a 2^-64 chance per pair. Fingerprints are
+ * siphash digests under a random key of each table, so peers can't choose hashes that collide with ones already stored.
+ * A fingerprint of zero marks an empty slot.
+ */
+template <typename Value = void>
+class fingerprint_table final
+{
+	static bool constexpr has_values = !std::is_void<Value>::value;
+	using value_type = std::conditional_t<has_values, Value, char>;
+
+public:
+	fingerprint_table ()
+	{
+		ysu::random_pool::generate_block (key.data (), key.size ());
+	}
+
+	uint64_t fingerprint (ysu::uint256_union const & number_a) const
+	{
+		uint64_t result;
+		siphash_t siphash (key.data (), static_cast<unsigned int> (key.size ()));
+		siphash.CalculateDigest (reinterpret_cast<uint8_t *> (&result), number_a.bytes.data (), number_a.bytes.size ());
+		return result != 0 ? result : 1;
+	}
+
+	bool contains (ysu::uint256_union const & key_a) const
+	{
+		return find_slot (fingerprint (key_a)) != npos;
+	}
+
+	/** Returns a pointer to the value of \p key_a which stays valid until the table is modified, or nullptr if it is not present */
+	value_type * find (ysu::uint256_union const & key_a)
+	{
+		static_assert (has_values, "fingerprint sets have no values");
+		auto slot (find_slot (fingerprint (key_a)));
+		return slot != npos ? &values[slot] : nullptr;
+	}
+
+	/** Inserts \p key_a with a value constructed from \p args_a. Returns false and leaves the existing value if it was already present */
+	template <typename... Args>
+	bool insert (ysu::uint256_union const & key_a, Args &&... args_a)
+	{
+		if ((count + 1) * max_load_denominator > keys.size () * max_load_numerator)
+		{
+			grow ();
+		}
+		auto fingerprint_l (fingerprint (key_a));
+		auto slot (home (fingerprint_l));
+		for (; keys[slot] != 0; slot = (slot + 1) & mask)
+		{
+			if (keys[slot] == fingerprint_l)
+			{
+				return false;
+			}
+		}
+		keys[slot] = fingerprint_l;
+		if constexpr (has_values)
+		{
+			values[slot] = Value{ std::forward<Args> (args_a)... };
+		}
+		++count;
+		return true;
+	}
+
+	/** Returns true if \p key_a was present */
+	bool erase (ysu::uint256_union const & key_a)
+	{
+		auto slot (find_slot (fingerprint (key_a)));
+		auto result (slot != npos);
+		if (result)
+		{
+			erase_slot (slot);
+		}
+		return result;
+	}
+
+	/** Calls \p action_a with each value until it returns false. The table must not be modified meanwhile */
+	template <typename Action>
+	void for_each (Action action_a)
+	{
+		static_assert (has_values, "fingerprint sets have no values");
+		for (size_t i (0), n (keys.size ()); i < n; ++i)
+		{
+			if (keys[i] != 0 && !action_a (values[i]))
+			{
+				break;
+			}
+		}
+	}
+
+	size_t size () const
+	{
+		return count;
+	}
+
+	bool empty () const
+	{
+		return count == 0;
+	}
+
+	void clear ()
+	{
+		keys = decltype (keys) ();
+		values = decltype (values) ();
+		count = 0;
+		mask = 0;
+		shift = 64;
+	}
+
+	/** Bytes allocated for slots, including the ones currently empty */
+	size_t memory_usage () const
+	{
+		return keys.capacity () * sizeof (uint64_t) + values.capacity () * sizeof (value_type);
+	}
+
+	/** Size of a single slot, for container info reporting */
+	static size_t constexpr slot_size = sizeof (uint64_t) + (has_values ? sizeof (value_type) : 0);
+
+private:
+	using siphash_t = CryptoPP::SipHash<2, 4, false>;
+	static size_t constexpr npos = static_cast<size_t> (-1);
+	static unsigned constexpr initial_capacity_bits = 4;
+	static size_t constexpr initial_capacity = size_t (1) << initial_capacity_bits;
+	/** Grow once the table is 80% full, which keeps probe sequences short */
+	static size_t constexpr max_load_numerator = 4;
+	static size_t constexpr max_load_denominator = 5;
+
+	/** Fibonacci hashing spreads keys whose fingerprints only differ in the high bits, such as accounts */
+	size_t home (uint64_t fingerprint_a) const
+	{
+		return static_cast<size_t> ((fingerprint_a * 0x9e3779b97f4a7c15ULL) >> shift);
+	}
+
+	size_t find_slot (uint64_t fingerprint_a) const
+	{
+		if (count != 0)
+		{
+			for (auto slot (home (fingerprint_a)); keys[slot] != 0; slot = (slot + 1) & mask)
+			{
+				if (keys[slot] == fingerprint_a)
+				{
+					return slot;
+				}
+			}
+		}
+		return npos;
+	}
+
+	void erase_slot (size_t hole_a)
+	{
+		auto hole (hole_a);
+		for (auto next ((hole + 1) & mask); keys[next] != 0; next = (next + 1) & mask)
+		{
+			// An entry can fill the hole if the hole lies between its home slot and the slot it currently occupies
+			if (((next - home (keys[next])) & mask) >= ((next - hole) & mask))
+			{
+				keys[hole] = keys[next];
+				if constexpr (has_values)
+				{
+					values[hole] = std::move (values[next]);
+				}
+				hole = next;
+			}
+		}
+		keys[hole] = 0;
+		--count;
+	}
+
+	void grow ()
+	{
+		auto capacity (keys.empty () ? initial_capacity : keys.size () * 2);
+		// Home slots are taken from the top bits of the hashed fingerprint, one more bit each time the capacity doubles
+		shift = keys.empty () ? 64 - initial_capacity_bits : shift - 1;
+		std::vector<uint64_t> keys_l (capacity, 0);
+		std::vector<value_type> values_l (has_values ? capacity : 0);
+		keys.swap (keys_l);
+		values.swap (values_l);
+		mask = capacity - 1;
+		for (size_t i (0), n (keys_l.size ()); i < n; ++i)
+		{
+			if (keys_l[i] != 0)
+			{
+				auto slot (home (keys_l[i]));
+				while (keys[slot] != 0)
+				{
+					slot = (slot + 1) & mask;
+				}
+				keys[slot] = keys_l[i];
+				if constexpr (has_values)
+				{
+					values[slot] = std::move (values_l[i]);
+				}
+			}
+		}
+	}
+
+	std::array<uint8_t, siphash_t::KEYLENGTH> key;
+	std::vector<uint64_t> keys;
+	std::vector<value_type> values;
+	size_t count{ 0 };
+	size_t mask{ 0 };
+	unsigned shift{ 64 };
+};
+
+using fingerprint_set = fingerprint_table<void>;
+template <typename Value>
+using fingerprint_map = fingerprint_table<Value>;
+}
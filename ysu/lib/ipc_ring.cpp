@@ -0,0 +1,249 @@
+#include <ysu/lib/ipc_ring.hpp>
+#include <ysu/lib/utility.hpp>
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+size_t align_record (size_t size_a)
+{
+	return (size_a + ysu::ipc::ring_record_alignment - 1) & ~(ysu::ipc::ring_record_alignment - 1);
+}
+
+size_t round_up_pow2 (size_t value_a)
+{
+	size_t result (1);
+	while (result < value_a)
+	{
+		result <<= 1;
+	}
+	return result;
+}
+}
+
+ysu::ipc::ring_writer::ring_writer (std::string const & name_a, size_t capacity_a) :
+name (name_a)
+{
+	auto capacity_l (round_up_pow2 (std::max<size_t> (capacity_a, 4096)));
+	boost::interprocess::shared_memory_object::remove (name.c_str ());
+	shm = boost::interprocess::shared_memory_object (boost::interprocess::create_only, name.c_str (), boost::interprocess::read_write);
+	shm.truncate (sizeof (ring_header) + capacity_l);
+	region = boost::interprocess::mapped_region (shm, boost::interprocess::read_write);
+	auto header_l (new (region.get_address ()) ring_header);
+	header_l->magic = ring_header::magic_value;
+	header_l->version = ring_header::current_version;
+	header_l->capacity = capacity_l;
+	header_l->write_position = 0;
+	header_l->tail_position = 0;
+	header_l->sequence = 0;
+	for (auto & slot : header_l->readers)
+	{
+		slot.in_use = 0;
+		slot.position = 0;
+		slot.overwrites = 0;
+	}
+}
+
+ysu::ipc::ring_writer::~ring_writer ()
+{
+	boost::interprocess::shared_memory_object::remove (name.c_str ());
+}
+
+bool ysu::ipc::ring_writer::write (uint8_t const * data_a, size_t size_a)
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	auto & header_l (header ());
+	auto capacity_l (header_l.capacity);
+	auto record_size (align_record (sizeof (ring_record_header) + size_a));
+	auto error (record_size > capacity_l / 2);
+	if (!error)
+	{
+		auto position (header_l.write_position.load (std::memory_order_relaxed));
+		auto offset (position & (capacity_l - 1));
+		auto padding_size (offset + record_size > capacity_l ? capacity_l - offset : 0);
+		auto end (position + padding_size + record_size);
+		auto new_tail (end > capacity_l ? end - capacity_l : 0);
+
+		// Invalidate the records about to be overwritten before touching them. Readers validate their
+		// copies against the tail, so the fence orders the tail update before the data writes.
+		header_l.tail_position.store (new_tail, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+
+		if (padding_size >= sizeof (ring_record_header))
+		{
+			ring_record_header padding{ 0, ring_record_header::padding, 0 };
+			std::memcpy (data () + offset, &padding, sizeof (padding));
+		}
+		if (padding_size > 0)
+		{
+			offset = 0;
+		}
+		auto sequence_l (header_l.sequence.load (std::memory_order_relaxed) + 1);
+		ring_record_header record{ static_cast<uint32_t> (size_a), 0, sequence_l };
+		std::memcpy (data () + offset, &record, sizeof (record));
+		std::memcpy (data () + offset + sizeof (record), data_a, size_a);
+
+		header_l.sequence.store (sequence_l, std::memory_order_relaxed);
+		header_l.write_position.store (end, std::memory_order_release);
+
+		overwritten_readers = 0;
+		for (auto & slot : header_l.readers)
+		{
+			if (slot.in_use.load (std::memory_order_relaxed) != 0 && slot.position.load (std::memory_order_relaxed) < new_tail)
+			{
+				slot.overwrites.fetch_add (1, std::memory_order_relaxed);
+				++overwritten_readers;
+			}
+		}
+	}
+	return error;
+}
+
+size_t ysu::ipc::ring_writer::last_overwritten_readers () const
+{
+	return overwritten_readers;
+}
+
+uint64_t ysu::ipc::ring_writer::sequence () const
+{
+	return header ().sequence.load (std::memory_order_relaxed);
+}
+
+size_t ysu::ipc::ring_writer::capacity () const
+{
+	return header ().capacity;
+}
+
+std::string const & ysu::ipc::ring_writer::get_name () const
+{
+	return name;
+}
+
+ysu::ipc::ring_header & ysu::ipc::ring_writer::header () const
+{
+	return *static_cast<ring_header *> (region.get_address ());
+}
+
+uint8_t * ysu::ipc::ring_writer::data () const
+{
+	return static_cast<uint8_t *> (region.get_address ()) + sizeof (ring_header);
+}
+
+ysu::ipc::ring_reader::ring_reader (std::string const & name_a) :
+shm (boost::interprocess::open_only, name_a.c_str (), boost::interprocess::read_write),
+region (shm, boost::interprocess::read_write)
+{
+	if (region.get_size () < sizeof (ring_header) || header ().magic != ring_header::magic_value || header ().version != ring_header::current_version || region.get_size () < sizeof (ring_header) + header ().capacity)
+	{
+		error = "Incompatible shared memory ring";
+	}
+	else
+	{
+		for (auto i (std::begin (header ().readers)), n (std::end (header ().readers)); i != n && slot == nullptr; ++i)
+		{
+			uint64_t expected (0);
+			if (i->in_use.compare_exchange_strong (expected, 1))
+			{
+				slot = &*i;
+				slot->overwrites.store (0, std::memory_order_relaxed);
+			}
+		}
+		if (slot == nullptr)
+		{
+			error = "No free reader slots in shared memory ring";
+		}
+		else
+		{
+			resync ();
+		}
+	}
+}
+
+ysu::ipc::ring_reader::~ring_reader ()
+{
+	if (slot != nullptr)
+	{
+		slot->in_use.store (0, std::memory_order_release);
+	}
+}
+
+ysu::error const & ysu::ipc::ring_reader::get_error () const
+{
+	return error;
+}
+
+bool ysu::ipc::ring_reader::poll (std::vector<uint8_t> & message_a)
+{
+	auto result (false);
+	if (!error)
+	{
+		auto & header_l (header ());
+		auto capacity_l (header_l.capacity);
+		auto data (static_cast<uint8_t const *> (region.get_address ()) + sizeof (ring_header));
+		while (!result && position < header_l.write_position.load (std::memory_order_acquire))
+		{
+			auto offset (position & (capacity_l - 1));
+			auto remaining (capacity_l - offset);
+			ring_record_header record{ 0, ring_record_header::padding, 0 };
+			if (remaining >= sizeof (record))
+			{
+				std::memcpy (&record, data + offset, sizeof (record));
+			}
+			auto valid (record.flags == ring_record_header::padding || sizeof (record) + record.length <= remaining);
+			if (valid && record.flags != ring_record_header::padding)
+			{
+				message_a.assign (data + offset + sizeof (record), data + offset + sizeof (record) + record.length);
+			}
+			// The copy is only valid if the producer did not start overwriting it meanwhile
+			std::atomic_thread_fence (std::memory_order_acquire);
+			if (!valid || header_l.tail_position.load (std::memory_order_relaxed) > position)
+			{
+				++overrun_count;
+				resync ();
+			}
+			else if (record.flags == ring_record_header::padding)
+			{
+				position += remaining;
+			}
+			else
+			{
+				position += align_record (sizeof (record) + record.length);
+				if (last_sequence != 0 && record.sequence > last_sequence + 1)
+				{
+					lost_count += record.sequence - last_sequence - 1;
+				}
+				last_sequence = record.sequence;
+				result = true;
+			}
+		}
+		slot->position.store (position, std::memory_order_release);
+	}
+	return result;
+}
+
+uint64_t ysu::ipc::ring_reader::sequence () const
+{
+	return last_sequence;
+}
+
+uint64_t ysu::ipc::ring_reader::overruns () const
+{
+	return overrun_count;
+}
+
+uint64_t ysu::ipc::ring_reader::lost () const
+{
+	return lost_count;
+}
+
+ysu::ipc::ring_header & ysu::ipc::ring_reader::header () const
+{
+	return *static_cast<ring_header *> (region.get_address ());
+}
+
+void ysu::ipc::ring_reader::resync ()
+{
+	position = header ().write_position.load (std::memory_order_acquire);
+	slot->position.store (position, std::memory_order_release);
+}
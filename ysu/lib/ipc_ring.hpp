@@ -0,0 +1,148 @@
+#pragma once
+
+#include <ysu/lib/errors.hpp>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ysu
+{
+namespace ipc
+{
+	/**
+	 * Shared memory ring transport.
+	 *
+	 * A single producer (the node) appends length-prefixed messages with monotonic sequence numbers into
+	 * a memory mapped ring. Any number of local readers poll the ring without syscalls. The producer never
+	 * waits for readers: when the ring wraps, the oldest records are overwritten and readers which have not
+	 * consumed them yet detect this through the tail position (a seqlock-style check) and resynchronize.
+	 *
+	 * Region layout: ring_header, followed by \p capacity bytes of record data. Every record starts with
+	 * a ring_record_header and is padded to ring_record_alignment. Positions are monotonic byte counters;
+	 * the offset into the data area is position modulo capacity.
+	 */
+	class ring_record_header final
+	{
+	public:
+		/** Padding records fill the remainder of the data area before the ring wraps */
+		static constexpr uint32_t padding = 1;
+		uint32_t length;
+		uint32_t flags;
+		uint64_t sequence;
+	};
+
+	static constexpr size_t ring_record_alignment = 8;
+
+	/** Reader registration. Each slot is owned by one reader and polled by the producer to detect slow readers. */
+	class alignas (64) ring_reader_slot final
+	{
+	public:
+		/** Non-zero while a reader owns the slot */
+		std::atomic<uint64_t> in_use;
+		/** Position up to which the reader has consumed records */
+		std::atomic<uint64_t> position;
+		/** Number of writes which overwrote records this reader had not consumed yet */
+		std::atomic<uint64_t> overwrites;
+	};
+
+	class ring_header final
+	{
+	public:
+		static constexpr uint32_t magic_value = 0x52555359; // "YSUR"
+		static constexpr uint32_t current_version = 1;
+		static constexpr size_t max_readers = 32;
+
+		uint32_t magic;
+		uint32_t version;
+		/** Size of the data area in bytes. Always a power of two. */
+		uint64_t capacity;
+		/** Position one past the last published record */
+		alignas (64) std::atomic<uint64_t> write_position;
+		/** Positions below this may have been overwritten */
+		std::atomic<uint64_t> tail_position;
+		/** Sequence number of the last published record */
+		std::atomic<uint64_t> sequence;
+		ring_reader_slot readers[max_readers];
+	};
+
+	/**
+	 * Creates the shared memory ring and publishes messages into it. The region is removed on destruction.
+	 * @note Writes are serialized internally; there is still only one logical producer per ring.
+	 */
+	class ring_writer final
+	{
+	public:
+		/**
+		 * Create (or recreate) the named shared memory region
+		 * @throws boost::interprocess::interprocess_exception if the region cannot be created
+		 */
+		ring_writer (std::string const & name_a, size_t capacity_a);
+		~ring_writer ();
+		/**
+		 * Append a message. Messages larger than half the capacity are rejected.
+		 * @return true if the message was rejected
+		 */
+		bool write (uint8_t const * data_a, size_t size_a);
+		/** Number of registered readers which had unconsumed records overwritten by the last write */
+		size_t last_overwritten_readers () const;
+		uint64_t sequence () const;
+		size_t capacity () const;
+		std::string const & get_name () const;
+
+	private:
+		ring_header & header () const;
+		uint8_t * data () const;
+
+		std::string name;
+		boost::interprocess::shared_memory_object shm;
+		boost::interprocess::mapped_region region;
+		size_t overwritten_readers{ 0 };
+		std::mutex mutex;
+	};
+
+	/**
+	 * Attaches to an existing ring and polls for new messages, starting with the next message published
+	 * after construction.
+	 */
+	class ring_reader final
+	{
+	public:
+		/** @throws boost::interprocess::interprocess_exception if the region does not exist */
+		ring_reader (std::string const & name_a);
+		~ring_reader ();
+		/** Returns an error if the region is not a compatible ring or all reader slots are taken */
+		ysu::error const & get_error () const;
+		/**
+		 * Copy the next available message into \p message_a
+		 * @return false if no message is available
+		 */
+		bool poll (std::vector<uint8_t> & message_a);
+		/** Sequence number of the last message returned by poll () */
+		uint64_t sequence () const;
+		/** Number of times this reader was overrun by the producer and had to skip ahead */
+		uint64_t overruns () const;
+		/** Number of messages skipped because of overruns, as observed through sequence number gaps */
+		uint64_t lost () const;
+
+	private:
+		ring_header & header () const;
+		void resync ();
+
+		boost::interprocess::shared_memory_object shm;
+		boost::interprocess::mapped_region region;
+		ring_reader_slot * slot{ nullptr };
+		uint64_t position{ 0 };
+		uint64_t last_sequence{ 0 };
+		uint64_t overrun_count{ 0 };
+		uint64_t lost_count{ 0 };
+		ysu::error error;
+	};
+}
+}
@@ -1,9 +1,229 @@
-#if YSU_TIMED_LOCKS > 0
 #include <ysu/lib/locks.hpp>
 #include <ysu/lib/utility.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+
+namespace
+{
+class mutex_registry final
+{
+public:
+	std::mutex mutex;
+	std::unordered_set<ysu::mutex *> mutexes;
+};
+
+mutex_registry & registry ()
+{
+	static mutex_registry registry;
+	return registry;
+}
+}
+
+std::atomic<bool> ysu::lock_profiler::detail::enabled{ false };
+
+void ysu::lock_profiler::enable (bool enable_a)
+{
+	detail::enabled.store (enable_a);
+}
+
+std::vector<ysu::lock_profile> ysu::lock_profiler::collect ()
+{
+	std::vector<ysu::lock_profile> profiles;
+	{
+		// Registered mutexes can't be destroyed while the registry is locked. Only their statistics are locked, never the mutexes
+		// themselves, whose holders may be waiting for the registry to construct or destroy another mutex.
+		std::lock_guard<std::mutex> guard (registry ().mutex);
+		for (auto mutex : registry ().mutexes)
+		{
+			mutex->collect (profiles);
+		}
+	}
+	// The same header may be compiled into several translation units, so call sites are merged by file name
+	std::map<std::tuple<std::string, std::string, unsigned>, ysu::lock_profile> merged;
+	for (auto & profile : profiles)
+	{
+		auto existing (merged.emplace (std::make_tuple (profile.mutex_name, profile.file, profile.line), profile));
+		if (!existing.second)
+		{
+			existing.first->second.stats.merge (profile.stats);
+		}
+	}
+	std::vector<ysu::lock_profile> result;
+	result.reserve (merged.size ());
+	for (auto & profile : merged)
+	{
+		result.push_back (std::move (profile.second));
+	}
+	return result;
+}
+
+void ysu::lock_profiler::clear ()
+{
+	std::lock_guard<std::mutex> guard (registry ().mutex);
+	for (auto mutex : registry ().mutexes)
+	{
+		mutex->clear ();
+	}
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::lock_profiler::collect_container_info (std::string const & name)
+{
+	std::map<std::string, size_t> sites;
+	{
+		std::lock_guard<std::mutex> guard (registry ().mutex);
+		for (auto mutex : registry ().mutexes)
+		{
+			sites[mutex->get_name ()] += mutex->site_count ();
+		}
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	for (auto const & site : sites)
+	{
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ site.first, site.second, sizeof (ysu::lock_site_stats) }));
+	}
+	return composite;
+}
+
+void ysu::lock_histogram::add (std::chrono::nanoseconds duration_a)
+{
+	auto micros (static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::microseconds> (duration_a).count ()));
+	size_t bucket (0);
+	while (micros > 1 && bucket < buckets.size () - 1)
+	{
+		micros >>= 1;
+		++bucket;
+	}
+	++buckets[bucket];
+}
 
+void ysu::lock_histogram::merge (ysu::lock_histogram const & other_a)
+{
+	for (size_t i (0); i < buckets.size (); ++i)
+	{
+		buckets[i] += other_a.buckets[i];
+	}
+}
+
+void ysu::lock_site_stats::merge (ysu::lock_site_stats const & other_a)
+{
+	acquisitions += other_a.acquisitions;
+	contended += other_a.contended;
+	wait_total += other_a.wait_total;
+	wait_max = std::max (wait_max, other_a.wait_max);
+	hold_total += other_a.hold_total;
+	hold_max = std::max (hold_max, other_a.hold_max);
+	wait.merge (other_a.wait);
+	hold.merge (other_a.hold);
+}
+
+ysu::mutex::mutex (char const * name_a) :
+name (name_a)
+{
+	std::lock_guard<std::mutex> guard (registry ().mutex);
+	registry ().mutexes.insert (this);
+}
+
+ysu::mutex::~mutex ()
+{
+	std::lock_guard<std::mutex> guard (registry ().mutex);
+	registry ().mutexes.erase (this);
+}
+
+void ysu::mutex::lock (ysu::lock_site const & site_a)
+{
+	if (!ysu::lock_profiler::enabled ())
+	{
+		mutex_m.lock ();
+	}
+	else
+	{
+		auto start (std::chrono::steady_clock::now ());
+		auto contended (!mutex_m.try_lock ());
+		if (contended)
+		{
+			mutex_m.lock ();
+		}
+		acquired (site_a, start, contended);
+	}
+}
+
+bool ysu::mutex::try_lock (ysu::lock_site const & site_a)
+{
+	auto result (mutex_m.try_lock ());
+	if (result && ysu::lock_profiler::enabled ())
+	{
+		acquired (site_a, std::chrono::steady_clock::now (), false);
+	}
+	return result;
+}
+
+void ysu::mutex::unlock ()
+{
+	if (profiled)
+	{
+		profiled = false;
+		std::chrono::nanoseconds held (std::chrono::steady_clock::now () - acquired_at);
+		std::lock_guard<std::mutex> guard (stats_mutex);
+		// Looked up again since the statistics may have been cleared meanwhile
+		auto & stats (sites[holder]);
+		stats.hold_total += held;
+		stats.hold_max = std::max (stats.hold_max, held);
+		stats.hold.add (held);
+	}
+	mutex_m.unlock ();
+}
+
+void ysu::mutex::acquired (ysu::lock_site const & site_a, std::chrono::steady_clock::time_point start_a, bool contended_a)
+{
+	acquired_at = std::chrono::steady_clock::now ();
+	std::chrono::nanoseconds waited (acquired_at - start_a);
+	{
+		std::lock_guard<std::mutex> guard (stats_mutex);
+		auto & stats (sites[site_a]);
+		++stats.acquisitions;
+		if (contended_a)
+		{
+			++stats.contended;
+			stats.wait_total += waited;
+			stats.wait_max = std::max (stats.wait_max, waited);
+		}
+		stats.wait.add (waited);
+	}
+	holder = site_a;
+	profiled = true;
+}
+
+char const * ysu::mutex::get_name () const
+{
+	return name;
+}
+
+void ysu::mutex::collect (std::vector<ysu::lock_profile> & profiles_a)
+{
+	std::lock_guard<std::mutex> guard (stats_mutex);
+	for (auto const & site : sites)
+	{
+		profiles_a.push_back ({ name, site.first.file, site.first.line, site.second });
+	}
+}
+
+void ysu::mutex::clear ()
+{
+	std::lock_guard<std::mutex> guard (stats_mutex);
+	sites.clear ();
+}
+
+size_t ysu::mutex::site_count ()
+{
+	std::lock_guard<std::mutex> guard (stats_mutex);
+	return sites.size ();
+}
+
+#if YSU_TIMED_LOCKS > 0
 namespace ysu
 {
 template <typename Mutex>
@@ -46,8 +266,10 @@ void output_if_blocked_long_enough (ysu::timer<std::chrono::milliseconds> & time
 // Explicit instantations
 template void output (const char * str, std::chrono::milliseconds time, std::mutex & mutex);
 template void output_if_held_long_enough (ysu::timer<std::chrono::milliseconds> & timer, std::mutex & mutex);
+template void output_if_held_long_enough (ysu::timer<std::chrono::milliseconds> & timer, ysu::mutex & mutex);
 #ifndef YSU_TIMED_LOCKS_IGNORE_BLOCKED
 template void output_if_blocked_long_enough (ysu::timer<std::chrono::milliseconds> & timer, std::mutex & mutex);
+template void output_if_blocked_long_enough (ysu::timer<std::chrono::milliseconds> & timer, ysu::mutex & mutex);
 #endif
 
 lock_guard<std::mutex>::lock_guard (std::mutex & mutex) :
@@ -196,6 +418,7 @@ void unique_lock<Mutex, U>::validate () const
 
 // Explicit instantiations for allowed types
 template class unique_lock<std::mutex>;
+template class unique_lock<ysu::mutex>;
 
 void condition_variable::notify_one () noexcept
 {
@@ -207,7 +430,8 @@ void condition_variable::notify_all () noexcept
 	cnd.notify_all ();
 }
 
-void condition_variable::wait (ysu::unique_lock<std::mutex> & lk)
+template <typename Mutex>
+void condition_variable::wait (ysu::unique_lock<Mutex> & lk)
 {
 	if (!lk.mut || !lk.owns)
 	{
@@ -220,5 +444,117 @@ void condition_variable::wait (ysu::unique_lock<std::mutex> & lk)
 	cnd.wait (lk);
 	lk.timer.restart ();
 }
+
+template void condition_variable::wait (ysu::unique_lock<std::mutex> &);
+template void condition_variable::wait (ysu::unique_lock<ysu::mutex> &);
+}
+#else
+ysu::detail::site_lock_guard::site_lock_guard (ysu::mutex & mutex_a, char const * file_a, unsigned line_a) :
+mut (mutex_a)
+{
+	mut.lock ({ file_a, line_a });
+}
+
+ysu::detail::site_lock_guard::~site_lock_guard () noexcept
+{
+	mut.unlock ();
+}
+
+ysu::detail::site_unique_lock::site_unique_lock (ysu::mutex & mutex_a, char const * file_a, unsigned line_a) :
+mut (std::addressof (mutex_a)),
+site{ file_a, line_a }
+{
+	lock ();
+}
+
+ysu::detail::site_unique_lock::site_unique_lock (ysu::mutex & mutex_a, std::defer_lock_t, char const * file_a, unsigned line_a) noexcept :
+mut (std::addressof (mutex_a)),
+site{ file_a, line_a }
+{
+}
+
+ysu::detail::site_unique_lock::site_unique_lock (site_unique_lock && other_a) noexcept :
+mut (other_a.mut),
+owns (other_a.owns),
+site (other_a.site)
+{
+	other_a.mut = nullptr;
+	other_a.owns = false;
+}
+
+ysu::detail::site_unique_lock & ysu::detail::site_unique_lock::operator= (site_unique_lock && other_a) noexcept
+{
+	if (this != std::addressof (other_a))
+	{
+		if (owns)
+		{
+			mut->unlock ();
+		}
+		mut = other_a.mut;
+		owns = other_a.owns;
+		site = other_a.site;
+		other_a.mut = nullptr;
+		other_a.owns = false;
+	}
+	return *this;
+}
+
+ysu::detail::site_unique_lock::~site_unique_lock () noexcept
+{
+	if (owns)
+	{
+		mut->unlock ();
+	}
+}
+
+void ysu::detail::site_unique_lock::lock ()
+{
+	validate ();
+	mut->lock (site);
+	owns = true;
+}
+
+bool ysu::detail::site_unique_lock::try_lock ()
+{
+	validate ();
+	owns = mut->try_lock (site);
+	return owns;
+}
+
+void ysu::detail::site_unique_lock::unlock ()
+{
+	if (!mut || !owns)
+	{
+		throw (std::system_error (std::make_error_code (std::errc::operation_not_permitted)));
+	}
+	mut->unlock ();
+	owns = false;
+}
+
+bool ysu::detail::site_unique_lock::owns_lock () const noexcept
+{
+	return owns;
+}
+
+ysu::detail::site_unique_lock::operator bool () const noexcept
+{
+	return owns;
+}
+
+ysu::mutex * ysu::detail::site_unique_lock::mutex () const noexcept
+{
+	return mut;
+}
+
+void ysu::detail::site_unique_lock::validate () const
+{
+	if (!mut)
+	{
+		throw (std::system_error (std::make_error_code (std::errc::operation_not_permitted)));
+	}
+	if (owns)
+	{
+		throw (std::system_error (std::make_error_code (std::errc::resource_deadlock_would_occur)));
+	}
 }
 #endif
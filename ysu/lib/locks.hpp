@@ -4,11 +4,145 @@
 #include <ysu/lib/timer.hpp>
 #endif
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Source location of the caller when used as a default argument
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+#define YSU_LOCK_SITE_FILE __builtin_FILE ()
+#define YSU_LOCK_SITE_LINE __builtin_LINE ()
+#else
+#define YSU_LOCK_SITE_FILE ""
+#define YSU_LOCK_SITE_LINE 0
+#endif
 
 namespace ysu
 {
+class container_info_component;
+
+/** Source location at which a ysu::mutex is acquired */
+class lock_site final
+{
+public:
+	char const * file{ "" };
+	unsigned line{ 0 };
+	bool operator== (ysu::lock_site const & other_a) const
+	{
+		return file == other_a.file && line == other_a.line;
+	}
+};
+}
+
+namespace std
+{
+template <>
+struct hash<::ysu::lock_site>
+{
+	size_t operator() (::ysu::lock_site const & site_a) const
+	{
+		return std::hash<char const *> () (site_a.file) ^ site_a.line;
+	}
+};
+}
+
+namespace ysu
+{
+/** Durations bucketed by powers of two microseconds, bucket i counting [2^i, 2^(i+1)) us. Bucket 0 also counts anything shorter. */
+class lock_histogram final
+{
+public:
+	void add (std::chrono::nanoseconds);
+	void merge (ysu::lock_histogram const &);
+	std::array<uint64_t, 24> buckets{};
+};
+
+class lock_site_stats final
+{
+public:
+	void merge (ysu::lock_site_stats const &);
+	uint64_t acquisitions{ 0 };
+	/** Acquisitions which had to wait for another holder */
+	uint64_t contended{ 0 };
+	std::chrono::nanoseconds wait_total{ 0 };
+	std::chrono::nanoseconds wait_max{ 0 };
+	std::chrono::nanoseconds hold_total{ 0 };
+	std::chrono::nanoseconds hold_max{ 0 };
+	ysu::lock_histogram wait;
+	ysu::lock_histogram hold;
+};
+
+/** Contention statistics of all mutexes with the same name at one call site */
+class lock_profile final
+{
+public:
+	std::string mutex_name;
+	std::string file;
+	unsigned line{ 0 };
+	ysu::lock_site_stats stats;
+};
+
+namespace lock_profiler
+{
+	namespace detail
+	{
+		extern std::atomic<bool> enabled;
+	}
+	/** Starts or stops recording contention statistics for every ysu::mutex, statistics already gathered are kept */
+	void enable (bool);
+	inline bool enabled ()
+	{
+		return detail::enabled.load (std::memory_order_relaxed);
+	}
+	/** Statistics of all existing mutexes, merged by mutex name and call site */
+	std::vector<ysu::lock_profile> collect ();
+	void clear ();
+	std::unique_ptr<ysu::container_info_component> collect_container_info (std::string const &);
+}
+
+/**
+ * A std::mutex with a name under which its contention is reported.
+ * While lock profiling is enabled, every acquisition through ysu::lock_guard or ysu::unique_lock records how long
+ * it waited for and held the mutex against the call site constructing the lock. When disabled the overhead is a
+ * relaxed atomic load per acquisition.
+ */
+class mutex final
+{
+public:
+	explicit mutex (char const * name_a);
+	~mutex ();
+	mutex (mutex const &) = delete;
+	mutex & operator= (mutex const &) = delete;
+
+	void lock (ysu::lock_site const & site_a = {});
+	bool try_lock (ysu::lock_site const & site_a = {});
+	void unlock ();
+	char const * get_name () const;
+	/** Appends the statistics of this mutex, one entry per call site */
+	void collect (std::vector<ysu::lock_profile> &);
+	void clear ();
+	size_t site_count ();
+
+private:
+	void acquired (ysu::lock_site const &, std::chrono::steady_clock::time_point, bool);
+
+	std::mutex mutex_m;
+	char const * name;
+	/** Only held while updating or copying the statistics, so that collecting them never waits for a holder of mutex_m */
+	std::mutex stats_mutex;
+	std::unordered_map<ysu::lock_site, ysu::lock_site_stats> sites;
+	// Protected by mutex_m
+	ysu::lock_site holder;
+	bool profiled{ false };
+	std::chrono::steady_clock::time_point acquired_at;
+};
+
 #if YSU_TIMED_LOCKS > 0
 template <typename Mutex>
 void output (const char * str, std::chrono::milliseconds time, Mutex & mutex);
@@ -50,7 +184,7 @@ private:
 	ysu::timer<std::chrono::milliseconds> timer;
 };
 
-template <typename Mutex, typename = std::enable_if_t<std::is_same<Mutex, std::mutex>::value>>
+template <typename Mutex, typename = std::enable_if_t<std::is_same<Mutex, std::mutex>::value || std::is_same<Mutex, ysu::mutex>::value>>
 class unique_lock final
 {
 public:
@@ -94,10 +228,11 @@ public:
 
 	void notify_one () noexcept;
 	void notify_all () noexcept;
-	void wait (ysu::unique_lock<std::mutex> & lt);
+	template <typename Mutex>
+	void wait (ysu::unique_lock<Mutex> & lt);
 
-	template <typename Pred>
-	void wait (ysu::unique_lock<std::mutex> & lk, Pred pred)
+	template <typename Mutex, typename Pred>
+	void wait (ysu::unique_lock<Mutex> & lk, Pred pred)
 	{
 		while (!pred ())
 		{
@@ -105,8 +240,8 @@ public:
 		}
 	}
 
-	template <typename Clock, typename Duration>
-	std::cv_status wait_until (ysu::unique_lock<std::mutex> & lk, std::chrono::time_point<Clock, Duration> const & timeout_time)
+	template <typename Mutex, typename Clock, typename Duration>
+	std::cv_status wait_until (ysu::unique_lock<Mutex> & lk, std::chrono::time_point<Clock, Duration> const & timeout_time)
 	{
 		if (!lk.mut || !lk.owns)
 		{
@@ -121,8 +256,8 @@ public:
 		return cv_status;
 	}
 
-	template <typename Clock, typename Duration, typename Pred>
-	bool wait_until (ysu::unique_lock<std::mutex> & lk, std::chrono::time_point<Clock, Duration> const & timeout_time, Pred pred)
+	template <typename Mutex, typename Clock, typename Duration, typename Pred>
+	bool wait_until (ysu::unique_lock<Mutex> & lk, std::chrono::time_point<Clock, Duration> const & timeout_time, Pred pred)
 	{
 		while (!pred ())
 		{
@@ -134,14 +269,14 @@ public:
 		return true;
 	}
 
-	template <typename Rep, typename Period>
-	void wait_for (ysu::unique_lock<std::mutex> & lk, std::chrono::duration<Rep, Period> const & rel_time)
+	template <typename Mutex, typename Rep, typename Period>
+	void wait_for (ysu::unique_lock<Mutex> & lk, std::chrono::duration<Rep, Period> const & rel_time)
 	{
 		wait_until (lk, std::chrono::steady_clock::now () + rel_time);
 	}
 
-	template <typename Rep, typename Period, typename Pred>
-	bool wait_for (ysu::unique_lock<std::mutex> & lk, std::chrono::duration<Rep, Period> const & rel_time, Pred pred)
+	template <typename Mutex, typename Rep, typename Period, typename Pred>
+	bool wait_for (ysu::unique_lock<Mutex> & lk, std::chrono::duration<Rep, Period> const & rel_time, Pred pred)
 	{
 		return wait_until (lk, std::chrono::steady_clock::now () + rel_time, std::move (pred));
 	}
@@ -151,11 +286,71 @@ private:
 };
 
 #else
+namespace detail
+{
+	/** Passes the call site on to ysu::mutex */
+	class site_lock_guard final
+	{
+	public:
+		explicit site_lock_guard (ysu::mutex & mutex_a, char const * file_a = YSU_LOCK_SITE_FILE, unsigned line_a = YSU_LOCK_SITE_LINE);
+		~site_lock_guard () noexcept;
+		site_lock_guard (site_lock_guard const &) = delete;
+		site_lock_guard & operator= (site_lock_guard const &) = delete;
+
+	private:
+		ysu::mutex & mut;
+	};
+
+	/** Passes the call site on to ysu::mutex, including relocks made by condition variables */
+	class site_unique_lock final
+	{
+	public:
+		site_unique_lock () = default;
+		explicit site_unique_lock (ysu::mutex & mutex_a, char const * file_a = YSU_LOCK_SITE_FILE, unsigned line_a = YSU_LOCK_SITE_LINE);
+		site_unique_lock (ysu::mutex & mutex_a, std::defer_lock_t, char const * file_a = YSU_LOCK_SITE_FILE, unsigned line_a = YSU_LOCK_SITE_LINE) noexcept;
+		site_unique_lock (site_unique_lock && other_a) noexcept;
+		site_unique_lock & operator= (site_unique_lock && other_a) noexcept;
+		~site_unique_lock () noexcept;
+		site_unique_lock (site_unique_lock const &) = delete;
+		site_unique_lock & operator= (site_unique_lock const &) = delete;
+
+		void lock ();
+		bool try_lock ();
+		void unlock ();
+		bool owns_lock () const noexcept;
+		explicit operator bool () const noexcept;
+		ysu::mutex * mutex () const noexcept;
+
+	private:
+		ysu::mutex * mut{ nullptr };
+		bool owns{ false };
+		ysu::lock_site site;
+
+		void validate () const;
+	};
+
+	template <typename Mutex>
+	class lock_types final
+	{
+	public:
+		using lock_guard = std::lock_guard<Mutex>;
+		using unique_lock = std::unique_lock<Mutex>;
+	};
+
+	template <>
+	class lock_types<ysu::mutex> final
+	{
+	public:
+		using lock_guard = site_lock_guard;
+		using unique_lock = site_unique_lock;
+	};
+}
+
 template <typename Mutex>
-using lock_guard = std::lock_guard<Mutex>;
+using lock_guard = typename detail::lock_types<Mutex>::lock_guard;
 
 template <typename Mutex>
-using unique_lock = std::unique_lock<Mutex>;
+using unique_lock = typename detail::lock_types<Mutex>::unique_lock;
 
 // For consistency wrapping the less well known _any variant which can be used with any lockable type
 using condition_variable = std::condition_variable_any;
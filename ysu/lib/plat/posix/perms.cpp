@@ -2,8 +2,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 void ysu::set_umask ()
 {
@@ -29,3 +31,15 @@ void ysu::set_secure_perm_file (boost::filesystem::path const & path, boost::sys
 {
 	boost::filesystem::permissions (path, boost::filesystem::perms::owner_read | boost::filesystem::perms::owner_write, ec);
 }
+
+bool ysu::sync_file (boost::filesystem::path const & path)
+{
+	auto fd (open (path.c_str (), O_RDONLY));
+	auto error (fd == -1);
+	if (!error)
+	{
+		error = fsync (fd) != 0;
+		close (fd);
+	}
+	return error;
+}
@@ -57,3 +57,20 @@ bool ysu::is_windows_elevated ()
 	}
 	return is_elevated;
 }
+
+bool ysu::sync_file (boost::filesystem::path const & path)
+{
+	// Directory entries can't be flushed on Windows, renames are made durable by the file system journal
+	auto error (false);
+	if (!boost::filesystem::is_directory (path))
+	{
+		auto handle (CreateFileW (path.wstring ().c_str (), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+		error = handle == INVALID_HANDLE_VALUE;
+		if (!error)
+		{
+			error = !FlushFileBuffers (handle);
+			CloseHandle (handle);
+		}
+	}
+	return error;
+}
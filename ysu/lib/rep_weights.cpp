@@ -3,7 +3,7 @@
 
 void ysu::rep_weights::representation_add (ysu::account const & source_rep_a, ysu::uint128_t const & amount_a)
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	auto source_previous (get (source_rep_a));
 	put (source_rep_a, source_previous + amount_a);
 }
@@ -12,7 +12,7 @@ void ysu::rep_weights::representation_add_dual (ysu::account const & source_rep_
 {
 	if (source_rep_1 != source_rep_2)
 	{
-		ysu::lock_guard<std::mutex> guard (mutex);
+		ysu::lock_guard<ysu::mutex> guard (mutex);
 		auto source_previous_1 (get (source_rep_1));
 		put (source_rep_1, source_previous_1 + amount_1);
 		auto source_previous_2 (get (source_rep_2));
@@ -26,27 +26,27 @@ void ysu::rep_weights::representation_add_dual (ysu::account const & source_rep_
 
 void ysu::rep_weights::representation_put (ysu::account const & account_a, ysu::uint128_union const & representation_a)
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	put (account_a, representation_a);
 }
 
 ysu::uint128_t ysu::rep_weights::representation_get (ysu::account const & account_a) const
 {
-	ysu::lock_guard<std::mutex> lk (mutex);
+	ysu::lock_guard<ysu::mutex> lk (mutex);
 	return get (account_a);
 }
 
 /** Makes a copy */
 std::unordered_map<ysu::account, ysu::uint128_t> ysu::rep_weights::get_rep_amounts () const
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return rep_amounts;
 }
 
 void ysu::rep_weights::copy_from (ysu::rep_weights & other_a)
 {
-	ysu::lock_guard<std::mutex> guard_this (mutex);
-	ysu::lock_guard<std::mutex> guard_other (other_a.mutex);
+	ysu::lock_guard<ysu::mutex> guard_this (mutex);
+	ysu::lock_guard<ysu::mutex> guard_other (other_a.mutex);
 	for (auto const & entry : other_a.rep_amounts)
 	{
 		auto prev_amount (get (entry.first));
@@ -86,7 +86,7 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (ysu:
 	size_t rep_amounts_count;
 
 	{
-		ysu::lock_guard<std::mutex> guard (rep_weights.mutex);
+		ysu::lock_guard<ysu::mutex> guard (rep_weights.mutex);
 		rep_amounts_count = rep_weights.rep_amounts.size ();
 	}
 	auto sizeof_element = sizeof (decltype (rep_weights.rep_amounts)::value_type);
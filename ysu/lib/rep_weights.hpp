@@ -23,7 +23,7 @@ public:
 	void copy_from (rep_weights & other_a);
 
 private:
-	mutable std::mutex mutex;
+	mutable ysu::mutex mutex{ "rep_weights" };
 	std::unordered_map<ysu::account, ysu::uint128_t> rep_amounts;
 	void put (ysu::account const & account_a, ysu::uint128_union const & representation_a);
 	ysu::uint128_t get (ysu::account const & account_a) const;
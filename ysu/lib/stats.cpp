@@ -214,6 +214,7 @@ std::shared_ptr<ysu::stat_entry> ysu::stat::get_entry_impl (uint32_t key, size_t
 	if (entry == entries.end ())
 	{
 		res = entries.emplace (key, std::make_shared<ysu::stat_entry> (capacity, interval)).first->second;
+		res->openmetrics_labels = boost::str (boost::format ("{type=\"%1%\",detail=\"%2%\",dir=\"%3%\"}") % type_to_string (key) % detail_to_string (key) % dir_to_string (key));
 	}
 	else
 	{
@@ -301,6 +302,32 @@ void ysu::stat::log_samples_impl (stat_log_sink & sink)
 	sink.finalize ();
 }
 
+void ysu::stat::write_openmetrics (std::ostream & stream_a, std::unordered_set<std::string> & series_a)
+{
+	ysu::lock_guard<std::mutex> guard (stat_mutex);
+	stream_a << "# TYPE ysu_stat counter\n";
+	stream_a << "# HELP ysu_stat Node statistics counters\n";
+	for (auto & it : entries)
+	{
+		if (series_a.insert ("ysu_stat_total" + it.second->openmetrics_labels).second)
+		{
+			stream_a << "ysu_stat_total" << it.second->openmetrics_labels << ' ' << it.second->counter.get_value () << '\n';
+		}
+	}
+	if (config.sampling_enabled)
+	{
+		stream_a << "# TYPE ysu_stat_sample gauge\n";
+		stream_a << "# HELP ysu_stat_sample Value of the last completed sample interval\n";
+		for (auto & it : entries)
+		{
+			if (!it.second->samples.empty () && series_a.insert ("ysu_stat_sample" + it.second->openmetrics_labels).second)
+			{
+				stream_a << "ysu_stat_sample" << it.second->openmetrics_labels << ' ' << it.second->samples.back ().get_value () << '\n';
+			}
+		}
+	}
+}
+
 void ysu::stat::update (uint32_t key_a, uint64_t value)
 {
 	static file_writer log_count (config.log_counters_filename);
@@ -453,6 +480,9 @@ std::string ysu::stat::type_to_string (uint32_t key)
 		case ysu::stat::type::vote_generator:
 			res = "vote_generator";
 			break;
+		case ysu::stat::type::store_cache:
+			res = "store_cache";
+			break;
 	}
 	return res;
 }
@@ -487,6 +517,9 @@ std::string ysu::stat::detail_to_string (uint32_t key)
 		case ysu::stat::detail::bulk_pull_receive_block_failure:
 			res = "bulk_pull_receive_block_failure";
 			break;
+		case ysu::stat::detail::bulk_pull_blocks:
+			res = "bulk_pull_blocks";
+			break;
 		case ysu::stat::detail::bulk_pull_request_failure:
 			res = "bulk_pull_request_failure";
 			break;
@@ -553,12 +586,30 @@ std::string ysu::stat::detail_to_string (uint32_t key)
 		case ysu::stat::detail::initiate_wallet_lazy:
 			res = "initiate_wallet_lazy";
 			break;
+		case ysu::stat::detail::initiate_ascending:
+			res = "initiate_ascending";
+			break;
+		case ysu::stat::detail::callback_batch:
+			res = "callback_batch";
+			break;
+		case ysu::stat::detail::callback_retry:
+			res = "callback_retry";
+			break;
+		case ysu::stat::detail::callback_latency:
+			res = "callback_latency";
+			break;
 		case ysu::stat::detail::insufficient_work:
 			res = "insufficient_work";
 			break;
 		case ysu::stat::detail::invocations:
 			res = "invocations";
 			break;
+		case ysu::stat::detail::shared_memory_publish:
+			res = "shared_memory_publish";
+			break;
+		case ysu::stat::detail::shared_memory_overwrite:
+			res = "shared_memory_overwrite";
+			break;
 		case ysu::stat::detail::keepalive:
 			res = "keepalive";
 			break;
@@ -760,6 +811,18 @@ std::string ysu::stat::detail_to_string (uint32_t key)
 		case ysu::stat::detail::generator_replies_discarded:
 			res = "generator_replies_discarded";
 			break;
+		case ysu::stat::detail::account_hit:
+			res = "account_hit";
+			break;
+		case ysu::stat::detail::account_miss:
+			res = "account_miss";
+			break;
+		case ysu::stat::detail::confirmation_height_hit:
+			res = "confirmation_height_hit";
+			break;
+		case ysu::stat::detail::confirmation_height_miss:
+			res = "confirmation_height_miss";
+			break;
 	}
 	return res;
 }
@@ -10,6 +10,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_set>
 
 namespace ysu
 {
@@ -107,6 +108,9 @@ public:
 
 	/** Observers for count. Called on each update. */
 	ysu::observer_set<uint64_t, uint64_t> count_observers;
+
+	/** OpenMetrics label set identifying this entry, rendered once when the entry is created */
+	std::string openmetrics_labels;
 };
 
 /** Log sink interface */
@@ -202,7 +206,8 @@ public:
 		requests,
 		filter,
 		telemetry,
-		vote_generator
+		vote_generator,
+		store_cache
 	};
 
 	/** Optional detail type */
@@ -247,10 +252,17 @@ public:
 		initiate,
 		initiate_lazy,
 		initiate_wallet_lazy,
+		initiate_ascending,
+
+		// http callback specific
+		callback_batch,
+		callback_retry,
+		callback_latency,
 
 		// bootstrap specific
 		bulk_pull,
 		bulk_pull_account,
+		bulk_pull_blocks,
 		bulk_pull_deserialize_receive_block,
 		bulk_pull_error_starting_request,
 		bulk_pull_failed_account,
@@ -304,6 +316,8 @@ public:
 
 		// ipc
 		invocations,
+		shared_memory_publish,
+		shared_memory_overwrite,
 
 		// peering
 		handshake,
@@ -342,7 +356,13 @@ public:
 		// vote generator
 		generator_broadcasts,
 		generator_replies,
-		generator_replies_discarded
+		generator_replies_discarded,
+
+		// store cache
+		account_hit,
+		account_miss,
+		confirmation_height_hit,
+		confirmation_height_miss
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
@@ -491,6 +511,12 @@ public:
 	/** Returns a new JSON log sink */
 	std::unique_ptr<stat_log_sink> log_sink_json () const;
 
+	/**
+	 * Writes counters, and the most recent sample of each sampled entry, in the OpenMetrics text format.
+	 * Series already in \p series_a are skipped, since scrapers reject expositions repeating a series, and written ones are added.
+	 */
+	void write_openmetrics (std::ostream & stream, std::unordered_set<std::string> & series_a);
+
 	/** Returns string representation of detail */
 	static std::string detail_to_string (uint32_t key);
 
@@ -88,6 +88,21 @@ std::string ysu::thread_role::get_string (ysu::thread_role::name role)
 		case ysu::thread_role::name::db_parallel_traversal:
 			thread_role_name_string = "DB par traversl";
 			break;
+		case ysu::thread_role::name::http_callbacks:
+			thread_role_name_string = "HTTP callbacks";
+			break;
+		case ysu::thread_role::name::openmetrics:
+			thread_role_name_string = "OpenMetrics";
+			break;
+		case ysu::thread_role::name::ledger_pruning:
+			thread_role_name_string = "Ledger pruning";
+			break;
+		case ysu::thread_role::name::block_filter:
+			thread_role_name_string = "Block filter";
+			break;
+		case ysu::thread_role::name::cold_storage:
+			thread_role_name_string = "Cold storage";
+			break;
 	}
 
 	/*
@@ -36,7 +36,12 @@ namespace thread_role
 		request_aggregator,
 		state_block_signature_verification,
 		epoch_upgrader,
-		db_parallel_traversal
+		db_parallel_traversal,
+		http_callbacks,
+		openmetrics,
+		ledger_pruning,
+		block_filter,
+		cold_storage
 	};
 	/*
 	 * Get/Set the identifier for the current thread
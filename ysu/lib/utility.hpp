@@ -87,6 +87,8 @@ void set_secure_perm_directory (boost::filesystem::path const & path);
 void set_secure_perm_directory (boost::filesystem::path const & path, boost::system::error_code & ec);
 void set_secure_perm_file (boost::filesystem::path const & path);
 void set_secure_perm_file (boost::filesystem::path const & path, boost::system::error_code & ec);
+/** Flushes the contents of the file or directory at \p path to disk, returns true on error */
+bool sync_file (boost::filesystem::path const & path);
 
 /*
  * Function to check if running Windows as an administrator
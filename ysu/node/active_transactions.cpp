@@ -43,7 +43,7 @@ thread ([this]() {
 		this->block_already_cemented_callback (hash_a);
 	});
 
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	condition.wait (lock, [& started = started] { return started; });
 }
 
@@ -55,7 +55,7 @@ ysu::active_transactions::~active_transactions ()
 bool ysu::active_transactions::insert_election_from_frontiers_confirmation (std::shared_ptr<ysu::block> const & block_a, ysu::account const & account_a, ysu::uint128_t previous_balance_a, ysu::election_behavior election_behavior_a)
 {
 	bool inserted{ false };
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	if (roots.get<tag_root> ().find (block_a->qualified_root ()) == roots.get<tag_root> ().end ())
 	{
 		std::function<void(std::shared_ptr<ysu::block> const &)> election_confirmation_cb;
@@ -124,7 +124,7 @@ void ysu::active_transactions::set_next_frontier_check (bool agressive_mode_a)
 
 void ysu::active_transactions::confirm_prioritized_frontiers (ysu::transaction const & transaction_a, uint64_t max_elections_a, uint64_t & elections_count_a)
 {
-	ysu::unique_lock<std::mutex> lk (mutex);
+	ysu::unique_lock<ysu::mutex> lk (mutex);
 	auto start_elections_for_prioritized_frontiers = [&transaction_a, &elections_count_a, max_elections_a, &lk, this](prioritize_num_uncemented & cementable_frontiers) {
 		while (!cementable_frontiers.empty () && !this->stopped && elections_count_a < max_elections_a && optimistic_elections_count < max_optimistic ())
 		{
@@ -201,7 +201,7 @@ void ysu::active_transactions::block_cemented_callback (std::shared_ptr<ysu::blo
 				auto election = existing->second;
 				election_winner_details.erase (hash);
 				election_winners_lk.unlock ();
-				ysu::unique_lock<std::mutex> lk (mutex);
+				ysu::unique_lock<ysu::mutex> lk (mutex);
 				if (election->confirmed () && election->status.winner->hash () == hash)
 				{
 					add_recently_cemented (election->status);
@@ -278,7 +278,7 @@ void ysu::active_transactions::block_already_cemented_callback (ysu::block_hash
 	remove_election_winner_details (hash_a);
 }
 
-void ysu::active_transactions::request_confirm (ysu::unique_lock<std::mutex> & lock_a)
+void ysu::active_transactions::request_confirm (ysu::unique_lock<ysu::mutex> & lock_a)
 {
 	debug_assert (!mutex.try_lock ());
 
@@ -414,7 +414,7 @@ unsigned ysu::active_transactions::max_optimistic ()
 	return node.ledger.cache.cemented_count < node.ledger.bootstrap_weight_max_blocks ? std::numeric_limits<unsigned>::max () : 50u;
 }
 
-void ysu::active_transactions::frontiers_confirmation (ysu::unique_lock<std::mutex> & lock_a)
+void ysu::active_transactions::frontiers_confirmation (ysu::unique_lock<ysu::mutex> & lock_a)
 {
 	// Spend some time prioritizing accounts with the most uncemented blocks to reduce voting traffic
 	auto request_interval = std::chrono::milliseconds (node.network_params.network.request_interval_ms);
@@ -533,7 +533,7 @@ bool ysu::active_transactions::should_do_frontiers_confirmation () const
 
 void ysu::active_transactions::request_loop ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	started = true;
 	lock.unlock ();
 	condition.notify_all ();
@@ -579,7 +579,7 @@ bool ysu::active_transactions::prioritize_account_for_confirmation (ysu::active_
 	if (info_a.block_count > confirmation_height_a && !confirmation_height_processor.is_processing_block (info_a.head))
 	{
 		auto num_uncemented = info_a.block_count - confirmation_height_a;
-		ysu::lock_guard<std::mutex> guard (mutex);
+		ysu::lock_guard<ysu::mutex> guard (mutex);
 		auto it = cementable_frontiers_a.get<tag_account> ().find (account_a);
 		if (it != cementable_frontiers_a.get<tag_account> ().end ())
 		{
@@ -625,7 +625,7 @@ void ysu::active_transactions::prioritize_frontiers_for_confirmation (ysu::trans
 		size_t priority_cementable_frontiers_size;
 		size_t priority_wallet_cementable_frontiers_size;
 		{
-			ysu::lock_guard<std::mutex> guard (mutex);
+			ysu::lock_guard<ysu::mutex> guard (mutex);
 			priority_cementable_frontiers_size = priority_cementable_frontiers.size ();
 			priority_wallet_cementable_frontiers_size = priority_wallet_cementable_frontiers.size ();
 		}
@@ -679,7 +679,7 @@ void ysu::active_transactions::prioritize_frontiers_for_confirmation (ysu::trans
 							auto it = priority_cementable_frontiers.find (account);
 							if (it != priority_cementable_frontiers.end ())
 							{
-								ysu::lock_guard<std::mutex> guard (mutex);
+								ysu::lock_guard<ysu::mutex> guard (mutex);
 								priority_cementable_frontiers.erase (it);
 								priority_cementable_frontiers_size = priority_cementable_frontiers.size ();
 							}
@@ -751,7 +751,7 @@ void ysu::active_transactions::prioritize_frontiers_for_confirmation (ysu::trans
 
 void ysu::active_transactions::stop ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	if (!started)
 	{
 		condition.wait (lock, [& started = started] { return started; });
@@ -798,6 +798,7 @@ ysu::election_insertion_result ysu::active_transactions::insert_impl (std::share
 				result.election = ysu::make_shared<ysu::election> (node, block_a, confirmation_action_a, prioritized, election_behavior_a);
 				roots.get<tag_root> ().emplace (ysu::active_transactions::conflict_info{ root, multiplier, result.election, epoch, previous_balance });
 				blocks.emplace (hash, result.election);
+				node.block_tracer.trace (hash, ysu::block_tracer::stage::election_started);
 				result.election->insert_inactive_votes_cache (hash);
 				node.stats.inc (ysu::stat::type::election, prioritized ? ysu::stat::detail::election_priority : ysu::stat::detail::election_non_priority);
 			}
@@ -819,7 +820,7 @@ ysu::election_insertion_result ysu::active_transactions::insert_impl (std::share
 
 ysu::election_insertion_result ysu::active_transactions::insert (std::shared_ptr<ysu::block> const & block_a, boost::optional<ysu::uint128_t> const & previous_balance_a, ysu::election_behavior election_behavior_a, std::function<void(std::shared_ptr<ysu::block>)> const & confirmation_action_a)
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	return insert_impl (block_a, previous_balance_a, election_behavior_a, confirmation_action_a);
 }
 
@@ -833,7 +834,7 @@ ysu::vote_code ysu::active_transactions::vote (std::shared_ptr<ysu::vote> vote_a
 	bool replay (false);
 	bool processed (false);
 	{
-		ysu::lock_guard<std::mutex> lock (mutex);
+		ysu::lock_guard<ysu::mutex> lock (mutex);
 		for (auto vote_block : vote_a->blocks)
 		{
 			ysu::election_vote_result result;
@@ -904,7 +905,7 @@ ysu::vote_code ysu::active_transactions::vote (std::shared_ptr<ysu::vote> vote_a
 
 bool ysu::active_transactions::active (ysu::qualified_root const & root_a)
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	return roots.get<tag_root> ().find (root_a) != roots.get<tag_root> ().end ();
 }
 
@@ -916,7 +917,7 @@ bool ysu::active_transactions::active (ysu::block const & block_a)
 std::shared_ptr<ysu::election> ysu::active_transactions::election (ysu::qualified_root const & root_a) const
 {
 	std::shared_ptr<ysu::election> result;
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	auto existing = roots.get<tag_root> ().find (root_a);
 	if (existing != roots.get<tag_root> ().end ())
 	{
@@ -928,7 +929,7 @@ std::shared_ptr<ysu::election> ysu::active_transactions::election (ysu::qualifie
 std::shared_ptr<ysu::block> ysu::active_transactions::winner (ysu::block_hash const & hash_a) const
 {
 	std::shared_ptr<ysu::block> result;
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	auto existing = blocks.find (hash_a);
 	if (existing != blocks.end ())
 	{
@@ -968,7 +969,7 @@ ysu::election_insertion_result ysu::active_transactions::activate (ysu::account
 
 bool ysu::active_transactions::update_difficulty (ysu::block const & block_a)
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	auto existing_election (roots.get<tag_root> ().find (block_a.qualified_root ()));
 	bool error = existing_election == roots.get<tag_root> ().end () || update_difficulty_impl (existing_election, block_a);
 	return error;
@@ -1074,7 +1075,7 @@ double ysu::active_transactions::normalized_multiplier (ysu::block const & block
 	return multiplier;
 }
 
-void ysu::active_transactions::update_active_multiplier (ysu::unique_lock<std::mutex> & lock_a)
+void ysu::active_transactions::update_active_multiplier (ysu::unique_lock<ysu::mutex> & lock_a)
 {
 	debug_assert (!mutex.try_lock ());
 	last_prioritized_multiplier.reset ();
@@ -1146,7 +1147,7 @@ double ysu::active_transactions::active_multiplier ()
 
 std::deque<ysu::election_status> ysu::active_transactions::list_recently_cemented ()
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	return recently_cemented;
 }
 
@@ -1170,13 +1171,13 @@ void ysu::active_transactions::add_recently_confirmed (ysu::qualified_root const
 
 void ysu::active_transactions::erase_recently_confirmed (ysu::block_hash const & hash_a)
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	recently_confirmed.get<tag_hash> ().erase (hash_a);
 }
 
 void ysu::active_transactions::erase (ysu::block const & block_a)
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	auto root_it (roots.get<tag_root> ().find (block_a.qualified_root ()));
 	if (root_it != roots.get<tag_root> ().end ())
 	{
@@ -1189,19 +1190,19 @@ void ysu::active_transactions::erase (ysu::block const & block_a)
 
 bool ysu::active_transactions::empty ()
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	return roots.empty ();
 }
 
 size_t ysu::active_transactions::size ()
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	return roots.size ();
 }
 
 bool ysu::active_transactions::publish (std::shared_ptr<ysu::block> block_a)
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	auto existing (roots.get<tag_root> ().find (block_a->qualified_root ()));
 	auto result (true);
 	if (existing != roots.get<tag_root> ().end ())
@@ -1222,7 +1223,7 @@ bool ysu::active_transactions::publish (std::shared_ptr<ysu::block> block_a)
 boost::optional<ysu::election_status_type> ysu::active_transactions::confirm_block (ysu::transaction const & transaction_a, std::shared_ptr<ysu::block> block_a)
 {
 	auto hash (block_a->hash ());
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	auto existing (blocks.find (hash));
 	boost::optional<ysu::election_status_type> status_type;
 	if (existing != blocks.end ())
@@ -1258,25 +1259,25 @@ boost::optional<ysu::election_status_type> ysu::active_transactions::confirm_blo
 
 size_t ysu::active_transactions::priority_cementable_frontiers_size ()
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return priority_cementable_frontiers.size ();
 }
 
 size_t ysu::active_transactions::priority_wallet_cementable_frontiers_size ()
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return priority_wallet_cementable_frontiers.size ();
 }
 
 boost::circular_buffer<double> ysu::active_transactions::difficulty_trend ()
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return multipliers_cb;
 }
 
 size_t ysu::active_transactions::inactive_votes_cache_size ()
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return inactive_votes_cache.size ();
 }
 
@@ -1332,7 +1333,7 @@ void ysu::active_transactions::add_inactive_votes_cache (ysu::block_hash const &
 
 void ysu::active_transactions::trigger_inactive_votes_cache_election (std::shared_ptr<ysu::block> const & block_a)
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	auto const status = find_inactive_votes_cache (block_a->hash ()).status;
 	if (status.election_started)
 	{
@@ -1436,7 +1437,7 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (acti
 	size_t recently_cemented_count;
 
 	{
-		ysu::lock_guard<std::mutex> guard (active_transactions.mutex);
+		ysu::lock_guard<ysu::mutex> guard (active_transactions.mutex);
 		roots_count = active_transactions.roots.size ();
 		blocks_count = active_transactions.blocks.size ();
 		recently_confirmed_count = active_transactions.recently_confirmed.size ();
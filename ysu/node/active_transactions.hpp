@@ -190,7 +190,7 @@ public:
 	// Returns false if the election was restarted
 	bool restart (std::shared_ptr<ysu::block> const &, ysu::write_transaction const &);
 	double normalized_multiplier (ysu::block const &, boost::optional<roots_iterator> const & = boost::none) const;
-	void update_active_multiplier (ysu::unique_lock<std::mutex> &);
+	void update_active_multiplier (ysu::unique_lock<ysu::mutex> &);
 	uint64_t active_difficulty ();
 	uint64_t limited_active_difficulty (ysu::block const &);
 	uint64_t limited_active_difficulty (ysu::work_version const, uint64_t const);
@@ -219,7 +219,7 @@ public:
 	void erase_inactive_votes_cache (ysu::block_hash const &);
 	ysu::confirmation_height_processor & confirmation_height_processor;
 	ysu::node & node;
-	mutable std::mutex mutex;
+	mutable ysu::mutex mutex{ "active_transactions" };
 	boost::circular_buffer<double> multipliers_cb;
 	std::atomic<double> trended_active_multiplier;
 	size_t priority_cementable_frontiers_size ();
@@ -243,7 +243,7 @@ private:
 	// Returns false if the election difficulty was updated
 	bool update_difficulty_impl (roots_iterator const &, ysu::block const &);
 	void request_loop ();
-	void request_confirm (ysu::unique_lock<std::mutex> &);
+	void request_confirm (ysu::unique_lock<ysu::mutex> &);
 	// Erase all blocks from active and, if not confirmed, clear digests from network filters
 	void cleanup_election (ysu::election_cleanup_info const &);
 	ysu::condition_variable condition;
@@ -295,7 +295,7 @@ private:
 	ysu::frontiers_confirmation_info get_frontiers_confirmation_info ();
 	void confirm_prioritized_frontiers (ysu::transaction const &, uint64_t, uint64_t &);
 	void confirm_expired_frontiers_pessimistically (ysu::transaction const &, uint64_t, uint64_t &);
-	void frontiers_confirmation (ysu::unique_lock<std::mutex> &);
+	void frontiers_confirmation (ysu::unique_lock<ysu::mutex> &);
 	bool insert_election_from_frontiers_confirmation (std::shared_ptr<ysu::block> const &, ysu::account const &, ysu::uint128_t, ysu::election_behavior);
 	ysu::account next_frontier_account{ 0 };
 	std::chrono::steady_clock::time_point next_frontier_check{ std::chrono::steady_clock::now () };
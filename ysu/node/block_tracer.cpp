@@ -0,0 +1,229 @@
+#include <ysu/lib/diagnosticsconfig.hpp>
+#include <ysu/lib/threading.hpp>
+#include <ysu/node/block_tracer.hpp>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+namespace
+{
+std::atomic<uint64_t> next_tracer_id{ 1 };
+}
+
+ysu::block_tracer::block_tracer (ysu::block_tracing_config const & config_a) :
+enabled_m (config_a.enable && config_a.sample_rate > 0),
+sample_rate (std::max (config_a.sample_rate, 1u)),
+buffer_size (std::max<size_t> (config_a.buffer_size, 1)),
+id (next_tracer_id++),
+start (std::chrono::steady_clock::now ())
+{
+}
+
+ysu::block_tracer::buffer::buffer (size_t size_a, unsigned thread_a, std::string const & thread_name_a) :
+slots (size_a),
+thread (thread_a),
+thread_name (thread_name_a)
+{
+}
+
+bool ysu::block_tracer::sampled (ysu::block_hash const & hash_a) const
+{
+	return enabled_m && hash_a.qwords[0] % sample_rate == 0;
+}
+
+void ysu::block_tracer::trace (ysu::block_hash const & hash_a, ysu::block_tracer::stage stage_a)
+{
+	if (sampled (hash_a))
+	{
+		auto time (std::chrono::steady_clock::now () - start);
+		auto & buffer (local_buffer ());
+		// Only this thread writes to the buffer
+		auto index (buffer.head.load (std::memory_order_relaxed));
+		auto & slot (buffer.slots[index % buffer.slots.size ()]);
+		slot.sequence.store (0, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		for (auto i (0); i < 4; ++i)
+		{
+			slot.hash[i].store (hash_a.qwords[i], std::memory_order_relaxed);
+		}
+		slot.time.store (std::chrono::duration_cast<std::chrono::nanoseconds> (time).count (), std::memory_order_relaxed);
+		slot.stage.store (static_cast<uint8_t> (stage_a), std::memory_order_relaxed);
+		slot.sequence.store (index + 1, std::memory_order_release);
+		buffer.head.store (index + 1, std::memory_order_release);
+	}
+}
+
+ysu::block_tracer::buffer & ysu::block_tracer::local_buffer ()
+{
+	// Threads are commonly shared by several nodes in tests, so the cache falls back to looking up by thread
+	thread_local uint64_t cached_id{ 0 };
+	thread_local std::shared_ptr<ysu::block_tracer::buffer> cached;
+	if (cached_id != id)
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		auto & existing (buffers[std::this_thread::get_id ()]);
+		if (existing == nullptr)
+		{
+			existing = std::make_shared<ysu::block_tracer::buffer> (buffer_size, static_cast<unsigned> (buffers.size ()), ysu::thread_role::get_string ());
+		}
+		cached = existing;
+		cached_id = id;
+	}
+	return *cached;
+}
+
+std::vector<ysu::block_tracer::event> ysu::block_tracer::events ()
+{
+	std::vector<std::shared_ptr<ysu::block_tracer::buffer>> buffers_l;
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		for (auto const & buffer : buffers)
+		{
+			buffers_l.push_back (buffer.second);
+		}
+	}
+	std::vector<ysu::block_tracer::event> result;
+	for (auto const & buffer : buffers_l)
+	{
+		auto head (buffer->head.load (std::memory_order_acquire));
+		auto size (buffer->slots.size ());
+		for (auto i (std::max<uint64_t> (buffer->tail.load (), head > size ? head - size : 0)); i < head; ++i)
+		{
+			auto & slot (buffer->slots[i % size]);
+			auto sequence (slot.sequence.load (std::memory_order_acquire));
+			if (sequence == i + 1)
+			{
+				ysu::block_tracer::event event;
+				for (auto j (0); j < 4; ++j)
+				{
+					event.hash.qwords[j] = slot.hash[j].load (std::memory_order_relaxed);
+				}
+				event.time = std::chrono::nanoseconds (slot.time.load (std::memory_order_relaxed));
+				event.stage = static_cast<ysu::block_tracer::stage> (slot.stage.load (std::memory_order_relaxed));
+				event.thread = buffer->thread;
+				std::atomic_thread_fence (std::memory_order_acquire);
+				// Discard the event if the writer wrapped around while it was being copied
+				if (slot.sequence.load (std::memory_order_relaxed) == sequence)
+				{
+					result.push_back (event);
+				}
+			}
+		}
+	}
+	return result;
+}
+
+std::string ysu::block_tracer::export_json ()
+{
+	std::map<ysu::block_hash, std::vector<ysu::block_tracer::event>> blocks;
+	for (auto const & event : events ())
+	{
+		blocks[event.hash].push_back (event);
+	}
+	std::vector<std::pair<unsigned, std::string>> threads;
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		for (auto const & buffer : buffers)
+		{
+			threads.emplace_back (buffer.second->thread, buffer.second->thread_name);
+		}
+	}
+	std::ostringstream stream;
+	auto first (true);
+	auto separator = [&first, &stream]() {
+		stream << (first ? "\n" : ",\n");
+		first = false;
+	};
+	auto micros = [](std::chrono::nanoseconds time_a) {
+		return boost::str (boost::format ("%1%.%|2$03|") % (time_a.count () / 1000) % (time_a.count () % 1000));
+	};
+	auto async_event = [&](char const * name_a, char phase_a, ysu::block_tracer::event const & event_a) {
+		separator ();
+		stream << boost::format (R"({"name":"%1%","cat":"block","ph":"%2%","id":"%3%","ts":%4%,"pid":1,"tid":%5%})") % name_a % phase_a % event_a.hash.to_string () % micros (event_a.time) % event_a.thread;
+	};
+	stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+	for (auto const & thread : threads)
+	{
+		separator ();
+		stream << boost::format (R"({"name":"thread_name","ph":"M","pid":1,"tid":%1%,"args":{"name":"%2%"}})") % thread.first % thread.second;
+	}
+	for (auto & block : blocks)
+	{
+		auto & events_l (block.second);
+		std::stable_sort (events_l.begin (), events_l.end (), [](ysu::block_tracer::event const & lhs, ysu::block_tracer::event const & rhs) {
+			return lhs.time < rhs.time;
+		});
+		// The whole lifecycle, with a nested slice for the time taken to reach each following stage
+		async_event ("block", 'b', events_l.front ());
+		async_event (stage_name (events_l.front ().stage), 'n', events_l.front ());
+		for (auto i (events_l.begin () + 1), n (events_l.end ()); i != n; ++i)
+		{
+			auto begin (*i);
+			begin.time = (i - 1)->time;
+			begin.thread = (i - 1)->thread;
+			async_event (stage_name (i->stage), 'b', begin);
+			async_event (stage_name (i->stage), 'e', *i);
+		}
+		async_event ("block", 'e', events_l.back ());
+	}
+	stream << "\n]}\n";
+	return stream.str ();
+}
+
+void ysu::block_tracer::clear ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	for (auto const & buffer : buffers)
+	{
+		buffer.second->tail.store (buffer.second->head.load ());
+	}
+}
+
+size_t ysu::block_tracer::size ()
+{
+	size_t result (0);
+	ysu::lock_guard<std::mutex> guard (mutex);
+	for (auto const & buffer : buffers)
+	{
+		auto head (buffer.second->head.load ());
+		result += std::min<uint64_t> (head - buffer.second->tail.load (), buffer.second->slots.size ());
+	}
+	return result;
+}
+
+char const * ysu::block_tracer::stage_name (ysu::block_tracer::stage stage_a)
+{
+	switch (stage_a)
+	{
+		case ysu::block_tracer::stage::arrival:
+			return "arrival";
+		case ysu::block_tracer::stage::queued:
+			return "queued";
+		case ysu::block_tracer::stage::processed:
+			return "processed";
+		case ysu::block_tracer::stage::election_started:
+			return "election_started";
+		case ysu::block_tracer::stage::first_vote:
+			return "first_vote";
+		case ysu::block_tracer::stage::confirmed:
+			return "confirmed";
+		case ysu::block_tracer::stage::cemented:
+			return "cemented";
+	}
+	return "unknown";
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (block_tracer & block_tracer, const std::string & name)
+{
+	size_t buffers_count;
+	{
+		ysu::lock_guard<std::mutex> guard (block_tracer.mutex);
+		buffers_count = block_tracer.buffers.size ();
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "buffers", buffers_count, block_tracer.buffer_size * sizeof (ysu::block_tracer::slot) }));
+	return composite;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <ysu/lib/numbers.hpp>
+#include <ysu/lib/utility.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ysu
+{
+class block_tracing_config;
+
+/**
+ * Records when a sample of blocks pass the stages between arriving at the node and being cemented.
+ *
+ * Blocks are sampled by hash, so every stage of a sampled block is recorded no matter which thread reaches it.
+ * Each thread appends to its own fixed size ring of events without taking a lock; readers detect slots that
+ * were overwritten while being copied. The events are exported in the Chrome trace-event format, which can be
+ * loaded in chrome://tracing or Perfetto, as one async track per block with a slice per stage.
+ */
+class block_tracer final
+{
+public:
+	enum class stage : uint8_t
+	{
+		arrival,
+		queued,
+		processed,
+		election_started,
+		first_vote,
+		confirmed,
+		cemented
+	};
+
+	explicit block_tracer (ysu::block_tracing_config const &);
+	bool enabled () const
+	{
+		return enabled_m;
+	}
+	bool sampled (ysu::block_hash const &) const;
+	/** Records that a block reached \p stage_a if it is part of the sample */
+	void trace (ysu::block_hash const &, ysu::block_tracer::stage stage_a);
+	/** All buffered events as a trace-event JSON document */
+	std::string export_json ();
+	/** Discards buffered events */
+	void clear ();
+	/** Number of buffered events */
+	size_t size ();
+	static char const * stage_name (ysu::block_tracer::stage);
+
+	class event final
+	{
+	public:
+		ysu::block_hash hash;
+		ysu::block_tracer::stage stage;
+		std::chrono::nanoseconds time;
+		unsigned thread;
+	};
+	std::vector<ysu::block_tracer::event> events ();
+
+private:
+	class slot final
+	{
+	public:
+		/** Index of the event plus one, zero while being written */
+		std::atomic<uint64_t> sequence{ 0 };
+		std::array<std::atomic<uint64_t>, 4> hash;
+		std::atomic<uint64_t> time{ 0 };
+		std::atomic<uint8_t> stage{ 0 };
+	};
+	class buffer final
+	{
+	public:
+		buffer (size_t, unsigned, std::string const &);
+		std::vector<ysu::block_tracer::slot> slots;
+		std::atomic<uint64_t> head{ 0 };
+		/** Events before this index were cleared */
+		std::atomic<uint64_t> tail{ 0 };
+		unsigned thread;
+		std::string thread_name;
+	};
+	ysu::block_tracer::buffer & local_buffer ();
+
+	bool const enabled_m;
+	uint64_t const sample_rate;
+	size_t const buffer_size;
+	/** Distinguishes tracers in the thread local buffer cache */
+	uint64_t const id;
+	std::chrono::steady_clock::time_point const start;
+	std::mutex mutex;
+	std::unordered_map<std::thread::id, std::shared_ptr<ysu::block_tracer::buffer>> buffers;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (block_tracer &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (block_tracer & block_tracer, const std::string & name);
+}
@@ -32,7 +32,7 @@ state_block_signature_verification (node.checker, node.ledger.network_params.led
 		{
 			{
 				// Prevent a race with condition.wait in block_processor::flush
-				ysu::lock_guard<std::mutex> guard (this->mutex);
+				ysu::lock_guard<ysu::mutex> guard (this->mutex);
 			}
 			this->condition.notify_all ();
 		}
@@ -47,7 +47,7 @@ ysu::block_processor::~block_processor ()
 void ysu::block_processor::stop ()
 {
 	{
-		ysu::lock_guard<std::mutex> lock (mutex);
+		ysu::lock_guard<ysu::mutex> lock (mutex);
 		stopped = true;
 	}
 	condition.notify_all ();
@@ -58,7 +58,7 @@ void ysu::block_processor::flush ()
 {
 	node.checker.flush ();
 	flushing = true;
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	while (!stopped && (have_blocks () || active || state_block_signature_verification.is_active ()))
 	{
 		condition.wait (lock);
@@ -68,7 +68,7 @@ void ysu::block_processor::flush ()
 
 size_t ysu::block_processor::size ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	return (blocks.size () + state_block_signature_verification.size () + forced.size ());
 }
 
@@ -91,6 +91,10 @@ void ysu::block_processor::add (std::shared_ptr<ysu::block> block_a, uint64_t or
 void ysu::block_processor::add (ysu::unchecked_info const & info_a, const bool push_front_preference_a)
 {
 	debug_assert (!ysu::work_validate_entry (*info_a.block));
+	if (node.block_tracer.enabled ())
+	{
+		node.block_tracer.trace (info_a.block->hash (), ysu::block_tracer::stage::queued);
+	}
 	bool quarter_full (size () > node.flags.block_processor_full_size / 4);
 	if (info_a.verified == ysu::signature_verification::unknown && (info_a.block->type () == ysu::block_type::state || info_a.block->type () == ysu::block_type::open || !info_a.account.is_zero ()))
 	{
@@ -102,7 +106,7 @@ void ysu::block_processor::add (ysu::unchecked_info const & info_a, const bool p
 		It's designed to help with realtime blocks traffic if block processor is not performing large task like bootstrap.
 		If deque is a quarter full then push back to allow other blocks processing. */
 		{
-			ysu::lock_guard<std::mutex> guard (mutex);
+			ysu::lock_guard<ysu::mutex> guard (mutex);
 			blocks.push_front (info_a);
 		}
 		condition.notify_all ();
@@ -110,7 +114,7 @@ void ysu::block_processor::add (ysu::unchecked_info const & info_a, const bool p
 	else
 	{
 		{
-			ysu::lock_guard<std::mutex> guard (mutex);
+			ysu::lock_guard<ysu::mutex> guard (mutex);
 			blocks.push_back (info_a);
 		}
 		condition.notify_all ();
@@ -120,7 +124,7 @@ void ysu::block_processor::add (ysu::unchecked_info const & info_a, const bool p
 void ysu::block_processor::force (std::shared_ptr<ysu::block> block_a)
 {
 	{
-		ysu::lock_guard<std::mutex> lock (mutex);
+		ysu::lock_guard<ysu::mutex> lock (mutex);
 		forced.push_back (block_a);
 	}
 	condition.notify_all ();
@@ -128,13 +132,13 @@ void ysu::block_processor::force (std::shared_ptr<ysu::block> block_a)
 
 void ysu::block_processor::wait_write ()
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	awaiting_write = true;
 }
 
 void ysu::block_processor::process_blocks ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	while (!stopped)
 	{
 		if (!blocks.empty () || !forced.empty ())
@@ -174,7 +178,7 @@ bool ysu::block_processor::have_blocks ()
 void ysu::block_processor::process_verified_state_blocks (std::deque<ysu::unchecked_info> & items, std::vector<int> const & verifications, std::vector<ysu::block_hash> const & hashes, std::vector<ysu::signature> const & blocks_signatures)
 {
 	{
-		ysu::unique_lock<std::mutex> lk (mutex);
+		ysu::unique_lock<ysu::mutex> lk (mutex);
 		for (auto i (0); i < verifications.size (); ++i)
 		{
 			debug_assert (verifications[i] == 1 || verifications[i] == 0);
@@ -210,11 +214,11 @@ void ysu::block_processor::process_verified_state_blocks (std::deque<ysu::unchec
 	condition.notify_all ();
 }
 
-void ysu::block_processor::process_batch (ysu::unique_lock<std::mutex> & lock_a)
+void ysu::block_processor::process_batch (ysu::unique_lock<ysu::mutex> & lock_a)
 {
 	auto scoped_write_guard = write_database_queue.wait (ysu::writer::process_batch);
 	block_post_events post_events;
-	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::unchecked }, { tables::confirmation_height }));
+	auto transaction (node.store.tx_begin_write ({ tables::account_balance, tables::account_height, tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::pending_summary, tables::unchecked, tables::unchecked_time }, { tables::confirmation_height }));
 	ysu::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
@@ -331,6 +335,7 @@ ysu::process_return ysu::block_processor::process_one (ysu::write_transaction co
 		case ysu::process_result::progress:
 		{
 			release_assert (info_a.account.is_zero () || info_a.account == node.store.block_account_calculated (*block));
+			node.block_tracer.trace (hash, ysu::block_tracer::stage::processed);
 			if (node.config.logging.ledger_logging ())
 			{
 				std::string block_string;
@@ -357,9 +362,15 @@ ysu::process_return ysu::block_processor::process_one (ysu::write_transaction co
 			}
 
 			ysu::unchecked_key unchecked_key (block->previous (), hash);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			// Blocks seen again while still waiting for their previous block are not a new signal for ascending bootstrap
+			auto account (node.flags.enable_ascending_bootstrap && !node.store.unchecked_exists (transaction_a, unchecked_key) ? (info_a.account.is_zero () ? block->account () : info_a.account) : ysu::account (0));
+			node.ledger.unchecked_put (transaction_a, unchecked_key, info_a);
 			node.gap_cache.add (hash);
 			node.stats.inc (ysu::stat::type::ledger, ysu::stat::detail::gap_previous);
+			if (!account.is_zero ())
+			{
+				node.bootstrap_initiator.ascending_prioritize (account);
+			}
 			break;
 		}
 		case ysu::process_result::gap_source:
@@ -375,7 +386,7 @@ ysu::process_return ysu::block_processor::process_one (ysu::write_transaction co
 			}
 
 			ysu::unchecked_key unchecked_key (node.ledger.block_source (transaction_a, *(block)), hash);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			node.ledger.unchecked_put (transaction_a, unchecked_key, info_a);
 			node.gap_cache.add (hash);
 			node.stats.inc (ysu::stat::type::ledger, ysu::stat::detail::gap_source);
 			break;
@@ -493,7 +504,7 @@ void ysu::block_processor::queue_unchecked (ysu::write_transaction const & trans
 	{
 		if (!node.flags.disable_block_processor_unchecked_deletion)
 		{
-			node.store.unchecked_del (transaction_a, ysu::unchecked_key (hash_a, info.block->hash ()));
+			node.ledger.unchecked_del (transaction_a, ysu::unchecked_key (hash_a, info.block->hash ()));
 		}
 		add (info, true);
 	}
@@ -512,7 +523,7 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (bloc
 	size_t forced_count;
 
 	{
-		ysu::lock_guard<std::mutex> guard (block_processor.mutex);
+		ysu::lock_guard<ysu::mutex> guard (block_processor.mutex);
 		blocks_count = block_processor.blocks.size ();
 		forced_count = block_processor.forced.size ();
 	}
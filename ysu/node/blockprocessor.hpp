@@ -63,7 +63,7 @@ public:
 
 private:
 	void queue_unchecked (ysu::write_transaction const &, ysu::block_hash const &);
-	void process_batch (ysu::unique_lock<std::mutex> &);
+	void process_batch (ysu::unique_lock<ysu::mutex> &);
 	void process_live (ysu::block_hash const &, std::shared_ptr<ysu::block>, ysu::process_return const &, const bool = false, ysu::block_origin const = ysu::block_origin::remote);
 	void process_old (ysu::write_transaction const &, std::shared_ptr<ysu::block> const &, ysu::block_origin const);
 	void requeue_invalid (ysu::block_hash const &, ysu::unchecked_info const &);
@@ -77,7 +77,7 @@ private:
 	ysu::condition_variable condition;
 	ysu::node & node;
 	ysu::write_database_queue & write_database_queue;
-	std::mutex mutex;
+	ysu::mutex mutex{ "block_processor" };
 	ysu::state_block_signature_verification state_block_signature_verification;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (block_processor & block_processor, const std::string & name);
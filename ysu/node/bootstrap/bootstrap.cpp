@@ -1,5 +1,6 @@
 #include <ysu/lib/threading.hpp>
 #include <ysu/node/bootstrap/bootstrap.hpp>
+#include <ysu/node/bootstrap/bootstrap_ascending.hpp>
 #include <ysu/node/bootstrap/bootstrap_attempt.hpp>
 #include <ysu/node/bootstrap/bootstrap_lazy.hpp>
 #include <ysu/node/common.hpp>
@@ -130,6 +131,46 @@ void ysu::bootstrap_initiator::bootstrap_wallet (std::deque<ysu::account> & acco
 	condition.notify_all ();
 }
 
+void ysu::bootstrap_initiator::bootstrap_ascending (std::string id_a)
+{
+	{
+		ysu::lock_guard<std::mutex> lock (mutex);
+		if (!stopped && find_attempt (ysu::bootstrap_mode::ascending) == nullptr)
+		{
+			node.stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::initiate_ascending, ysu::stat::dir::out);
+			auto ascending_attempt (std::make_shared<ysu::bootstrap_attempt_ascending> (node.shared (), attempts.incremental++, id_a));
+			attempts_list.push_back (ascending_attempt);
+			attempts.add (ascending_attempt);
+		}
+	}
+	ascending_starting = false;
+	condition.notify_all ();
+}
+
+void ysu::bootstrap_initiator::ascending_prioritize (ysu::account const & account_a, double priority_a)
+{
+	if (node.flags.enable_ascending_bootstrap && !stopped)
+	{
+		ascending_accounts.prioritize (account_a, priority_a);
+		auto attempt (current_ascending_attempt ());
+		// Called while processing blocks, so the attempt is created in the background
+		if (attempt == nullptr && !ascending_starting.exchange (true))
+		{
+			std::weak_ptr<ysu::node> node_w (node.shared ());
+			node.background ([node_w]() {
+				if (auto node_l = node_w.lock ())
+				{
+					node_l->bootstrap_initiator.bootstrap_ascending ();
+				}
+			});
+		}
+		else if (attempt != nullptr)
+		{
+			attempt->condition.notify_all ();
+		}
+	}
+}
+
 void ysu::bootstrap_initiator::run_bootstrap ()
 {
 	ysu::unique_lock<std::mutex> lock (mutex);
@@ -242,6 +283,12 @@ std::shared_ptr<ysu::bootstrap_attempt> ysu::bootstrap_initiator::current_wallet
 	return find_attempt (ysu::bootstrap_mode::wallet_lazy);
 }
 
+std::shared_ptr<ysu::bootstrap_attempt> ysu::bootstrap_initiator::current_ascending_attempt ()
+{
+	ysu::lock_guard<std::mutex> lock (mutex);
+	return find_attempt (ysu::bootstrap_mode::ascending);
+}
+
 void ysu::bootstrap_initiator::stop_attempts ()
 {
 	ysu::unique_lock<std::mutex> lock (mutex);
@@ -300,9 +347,54 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (boot
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "observers", count, sizeof_element }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pulls_cache", cache_count, sizeof_cache_element }));
+	composite->add_component (collect_container_info (bootstrap_initiator.connections->peer_scores, "peer_scores"));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "ascending_accounts", bootstrap_initiator.ascending_accounts.size (), sizeof (ysu::account_priorities::item) }));
 	return composite;
 }
 
+void ysu::account_priorities::prioritize (ysu::account const & account_a, double priority_a)
+{
+	ysu::lock_guard<std::mutex> lock (mutex);
+	auto & accounts_by_account (accounts.get<account_tag> ());
+	auto existing (accounts_by_account.find (account_a));
+	if (existing != accounts_by_account.end ())
+	{
+		accounts_by_account.modify (existing, [priority_a](ysu::account_priorities::item & item_a) {
+			item_a.priority = std::min (item_a.priority + priority_a, priority_max);
+		});
+	}
+	else
+	{
+		accounts.get<account_tag> ().insert ({ account_a, std::min (priority_a, priority_max) });
+		if (accounts.size () > size_max)
+		{
+			// Evict the least wanted account
+			accounts.get<priority_tag> ().erase (std::prev (accounts.get<priority_tag> ().end ()));
+		}
+	}
+}
+
+bool ysu::account_priorities::pop (ysu::account & account_a, double & priority_a)
+{
+	ysu::lock_guard<std::mutex> lock (mutex);
+	auto result (!accounts.empty ());
+	if (result)
+	{
+		auto & accounts_by_priority (accounts.get<priority_tag> ());
+		auto first (accounts_by_priority.begin ());
+		account_a = first->account;
+		priority_a = first->priority;
+		accounts_by_priority.erase (first);
+	}
+	return result;
+}
+
+size_t ysu::account_priorities::size ()
+{
+	ysu::lock_guard<std::mutex> lock (mutex);
+	return accounts.size ();
+}
+
 void ysu::pulls_cache::add (ysu::pull_info const & pull_a)
 {
 	if (pull_a.processed > 500)
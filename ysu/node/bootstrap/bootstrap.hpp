@@ -27,7 +27,8 @@ enum class bootstrap_mode
 {
 	legacy,
 	lazy,
-	wallet_lazy
+	wallet_lazy,
+	ascending
 };
 enum class sync_result
 {
@@ -63,6 +64,41 @@ public:
 	// clang-format on
 	constexpr static size_t cache_size_max = 10000;
 };
+/** Accounts with missing dependencies, ordered by how urgently their blocks are needed */
+class account_priorities final
+{
+public:
+	/** Adds to the priority of an account, inserting it if needed */
+	void prioritize (ysu::account const &, double);
+	/** Removes the highest priority account, returns false if there is none */
+	bool pop (ysu::account &, double &);
+	size_t size ();
+	class item final
+	{
+	public:
+		ysu::account account;
+		double priority;
+	};
+	class account_tag
+	{
+	};
+	class priority_tag
+	{
+	};
+	std::mutex mutex;
+	// clang-format off
+	boost::multi_index_container<item,
+	mi::indexed_by<
+		mi::ordered_non_unique<mi::tag<priority_tag>,
+			mi::member<item, double, &item::priority>,
+			std::greater<double>>,
+		mi::hashed_unique<mi::tag<account_tag>,
+			mi::member<item, ysu::account, &item::account>>>>
+	accounts;
+	// clang-format on
+	constexpr static size_t size_max = 256 * 1024;
+	constexpr static double priority_max = 64.0;
+};
 class bootstrap_attempts final
 {
 public:
@@ -85,6 +121,9 @@ public:
 	void bootstrap (bool force = false, std::string id_a = "");
 	void bootstrap_lazy (ysu::hash_or_account const &, bool force = false, bool confirmed = true, std::string id_a = "");
 	void bootstrap_wallet (std::deque<ysu::account> &);
+	void bootstrap_ascending (std::string id_a = "");
+	/** Raises the priority of an account for ascending bootstrap, starting an attempt if none is running */
+	void ascending_prioritize (ysu::account const &, double = 1.0);
 	void run_bootstrap ();
 	void lazy_requeue (ysu::block_hash const &, ysu::block_hash const &, bool);
 	void notify_listeners (bool);
@@ -96,8 +135,10 @@ public:
 	std::shared_ptr<ysu::bootstrap_attempt> current_attempt ();
 	std::shared_ptr<ysu::bootstrap_attempt> current_lazy_attempt ();
 	std::shared_ptr<ysu::bootstrap_attempt> current_wallet_attempt ();
+	std::shared_ptr<ysu::bootstrap_attempt> current_ascending_attempt ();
 	ysu::pulls_cache cache;
 	ysu::bootstrap_attempts attempts;
+	ysu::account_priorities ascending_accounts;
 	void stop ();
 
 private:
@@ -107,6 +148,7 @@ private:
 	void stop_attempts ();
 	std::vector<std::shared_ptr<ysu::bootstrap_attempt>> attempts_list;
 	std::atomic<bool> stopped{ false };
+	std::atomic<bool> ascending_starting{ false };
 	std::mutex mutex;
 	ysu::condition_variable condition;
 	std::mutex observers_mutex;
@@ -127,6 +169,10 @@ public:
 	static constexpr double bootstrap_minimum_frontier_blocks_per_sec = 1000.0;
 	static constexpr double bootstrap_minimum_termination_time_sec = 30.0;
 	static constexpr unsigned bootstrap_max_new_connections = 32;
+	/** Number of peers drawn for every new connection, of which the best scored one is connected to */
+	static constexpr unsigned bootstrap_peer_candidates = 3;
+	/** Lower bound for scaling down the connection target while the block processor can't keep up */
+	static constexpr double bootstrap_pool_scale_min = 0.25;
 	static constexpr size_t bootstrap_max_confirm_frontiers = 70;
 	static constexpr double required_frontier_confirmation_ratio = 0.8;
 	static constexpr unsigned frontier_confirmation_blocks_limit = 128 * 1024;
@@ -134,10 +180,21 @@ public:
 	static constexpr unsigned requeued_pulls_limit_dev = 1;
 	static constexpr unsigned requeued_pulls_processed_blocks_factor = 4096;
 	static constexpr unsigned bulk_push_cost_limit = 200;
+	/** Pulls of the same attempt requested at once over a connection */
+	static constexpr size_t bulk_pull_pipeline_depth = 4;
+	/** Frontier requests for less than 1/2^depth of the account space aren't split further */
+	static constexpr unsigned frontier_range_split_depth = 16;
 	static constexpr std::chrono::seconds lazy_flush_delay_sec = std::chrono::seconds (5);
 	static constexpr unsigned lazy_destinations_request_limit = 256 * 1024;
 	static constexpr uint64_t lazy_batch_pull_count_resize_blocks_limit = 4 * 1024 * 1024;
 	static constexpr double lazy_batch_pull_count_resize_ratio = 2.0;
 	static constexpr size_t lazy_blocks_restart_limit = 1024 * 1024;
+	/** Blocks requested by each ascending pull, kept small so that they can be processed as soon as they arrive */
+	static constexpr uint32_t ascending_pull_count = 128;
+	/** Accounts whose pulls keep failing are dropped once their priority falls below this */
+	static constexpr double ascending_priority_min = 0.25;
+	static constexpr size_t ascending_unchecked_seed_max = 64 * 1024;
+	/** Ascending attempts exit after having nothing to pull for this long */
+	static constexpr std::chrono::seconds ascending_idle_timeout = std::chrono::seconds (30);
 };
 }
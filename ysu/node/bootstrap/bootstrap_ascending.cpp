@@ -0,0 +1,158 @@
+#include <ysu/node/bootstrap/bootstrap_ascending.hpp>
+#include <ysu/node/bootstrap/bootstrap_connections.hpp>
+#include <ysu/node/node.hpp>
+
+#include <boost/format.hpp>
+
+constexpr uint32_t ysu::bootstrap_limits::ascending_pull_count;
+constexpr double ysu::bootstrap_limits::ascending_priority_min;
+constexpr size_t ysu::bootstrap_limits::ascending_unchecked_seed_max;
+constexpr std::chrono::seconds ysu::bootstrap_limits::ascending_idle_timeout;
+
+ysu::bootstrap_attempt_ascending::bootstrap_attempt_ascending (std::shared_ptr<ysu::node> node_a, uint64_t incremental_id_a, std::string id_a) :
+ysu::bootstrap_attempt (node_a, ysu::bootstrap_mode::ascending, incremental_id_a, id_a)
+{
+}
+
+ysu::bootstrap_attempt_ascending::~bootstrap_attempt_ascending ()
+{
+}
+
+void ysu::bootstrap_attempt_ascending::run ()
+{
+	debug_assert (started);
+	node->bootstrap_initiator.connections->populate_connections (false);
+	seed_unchecked ();
+	auto idle_since (std::chrono::steady_clock::now ());
+	ysu::unique_lock<std::mutex> lock (mutex);
+	while (!stopped)
+	{
+		ysu::account account (0);
+		double priority (0);
+		// Leave room in the block processor, blocks of an account are only useful once the previous batch is processed
+		if (pulling < node->config.bootstrap_connections_max && !node->block_processor.half_full () && node->bootstrap_initiator.ascending_accounts.pop (account, priority))
+		{
+			request (account, priority);
+			idle_since = std::chrono::steady_clock::now ();
+		}
+		else if (pulling == 0 && std::chrono::steady_clock::now () - idle_since > ysu::bootstrap_limits::ascending_idle_timeout)
+		{
+			break;
+		}
+		else
+		{
+			if (pulling != 0)
+			{
+				idle_since = std::chrono::steady_clock::now ();
+			}
+			condition.wait_for (lock, std::chrono::milliseconds (100));
+		}
+	}
+	if (!stopped)
+	{
+		node->logger.try_log (boost::str (boost::format ("Completed ascending pulls for %1% accounts") % accounts_completed));
+	}
+	lock.unlock ();
+	stop ();
+	condition.notify_all ();
+}
+
+void ysu::bootstrap_attempt_ascending::request (ysu::account const & account_a, double priority_a)
+{
+	debug_assert (!mutex.try_lock ());
+	auto existing (in_flight.find (account_a));
+	if (existing != in_flight.end ())
+	{
+		// Blocks keep arriving for an account already being pulled, retry it with the combined priority afterwards
+		existing->second += priority_a;
+	}
+	else
+	{
+		ysu::block_hash head (0);
+		auto continuation (continuations.find (account_a));
+		if (continuation != continuations.end ())
+		{
+			head = continuation->second;
+		}
+		else
+		{
+			ysu::account_info info;
+			if (!node->store.account_get (node->store.tx_begin_read (), account_a, info))
+			{
+				head = info.head;
+			}
+		}
+		in_flight.emplace (account_a, 0.0);
+		ysu::pull_info pull (account_a, head, ysu::block_hash (0), incremental_id, ysu::bootstrap_limits::ascending_pull_count);
+		pull.ascending = true;
+		++pulling;
+		node->bootstrap_initiator.connections->add_pull (pull);
+	}
+}
+
+void ysu::bootstrap_attempt_ascending::ascending_pull_finished (ysu::account const & account_a, ysu::block_hash const & last_a, uint64_t blocks_a, bool error_a)
+{
+	auto & priorities (node->bootstrap_initiator.ascending_accounts);
+	ysu::lock_guard<std::mutex> lock (mutex);
+	auto existing (in_flight.find (account_a));
+	auto priority (existing != in_flight.end () ? existing->second : 0.0);
+	if (existing != in_flight.end ())
+	{
+		in_flight.erase (existing);
+	}
+	if (error_a)
+	{
+		++failed_pulls;
+		// Retry through another peer, dropping accounts no peer seems able to serve
+		auto retry_priority ((priority + 1.0) / 2);
+		if (retry_priority >= ysu::bootstrap_limits::ascending_priority_min)
+		{
+			priorities.prioritize (account_a, retry_priority);
+		}
+	}
+	else if (blocks_a >= ysu::bootstrap_limits::ascending_pull_count)
+	{
+		// The peer has more blocks for this account, continue from the last one received
+		continuations[account_a] = last_a;
+		priorities.prioritize (account_a, priority + 1.0);
+	}
+	else
+	{
+		continuations.erase (account_a);
+		++accounts_completed;
+		if (priority > 0)
+		{
+			priorities.prioritize (account_a, priority);
+		}
+	}
+}
+
+void ysu::bootstrap_attempt_ascending::seed_unchecked ()
+{
+	size_t count (0);
+	auto transaction (node->store.tx_begin_read ());
+	for (auto i (node->store.unchecked_begin (transaction)), n (node->store.unchecked_end ()); i != n && count < ysu::bootstrap_limits::ascending_unchecked_seed_max && !stopped; ++i, ++count)
+	{
+		ysu::unchecked_key const & key (i->first);
+		ysu::unchecked_info const & info (i->second);
+		// Only gaps in the previous block identify the account, missing sources could belong to any account
+		if (info.block != nullptr && info.block->previous () == key.previous && !node->store.block_exists (transaction, key.previous))
+		{
+			auto account (info.account.is_zero () ? info.block->account () : info.account);
+			if (!account.is_zero ())
+			{
+				node->bootstrap_initiator.ascending_accounts.prioritize (account, 1.0);
+			}
+		}
+	}
+}
+
+void ysu::bootstrap_attempt_ascending::get_information (boost::property_tree::ptree & tree_a)
+{
+	ysu::lock_guard<std::mutex> lock (mutex);
+	tree_a.put ("accounts", std::to_string (node->bootstrap_initiator.ascending_accounts.size ()));
+	tree_a.put ("pulling_accounts", std::to_string (in_flight.size ()));
+	tree_a.put ("continuations", std::to_string (continuations.size ()));
+	tree_a.put ("accounts_completed", std::to_string (accounts_completed));
+	tree_a.put ("failed_pulls", std::to_string (failed_pulls));
+}
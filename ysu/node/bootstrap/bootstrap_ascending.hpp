@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ysu/node/bootstrap/bootstrap_attempt.hpp>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace ysu
+{
+class node;
+/**
+ * Bootstrap driven by the accounts the node is known to be missing blocks for.
+ *
+ * Accounts are taken from ysu::bootstrap_initiator::ascending_accounts in priority order and pulled from their
+ * last known block upwards in small batches, so each block received can be processed straight away instead of
+ * waiting in unchecked for its predecessors. Pulls are spread over all available peers and accounts with more
+ * blocks to pull are rescheduled after each batch.
+ */
+class bootstrap_attempt_ascending final : public bootstrap_attempt
+{
+public:
+	explicit bootstrap_attempt_ascending (std::shared_ptr<ysu::node> node_a, uint64_t incremental_id_a, std::string id_a = "");
+	~bootstrap_attempt_ascending ();
+	void run () override;
+	void ascending_pull_finished (ysu::account const &, ysu::block_hash const &, uint64_t, bool) override;
+	void get_information (boost::property_tree::ptree &) override;
+	/** Prioritizes the accounts of unchecked blocks which are waiting for their previous block */
+	void seed_unchecked ();
+
+private:
+	void request (ysu::account const &, double);
+	/** Accounts with a pull in flight, mapped to the priority they gathered while it was running */
+	std::unordered_map<ysu::account, double> in_flight;
+	/** Last block pulled for accounts whose previous pull stopped at the count limit */
+	std::unordered_map<ysu::account, ysu::block_hash> continuations;
+	std::atomic<uint64_t> accounts_completed{ 0 };
+	std::atomic<uint64_t> failed_pulls{ 0 };
+};
+}
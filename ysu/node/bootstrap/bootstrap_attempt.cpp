@@ -17,6 +17,7 @@ constexpr double ysu::bootstrap_limits::required_frontier_confirmation_ratio;
 constexpr unsigned ysu::bootstrap_limits::frontier_confirmation_blocks_limit;
 constexpr unsigned ysu::bootstrap_limits::requeued_pulls_limit;
 constexpr unsigned ysu::bootstrap_limits::requeued_pulls_limit_dev;
+constexpr unsigned ysu::bootstrap_limits::frontier_range_split_depth;
 
 ysu::bootstrap_attempt::bootstrap_attempt (std::shared_ptr<ysu::node> node_a, ysu::bootstrap_mode mode_a, uint64_t incremental_id_a, std::string id_a) :
 node (node_a),
@@ -113,6 +114,10 @@ std::string ysu::bootstrap_attempt::mode_text ()
 	{
 		mode_text = "wallet_lazy";
 	}
+	else if (mode == ysu::bootstrap_mode::ascending)
+	{
+		mode_text = "ascending";
+	}
 	return mode_text;
 }
 
@@ -198,6 +203,11 @@ size_t ysu::bootstrap_attempt::wallet_size ()
 	return 0;
 }
 
+void ysu::bootstrap_attempt::ascending_pull_finished (ysu::account const &, ysu::block_hash const &, uint64_t, bool)
+{
+	debug_assert (mode == ysu::bootstrap_mode::ascending);
+}
+
 ysu::bootstrap_attempt_legacy::bootstrap_attempt_legacy (std::shared_ptr<ysu::node> node_a, uint64_t incremental_id_a, std::string id_a) :
 ysu::bootstrap_attempt (node_a, ysu::bootstrap_mode::legacy, incremental_id_a, id_a)
 {
@@ -225,14 +235,17 @@ void ysu::bootstrap_attempt_legacy::stop ()
 	lock.unlock ();
 	condition.notify_all ();
 	lock.lock ();
-	if (auto i = frontiers.lock ())
+	for (auto const & frontier : frontiers)
 	{
-		try
-		{
-			i->promise.set_value (true);
-		}
-		catch (std::future_error &)
+		if (auto i = frontier.lock ())
 		{
+			try
+			{
+				i->promise.set_value (true);
+			}
+			catch (std::future_error &)
+			{
+			}
 		}
 	}
 	if (auto i = push.lock ())
@@ -252,8 +265,14 @@ void ysu::bootstrap_attempt_legacy::stop ()
 void ysu::bootstrap_attempt_legacy::request_push (ysu::unique_lock<std::mutex> & lock_a)
 {
 	bool error (false);
+	auto endpoints (endpoints_frontier_request);
 	lock_a.unlock ();
-	auto connection_l (node->bootstrap_initiator.connections->find_connection (endpoint_frontier_request));
+	// Push to any of the peers frontiers were requested from
+	std::shared_ptr<ysu::bootstrap_client> connection_l;
+	for (auto i (endpoints.begin ()), n (endpoints.end ()); i != n && connection_l == nullptr; ++i)
+	{
+		connection_l = node->bootstrap_initiator.connections->find_connection (*i);
+	}
 	lock_a.lock ();
 	if (connection_l)
 	{
@@ -335,14 +354,18 @@ void ysu::bootstrap_attempt_legacy::attempt_restart_check (ysu::unique_lock<std:
 		if (!confirmed)
 		{
 			node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::frontier_confirmation_failed, ysu::stat::dir::in);
-			auto score (node->network.excluded_peers.add (endpoint_frontier_request, node->network.size ()));
-			if (score >= ysu::peer_exclusion::score_limit)
+			// Any of the peers frontiers were requested from may have sent the unconfirmed frontiers
+			for (auto const & endpoint_frontier_request : endpoints_frontier_request)
 			{
-				node->logger.always_log (boost::str (boost::format ("Adding peer %1% to excluded peers list with score %2% after %3% seconds bootstrap attempt") % endpoint_frontier_request % score % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - attempt_start).count ()));
-				auto channel = node->network.find_channel (ysu::transport::map_tcp_to_endpoint (endpoint_frontier_request));
-				if (channel != nullptr)
+				auto score (node->network.excluded_peers.add (endpoint_frontier_request, node->network.size ()));
+				if (score >= ysu::peer_exclusion::score_limit)
 				{
-					node->network.erase (*channel);
+					node->logger.always_log (boost::str (boost::format ("Adding peer %1% to excluded peers list with score %2% after %3% seconds bootstrap attempt") % endpoint_frontier_request % score % std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - attempt_start).count ()));
+					auto channel = node->network.find_channel (ysu::transport::map_tcp_to_endpoint (endpoint_frontier_request));
+					if (channel != nullptr)
+					{
+						node->network.erase (*channel);
+					}
 				}
 			}
 			lock_a.unlock ();
@@ -442,7 +465,7 @@ bool ysu::bootstrap_attempt_legacy::confirm_frontiers (ysu::unique_lock<std::mut
 				}
 				else
 				{
-					ysu::unique_lock<std::mutex> active_lock (node->active.mutex);
+					ysu::unique_lock<ysu::mutex> active_lock (node->active.mutex);
 					auto existing (node->active.find_inactive_votes_cache (*ii));
 					active_lock.unlock ();
 					ysu::uint128_t tally;
@@ -497,67 +520,130 @@ bool ysu::bootstrap_attempt_legacy::confirm_frontiers (ysu::unique_lock<std::mut
 	return confirmed;
 }
 
+/*
+ * Requests the frontiers of each pending range of the account space from its own peer. Pulls are
+ * queued whenever a range completes, the unreceived part of a failed range is requested again and
+ * once no ranges are pending, the widest range still being received is split to keep peers busy.
+ * Returns true if some ranges couldn't be requested.
+ */
 bool ysu::bootstrap_attempt_legacy::request_frontier (ysu::unique_lock<std::mutex> & lock_a, bool first_attempt)
 {
-	auto result (true);
-	lock_a.unlock ();
-	auto connection_l (node->bootstrap_initiator.connections->connection (shared_from_this (), first_attempt));
-	lock_a.lock ();
-	if (connection_l && !stopped)
+	std::vector<std::pair<std::shared_ptr<ysu::frontier_req_client>, std::future<bool>>> clients;
+	auto connection_available (true);
+	auto minimum_split (std::numeric_limits<ysu::uint256_t>::max () >> ysu::bootstrap_limits::frontier_range_split_depth);
+	while (!stopped && (!clients.empty () || (!frontier_ranges.empty () && connection_available)))
 	{
-		endpoint_frontier_request = connection_l->channel->get_tcp_endpoint ();
-		std::future<bool> future;
+		while (!stopped && !frontier_ranges.empty () && connection_available)
 		{
-			auto this_l (shared_from_this ());
-			auto client (std::make_shared<ysu::frontier_req_client> (connection_l, this_l));
-			client->run ();
-			frontiers = client;
-			future = client->promise.get_future ();
+			lock_a.unlock ();
+			auto connection_l (node->bootstrap_initiator.connections->connection (shared_from_this (), first_attempt && clients.empty ()));
+			lock_a.lock ();
+			connection_available = connection_l != nullptr;
+			if (connection_available && !stopped)
+			{
+				auto range (frontier_ranges.front ());
+				frontier_ranges.pop_front ();
+				auto endpoint (connection_l->channel->get_tcp_endpoint ());
+				if (std::find (endpoints_frontier_request.begin (), endpoints_frontier_request.end (), endpoint) == endpoints_frontier_request.end ())
+				{
+					endpoints_frontier_request.push_back (endpoint);
+				}
+				auto client (std::make_shared<ysu::frontier_req_client> (connection_l, shared_from_this (), range.first, range.second));
+				frontiers.erase (std::remove_if (frontiers.begin (), frontiers.end (), [](auto const & frontier_a) { return frontier_a.expired (); }), frontiers.end ());
+				frontiers.push_back (client);
+				clients.emplace_back (client, client->promise.get_future ());
+				client->run ();
+			}
 		}
-		lock_a.unlock ();
-		result = consume_future (future); // This is out of scope of `client' so when the last reference via boost::asio::io_context is lost and the client is destroyed, the future throws an exception.
-		lock_a.lock ();
-		if (result)
+		auto ready = [](std::future<bool> const & future_a) {
+			return future_a.wait_for (std::chrono::seconds (0)) == std::future_status::ready;
+		};
+		// Clients notify the condition when they finish, the timeout covers clients destroyed on errors
+		condition.wait_for (lock_a, std::chrono::milliseconds (100), [&clients, &ready, &stopped = stopped] {
+			return stopped || std::any_of (clients.begin (), clients.end (), [&ready](auto const & client_a) { return ready (client_a.second); });
+		});
+		auto completed (false);
+		for (auto i (clients.begin ()); i != clients.end ();)
 		{
-			frontier_pulls.clear ();
-		}
-		else
-		{
-			account_count = ysu::narrow_cast<unsigned int> (frontier_pulls.size ());
-			// Shuffle pulls
-			release_assert (std::numeric_limits<CryptoPP::word32>::max () > frontier_pulls.size ());
-			if (!frontier_pulls.empty ())
+			if (ready (i->second))
 			{
-				for (auto i = static_cast<CryptoPP::word32> (frontier_pulls.size () - 1); i > 0; --i)
+				if (consume_future (i->second))
+				{
+					auto remaining (i->first->remaining ());
+					if (remaining.second.is_zero () || remaining.first < remaining.second)
+					{
+						frontier_ranges.push_front (remaining);
+					}
+					node->stats.inc (ysu::stat::type::error, ysu::stat::detail::frontier_req, ysu::stat::dir::out);
+				}
+				else if (node->config.logging.network_logging ())
 				{
-					auto k = ysu::random_pool::generate_word32 (0, i);
-					std::swap (frontier_pulls[i], frontier_pulls[k]);
+					node->logger.try_log (boost::str (boost::format ("Completed frontier request, %1% out of sync accounts according to %2%") % frontier_pulls.size () % i->first->connection->channel->to_string ()));
 				}
+				i = clients.erase (i);
+				completed = true;
 			}
-			// Add to regular pulls
-			while (!frontier_pulls.empty ())
+			else
 			{
-				auto pull (frontier_pulls.front ());
-				lock_a.unlock ();
-				node->bootstrap_initiator.connections->add_pull (pull);
-				lock_a.lock ();
-				++pulling;
-				frontier_pulls.pop_front ();
+				++i;
 			}
 		}
-		if (node->config.logging.network_logging ())
+		if (completed && stopped)
 		{
-			if (!result)
-			{
-				node->logger.try_log (boost::str (boost::format ("Completed frontier request, %1% out of sync accounts according to %2%") % account_count % connection_l->channel->to_string ()));
-			}
-			else
+			frontier_pulls.clear ();
+		}
+		else if (completed)
+		{
+			connection_available = true;
+			add_frontier_pulls (lock_a);
+			if (frontier_ranges.empty ())
 			{
-				node->stats.inc (ysu::stat::type::error, ysu::stat::detail::frontier_req, ysu::stat::dir::out);
+				std::shared_ptr<ysu::frontier_req_client> widest;
+				ysu::uint256_t widest_span (0);
+				for (auto const & client : clients)
+				{
+					auto remaining (client.first->remaining ());
+					ysu::uint256_t last (remaining.second.is_zero () ? std::numeric_limits<ysu::uint256_t>::max () : remaining.second.number ());
+					if (last > remaining.first.number () && last - remaining.first.number () > widest_span)
+					{
+						widest = client.first;
+						widest_span = last - remaining.first.number ();
+					}
+				}
+				std::pair<ysu::account, ysu::account> range;
+				if (widest != nullptr && !widest->split (minimum_split, range))
+				{
+					frontier_ranges.push_back (range);
+				}
 			}
 		}
 	}
-	return result;
+	return stopped || !frontier_ranges.empty ();
+}
+
+void ysu::bootstrap_attempt_legacy::add_frontier_pulls (ysu::unique_lock<std::mutex> & lock_a)
+{
+	account_count += ysu::narrow_cast<unsigned int> (frontier_pulls.size ());
+	// Shuffle pulls
+	release_assert (std::numeric_limits<CryptoPP::word32>::max () > frontier_pulls.size ());
+	if (!frontier_pulls.empty ())
+	{
+		for (auto i = static_cast<CryptoPP::word32> (frontier_pulls.size () - 1); i > 0; --i)
+		{
+			auto k = ysu::random_pool::generate_word32 (0, i);
+			std::swap (frontier_pulls[i], frontier_pulls[k]);
+		}
+	}
+	// Add to regular pulls
+	while (!frontier_pulls.empty ())
+	{
+		auto pull (frontier_pulls.front ());
+		lock_a.unlock ();
+		node->bootstrap_initiator.connections->add_pull (pull);
+		lock_a.lock ();
+		++pulling;
+		frontier_pulls.pop_front ();
+	}
 }
 
 void ysu::bootstrap_attempt_legacy::run_start (ysu::unique_lock<std::mutex> & lock_a)
@@ -567,6 +653,16 @@ void ysu::bootstrap_attempt_legacy::run_start (ysu::unique_lock<std::mutex> & lo
 	total_blocks = 0;
 	requeued_pulls = 0;
 	recent_pulls_head.clear ();
+	account_count = 0;
+	endpoints_frontier_request.clear ();
+	// Split the account space evenly between the bootstrap connections
+	frontier_ranges.clear ();
+	auto ranges (std::max (node->config.bootstrap_connections, 1u));
+	ysu::uint256_t width (std::numeric_limits<ysu::uint256_t>::max () / ranges);
+	for (auto i (0u); i < ranges; ++i)
+	{
+		frontier_ranges.emplace_back (ysu::account (width * i), i + 1 < ranges ? ysu::account (width * (i + 1)) : ysu::account (0));
+	}
 	auto frontier_failure (true);
 	uint64_t frontier_attempts (0);
 	while (!stopped && frontier_failure)
@@ -621,6 +717,7 @@ void ysu::bootstrap_attempt_legacy::get_information (boost::property_tree::ptree
 {
 	ysu::lock_guard<std::mutex> lock (mutex);
 	tree_a.put ("frontier_pulls", std::to_string (frontier_pulls.size ()));
+	tree_a.put ("frontier_ranges", std::to_string (frontier_ranges.size ()));
 	tree_a.put ("frontiers_received", static_cast<bool> (frontiers_received));
 	tree_a.put ("frontiers_confirmed", static_cast<bool> (frontiers_confirmed));
 	tree_a.put ("frontiers_confirmation_pending", static_cast<bool> (frontiers_confirmation_pending));
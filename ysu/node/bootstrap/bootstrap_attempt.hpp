@@ -38,6 +38,7 @@ public:
 	virtual void requeue_pending (ysu::account const &);
 	virtual void wallet_start (std::deque<ysu::account> &);
 	virtual size_t wallet_size ();
+	virtual void ascending_pull_finished (ysu::account const &, ysu::block_hash const &, uint64_t, bool);
 	virtual void get_information (boost::property_tree::ptree &) = 0;
 	std::mutex next_log_mutex;
 	std::chrono::steady_clock::time_point next_log{ std::chrono::steady_clock::now () };
@@ -75,8 +76,11 @@ public:
 	void attempt_restart_check (ysu::unique_lock<std::mutex> &);
 	bool confirm_frontiers (ysu::unique_lock<std::mutex> &);
 	void get_information (boost::property_tree::ptree &) override;
-	ysu::tcp_endpoint endpoint_frontier_request;
-	std::weak_ptr<ysu::frontier_req_client> frontiers;
+	void add_frontier_pulls (ysu::unique_lock<std::mutex> &);
+	std::vector<ysu::tcp_endpoint> endpoints_frontier_request;
+	/** Parts of the account space, [start, end), whose frontiers are yet to be requested */
+	std::deque<std::pair<ysu::account, ysu::account>> frontier_ranges;
+	std::vector<std::weak_ptr<ysu::frontier_req_client>> frontiers;
 	std::weak_ptr<ysu::bulk_push_client> push;
 	std::deque<ysu::pull_info> frontier_pulls;
 	std::deque<ysu::block_hash> recent_pulls_head;
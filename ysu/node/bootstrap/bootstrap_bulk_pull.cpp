@@ -31,8 +31,23 @@ unexpected_count (0)
 
 ysu::bulk_pull_client::~bulk_pull_client ()
 {
+	if (pull.ascending)
+	{
+		// Ascending pulls are small and are rescheduled by the attempt, which owns the account priorities
+		auto error (network_error || unexpected_count != 0);
+		if (error)
+		{
+			connection->connections->peer_scores.failed (connection->channel->get_tcp_endpoint ());
+		}
+		else if (!cancelled)
+		{
+			connection->connections->peer_scores.succeeded (connection->channel->get_tcp_endpoint ());
+		}
+		// Fallback pulls end at the last known block, so there is nothing to continue from
+		attempt->ascending_pull_finished (pull.account_or_head.as_account (), expected, descending_fallback ? 0 : pull_blocks - unexpected_count, error || cancelled);
+	}
 	// If received end block is not expected end block
-	if (expected != pull.end)
+	else if (expected != pull.end)
 	{
 		pull.head = expected;
 		if (attempt->mode != ysu::bootstrap_mode::legacy)
@@ -40,7 +55,11 @@ ysu::bulk_pull_client::~bulk_pull_client ()
 			pull.account_or_head = expected;
 		}
 		pull.processed += pull_blocks - unexpected_count;
-		connection->node->bootstrap_initiator.connections->requeue_pull (pull, network_error);
+		if (network_error)
+		{
+			connection->connections->peer_scores.failed (connection->channel->get_tcp_endpoint ());
+		}
+		connection->node->bootstrap_initiator.connections->requeue_pull (pull, network_error || cancelled);
 		if (connection->node->config.logging.bulk_pull_logging ())
 		{
 			connection->node->logger.try_log (boost::str (boost::format ("Bulk pull end block is not expected %1% for account %2%") % pull.end.to_string () % pull.account_or_head.to_account ()));
@@ -48,17 +67,34 @@ ysu::bulk_pull_client::~bulk_pull_client ()
 	}
 	else
 	{
+		connection->connections->peer_scores.succeeded (connection->channel->get_tcp_endpoint ());
 		connection->node->bootstrap_initiator.cache.remove (pull);
 	}
 	attempt->pull_finished ();
 }
 
-void ysu::bulk_pull_client::request ()
+ysu::bulk_pull ysu::bulk_pull_client::request ()
 {
 	debug_assert (!pull.head.is_zero () || pull.retry_limit != std::numeric_limits<unsigned>::max ());
 	expected = pull.head;
 	ysu::bulk_pull req;
-	if (pull.head == pull.head_original && pull.attempts % 4 < 3)
+	req.end = pull.end;
+	req.count = pull.count;
+	descending_fallback = pull.ascending && connection->channel->get_network_version () < connection->node->network_params.protocol.bulk_pull_ascending_protocol_version_min;
+	if (descending_fallback)
+	{
+		// Everything from the frontier of the peer down to the last known block of the account
+		req.start = pull.account_or_head;
+		req.end = pull.head;
+		req.count = 0;
+	}
+	else if (pull.ascending)
+	{
+		// Continue from the last known block of the account, or from its open block
+		req.start = pull.head.is_zero () ? pull.account_or_head : pull.head;
+		req.set_ascending (true);
+	}
+	else if (pull.head == pull.head_original && pull.attempts % 4 < 3)
 	{
 		// Account for new pulls
 		req.start = pull.account_or_head;
@@ -68,9 +104,7 @@ void ysu::bulk_pull_client::request ()
 		// Head for cached pulls or accounts with public key equal to existing block hash (25% of attempts)
 		req.start = pull.head;
 	}
-	req.end = pull.end;
-	req.count = pull.count;
-	req.set_count_present (pull.count != 0);
+	req.set_count_present (req.count != 0);
 
 	if (connection->node->config.logging.bulk_pull_logging ())
 	{
@@ -80,31 +114,160 @@ void ysu::bulk_pull_client::request ()
 	{
 		connection->node->logger.always_log (boost::str (boost::format ("%1% accounts in pull queue") % attempt->pulling));
 	}
-	auto this_l (shared_from_this ());
-	connection->channel->send (
-	req, [this_l](boost::system::error_code const & ec, size_t size_a) {
-		if (!ec)
+	return req;
+}
+
+ysu::bulk_pull_client::progress ysu::bulk_pull_client::received_block (std::shared_ptr<ysu::block> const & block_a)
+{
+	auto hash (block_a->hash ());
+	if (connection->node->config.logging.bulk_pull_logging ())
+	{
+		std::string block_l;
+		block_a->serialize_json (block_l, connection->node->config.logging.single_line_record ());
+		connection->node->logger.try_log (boost::str (boost::format ("Pulled block %1% %2%") % hash.to_string () % block_l));
+	}
+	// Is block expected?
+	bool block_expected (false);
+	// Unconfirmed head is used only for lazy destinations if legacy bootstrap is not available, see ysu::bootstrap_attempt::lazy_destinations_increment (...)
+	bool unconfirmed_account_head (connection->node->flags.disable_legacy_bootstrap && pull_blocks == 0 && pull.retry_limit != std::numeric_limits<unsigned>::max () && expected == pull.account_or_head && block_a->account () == pull.account_or_head);
+	if (descending_fallback)
+	{
+		// The frontier of the peer isn't known, the following blocks have to link down from the first one
+		if (pull_blocks == 0 || hash == expected)
 		{
-			this_l->throttled_receive_block ();
+			expected = block_a->previous ();
+			block_expected = true;
 		}
 		else
 		{
-			if (this_l->connection->node->config.logging.bulk_pull_logging ())
+			unexpected_count++;
+		}
+	}
+	else if (pull.ascending)
+	{
+		// Ascending pulls walk forward, each block has to build on the previous one
+		if (block_a->previous () == expected)
+		{
+			expected = hash;
+			block_expected = true;
+		}
+		else
+		{
+			unexpected_count++;
+		}
+	}
+	else if (hash == expected || unconfirmed_account_head)
+	{
+		expected = block_a->previous ();
+		block_expected = true;
+	}
+	else
+	{
+		unexpected_count++;
+	}
+	if (pull_blocks == 0 && block_expected)
+	{
+		known_account = pull.ascending ? pull.account_or_head.as_account () : block_a->account ();
+	}
+	if (connection->block_count++ == 0)
+	{
+		connection->set_start_time (std::chrono::steady_clock::now ());
+	}
+	++connection->connections->blocks_received;
+	attempt->total_blocks++;
+	bool stop_pull (attempt->process_block (block_a, known_account, pull_blocks, pull.count, block_expected, pull.retry_limit));
+	pull_blocks++;
+	auto result (progress::failed);
+	if (!stop_pull && !connection->hard_stop.load ())
+	{
+		/* Process block in lazy pull if not stopped
+		Stop usual pull request with unexpected block & more than 16k blocks processed
+		to prevent spam */
+		if (pull.ascending ? block_expected : (attempt->mode != ysu::bootstrap_mode::legacy || unexpected_count < 16384))
+		{
+			result = progress::more;
+		}
+	}
+	else if (stop_pull && block_expected)
+	{
+		result = progress::done;
+	}
+	return result;
+}
+
+bool ysu::bulk_pull_client::received_end ()
+{
+	// Avoid re-using slow peers, or peers that sent the wrong blocks.
+	return !connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks) || (pull.ascending && unexpected_count == 0));
+}
+
+constexpr size_t ysu::bulk_pull_pipeline::receive_buffer_size;
+
+ysu::bulk_pull_pipeline::bulk_pull_pipeline (std::shared_ptr<ysu::bootstrap_client> connection_a, std::shared_ptr<ysu::bootstrap_attempt> attempt_a, std::deque<std::unique_ptr<ysu::bulk_pull_client>> pulls_a) :
+connection (connection_a),
+attempt (attempt_a),
+pulls (std::move (pulls_a)),
+buffer (std::make_shared<std::vector<uint8_t>> (receive_buffer_size))
+{
+	debug_assert (!pulls.empty ());
+}
+
+void ysu::bulk_pull_pipeline::request ()
+{
+	auto this_l (shared_from_this ());
+	// All requests are built before the first is sent, a failed write clears the pulls
+	std::vector<ysu::bulk_pull> requests;
+	requests.reserve (pulls.size ());
+	for (auto & pull : pulls)
+	{
+		requests.push_back (pull->request ());
+	}
+	auto remaining (requests.size ());
+	for (auto & request : requests)
+	{
+		// Requests are written in order, the responses are read once the last one was sent
+		auto last (--remaining == 0);
+		connection->channel->send (
+		request, [this_l, last](boost::system::error_code const & ec, size_t size_a) {
+			if (!ec)
 			{
-				this_l->connection->node->logger.try_log (boost::str (boost::format ("Error sending bulk pull request to %1%: to %2%") % ec.message () % this_l->connection->channel->to_string ()));
+				if (last)
+				{
+					this_l->throttled_receive ();
+				}
 			}
-			this_l->connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_request_failure, ysu::stat::dir::in);
-		}
-	},
-	ysu::buffer_drop_policy::no_limiter_drop);
+			else
+			{
+				if (this_l->connection->node->config.logging.bulk_pull_logging ())
+				{
+					this_l->connection->node->logger.try_log (boost::str (boost::format ("Error sending bulk pull request to %1%: to %2%") % ec.message () % this_l->connection->channel->to_string ()));
+				}
+				this_l->connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_request_failure, ysu::stat::dir::in);
+				this_l->request_failed ();
+			}
+		},
+		ysu::buffer_drop_policy::no_limiter_drop);
+	}
+}
+
+void ysu::bulk_pull_pipeline::request_failed ()
+{
+	// The peer may have received only part of the requests, so nothing is read from the connection anymore
+	connection->stop (true);
+	connection->socket->close ();
+	// Each pull still waiting is requeued as a network error when it is destroyed
+	for (auto & pull : pulls)
+	{
+		pull->network_error = true;
+	}
+	pulls.clear ();
 }
 
-void ysu::bulk_pull_client::throttled_receive_block ()
+void ysu::bulk_pull_pipeline::throttled_receive ()
 {
-	debug_assert (!network_error);
 	if (!connection->node->block_processor.half_full () && !connection->node->block_processor.flushing)
 	{
-		receive_block ();
+		receive ();
 	}
 	else
 	{
@@ -112,175 +275,167 @@ void ysu::bulk_pull_client::throttled_receive_block ()
 		connection->node->alarm.add (std::chrono::steady_clock::now () + std::chrono::seconds (1), [this_l]() {
 			if (!this_l->connection->pending_stop && !this_l->attempt->stopped)
 			{
-				this_l->throttled_receive_block ();
+				this_l->throttled_receive ();
 			}
 		});
 	}
 }
 
-void ysu::bulk_pull_client::receive_block ()
+void ysu::bulk_pull_pipeline::receive ()
 {
+	if (buffer_begin != 0)
+	{
+		// Move the partially received block to the front, leaving the rest of the buffer for the next read
+		std::copy (buffer->begin () + buffer_begin, buffer->begin () + buffer_end, buffer->begin ());
+		buffer_end -= buffer_begin;
+		buffer_begin = 0;
+	}
 	auto this_l (shared_from_this ());
-	connection->socket->async_read (connection->receive_buffer, 1, [this_l](boost::system::error_code const & ec, size_t size_a) {
-		if (!ec)
-		{
-			this_l->received_type ();
-		}
-		else
-		{
-			if (this_l->connection->node->config.logging.bulk_pull_logging ())
-			{
-				this_l->connection->node->logger.try_log (boost::str (boost::format ("Error receiving block type: %1%") % ec.message ()));
-			}
-			this_l->connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_receive_block_failure, ysu::stat::dir::in);
-			this_l->network_error = true;
-		}
+	connection->socket->async_read_some (buffer, buffer_end, buffer->size () - buffer_end, [this_l](boost::system::error_code const & ec, size_t size_a) {
+		this_l->received (ec, size_a);
 	});
 }
 
-void ysu::bulk_pull_client::received_type ()
+void ysu::bulk_pull_pipeline::received (boost::system::error_code const & ec, size_t size_a)
 {
-	auto this_l (shared_from_this ());
-	ysu::block_type type (static_cast<ysu::block_type> (connection->receive_buffer->data ()[0]));
-
-	auto const & socket_l = connection->socket;
-	switch (type)
+	if (!ec)
 	{
-		case ysu::block_type::send:
+		buffer_end += size_a;
+		if (parse ())
 		{
-			socket_l->async_read (connection->receive_buffer, ysu::send_block::size, [this_l, type](boost::system::error_code const & ec, size_t size_a) {
-				this_l->received_block (ec, size_a, type);
-			});
-			break;
+			throttled_receive ();
 		}
-		case ysu::block_type::receive:
-		{
-			socket_l->async_read (connection->receive_buffer, ysu::receive_block::size, [this_l, type](boost::system::error_code const & ec, size_t size_a) {
-				this_l->received_block (ec, size_a, type);
-			});
-			break;
-		}
-		case ysu::block_type::open:
-		{
-			socket_l->async_read (connection->receive_buffer, ysu::open_block::size, [this_l, type](boost::system::error_code const & ec, size_t size_a) {
-				this_l->received_block (ec, size_a, type);
-			});
-			break;
-		}
-		case ysu::block_type::change:
-		{
-			socket_l->async_read (connection->receive_buffer, ysu::change_block::size, [this_l, type](boost::system::error_code const & ec, size_t size_a) {
-				this_l->received_block (ec, size_a, type);
-			});
-			break;
-		}
-		case ysu::block_type::state:
-		{
-			socket_l->async_read (connection->receive_buffer, ysu::state_block::size, [this_l, type](boost::system::error_code const & ec, size_t size_a) {
-				this_l->received_block (ec, size_a, type);
-			});
-			break;
-		}
-		case ysu::block_type::not_a_block:
-		{
-			// Avoid re-using slow peers, or peers that sent the wrong blocks.
-			if (!connection->pending_stop && (expected == pull.end || (pull.count != 0 && pull.count == pull_blocks)))
-			{
-				connection->connections->pool_connection (connection);
-			}
-			break;
-		}
-		default:
+	}
+	else
+	{
+		if (connection->node->config.logging.bulk_pull_logging ())
 		{
-			if (connection->node->config.logging.network_packet_logging ())
-			{
-				connection->node->logger.try_log (boost::str (boost::format ("Unknown type received as block type: %1%") % static_cast<int> (type)));
-			}
-			break;
+			connection->node->logger.try_log (boost::str (boost::format ("Error bulk receiving block: %1%") % ec.message ()));
 		}
+		connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_receive_block_failure, ysu::stat::dir::in);
+		pulls.front ()->network_error = true;
+		pulls.pop_front ();
+		drop ();
 	}
 }
 
-void ysu::bulk_pull_client::received_block (boost::system::error_code const & ec, size_t size_a, ysu::block_type type_a)
+bool ysu::bulk_pull_pipeline::parse ()
 {
-	if (!ec)
+	auto result (true);
+	while (result && buffer_begin < buffer_end)
 	{
-		ysu::bufferstream stream (connection->receive_buffer->data (), size_a);
-		std::shared_ptr<ysu::block> block (ysu::deserialize_block (stream, type_a));
-		if (block != nullptr && !ysu::work_validate_entry (*block))
+		auto type (static_cast<ysu::block_type> ((*buffer)[buffer_begin]));
+		switch (type)
 		{
-			auto hash (block->hash ());
-			if (connection->node->config.logging.bulk_pull_logging ())
+			case ysu::block_type::send:
+			case ysu::block_type::receive:
+			case ysu::block_type::open:
+			case ysu::block_type::change:
+			case ysu::block_type::state:
 			{
-				std::string block_l;
-				block->serialize_json (block_l, connection->node->config.logging.single_line_record ());
-				connection->node->logger.try_log (boost::str (boost::format ("Pulled block %1% %2%") % hash.to_string () % block_l));
-			}
-			// Is block expected?
-			bool block_expected (false);
-			// Unconfirmed head is used only for lazy destinations if legacy bootstrap is not available, see ysu::bootstrap_attempt::lazy_destinations_increment (...)
-			bool unconfirmed_account_head (connection->node->flags.disable_legacy_bootstrap && pull_blocks == 0 && pull.retry_limit != std::numeric_limits<unsigned>::max () && expected == pull.account_or_head && block->account () == pull.account_or_head);
-			if (hash == expected || unconfirmed_account_head)
-			{
-				expected = block->previous ();
-				block_expected = true;
-			}
-			else
-			{
-				unexpected_count++;
-			}
-			if (pull_blocks == 0 && block_expected)
-			{
-				known_account = block->account ();
-			}
-			if (connection->block_count++ == 0)
-			{
-				connection->set_start_time (std::chrono::steady_clock::now ());
-			}
-			attempt->total_blocks++;
-			bool stop_pull (attempt->process_block (block, known_account, pull_blocks, pull.count, block_expected, pull.retry_limit));
-			pull_blocks++;
-			if (!stop_pull && !connection->hard_stop.load ())
-			{
-				/* Process block in lazy pull if not stopped
-				Stop usual pull request with unexpected block & more than 16k blocks processed
-				to prevent spam */
-				if (attempt->mode != ysu::bootstrap_mode::legacy || unexpected_count < 16384)
+				auto size (ysu::block::size (type));
+				if (buffer_end - buffer_begin <= size)
 				{
-					throttled_receive_block ();
+					// Wait for the rest of the block
+					return result;
 				}
+				ysu::bufferstream stream (buffer->data () + buffer_begin + 1, size);
+				buffer_begin += 1 + size;
+				if (skipping)
+				{
+					break;
+				}
+				std::shared_ptr<ysu::block> block (ysu::deserialize_block (stream, type));
+				if (block == nullptr)
+				{
+					if (connection->node->config.logging.bulk_pull_logging ())
+					{
+						connection->node->logger.try_log ("Error deserializing block received from pull request");
+					}
+					connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_deserialize_receive_block, ysu::stat::dir::in);
+					result = false;
+				}
+				else if (ysu::work_validate_entry (*block))
+				{
+					if (connection->node->config.logging.bulk_pull_logging ())
+					{
+						connection->node->logger.try_log (boost::str (boost::format ("Insufficient work for bulk pull block: %1%") % block->hash ().to_string ()));
+					}
+					connection->node->stats.inc_detail_only (ysu::stat::type::error, ysu::stat::detail::insufficient_work);
+					result = false;
+				}
+				else
+				{
+					switch (pulls.front ()->received_block (block))
+					{
+						case ysu::bulk_pull_client::progress::more:
+							break;
+						case ysu::bulk_pull_client::progress::done:
+							skipping = true;
+							break;
+						case ysu::bulk_pull_client::progress::failed:
+							result = false;
+							break;
+					}
+				}
+				if (!result)
+				{
+					pulls.pop_front ();
+					drop ();
+				}
+				break;
 			}
-			else if (stop_pull && block_expected)
-			{
-				connection->connections->pool_connection (connection);
-			}
-		}
-		else if (block == nullptr)
-		{
-			if (connection->node->config.logging.bulk_pull_logging ())
+			case ysu::block_type::not_a_block:
 			{
-				connection->node->logger.try_log ("Error deserializing block received from pull request");
+				++buffer_begin;
+				result = received_end ();
+				break;
 			}
-			connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_deserialize_receive_block, ysu::stat::dir::in);
-		}
-		else // Work invalid
-		{
-			if (connection->node->config.logging.bulk_pull_logging ())
+			default:
 			{
-				connection->node->logger.try_log (boost::str (boost::format ("Insufficient work for bulk pull block: %1%") % block->hash ().to_string ()));
+				if (connection->node->config.logging.network_packet_logging ())
+				{
+					connection->node->logger.try_log (boost::str (boost::format ("Unknown type received as block type: %1%") % static_cast<int> (type)));
+				}
+				pulls.pop_front ();
+				drop ();
+				result = false;
+				break;
 			}
-			connection->node->stats.inc_detail_only (ysu::stat::type::error, ysu::stat::detail::insufficient_work);
 		}
 	}
-	else
+	return result;
+}
+
+bool ysu::bulk_pull_pipeline::received_end ()
+{
+	auto reuse (pulls.front ()->received_end () || (skipping && !connection->pending_stop));
+	pulls.pop_front ();
+	skipping = false;
+	auto result (reuse && !pulls.empty ());
+	if (!reuse)
 	{
-		if (connection->node->config.logging.bulk_pull_logging ())
+		drop ();
+	}
+	else if (pulls.empty ())
+	{
+		// Nothing else was requested, anything left in the buffer means the peer doesn't follow the protocol
+		if (buffer_begin == buffer_end)
 		{
-			connection->node->logger.try_log (boost::str (boost::format ("Error bulk receiving block: %1%") % ec.message ()));
+			connection->connections->pool_connection (connection);
 		}
-		connection->node->stats.inc (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_receive_block_failure, ysu::stat::dir::in);
-		network_error = true;
 	}
+	return result;
+}
+
+void ysu::bulk_pull_pipeline::drop ()
+{
+	// The connection is closed once the last reference is released, the pulls still waiting are requeued
+	for (auto & pull : pulls)
+	{
+		pull->cancelled = true;
+	}
+	pulls.clear ();
 }
 
 ysu::bulk_pull_account_client::bulk_pull_account_client (std::shared_ptr<ysu::bootstrap_client> connection_a, std::shared_ptr<ysu::bootstrap_attempt> attempt_a, ysu::account const & account_a) :
@@ -478,32 +633,130 @@ void ysu::bulk_pull_server::set_current_end ()
 	}
 }
 
-void ysu::bulk_pull_server::send_next ()
+/**
+ * Ascending pulls start with the successor of the start block, or with the
+ * open block when the start is an account, and follow successors up to the
+ * end block or the frontier. The cursor is zero once there is nothing left.
+ */
+void ysu::bulk_pull_server::set_current_ascending ()
 {
-	auto block (get_next ());
-	if (block != nullptr)
+	include_start = false;
+	debug_assert (request != nullptr);
+	current.clear ();
+	auto transaction (connection->node->store.tx_begin_read ());
+	if (connection->node->store.block_exists (transaction, request->start.as_block_hash ()))
 	{
-		std::vector<uint8_t> send_buffer;
+		current = connection->node->store.block_successor (transaction, request->start.as_block_hash ());
+	}
+	else
+	{
+		ysu::account_info info;
+		if (!connection->node->store.account_get (transaction, request->start.as_account (), info))
 		{
-			ysu::vectorstream stream (send_buffer);
-			ysu::serialize_block (stream, *block);
+			current = info.open_block;
 		}
-		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
+		else if (connection->node->config.logging.bulk_pull_logging ())
 		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+			connection->node->logger.try_log (boost::str (boost::format ("Ascending request for unknown account or block: %1%") % request->start.to_string ()));
 		}
-		connection->socket->async_write (ysu::shared_const_buffer (std::move (send_buffer)), [this_l](boost::system::error_code const & ec, size_t size_a) {
+	}
+	sent_count = 0;
+	max_count = request->is_count_present () ? request->count : 0;
+}
+
+void ysu::bulk_pull_server::send_next ()
+{
+	start = std::chrono::steady_clock::now ();
+	fill (*next_buffer);
+	write_next ();
+}
+
+/*
+ * Writes the prepared chunk and, while it is in flight, serializes the
+ * following one so it can be written as soon as the socket is ready
+ */
+void ysu::bulk_pull_server::write_next ()
+{
+	std::swap (send_buffer, next_buffer);
+	next_buffer->clear ();
+	auto last (finished);
+	auto this_l (shared_from_this ());
+	connection->socket->async_write (ysu::shared_const_buffer (send_buffer), [this_l, last](boost::system::error_code const & ec, size_t size_a) {
+		if (last)
+		{
+			this_l->no_block_sent (ec, size_a);
+		}
+		else
+		{
 			this_l->sent_action (ec, size_a);
-		});
+		}
+	});
+	if (!last)
+	{
+		fill (*next_buffer);
 	}
-	else
+}
+
+void ysu::bulk_pull_server::fill (std::vector<uint8_t> & buffer_a)
+{
+	auto & node (*connection->node);
+	// Only held while the chunk is serialized, not while waiting for the peer
+	auto transaction (node.store.tx_begin_read ());
+	size_t size (0);
+	uint64_t count (0);
 	{
-		send_finished ();
+		ysu::vectorstream stream (buffer_a);
+		while (!finished && size < send_buffer_size)
+		{
+			auto block (get_next (transaction));
+			if (block != nullptr)
+			{
+				if (node.config.logging.bulk_pull_logging ())
+				{
+					node.logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+				}
+				ysu::serialize_block (stream, *block);
+				size += 1 + ysu::block::size (block->type ());
+				++count;
+			}
+			else
+			{
+				if (node.config.logging.bulk_pull_logging ())
+				{
+					node.logger.try_log ("Bulk sending finished");
+				}
+				ysu::write (stream, static_cast<uint8_t> (ysu::block_type::not_a_block));
+				finished = true;
+			}
+		}
 	}
+	blocks_sent += count;
+	node.stats.add (ysu::stat::type::bootstrap, ysu::stat::detail::bulk_pull_blocks, ysu::stat::dir::out, count);
 }
 
 std::shared_ptr<ysu::block> ysu::bulk_pull_server::get_next ()
+{
+	return get_next (connection->node->store.tx_begin_read ());
+}
+
+std::shared_ptr<ysu::block> ysu::bulk_pull_server::get_next (ysu::transaction const & transaction_a)
+{
+	return request->is_ascending () ? get_next_ascending (transaction_a) : get_next_descending (transaction_a);
+}
+
+std::shared_ptr<ysu::block> ysu::bulk_pull_server::get_next_ascending (ysu::transaction const & transaction_a)
+{
+	std::shared_ptr<ysu::block> result;
+	if (!current.is_zero () && (max_count == 0 || sent_count < max_count))
+	{
+		result = connection->node->store.block_get (transaction_a, current);
+		current = result != nullptr && current != request->end ? connection->node->store.block_successor (transaction_a, current) : ysu::block_hash (0);
+		sent_count++;
+	}
+	return result;
+}
+
+std::shared_ptr<ysu::block> ysu::bulk_pull_server::get_next_descending (ysu::transaction const & transaction_a)
 {
 	std::shared_ptr<ysu::block> result;
 	bool send_current = false, set_current_to_end = false;
@@ -544,7 +797,7 @@ std::shared_ptr<ysu::block> ysu::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		result = connection->node->block (current);
+		result = connection->node->store.block_get (transaction_a, current);
 		if (result != nullptr && set_current_to_end == false)
 		{
 			auto previous (result->previous ());
@@ -578,7 +831,7 @@ void ysu::bulk_pull_server::sent_action (boost::system::error_code const & ec, s
 {
 	if (!ec)
 	{
-		send_next ();
+		write_next ();
 	}
 	else
 	{
@@ -589,24 +842,15 @@ void ysu::bulk_pull_server::sent_action (boost::system::error_code const & ec, s
 	}
 }
 
-void ysu::bulk_pull_server::send_finished ()
-{
-	ysu::shared_const_buffer send_buffer (static_cast<uint8_t> (ysu::block_type::not_a_block));
-	auto this_l (shared_from_this ());
-	if (connection->node->config.logging.bulk_pull_logging ())
-	{
-		connection->node->logger.try_log ("Bulk sending finished");
-	}
-	connection->socket->async_write (send_buffer, [this_l](boost::system::error_code const & ec, size_t size_a) {
-		this_l->no_block_sent (ec, size_a);
-	});
-}
-
 void ysu::bulk_pull_server::no_block_sent (boost::system::error_code const & ec, size_t size_a)
 {
 	if (!ec)
 	{
-		debug_assert (size_a == 1);
+		if (connection->node->config.logging.bulk_pull_logging ())
+		{
+			auto elapsed (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start));
+			connection->node->logger.try_log (boost::str (boost::format ("Bulk pull served %1% blocks to %2% at %3% blocks/s") % blocks_sent % connection->remote_endpoint % (blocks_sent * 1000 / std::max<uint64_t> (elapsed.count (), 1))));
+		}
 		connection->finish_request ();
 	}
 	else
@@ -620,9 +864,20 @@ void ysu::bulk_pull_server::no_block_sent (boost::system::error_code const & ec,
 
 ysu::bulk_pull_server::bulk_pull_server (std::shared_ptr<ysu::bootstrap_server> const & connection_a, std::unique_ptr<ysu::bulk_pull> request_a) :
 connection (connection_a),
-request (std::move (request_a))
+request (std::move (request_a)),
+send_buffer (std::make_shared<std::vector<uint8_t>> ()),
+next_buffer (std::make_shared<std::vector<uint8_t>> ())
 {
-	set_current_end ();
+	send_buffer->reserve (send_buffer_size + ysu::block::size (ysu::block_type::state) + 1);
+	next_buffer->reserve (send_buffer_size + ysu::block::size (ysu::block_type::state) + 1);
+	if (request->is_ascending ())
+	{
+		set_current_ascending ();
+	}
+	else
+	{
+		set_current_end ();
+	}
 }
 
 /**
@@ -2,7 +2,9 @@
 
 #include <ysu/node/common.hpp>
 #include <ysu/node/socket.hpp>
+#include <ysu/secure/blockstore.hpp>
 
+#include <deque>
 #include <unordered_set>
 
 namespace ysu
@@ -23,19 +25,28 @@ public:
 	uint64_t processed{ 0 };
 	unsigned retry_limit{ 0 };
 	uint64_t bootstrap_id{ 0 };
+	/** Pull blocks oldest first, starting after \p head or with the open block if \p head is zero */
+	bool ascending{ false };
 };
 class bootstrap_client;
-class bulk_pull_client final : public std::enable_shared_from_this<ysu::bulk_pull_client>
+class bulk_pull_client final
 {
 public:
+	/** What to do with the rest of the response after a block was received */
+	enum class progress
+	{
+		more,
+		/** Skip the remaining blocks, the connection can be reused once the response ends */
+		done,
+		/** Drop the connection */
+		failed
+	};
 	bulk_pull_client (std::shared_ptr<ysu::bootstrap_client>, std::shared_ptr<ysu::bootstrap_attempt>, ysu::pull_info const &);
 	~bulk_pull_client ();
-	void request ();
-	void receive_block ();
-	void throttled_receive_block ();
-	void received_type ();
-	void received_block (boost::system::error_code const &, size_t, ysu::block_type);
-	ysu::block_hash first ();
+	ysu::bulk_pull request ();
+	progress received_block (std::shared_ptr<ysu::block> const &);
+	/** Called when the response is terminated by not_a_block, returns true if the connection can be reused */
+	bool received_end ();
 	std::shared_ptr<ysu::bootstrap_client> connection;
 	std::shared_ptr<ysu::bootstrap_attempt> attempt;
 	ysu::block_hash expected;
@@ -44,6 +55,43 @@ public:
 	uint64_t pull_blocks;
 	uint64_t unexpected_count;
 	bool network_error{ false };
+	/** Set if the connection was dropped before the response to this pull started, which isn't held against the pull or the peer */
+	bool cancelled{ false };
+	/** Set for ascending pulls sent to peers which don't support them, the missing blocks are pulled newest first instead */
+	bool descending_fallback{ false };
+};
+/**
+ * Sends several bulk_pull requests over a connection at once, so that short pulls aren't each delayed by a round trip.
+ * The server answers them in order, each response terminated by not_a_block. Responses are read into a large buffer
+ * and all complete blocks are parsed after every read.
+ */
+class bulk_pull_pipeline final : public std::enable_shared_from_this<ysu::bulk_pull_pipeline>
+{
+public:
+	bulk_pull_pipeline (std::shared_ptr<ysu::bootstrap_client>, std::shared_ptr<ysu::bootstrap_attempt>, std::deque<std::unique_ptr<ysu::bulk_pull_client>>);
+	void request ();
+	static size_t constexpr receive_buffer_size = 64 * 1024;
+
+private:
+	void throttled_receive ();
+	void receive ();
+	void received (boost::system::error_code const &, size_t);
+	/** Hands the complete blocks in the buffer to the pull they belong to, returns false once nothing more is read */
+	bool parse ();
+	/** Returns false if the connection was dropped */
+	bool received_end ();
+	void drop ();
+	/** Closes the connection after a request couldn't be written and requeues all pulls */
+	void request_failed ();
+	std::shared_ptr<ysu::bootstrap_client> connection;
+	std::shared_ptr<ysu::bootstrap_attempt> attempt;
+	/** Pulls waiting for their response, the front one is being received */
+	std::deque<std::unique_ptr<ysu::bulk_pull_client>> pulls;
+	std::shared_ptr<std::vector<uint8_t>> buffer;
+	size_t buffer_begin{ 0 };
+	size_t buffer_end{ 0 };
+	/** Skipping the rest of the response to the front pull */
+	bool skipping{ false };
 };
 class bulk_pull_account_client final : public std::enable_shared_from_this<ysu::bulk_pull_account_client>
 {
@@ -64,10 +112,11 @@ class bulk_pull_server final : public std::enable_shared_from_this<ysu::bulk_pul
 public:
 	bulk_pull_server (std::shared_ptr<ysu::bootstrap_server> const &, std::unique_ptr<ysu::bulk_pull>);
 	void set_current_end ();
+	void set_current_ascending ();
 	std::shared_ptr<ysu::block> get_next ();
+	std::shared_ptr<ysu::block> get_next (ysu::transaction const &);
 	void send_next ();
 	void sent_action (boost::system::error_code const &, size_t);
-	void send_finished ();
 	void no_block_sent (boost::system::error_code const &, size_t);
 	std::shared_ptr<ysu::bootstrap_server> connection;
 	std::unique_ptr<ysu::bulk_pull> request;
@@ -75,6 +124,21 @@ public:
 	bool include_start;
 	ysu::bulk_pull::count_t max_count;
 	ysu::bulk_pull::count_t sent_count;
+	/** Blocks are written in chunks of about this many bytes */
+	static size_t constexpr send_buffer_size = 16 * 1024;
+
+private:
+	std::shared_ptr<ysu::block> get_next_ascending (ysu::transaction const &);
+	std::shared_ptr<ysu::block> get_next_descending (ysu::transaction const &);
+	/** Serializes the following blocks into \p buffer_a, terminated by not_a_block once the pull is complete */
+	void fill (std::vector<uint8_t> & buffer_a);
+	void write_next ();
+	/** The chunk being written, and the one prepared while it is in flight. Both are reused for the whole pull. */
+	std::shared_ptr<std::vector<uint8_t>> send_buffer;
+	std::shared_ptr<std::vector<uint8_t>> next_buffer;
+	bool finished{ false };
+	uint64_t blocks_sent{ 0 };
+	std::chrono::steady_clock::time_point start;
 };
 class bulk_pull_account;
 class bulk_pull_account_server final : public std::enable_shared_from_this<ysu::bulk_pull_account_server>
@@ -11,6 +11,9 @@ constexpr double ysu::bootstrap_limits::bootstrap_connection_scale_target_blocks
 constexpr double ysu::bootstrap_limits::bootstrap_minimum_blocks_per_sec;
 constexpr double ysu::bootstrap_limits::bootstrap_minimum_termination_time_sec;
 constexpr unsigned ysu::bootstrap_limits::bootstrap_max_new_connections;
+constexpr unsigned ysu::bootstrap_limits::bootstrap_peer_candidates;
+constexpr double ysu::bootstrap_limits::bootstrap_pool_scale_min;
+constexpr size_t ysu::bootstrap_limits::bulk_pull_pipeline_depth;
 constexpr unsigned ysu::bootstrap_limits::requeued_pulls_processed_blocks_factor;
 
 ysu::bootstrap_client::bootstrap_client (std::shared_ptr<ysu::node> node_a, std::shared_ptr<ysu::bootstrap_connections> connections_a, std::shared_ptr<ysu::transport::channel_tcp> channel_a, std::shared_ptr<ysu::socket> socket_a) :
@@ -72,8 +75,24 @@ std::shared_ptr<ysu::bootstrap_client> ysu::bootstrap_connections::connection (s
 	{
 		if (!use_front_connection)
 		{
-			result = idle.back ();
-			idle.pop_back ();
+			// Hand out the connection expected to be fastest so that fast peers take the bulk of the pulls. Ties go to the most recently pooled one
+			auto best (idle.end () - 1);
+			auto best_rate (-1.0);
+			for (auto i (idle.rbegin ()), n (idle.rend ()); i != n; ++i)
+			{
+				auto rate ((*i)->block_rate.load ());
+				if (rate == 0)
+				{
+					rate = peer_scores.score ((*i)->channel->get_tcp_endpoint ()).value_or (0);
+				}
+				if (rate > best_rate)
+				{
+					best_rate = rate;
+					best = i.base () - 1;
+				}
+			}
+			result = *best;
+			idle.erase (best);
 		}
 		else
 		{
@@ -145,19 +164,26 @@ void ysu::bootstrap_connections::connect_client (ysu::tcp_endpoint const & endpo
 	++connections_count;
 	auto socket (std::make_shared<ysu::socket> (node));
 	auto this_l (shared_from_this ());
+	auto start (std::chrono::steady_clock::now ());
 	socket->async_connect (endpoint_a,
-	[this_l, socket, endpoint_a, push_front](boost::system::error_code const & ec) {
+	[this_l, socket, endpoint_a, push_front, start](boost::system::error_code const & ec) {
 		if (!ec)
 		{
+			this_l->peer_scores.connected (endpoint_a, std::chrono::steady_clock::now () - start);
 			if (this_l->node.config.logging.bulk_pull_logging ())
 			{
 				this_l->node.logger.try_log (boost::str (boost::format ("Connection established to %1%") % endpoint_a));
 			}
-			auto client (std::make_shared<ysu::bootstrap_client> (this_l->node.shared (), this_l, std::make_shared<ysu::transport::channel_tcp> (*this_l->node.shared (), socket), socket));
+			auto channel (std::make_shared<ysu::transport::channel_tcp> (*this_l->node.shared (), socket));
+			// Bootstrap connections don't exchange messages with a header before pulling, the version is known from the realtime channel if there is one
+			auto realtime (this_l->node.network.find_channel (ysu::transport::map_tcp_to_endpoint (endpoint_a)));
+			channel->set_network_version (realtime != nullptr ? realtime->get_network_version () : 0);
+			auto client (std::make_shared<ysu::bootstrap_client> (this_l->node.shared (), this_l, channel, socket));
 			this_l->pool_connection (client, true, push_front);
 		}
 		else
 		{
+			this_l->peer_scores.failed (endpoint_a);
 			if (this_l->node.config.logging.network_logging ())
 			{
 				switch (ec.value ())
@@ -189,7 +215,7 @@ unsigned ysu::bootstrap_connections::target_connections (size_t pulls_remaining,
 	// Only scale up to bootstrap_connections_max for large pulls.
 	double step_scale = std::min (1.0, std::max (0.0, (double)pulls_remaining / ysu::bootstrap_limits::bootstrap_connection_scale_target_blocks));
 	double target = (double)attempts_factor + (double)(node.config.bootstrap_connections_max - attempts_factor) * step_scale;
-	return std::max (1U, (unsigned)(target + 0.5f));
+	return std::max (1U, (unsigned)(target * pool_scale + 0.5f));
 }
 
 struct block_rate_cmp
@@ -220,13 +246,15 @@ void ysu::bootstrap_connections::populate_connections (bool repeat)
 				double elapsed_sec = client->elapsed_seconds ();
 				auto blocks_per_sec = client->sample_block_rate ();
 				rate_sum += blocks_per_sec;
-				if (client->elapsed_seconds () > ysu::bootstrap_limits::bootstrap_connection_warmup_time_sec && client->block_count > 0)
+				auto warmed_up (elapsed_sec > ysu::bootstrap_limits::bootstrap_connection_warmup_time_sec);
+				if (warmed_up && client->block_count > 0)
 				{
 					sorted_connections.push (client);
+					peer_scores.sample (client->channel->get_tcp_endpoint (), blocks_per_sec);
 				}
 				// Force-stop the slowest peers, since they can take the whole bootstrap hostage by dribbling out blocks on the last remaining pull.
-				// This is ~1.5kilobits/sec.
-				if (elapsed_sec > ysu::bootstrap_limits::bootstrap_minimum_termination_time_sec && blocks_per_sec < ysu::bootstrap_limits::bootstrap_minimum_blocks_per_sec)
+				// This is ~1.5kilobits/sec. Peers with a history of being slow are stopped as soon as they are past the warmup time.
+				if ((elapsed_sec > ysu::bootstrap_limits::bootstrap_minimum_termination_time_sec || (warmed_up && peer_scores.poor (client->channel->get_tcp_endpoint ()))) && blocks_per_sec < ysu::bootstrap_limits::bootstrap_minimum_blocks_per_sec)
 				{
 					if (node.config.logging.bulk_pull_logging ())
 					{
@@ -242,6 +270,7 @@ void ysu::bootstrap_connections::populate_connections (bool repeat)
 		clients.swap (new_clients);
 	}
 
+	update_pool_scale ();
 	auto target = target_connections (num_pulls, attempts_count);
 
 	// We only want to drop slow peers when more than 2/3 are active. 2/3 because 1/2 is too aggressive, and 100% rarely happens.
@@ -272,7 +301,7 @@ void ysu::bootstrap_connections::populate_connections (bool repeat)
 
 	if (node.config.logging.bulk_pull_logging ())
 	{
-		node.logger.try_log (boost::str (boost::format ("Bulk pull connections: %1%, rate: %2% blocks/sec, bootstrap attempts %3%, remaining pulls: %4%") % connections_count.load () % (int)rate_sum % attempts_count % num_pulls));
+		node.logger.try_log (boost::str (boost::format ("Bulk pull connections: %1%, rate: %2% blocks/sec, drain rate: %3% blocks/sec, pool scale: %4%, bootstrap attempts %5%, remaining pulls: %6%") % connections_count.load () % (int)rate_sum % (int)drain_rate.load () % pool_scale.load () % attempts_count % num_pulls));
 	}
 
 	if (connections_count < target && (attempts_count != 0 || new_connections_empty) && !stopped)
@@ -282,8 +311,8 @@ void ysu::bootstrap_connections::populate_connections (bool repeat)
 		// Not many peers respond, need to try to make more connections than we need.
 		for (auto i = 0u; i < delta; i++)
 		{
-			auto endpoint (node.network.bootstrap_peer (true));
-			if (endpoint != ysu::tcp_endpoint (boost::asio::ip::address_v6::any (), 0) && (node.flags.allow_bootstrap_peers_duplicates || endpoints.find (endpoint) == endpoints.end ()) && !node.network.excluded_peers.check (endpoint))
+			auto endpoint (select_peer (endpoints));
+			if (endpoint != ysu::tcp_endpoint (boost::asio::ip::address_v6::any (), 0))
 			{
 				connect_client (endpoint);
 				endpoints.insert (endpoint);
@@ -312,6 +341,58 @@ void ysu::bootstrap_connections::populate_connections (bool repeat)
 	}
 }
 
+ysu::tcp_endpoint ysu::bootstrap_connections::select_peer (std::unordered_set<ysu::tcp_endpoint> const & endpoints_a)
+{
+	std::vector<ysu::tcp_endpoint> candidates;
+	std::vector<ysu::tcp_endpoint> poor;
+	for (auto i = 0u; i < ysu::bootstrap_limits::bootstrap_peer_candidates; i++)
+	{
+		auto endpoint (node.network.bootstrap_peer (true));
+		if (endpoint == ysu::tcp_endpoint (boost::asio::ip::address_v6::any (), 0))
+		{
+			break;
+		}
+		if ((node.flags.allow_bootstrap_peers_duplicates || endpoints_a.find (endpoint) == endpoints_a.end ()) && !node.network.excluded_peers.check (endpoint))
+		{
+			(peer_scores.poor (endpoint) ? poor : candidates).push_back (endpoint);
+		}
+	}
+	// Peers known to be slow or unreliable are only used when there is nobody else to connect to
+	auto const & choice (!candidates.empty () ? candidates : poor);
+	return !choice.empty () ? peer_scores.select (choice) : ysu::tcp_endpoint (boost::asio::ip::address_v6::any (), 0);
+}
+
+void ysu::bootstrap_connections::update_pool_scale ()
+{
+	auto now (std::chrono::steady_clock::now ());
+	auto elapsed (std::chrono::duration<double> (now - last_pool_update).count ());
+	auto received (blocks_received.load ());
+	auto queue_size (node.block_processor.size ());
+	// Blocks leaving the queue are the ones which arrived, less the growth of the queue
+	auto inflow (static_cast<double> (received - last_blocks_received));
+	auto growth (static_cast<double> (queue_size) - static_cast<double> (last_queue_size));
+	auto arrival_rate (0.0);
+	if (elapsed > 0)
+	{
+		drain_rate = std::max (0.0, inflow - growth) / elapsed;
+		arrival_rate = inflow / elapsed;
+	}
+	auto scale (pool_scale.load ());
+	if (node.block_processor.half_full () && arrival_rate > drain_rate)
+	{
+		// The block processor is the bottleneck, so only the share of connections which delivers the blocks it drains is kept
+		scale = std::max (ysu::bootstrap_limits::bootstrap_pool_scale_min, scale * drain_rate / arrival_rate);
+	}
+	else if (!node.block_processor.half_full ())
+	{
+		scale = std::min (1.0, scale * 1.25);
+	}
+	pool_scale = scale;
+	last_pool_update = now;
+	last_blocks_received = received;
+	last_queue_size = queue_size;
+}
+
 void ysu::bootstrap_connections::start_populate_connections ()
 {
 	if (!populate_connections_started.exchange (true))
@@ -323,7 +404,10 @@ void ysu::bootstrap_connections::start_populate_connections ()
 void ysu::bootstrap_connections::add_pull (ysu::pull_info const & pull_a)
 {
 	ysu::pull_info pull (pull_a);
-	node.bootstrap_initiator.cache.update_pull (pull);
+	if (!pull.ascending)
+	{
+		node.bootstrap_initiator.cache.update_pull (pull);
+	}
 	{
 		ysu::lock_guard<std::mutex> lock (mutex);
 		pulls.push_back (pull);
@@ -339,31 +423,39 @@ void ysu::bootstrap_connections::request_pull (ysu::unique_lock<std::mutex> & lo
 	if (connection_l != nullptr && !pulls.empty ())
 	{
 		std::shared_ptr<ysu::bootstrap_attempt> attempt_l;
-		ysu::pull_info pull;
-		// Search pulls with existing attempts
-		while (attempt_l == nullptr && !pulls.empty ())
+		std::vector<ysu::pull_info> pipeline;
+		// Search pulls with existing attempts, taking the following ones of the same attempt as well
+		while (pipeline.size () < ysu::bootstrap_limits::bulk_pull_pipeline_depth && !pulls.empty () && (attempt_l == nullptr || pulls.front ().bootstrap_id == attempt_l->incremental_id))
 		{
-			pull = pulls.front ();
+			auto pull (pulls.front ());
 			pulls.pop_front ();
-			attempt_l = node.bootstrap_initiator.attempts.find (pull.bootstrap_id);
+			auto pull_attempt (node.bootstrap_initiator.attempts.find (pull.bootstrap_id));
 			// Check if lazy pull is obsolete (head was processed or head is 0 for destinations requests)
-			if (attempt_l != nullptr && attempt_l->mode == ysu::bootstrap_mode::lazy && !pull.head.is_zero () && attempt_l->lazy_processed_or_exists (pull.head))
+			if (pull_attempt != nullptr && pull_attempt->mode == ysu::bootstrap_mode::lazy && !pull.head.is_zero () && pull_attempt->lazy_processed_or_exists (pull.head))
 			{
-				attempt_l->pull_finished ();
-				attempt_l = nullptr;
+				pull_attempt->pull_finished ();
+			}
+			else if (pull_attempt != nullptr)
+			{
+				if (pull_attempt->mode == ysu::bootstrap_mode::legacy)
+				{
+					pull_attempt->add_recent_pull (pull.head);
+				}
+				attempt_l = pull_attempt;
+				pipeline.push_back (pull);
 			}
 		}
 		if (attempt_l != nullptr)
 		{
-			if (attempt_l->mode == ysu::bootstrap_mode::legacy)
-			{
-				attempt_l->add_recent_pull (pull.head);
-			}
 			// The bulk_pull_client destructor attempt to requeue_pull which can cause a deadlock if this is the last reference
 			// Dispatch request in an external thread in case it needs to be destroyed
-			node.background ([connection_l, attempt_l, pull]() {
-				auto client (std::make_shared<ysu::bulk_pull_client> (connection_l, attempt_l, pull));
-				client->request ();
+			node.background ([connection_l, attempt_l, pipeline]() {
+				std::deque<std::unique_ptr<ysu::bulk_pull_client>> clients;
+				for (auto const & pull : pipeline)
+				{
+					clients.push_back (std::make_unique<ysu::bulk_pull_client> (connection_l, attempt_l, pull));
+				}
+				std::make_shared<ysu::bulk_pull_pipeline> (connection_l, attempt_l, std::move (clients))->request ();
 			});
 		}
 	}
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <ysu/node/bootstrap/bootstrap_bulk_pull.hpp>
+#include <ysu/node/bootstrap/bootstrap_peer_scores.hpp>
 #include <ysu/node/common.hpp>
 #include <ysu/node/socket.hpp>
 
 #include <atomic>
+#include <unordered_set>
 
 namespace ysu
 {
@@ -64,6 +66,13 @@ public:
 	void stop ();
 	std::deque<std::weak_ptr<ysu::bootstrap_client>> clients;
 	std::atomic<unsigned> connections_count{ 0 };
+	/** Blocks received by all clients, used to compare the pulled rate against the block processor drain rate */
+	std::atomic<uint64_t> blocks_received{ 0 };
+	/** Fraction of the connection target in use, lowered to match drain_rate while the block processor is the bottleneck */
+	std::atomic<double> pool_scale{ 1.0 };
+	/** Blocks per second drained from the block processor queue, measured between populate_connections calls */
+	std::atomic<double> drain_rate{ 0 };
+	ysu::bootstrap_peer_scores peer_scores;
 	ysu::node & node;
 	std::deque<std::shared_ptr<ysu::bootstrap_client>> idle;
 	std::deque<ysu::pull_info> pulls;
@@ -72,5 +81,12 @@ public:
 	std::atomic<bool> stopped{ false };
 	std::mutex mutex;
 	ysu::condition_variable condition;
+
+private:
+	void update_pool_scale ();
+	ysu::tcp_endpoint select_peer (std::unordered_set<ysu::tcp_endpoint> const & endpoints);
+	std::chrono::steady_clock::time_point last_pool_update{ std::chrono::steady_clock::now () };
+	uint64_t last_blocks_received{ 0 };
+	size_t last_queue_size{ 0 };
 };
 }
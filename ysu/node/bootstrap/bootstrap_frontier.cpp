@@ -15,7 +15,7 @@ constexpr size_t ysu::frontier_req_client::size_frontier;
 void ysu::frontier_req_client::run ()
 {
 	ysu::frontier_req request;
-	request.start.clear ();
+	request.start = start;
 	request.age = std::numeric_limits<decltype (request.age)>::max ();
 	request.count = std::numeric_limits<decltype (request.count)>::max ();
 	auto this_l (shared_from_this ());
@@ -36,12 +36,15 @@ void ysu::frontier_req_client::run ()
 	ysu::buffer_drop_policy::no_limiter_drop);
 }
 
-ysu::frontier_req_client::frontier_req_client (std::shared_ptr<ysu::bootstrap_client> connection_a, std::shared_ptr<ysu::bootstrap_attempt> attempt_a) :
+ysu::frontier_req_client::frontier_req_client (std::shared_ptr<ysu::bootstrap_client> connection_a, std::shared_ptr<ysu::bootstrap_attempt> attempt_a, ysu::account const & start_a, ysu::account const & end_a) :
 connection (connection_a),
 attempt (attempt_a),
-current (0),
+current (start_a.number () - 1),
 count (0),
-bulk_push_cost (0)
+bulk_push_cost (0),
+start (start_a),
+end (end_a),
+position (start_a)
 {
 	next ();
 }
@@ -86,6 +89,44 @@ void ysu::frontier_req_client::unsynced (ysu::block_hash const & head, ysu::bloc
 	}
 }
 
+bool ysu::frontier_req_client::in_range (ysu::account const & account_a)
+{
+	ysu::lock_guard<std::mutex> guard (range_mutex);
+	return !account_a.is_zero () && (end.is_zero () || account_a < end);
+}
+
+bool ysu::frontier_req_client::split (ysu::uint256_t const & minimum_a, std::pair<ysu::account, ysu::account> & range_a)
+{
+	ysu::lock_guard<std::mutex> guard (range_mutex);
+	ysu::uint256_t last (end.is_zero () ? std::numeric_limits<ysu::uint256_t>::max () : end.number ());
+	auto result (last <= position.number () || last - position.number () < minimum_a);
+	if (!result)
+	{
+		ysu::account middle (position.number () + (last - position.number ()) / 2);
+		range_a = std::make_pair (middle, end);
+		end = middle;
+	}
+	return result;
+}
+
+std::pair<ysu::account, ysu::account> ysu::frontier_req_client::remaining ()
+{
+	ysu::lock_guard<std::mutex> guard (range_mutex);
+	return std::make_pair (position, end);
+}
+
+void ysu::frontier_req_client::finish (bool failed_a)
+{
+	try
+	{
+		promise.set_value (failed_a);
+	}
+	catch (std::future_error &)
+	{
+	}
+	attempt->condition.notify_all ();
+}
+
 void ysu::frontier_req_client::received_frontier (boost::system::error_code const & ec, size_t size_a)
 {
 	if (!ec)
@@ -113,15 +154,19 @@ void ysu::frontier_req_client::received_frontier (boost::system::error_code cons
 		if (elapsed_sec > ysu::bootstrap_limits::bootstrap_connection_warmup_time_sec && blocks_per_sec < ysu::bootstrap_limits::bootstrap_minimum_frontier_blocks_per_sec)
 		{
 			connection->node->logger.try_log (boost::str (boost::format ("Aborting frontier req because it was too slow")));
-			promise.set_value (true);
+			finish (true);
 			return;
 		}
 		if (attempt->should_log ())
 		{
 			connection->node->logger.always_log (boost::str (boost::format ("Received %1% frontiers from %2%") % std::to_string (count) % connection->channel->to_string ()));
 		}
-		if (!account.is_zero ())
+		if (in_range (account))
 		{
+			{
+				ysu::lock_guard<std::mutex> guard (range_mutex);
+				position = account.number () + 1;
+			}
 			while (!current.is_zero () && current < account)
 			{
 				// We know about an account they don't.
@@ -167,7 +212,7 @@ void ysu::frontier_req_client::received_frontier (boost::system::error_code cons
 		}
 		else
 		{
-			while (!current.is_zero ())
+			while (in_range (current))
 			{
 				// We know about an account they don't.
 				unsynced (frontier, 0);
@@ -177,16 +222,16 @@ void ysu::frontier_req_client::received_frontier (boost::system::error_code cons
 			{
 				connection->node->logger.try_log ("Bulk push cost: ", bulk_push_cost);
 			}
+			finish (false);
+			if (account.is_zero ())
 			{
-				try
-				{
-					promise.set_value (false);
-				}
-				catch (std::future_error &)
-				{
-				}
 				connection->connections->pool_connection (connection);
 			}
+			else
+			{
+				// The peer is still sending the frontiers past the end of the range
+				connection->socket->close ();
+			}
 		}
 	}
 	else
@@ -223,6 +268,12 @@ void ysu::frontier_req_client::next ()
 	current = account_pair.first;
 	frontier = account_pair.second;
 	accounts.pop_front ();
+	if (!in_range (current))
+	{
+		// Past the end of the requested range
+		current.clear ();
+		frontier.clear ();
+	}
 }
 
 ysu::frontier_req_server::frontier_req_server (std::shared_ptr<ysu::bootstrap_server> const & connection_a, std::unique_ptr<ysu::frontier_req> request_a) :
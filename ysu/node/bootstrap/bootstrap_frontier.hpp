@@ -9,16 +9,26 @@ namespace ysu
 {
 class bootstrap_attempt;
 class bootstrap_client;
+/**
+ * Requests the frontiers of the accounts in [start, end) from a peer, a zero end standing for the end of the account space
+ */
 class frontier_req_client final : public std::enable_shared_from_this<ysu::frontier_req_client>
 {
 public:
-	explicit frontier_req_client (std::shared_ptr<ysu::bootstrap_client>, std::shared_ptr<ysu::bootstrap_attempt>);
+	frontier_req_client (std::shared_ptr<ysu::bootstrap_client>, std::shared_ptr<ysu::bootstrap_attempt>, ysu::account const & start_a = ysu::account (0), ysu::account const & end_a = ysu::account (0));
 	~frontier_req_client ();
 	void run ();
 	void receive_frontier ();
 	void received_frontier (boost::system::error_code const &, size_t);
 	void unsynced (ysu::block_hash const &, ysu::block_hash const &);
 	void next ();
+	/**
+	 * Hands over the upper half of the part of the range not received yet, if it spans at least \p minimum_a accounts
+	 * @return true if the range wasn't split
+	 */
+	bool split (ysu::uint256_t const & minimum_a, std::pair<ysu::account, ysu::account> & range_a);
+	/** The part of the range not received yet */
+	std::pair<ysu::account, ysu::account> remaining ();
 	std::shared_ptr<ysu::bootstrap_client> connection;
 	std::shared_ptr<ysu::bootstrap_attempt> attempt;
 	ysu::account current;
@@ -32,6 +42,16 @@ public:
 	uint64_t bulk_push_cost;
 	std::deque<std::pair<ysu::account, ysu::block_hash>> accounts;
 	static size_t constexpr size_frontier = sizeof (ysu::account) + sizeof (ysu::block_hash);
+
+private:
+	void finish (bool);
+	bool in_range (ysu::account const &);
+	ysu::account const start;
+	/** Can be lowered by split () while the request is running */
+	ysu::account end;
+	/** Frontiers of accounts before this one have been received */
+	ysu::account position;
+	std::mutex range_mutex;
 };
 class bootstrap_server;
 class frontier_req;
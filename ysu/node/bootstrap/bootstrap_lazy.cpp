@@ -271,10 +271,10 @@ bool ysu::bootstrap_attempt_lazy::process_block_lazy (std::shared_ptr<ysu::block
 		// Adding lazy balances for first processed block in pull
 		if (pull_blocks == 0 && (block_a->type () == ysu::block_type::state || block_a->type () == ysu::block_type::send))
 		{
-			lazy_balances.emplace (hash, block_a->balance ().number ());
+			lazy_balances.insert (hash, block_a->balance ().number ());
 		}
 		// Clearing lazy balances for previous block
-		if (!block_a->previous ().is_zero () && lazy_balances.find (block_a->previous ()) != lazy_balances.end ())
+		if (!block_a->previous ().is_zero ())
 		{
 			lazy_balances.erase (block_a->previous ());
 		}
@@ -324,9 +324,9 @@ void ysu::bootstrap_attempt_lazy::lazy_block_state (std::shared_ptr<ysu::block>
 			else if (lazy_blocks_processed (previous))
 			{
 				auto previous_balance (lazy_balances.find (previous));
-				if (previous_balance != lazy_balances.end ())
+				if (previous_balance != nullptr)
 				{
-					if (previous_balance->second <= balance)
+					if (*previous_balance <= balance)
 					{
 						lazy_add (link, retry_limit);
 					}
@@ -334,13 +334,13 @@ void ysu::bootstrap_attempt_lazy::lazy_block_state (std::shared_ptr<ysu::block>
 					{
 						lazy_destinations_increment (link.as_account ());
 					}
-					lazy_balances.erase (previous_balance);
+					lazy_balances.erase (previous);
 				}
 			}
 			// Insert in backlog state blocks if previous wasn't already processed
 			else
 			{
-				lazy_state_backlog.emplace (previous, ysu::lazy_state_backlog_item{ link, balance, retry_limit });
+				lazy_state_backlog.insert (previous, previous, link, balance, retry_limit);
 			}
 		}
 	}
@@ -350,9 +350,9 @@ void ysu::bootstrap_attempt_lazy::lazy_block_state_backlog_check (std::shared_pt
 {
 	// Search unknown state blocks balances
 	auto find_state (lazy_state_backlog.find (hash_a));
-	if (find_state != lazy_state_backlog.end ())
+	if (find_state != nullptr)
 	{
-		auto next_block (find_state->second);
+		auto next_block (*find_state);
 		// Retrieve balance for previous state & send blocks
 		if (block_a->type () == ysu::block_type::state || block_a->type () == ysu::block_type::send)
 		{
@@ -366,25 +366,24 @@ void ysu::bootstrap_attempt_lazy::lazy_block_state_backlog_check (std::shared_pt
 			}
 		}
 		// Assumption for other legacy block types
-		else if (lazy_undefined_links.find (next_block.link.as_block_hash ()) == lazy_undefined_links.end ())
+		else if (!lazy_undefined_links.contains (next_block.link.as_block_hash ()))
 		{
 			lazy_add (next_block.link, node->network_params.bootstrap.lazy_retry_limit); // Head is not confirmed. It can be account or hash or non-existing
 			lazy_undefined_links.insert (next_block.link.as_block_hash ());
 		}
-		lazy_state_backlog.erase (find_state);
+		lazy_state_backlog.erase (hash_a);
 	}
 }
 
 void ysu::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 {
 	uint64_t read_count (0);
+	std::vector<ysu::block_hash> processed;
 	auto transaction (node->store.tx_begin_read ());
-	for (auto it (lazy_state_backlog.begin ()), end (lazy_state_backlog.end ()); it != end && !stopped;)
-	{
-		if (node->store.block_exists (transaction, it->first))
+	lazy_state_backlog.for_each ([this, &read_count, &processed, &transaction](ysu::lazy_state_backlog_item const & next_block) {
+		if (node->store.block_exists (transaction, next_block.previous))
 		{
-			auto next_block (it->second);
-			if (node->ledger.balance (transaction, it->first) <= next_block.balance) // balance
+			if (node->ledger.balance (transaction, next_block.previous) <= next_block.balance) // balance
 			{
 				lazy_add (next_block.link, next_block.retry_limit); // link
 			}
@@ -392,12 +391,11 @@ void ysu::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 			{
 				lazy_destinations_increment (next_block.link.as_account ());
 			}
-			it = lazy_state_backlog.erase (it);
+			processed.push_back (next_block.previous);
 		}
 		else
 		{
-			lazy_add (it->first, it->second.retry_limit);
-			++it;
+			lazy_add (next_block.previous, next_block.retry_limit);
 		}
 		// We don't want to open read transactions for too long
 		++read_count;
@@ -405,6 +403,12 @@ void ysu::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 		{
 			transaction.refresh ();
 		}
+		return !stopped;
+	});
+	// Entries move when others are erased, so they are only removed once the iteration is done
+	for (auto const & previous : processed)
+	{
+		lazy_state_backlog.erase (previous);
 	}
 }
 
@@ -444,8 +448,7 @@ void ysu::bootstrap_attempt_lazy::lazy_destinations_flush ()
 void ysu::bootstrap_attempt_lazy::lazy_blocks_insert (ysu::block_hash const & hash_a)
 {
 	debug_assert (!mutex.try_lock ());
-	auto inserted (lazy_blocks.insert (std::hash<::ysu::block_hash> () (hash_a)));
-	if (inserted.second)
+	if (lazy_blocks.insert (hash_a))
 	{
 		++lazy_blocks_count;
 		debug_assert (lazy_blocks_count > 0);
@@ -455,8 +458,7 @@ void ysu::bootstrap_attempt_lazy::lazy_blocks_insert (ysu::block_hash const & ha
 void ysu::bootstrap_attempt_lazy::lazy_blocks_erase (ysu::block_hash const & hash_a)
 {
 	debug_assert (!mutex.try_lock ());
-	auto erased (lazy_blocks.erase (std::hash<::ysu::block_hash> () (hash_a)));
-	if (erased)
+	if (lazy_blocks.erase (hash_a))
 	{
 		--lazy_blocks_count;
 		debug_assert (lazy_blocks_count != std::numeric_limits<size_t>::max ());
@@ -465,7 +467,7 @@ void ysu::bootstrap_attempt_lazy::lazy_blocks_erase (ysu::block_hash const & has
 
 bool ysu::bootstrap_attempt_lazy::lazy_blocks_processed (ysu::block_hash const & hash_a)
 {
-	return lazy_blocks.find (std::hash<::ysu::block_hash> () (hash_a)) != lazy_blocks.end ();
+	return lazy_blocks.contains (hash_a);
 }
 
 bool ysu::bootstrap_attempt_lazy::lazy_processed_or_exists (ysu::block_hash const & hash_a)
@@ -501,6 +503,14 @@ void ysu::bootstrap_attempt_lazy::get_information (boost::property_tree::ptree &
 	{
 		tree_a.put ("lazy_key_1", (*(lazy_keys.begin ())).to_string ());
 	}
+	auto memory (lazy_memory_usage ());
+	tree_a.put ("lazy_memory", std::to_string (memory));
+	tree_a.put ("lazy_memory_per_block", std::to_string (lazy_blocks.empty () ? 0 : memory / lazy_blocks.size ()));
+}
+
+size_t ysu::bootstrap_attempt_lazy::lazy_memory_usage ()
+{
+	return lazy_blocks.memory_usage () + lazy_state_backlog.memory_usage () + lazy_undefined_links.memory_usage () + lazy_balances.memory_usage ();
 }
 
 ysu::bootstrap_attempt_wallet::bootstrap_attempt_wallet (std::shared_ptr<ysu::node> node_a, uint64_t incremental_id_a, std::string id_a) :
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ysu/lib/fingerprint_table.hpp>
 #include <ysu/node/bootstrap/bootstrap_attempt.hpp>
 
 #include <boost/multi_index/hashed_index.hpp>
@@ -19,6 +20,7 @@ class node;
 class lazy_state_backlog_item final
 {
 public:
+	ysu::block_hash previous{ 0 };
 	ysu::link link{ 0 };
 	ysu::uint128_t balance{ 0 };
 	unsigned retry_limit{ 0 };
@@ -55,10 +57,14 @@ public:
 	bool lazy_blocks_processed (ysu::block_hash const &);
 	bool lazy_processed_or_exists (ysu::block_hash const &) override;
 	void get_information (boost::property_tree::ptree &) override;
-	std::unordered_set<size_t> lazy_blocks;
-	std::unordered_map<ysu::block_hash, ysu::lazy_state_backlog_item> lazy_state_backlog;
-	std::unordered_set<ysu::block_hash> lazy_undefined_links;
-	std::unordered_map<ysu::block_hash, ysu::uint128_t> lazy_balances;
+	/** Bytes allocated by the containers which grow with the number of pulled blocks */
+	size_t lazy_memory_usage ();
+	ysu::fingerprint_set lazy_blocks;
+	/** State blocks waiting for the balance of their previous block, keyed by previous */
+	ysu::fingerprint_map<ysu::lazy_state_backlog_item> lazy_state_backlog;
+	ysu::fingerprint_set lazy_undefined_links;
+	ysu::fingerprint_map<ysu::uint128_t> lazy_balances;
+	/** Limited to a few thousand start keys, which are iterated over to check for completion */
 	std::unordered_set<ysu::block_hash> lazy_keys;
 	std::deque<std::pair<ysu::hash_or_account, unsigned>> lazy_pulls;
 	std::chrono::steady_clock::time_point lazy_start_time;
@@ -0,0 +1,195 @@
+#include <ysu/node/bootstrap/bootstrap.hpp>
+#include <ysu/node/bootstrap/bootstrap_peer_scores.hpp>
+
+#include <istream>
+#include <ostream>
+
+constexpr size_t ysu::bootstrap_peer_scores::size_max;
+constexpr double ysu::bootstrap_peer_scores::smoothing;
+constexpr uint64_t ysu::bootstrap_peer_scores::failures_min;
+constexpr double ysu::bootstrap_peer_scores::reliability_min;
+
+template <typename Action>
+void ysu::bootstrap_peer_scores::modify (ysu::tcp_endpoint const & endpoint_a, Action action_a)
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	auto & peers_by_endpoint (peers.get<tag_endpoint> ());
+	auto existing (peers_by_endpoint.find (endpoint_a));
+	if (existing == peers_by_endpoint.end ())
+	{
+		// Forget the peers which haven't been seen for the longest time
+		while (peers.size () >= size_max)
+		{
+			peers.get<tag_update> ().erase (peers.get<tag_update> ().begin ());
+		}
+		item item_l;
+		item_l.endpoint = endpoint_a;
+		existing = peers_by_endpoint.insert (item_l).first;
+	}
+	peers_by_endpoint.modify (existing, [&action_a](item & item_a) {
+		item_a.last_update = std::chrono::steady_clock::now ();
+		action_a (item_a);
+	});
+}
+
+void ysu::bootstrap_peer_scores::connected (ysu::tcp_endpoint const & endpoint_a, std::chrono::steady_clock::duration latency_a)
+{
+	auto latency_ms (std::chrono::duration_cast<std::chrono::duration<double, std::milli>> (latency_a).count ());
+	modify (endpoint_a, [latency_ms](item & item_a) {
+		item_a.latency_ms = item_a.latency_ms == 0 ? latency_ms : item_a.latency_ms + (latency_ms - item_a.latency_ms) * smoothing;
+	});
+}
+
+void ysu::bootstrap_peer_scores::failed (ysu::tcp_endpoint const & endpoint_a)
+{
+	modify (endpoint_a, [](item & item_a) {
+		++item_a.failures;
+	});
+}
+
+void ysu::bootstrap_peer_scores::succeeded (ysu::tcp_endpoint const & endpoint_a)
+{
+	modify (endpoint_a, [](item & item_a) {
+		++item_a.successes;
+	});
+}
+
+void ysu::bootstrap_peer_scores::sample (ysu::tcp_endpoint const & endpoint_a, double block_rate_a)
+{
+	modify (endpoint_a, [block_rate_a](item & item_a) {
+		item_a.block_rate = item_a.rate_samples == 0 ? block_rate_a : item_a.block_rate + (block_rate_a - item_a.block_rate) * smoothing;
+		++item_a.rate_samples;
+	});
+}
+
+double ysu::bootstrap_peer_scores::score (item const & item_a) const
+{
+	// Laplace smoothing keeps a single failure from dominating the score of a new peer
+	auto reliability ((item_a.successes + 1.0) / (item_a.successes + item_a.failures + 2.0));
+	return item_a.block_rate * reliability / (1.0 + item_a.latency_ms / 1000.0);
+}
+
+boost::optional<double> ysu::bootstrap_peer_scores::score (ysu::tcp_endpoint const & endpoint_a) const
+{
+	boost::optional<double> result;
+	ysu::lock_guard<std::mutex> guard (mutex);
+	auto & peers_by_endpoint (peers.get<tag_endpoint> ());
+	auto existing (peers_by_endpoint.find (endpoint_a));
+	if (existing != peers_by_endpoint.end () && existing->rate_samples > 0)
+	{
+		result = score (*existing);
+	}
+	return result;
+}
+
+bool ysu::bootstrap_peer_scores::poor (ysu::tcp_endpoint const & endpoint_a) const
+{
+	bool result (false);
+	ysu::lock_guard<std::mutex> guard (mutex);
+	auto & peers_by_endpoint (peers.get<tag_endpoint> ());
+	auto existing (peers_by_endpoint.find (endpoint_a));
+	if (existing != peers_by_endpoint.end ())
+	{
+		auto unreliable (existing->failures >= failures_min && (existing->successes + 1.0) / (existing->successes + existing->failures + 2.0) < reliability_min);
+		auto slow (existing->rate_samples > 0 && existing->block_rate < ysu::bootstrap_limits::bootstrap_minimum_blocks_per_sec);
+		result = unreliable || slow;
+	}
+	return result;
+}
+
+ysu::tcp_endpoint ysu::bootstrap_peer_scores::select (std::vector<ysu::tcp_endpoint> const & candidates_a) const
+{
+	debug_assert (!candidates_a.empty ());
+	auto result (candidates_a.front ());
+	ysu::lock_guard<std::mutex> guard (mutex);
+	double sum (0);
+	size_t scored (0);
+	for (auto const & peer : peers)
+	{
+		if (peer.rate_samples > 0)
+		{
+			sum += score (peer);
+			++scored;
+		}
+	}
+	auto average (scored != 0 ? sum / scored : 0.0);
+	auto best (-1.0);
+	auto & peers_by_endpoint (peers.get<tag_endpoint> ());
+	for (auto const & candidate : candidates_a)
+	{
+		auto existing (peers_by_endpoint.find (candidate));
+		auto score_l (existing != peers_by_endpoint.end () && existing->rate_samples > 0 ? score (*existing) : average);
+		if (score_l > best)
+		{
+			best = score_l;
+			result = candidate;
+		}
+	}
+	return result;
+}
+
+size_t ysu::bootstrap_peer_scores::size () const
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return peers.size ();
+}
+
+void ysu::bootstrap_peer_scores::serialize (std::ostream & stream_a) const
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	uint64_t count (peers.size ());
+	stream_a.write (reinterpret_cast<char const *> (&count), sizeof (count));
+	for (auto const & peer : peers.get<tag_update> ())
+	{
+		auto address (peer.endpoint.address ().to_v6 ().to_bytes ());
+		auto port (peer.endpoint.port ());
+		stream_a.write (reinterpret_cast<char const *> (address.data ()), address.size ());
+		stream_a.write (reinterpret_cast<char const *> (&port), sizeof (port));
+		double rates[] = { peer.block_rate, peer.latency_ms };
+		stream_a.write (reinterpret_cast<char const *> (rates), sizeof (rates));
+		uint64_t counts[] = { peer.rate_samples, peer.successes, peer.failures };
+		stream_a.write (reinterpret_cast<char const *> (counts), sizeof (counts));
+	}
+}
+
+bool ysu::bootstrap_peer_scores::deserialize (std::istream & stream_a)
+{
+	uint64_t count (0);
+	auto error (!stream_a.read (reinterpret_cast<char *> (&count), sizeof (count)) || count > size_max);
+	ordered_peers peers_l;
+	// Equal update times keep their insertion order, so the least recently updated peers are still forgotten first
+	auto now (std::chrono::steady_clock::now ());
+	for (uint64_t i (0); !error && i < count; ++i)
+	{
+		boost::asio::ip::address_v6::bytes_type address;
+		uint16_t port;
+		double rates[2];
+		uint64_t counts[3];
+		error = !stream_a.read (reinterpret_cast<char *> (address.data ()), address.size ()) || !stream_a.read (reinterpret_cast<char *> (&port), sizeof (port)) || !stream_a.read (reinterpret_cast<char *> (rates), sizeof (rates)) || !stream_a.read (reinterpret_cast<char *> (counts), sizeof (counts));
+		if (!error)
+		{
+			item item_l;
+			item_l.endpoint = ysu::tcp_endpoint (boost::asio::ip::address_v6 (address), port);
+			item_l.last_update = now;
+			item_l.block_rate = rates[0];
+			item_l.latency_ms = rates[1];
+			item_l.rate_samples = counts[0];
+			item_l.successes = counts[1];
+			item_l.failures = counts[2];
+			peers_l.insert (item_l);
+		}
+	}
+	if (!error)
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		peers = std::move (peers_l);
+	}
+	return error;
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (ysu::bootstrap_peer_scores const & peer_scores, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", peer_scores.size (), sizeof (ysu::bootstrap_peer_scores::ordered_peers::value_type) }));
+	return composite;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ysu/node/common.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/optional.hpp>
+
+#include <iosfwd>
+
+namespace mi = boost::multi_index;
+
+namespace ysu
+{
+/**
+ * Remembers how bootstrap peers performed across connections and attempts, so that peers can be ranked
+ * by the block rate they are expected to deliver before connecting to them. The node keeps the scores in a file
+ * next to the ledger across restarts.
+ */
+class bootstrap_peer_scores final
+{
+	class item final
+	{
+	public:
+		ysu::tcp_endpoint endpoint;
+		std::chrono::steady_clock::time_point last_update;
+		/** Smoothed blocks per second over connections which got past the warmup time */
+		double block_rate{ 0 };
+		/** Smoothed time to establish a connection */
+		double latency_ms{ 0 };
+		uint64_t rate_samples{ 0 };
+		uint64_t successes{ 0 };
+		uint64_t failures{ 0 };
+	};
+
+	// clang-format off
+	class tag_endpoint {};
+	class tag_update {};
+	// clang-format on
+
+public:
+	// clang-format off
+	using ordered_peers = boost::multi_index_container<item,
+	mi::indexed_by<
+		mi::ordered_non_unique<mi::tag<tag_update>,
+			mi::member<item, std::chrono::steady_clock::time_point, &item::last_update>>,
+		mi::hashed_unique<mi::tag<tag_endpoint>,
+			mi::member<item, ysu::tcp_endpoint, &item::endpoint>>>>;
+	// clang-format on
+
+	constexpr static size_t size_max = 5000;
+	/** Weight of a new sample in the smoothed block rate and latency */
+	constexpr static double smoothing = 0.3;
+	/** Failures needed before a peer can be considered unreliable */
+	constexpr static uint64_t failures_min = 3;
+	constexpr static double reliability_min = 0.25;
+
+	void connected (ysu::tcp_endpoint const &, std::chrono::steady_clock::duration latency);
+	/** A connection attempt or pull which ended in a network error */
+	void failed (ysu::tcp_endpoint const &);
+	/** A pull which returned the whole requested chain */
+	void succeeded (ysu::tcp_endpoint const &);
+	void sample (ysu::tcp_endpoint const &, double block_rate);
+	/** Expected blocks per second from the peer, discounted by its failure ratio and connection latency. Empty for peers without rate samples */
+	boost::optional<double> score (ysu::tcp_endpoint const &) const;
+	/** Peers which proved slower than the minimum bootstrap rate or failed most of their requests */
+	bool poor (ysu::tcp_endpoint const &) const;
+	/** The candidate expected to be fastest. Unscored peers rank as the average scored peer so they still get tried */
+	ysu::tcp_endpoint select (std::vector<ysu::tcp_endpoint> const &) const;
+	size_t size () const;
+	/** Writes the scores least recently updated first */
+	void serialize (std::ostream &) const;
+	/** Replaces the scores with the ones written by serialize. Returns true and keeps the current scores on error */
+	bool deserialize (std::istream &);
+
+private:
+	template <typename Action>
+	void modify (ysu::tcp_endpoint const &, Action);
+	double score (item const &) const;
+	ordered_peers peers;
+	mutable std::mutex mutex;
+};
+std::unique_ptr<container_info_component> collect_container_info (bootstrap_peer_scores const & peer_scores, const std::string & name);
+}
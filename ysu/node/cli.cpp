@@ -4,6 +4,7 @@
 #include <ysu/node/common.hpp>
 #include <ysu/node/daemonconfig.hpp>
 #include <ysu/node/node.hpp>
+#include <ysu/secure/snapshot.hpp>
 
 #include <boost/format.hpp>
 
@@ -49,6 +50,9 @@ void ysu::add_node_options (boost::program_options::options_description & descri
 	("account_key", "Get the public key for <account>")
 	("vacuum", "Compact database. If data_path is missing, the database in data directory is compacted.")
 	("snapshot", "Compact database and create snapshot, functions similar to vacuum but does not replace the existing database")
+	("snapshot_export", boost::program_options::value<std::string> (), "Write a ledger snapshot, independent of the database backend, to the <arg> directory")
+	("snapshot_import", boost::program_options::value<std::string> (), "Load the ledger snapshot in the <arg> directory into a new ledger in data_path")
+	("snapshot_hash", boost::program_options::value<std::string> (), "Manifest hash of the trusted snapshot loaded by snapshot_import")
 	("data_path", boost::program_options::value<std::string> (), "Use the supplied path as the data directory")
 	("network", boost::program_options::value<std::string> (), "Use the supplied network (live, test, beta or dev)")
 	("clear_send_ids", "Remove all send IDs from the database (dangerous: not intended for production use)")
@@ -100,6 +104,8 @@ void ysu::add_node_flag_options (boost::program_options::options_description & d
 		("disable_providing_telemetry_metrics", "Disable using any node information in the telemetry_ack messages.")
 		("disable_block_processor_unchecked_deletion", "Disable deletion of unchecked blocks after processing")
 		("enable_pruning", "Enable experimental ledger pruning")
+		("enable_ascending_bootstrap", "Enable experimental bootstrap of accounts with missing blocks, pulled oldest first")
+		("enable_balance_index", "Maintain an index of accounts ordered by balance, used by the ledger RPC with sorting. Dropped when started without this flag")
 		("allow_bootstrap_peers_duplicates", "Allow multiple connections to same peer in bootstrap attempts")
 		("fast_bootstrap", "Increase bootstrap speed for high end nodes with higher limits")
 		("block_processor_batch_size", boost::program_options::value<std::size_t>(), "Increase block processor transaction batch write size, default 0 (limited by config block_processor_batch_max_time), 256k for fast_bootstrap")
@@ -137,6 +143,8 @@ std::error_code ysu::update_flags (ysu::node_flags & flags_a, boost::program_opt
 	flags_a.disable_unchecked_drop = (vm.count ("disable_unchecked_drop") > 0);
 	flags_a.disable_block_processor_unchecked_deletion = (vm.count ("disable_block_processor_unchecked_deletion") > 0);
 	flags_a.enable_pruning = (vm.count ("enable_pruning") > 0);
+	flags_a.enable_ascending_bootstrap = (vm.count ("enable_ascending_bootstrap") > 0);
+	flags_a.enable_balance_index = (vm.count ("enable_balance_index") > 0);
 	flags_a.allow_bootstrap_peers_duplicates = (vm.count ("allow_bootstrap_peers_duplicates") > 0);
 	flags_a.fast_bootstrap = (vm.count ("fast_bootstrap") > 0);
 	if (flags_a.fast_bootstrap)
@@ -212,7 +220,7 @@ bool copy_database (boost::filesystem::path const & data_path, boost::program_op
 		if (vm.count ("unchecked_clear"))
 		{
 			auto transaction (node.node->store.tx_begin_write ());
-			node.node->store.unchecked_clear (transaction);
+			node.node->ledger.unchecked_clear (transaction);
 		}
 		if (vm.count ("clear_send_ids"))
 		{
@@ -377,6 +385,8 @@ std::error_code ysu::handle_node_options (boost::program_options::variables_map
 						boost::filesystem::remove (backup_path);
 						boost::filesystem::rename (source_path, backup_path);
 						boost::filesystem::rename (vacuum_path, source_path);
+						// The cold tier of the source stays in place
+						boost::filesystem::remove_all (vacuum_path.string () + "-cold");
 					}
 					std::cout << "Vacuum completed" << std::endl;
 				}
@@ -446,6 +456,93 @@ std::error_code ysu::handle_node_options (boost::program_options::variables_map
 			std::cerr << "Snapshot failed (unknown reason)" << std::endl;
 		}
 	}
+	else if (vm.count ("snapshot_export"))
+	{
+		boost::filesystem::path snapshot_path (vm["snapshot_export"].as<std::string> ());
+		auto node_flags = ysu::inactive_node_flag_defaults ();
+		ysu::update_flags (node_flags, vm);
+		ysu::inactive_node node (data_path, node_flags);
+		if (!node.node->init_error ())
+		{
+			std::cout << "Exporting ledger snapshot to " << snapshot_path << std::endl;
+			std::cout << "This may take a while..." << std::endl;
+			auto error (ysu::snapshot_export (node.node->store, snapshot_path));
+			if (!error)
+			{
+				std::cout << "Snapshot exported, manifest hash " << ysu::snapshot_hash (snapshot_path).to_string () << std::endl;
+			}
+			else
+			{
+				std::cerr << "Snapshot export failed: " << error.get_message () << std::endl;
+				ec = ysu::error_cli::generic;
+			}
+		}
+		else
+		{
+			std::cerr << "Error initializing node" << std::endl;
+			ec = ysu::error_cli::generic;
+		}
+	}
+	else if (vm.count ("snapshot_import"))
+	{
+		boost::filesystem::path snapshot_path (vm["snapshot_import"].as<std::string> ());
+		ysu::uint256_union expected_hash;
+		ysu::daemon_config config (data_path);
+		if (ysu::read_node_config_toml (data_path, config))
+		{
+			ec = ysu::error_cli::reading_config;
+		}
+		else if (boost::filesystem::exists (data_path / "data.ldb") || boost::filesystem::exists (data_path / "rocksdb"))
+		{
+			std::cerr << "Snapshots can only be imported into a new ledger, " << data_path << " already holds one" << std::endl;
+			ec = ysu::error_cli::invalid_arguments;
+		}
+		else if (expected_hash.decode_hex (vm.count ("snapshot_hash") ? vm["snapshot_hash"].as<std::string> () : ""))
+		{
+			std::cerr << "snapshot_hash is required, the manifest hash of " << snapshot_path << " is " << ysu::snapshot_hash (snapshot_path).to_string () << ", check it matches the one of a trusted snapshot" << std::endl;
+			ec = ysu::error_cli::invalid_arguments;
+		}
+		else
+		{
+			std::cout << "Importing ledger snapshot from " << snapshot_path << std::endl;
+			// The ledger is loaded next to data_path and only moved into it once complete, so a failed import leaves nothing behind
+			auto import_path (data_path / "snapshot_import");
+			boost::system::error_code error_chmod;
+			boost::filesystem::remove_all (import_path);
+			boost::filesystem::create_directories (import_path);
+			ysu::set_secure_perm_directory (import_path, error_chmod);
+			ysu::error error;
+			{
+				ysu::logger_mt logger;
+				auto store (ysu::make_store (logger, import_path, false, true, config.node.rocksdb_config, config.node.diagnostics_config.txn_tracking, config.node.block_processor_batch_max_time, config.node.lmdb_config, false, config.node.rocksdb_config.enable));
+				error = store->init_error () ? ysu::error ("Could not open the ledger") : ysu::snapshot_import (*store, snapshot_path, expected_hash, std::max (1u, std::thread::hardware_concurrency ()));
+			}
+			if (!error)
+			{
+				try
+				{
+					for (boost::filesystem::directory_iterator i (import_path), n; i != n; ++i)
+					{
+						boost::filesystem::rename (i->path (), data_path / i->path ().filename ());
+					}
+				}
+				catch (boost::filesystem::filesystem_error const & ex)
+				{
+					error = ex;
+				}
+			}
+			boost::filesystem::remove_all (import_path);
+			if (!error)
+			{
+				std::cout << "Snapshot imported" << std::endl;
+			}
+			else
+			{
+				std::cerr << "Snapshot import failed: " << error.get_message () << std::endl;
+				ec = ysu::error_cli::generic;
+			}
+		}
+	}
 	else if (vm.count ("unchecked_clear"))
 	{
 		boost::filesystem::path data_path = vm.count ("data_path") ? boost::filesystem::path (vm["data_path"].as<std::string> ()) : ysu::working_path ();
@@ -456,7 +553,7 @@ std::error_code ysu::handle_node_options (boost::program_options::variables_map
 		if (!node.node->init_error ())
 		{
 			auto transaction (node.node->store.tx_begin_write ());
-			node.node->store.unchecked_clear (transaction);
+			node.node->ledger.unchecked_clear (transaction);
 			std::cout << "Unchecked blocks deleted" << std::endl;
 		}
 		else
@@ -0,0 +1,209 @@
+#include <ysu/lib/threading.hpp>
+#include <ysu/node/cold_storage.hpp>
+#include <ysu/node/node.hpp>
+#include <ysu/secure/cold_store.hpp>
+
+#include <boost/format.hpp>
+
+constexpr uint64_t ysu::cold_storage::batch_size;
+constexpr uint64_t ysu::cold_storage::segment_size;
+constexpr uint64_t ysu::cold_storage::minimum_segment_size;
+constexpr std::chrono::minutes ysu::cold_storage::pass_interval;
+
+ysu::cold_storage::cold_storage (ysu::node & node_a) :
+node (node_a)
+{
+}
+
+ysu::cold_storage::~cold_storage ()
+{
+	stop ();
+}
+
+bool ysu::cold_storage::start ()
+{
+	debug_assert (!thread.joinable ());
+	auto error (node.store.cold_open ());
+	if (!error)
+	{
+		thread = std::thread ([this]() {
+			ysu::thread_role::set (ysu::thread_role::name::cold_storage);
+			run ();
+		});
+	}
+	return error;
+}
+
+void ysu::cold_storage::stop ()
+{
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+void ysu::cold_storage::trigger ()
+{
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		triggered = true;
+	}
+	condition.notify_all ();
+}
+
+ysu::cold_storage_status ysu::cold_storage::status ()
+{
+	ysu::lock_guard<ysu::mutex> guard (mutex);
+	return status_m;
+}
+
+void ysu::cold_storage::run ()
+{
+	ysu::unique_lock<ysu::mutex> lock (mutex);
+	while (!stopped)
+	{
+		auto triggered_l (triggered);
+		triggered = false;
+		lock.unlock ();
+		pass (triggered_l);
+		lock.lock ();
+		condition.wait_for (lock, pass_interval, [this]() { return stopped || triggered; });
+	}
+}
+
+void ysu::cold_storage::pass (bool triggered_a)
+{
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		status_m.active = true;
+	}
+	uint64_t moved_count (0);
+	auto more (true);
+	while (more && !stopped)
+	{
+		auto hashes (collect (node.config.cold_storage_depth, segment_size));
+		more = hashes.size () >= segment_size;
+		if (hashes.empty () || (hashes.size () < minimum_segment_size && !triggered_a))
+		{
+			break;
+		}
+		// The segment is durable before any block is deleted, so an interrupted move leaves blocks in both tiers
+		if (node.store.cold_put (node.store.tx_begin_read (), hashes))
+		{
+			node.logger.always_log ("Failed to write a cold storage segment");
+			break;
+		}
+		// Lowest blocks of each account are deleted first, so that the blocks still in the database are always the highest ones
+		auto i (hashes.rbegin ());
+		auto n (hashes.rend ());
+		while (i != n && !stopped)
+		{
+			// Moving blocks shares the write lock with block processing, which takes priority
+			{
+				ysu::unique_lock<ysu::mutex> lock (mutex);
+				if (node.block_processor.half_full ())
+				{
+					++status_m.pauses;
+				}
+				while (node.block_processor.half_full () && !stopped)
+				{
+					condition.wait_for (lock, std::chrono::seconds (1), [this]() { return stopped.load (); });
+				}
+			}
+			uint64_t transaction_moved (0);
+			{
+				auto scoped_write_guard = node.write_database_queue.wait (ysu::writer::cold_storage);
+				auto transaction (node.store.tx_begin_write ({ tables::blocks }));
+				for (; i != n && transaction_moved < batch_size; ++i, ++transaction_moved)
+				{
+					node.store.cold_release (transaction, *i);
+				}
+			}
+			moved_count += transaction_moved;
+			ysu::lock_guard<ysu::mutex> guard (mutex);
+			status_m.blocks_moved += transaction_moved;
+		}
+	}
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		status_m.active = false;
+		++status_m.passes;
+		status_m.last_pass = ysu::seconds_since_epoch ();
+	}
+	if (moved_count != 0)
+	{
+		node.logger.always_log (boost::str (boost::format ("Moved %1% blocks to cold storage, %2% blocks in cold storage in total") % moved_count % node.store.get_cold_store ()->size ()));
+	}
+}
+
+std::vector<ysu::block_hash> ysu::cold_storage::collect (uint64_t depth_a, uint64_t max_a)
+{
+	std::vector<ysu::block_hash> result;
+	std::mutex result_mutex;
+	std::atomic<uint64_t> collected{ 0 };
+	node.store.confirmation_height_for_each_par ([this, &result, &result_mutex, &collected, depth_a, max_a](ysu::read_transaction const & transaction_a, ysu::store_iterator<ysu::account, ysu::confirmation_height_info> i, ysu::store_iterator<ysu::account, ysu::confirmation_height_info> n) {
+		std::vector<ysu::block_hash> hashes_l;
+		for (; i != n && !stopped && collected < max_a; ++i)
+		{
+			auto const & account (i->first);
+			auto const & height (i->second.height);
+			if (height > depth_a)
+			{
+				auto target (height - depth_a);
+				auto lowest (lowest_hot_height (transaction_a, account, target));
+				if (lowest <= target)
+				{
+					// When the segment fills up the lowest blocks are taken, the rest is moved by the next segment
+					auto wanted (target - lowest + 1);
+					auto start (collected.fetch_add (wanted));
+					auto count (start < max_a ? std::min (wanted, max_a - start) : 0);
+					for (auto height_l (lowest + count); height_l > lowest; --height_l)
+					{
+						auto hash (node.store.account_height_get (transaction_a, account, height_l - 1));
+						if (!hash.is_zero ())
+						{
+							hashes_l.push_back (hash);
+						}
+					}
+				}
+			}
+		}
+		std::lock_guard<std::mutex> guard (result_mutex);
+		result.insert (result.end (), hashes_l.begin (), hashes_l.end ());
+	});
+	return result;
+}
+
+uint64_t ysu::cold_storage::lowest_hot_height (ysu::transaction const & transaction_a, ysu::account const & account_a, uint64_t target_a)
+{
+	auto hot = [this, &transaction_a, &account_a](uint64_t height_a) {
+		auto hash (node.store.account_height_get (transaction_a, account_a, height_a));
+		return !hash.is_zero () && node.store.block_exists_hot (transaction_a, hash);
+	};
+	uint64_t result (1);
+	if (!hot (result))
+	{
+		// Heights up to low were moved, high is still in the database or past the target
+		uint64_t low (1);
+		uint64_t high (target_a + 1);
+		while (high - low > 1)
+		{
+			auto middle (low + (high - low) / 2);
+			if (hot (middle))
+			{
+				high = middle;
+			}
+			else
+			{
+				low = middle;
+			}
+		}
+		result = high;
+	}
+	return result;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <ysu/lib/locks.hpp>
+#include <ysu/lib/numbers.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace ysu
+{
+class node;
+class transaction;
+
+class cold_storage_status final
+{
+public:
+	/** A pass is collecting or moving blocks */
+	bool active{ false };
+	uint64_t passes{ 0 };
+	/** Blocks moved to the cold tier since the node started */
+	uint64_t blocks_moved{ 0 };
+	/** Number of times moving blocks waited for the block processor */
+	uint64_t pauses{ 0 };
+	/** Seconds since epoch when the last pass completed, 0 if none did */
+	uint64_t last_pass{ 0 };
+};
+
+/**
+ * Moves blocks cemented more than node_config::cold_storage_depth blocks below the confirmed frontier of their account out
+ * of the database into the cold tier of the block store, where block_get still finds them.
+ *
+ * Moved blocks are always the lowest ones of their account, so the blocks of an account which are still in the database
+ * are found by a binary search over heights. Each pass walks the confirmation heights in parallel read transactions and
+ * collects up to segment_size blocks, highest first for each account, so that readers following previous from a frontier
+ * read consecutive records. They are written to a segment, then deleted from the database in write transactions of about
+ * batch_size blocks, waiting while the block processor is half full. Passes which would write fewer than
+ * minimum_segment_size blocks are skipped unless triggered, so that segments aren't fragmented.
+ */
+class cold_storage final
+{
+public:
+	explicit cold_storage (ysu::node &);
+	~cold_storage ();
+	/** Opens the cold tier of the store and starts moving blocks. Returns true on error */
+	bool start ();
+	void stop ();
+	/** Starts the next pass now instead of after pass_interval, writing a segment however few blocks there are to move */
+	void trigger ();
+	ysu::cold_storage_status status ();
+	static uint64_t constexpr batch_size = 2 * 1024;
+	static uint64_t constexpr segment_size = 1024 * 1024;
+	static uint64_t constexpr minimum_segment_size = 64 * 1024;
+	static std::chrono::minutes constexpr pass_interval{ 15 };
+
+private:
+	void run ();
+	void pass (bool triggered_a);
+	std::vector<ysu::block_hash> collect (uint64_t depth_a, uint64_t max_a);
+	/** Height of the lowest block of \p account_a which is still in the database, or \p target_a + 1 if there is none up to it */
+	uint64_t lowest_hot_height (ysu::transaction const & transaction_a, ysu::account const & account_a, uint64_t target_a);
+	ysu::node & node;
+	ysu::cold_storage_status status_m;
+	std::atomic<bool> stopped{ false };
+	bool triggered{ false };
+	ysu::mutex mutex{ "cold_storage" };
+	ysu::condition_variable condition;
+	std::thread thread;
+};
+}
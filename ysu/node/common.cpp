@@ -993,6 +993,16 @@ void ysu::bulk_pull::set_count_present (bool value_a)
 	header.extensions.set (count_present_flag, value_a);
 }
 
+bool ysu::bulk_pull::is_ascending () const
+{
+	return header.extensions.test (ascending_flag);
+}
+
+void ysu::bulk_pull::set_ascending (bool value_a)
+{
+	header.extensions.set (ascending_flag, value_a);
+}
+
 ysu::bulk_pull_account::bulk_pull_account () :
 message (ysu::message_type::bulk_pull_account)
 {
@@ -208,6 +208,7 @@ public:
 
 	void flag_set (uint8_t);
 	static uint8_t constexpr bulk_pull_count_present_flag = 0;
+	static uint8_t constexpr bulk_pull_ascending_flag = 1;
 	bool bulk_pull_is_count_present () const;
 	static uint8_t constexpr node_id_handshake_query_flag = 0;
 	static uint8_t constexpr node_id_handshake_response_flag = 1;
@@ -415,7 +416,11 @@ public:
 	count_t count{ 0 };
 	bool is_count_present () const;
 	void set_count_present (bool);
+	/** Blocks are requested oldest first, starting after the \p start block, or with the open block if \p start is an account */
+	bool is_ascending () const;
+	void set_ascending (bool);
 	static size_t constexpr count_present_flag = ysu::message_header::bulk_pull_count_present_flag;
+	static size_t constexpr ascending_flag = ysu::message_header::bulk_pull_ascending_flag;
 	static size_t constexpr extended_parameters_size = 8;
 	static size_t constexpr size = sizeof (start) + sizeof (end);
 };
@@ -182,6 +182,12 @@ void ysu::confirmation_height_processor::add_block_already_cemented_observer (st
 	block_already_cemented_observers.push_back (callback_a);
 }
 
+// Not thread-safe, only call before this processor has begun cementing
+void ysu::confirmation_height_processor::add_cemented_batch_observer (std::function<void()> const & callback_a)
+{
+	cemented_batch_observers.push_back (callback_a);
+}
+
 void ysu::confirmation_height_processor::notify_observers (std::vector<std::shared_ptr<ysu::block>> const & cemented_blocks)
 {
 	for (auto const & block_callback_data : cemented_blocks)
@@ -191,6 +197,10 @@ void ysu::confirmation_height_processor::notify_observers (std::vector<std::shar
 			observer (block_callback_data);
 		}
 	}
+	for (auto const & observer : cemented_batch_observers)
+	{
+		observer ();
+	}
 }
 
 void ysu::confirmation_height_processor::notify_observers (ysu::block_hash const & hash_already_cemented_a)
@@ -45,6 +45,8 @@ public:
 
 	void add_cemented_observer (std::function<void(std::shared_ptr<ysu::block>)> const &);
 	void add_block_already_cemented_observer (std::function<void(ysu::block_hash const &)> const &);
+	/** Called once per written batch, after the cemented observers were called for each of its blocks */
+	void add_cemented_batch_observer (std::function<void()> const &);
 
 private:
 	mutable std::mutex mutex;
@@ -71,6 +73,7 @@ private:
 	// No mutex needed for the observers as these should be set up during initialization of the node
 	std::vector<std::function<void(std::shared_ptr<ysu::block>)>> cemented_observers;
 	std::vector<std::function<void(ysu::block_hash const &)>> block_already_cemented_observers;
+	std::vector<std::function<void()>> cemented_batch_observers;
 
 	ysu::ledger & ledger;
 	ysu::write_database_queue & write_database_queue;
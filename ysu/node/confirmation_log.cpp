@@ -0,0 +1,407 @@
+#include <ysu/crypto/blake2/blake2.h>
+#include <ysu/lib/blocks.hpp>
+#include <ysu/lib/logger_mt.hpp>
+#include <ysu/lib/tomlconfig.hpp>
+#include <ysu/node/confirmation_log.hpp>
+#include <ysu/secure/buffer.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast/try_lexical_convert.hpp>
+
+#include <algorithm>
+
+ysu::error ysu::confirmation_log_config::serialize_toml (ysu::tomlconfig & toml) const
+{
+	toml.put ("enable", enabled, "Write cemented blocks to a durable log, which consumers can replay from any sequence number.\ntype:bool");
+	toml.put ("segment_size", segment_size, "Size in bytes after which a new segment file is started. Retention deletes whole segments.\ntype:uint64");
+	toml.put ("max_size", max_size, "Maximum total size of the log in bytes before the oldest segments are deleted. 0 disables size based retention.\ntype:uint64");
+	toml.put ("max_age", max_age.count (), "Segments which have not been written to for this many hours are deleted. 0 disables age based retention.\ntype:hours");
+	return toml.get_error ();
+}
+
+ysu::error ysu::confirmation_log_config::deserialize_toml (ysu::tomlconfig & toml)
+{
+	toml.get<bool> ("enable", enabled);
+	toml.get<uint64_t> ("segment_size", segment_size);
+	toml.get<uint64_t> ("max_size", max_size);
+	auto max_age_l (max_age.count ());
+	toml.get ("max_age", max_age_l);
+	max_age = std::chrono::hours (max_age_l);
+	if (segment_size < ysu::confirmation_log::max_payload_size)
+	{
+		toml.get_error ().set ("segment_size must be at least " + std::to_string (ysu::confirmation_log::max_payload_size));
+	}
+	return toml.get_error ();
+}
+
+constexpr std::chrono::minutes ysu::confirmation_log::retention_interval;
+
+namespace
+{
+size_t constexpr record_header_size = sizeof (uint32_t) + sizeof (uint32_t);
+
+uint32_t record_checksum (uint8_t const * data_a, size_t size_a)
+{
+	uint32_t result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result));
+	blake2b_update (&state, data_a, size_a);
+	blake2b_final (&state, reinterpret_cast<uint8_t *> (&result), sizeof (result));
+	return result;
+}
+
+/** Reads the record at the current position of \p stream_a into \p payload_a. Returns true if there is no complete, valid record. */
+bool read_record (std::ifstream & stream_a, std::vector<uint8_t> & payload_a)
+{
+	uint32_t size (0);
+	uint32_t checksum (0);
+	stream_a.read (reinterpret_cast<char *> (&size), sizeof (size));
+	stream_a.read (reinterpret_cast<char *> (&checksum), sizeof (checksum));
+	auto error (!stream_a || size > ysu::confirmation_log::max_payload_size);
+	if (!error)
+	{
+		payload_a.resize (size);
+		stream_a.read (reinterpret_cast<char *> (payload_a.data ()), size);
+		error = !stream_a || record_checksum (payload_a.data (), payload_a.size ()) != checksum;
+	}
+	return error;
+}
+
+/** Returns true if the payload cannot be decoded */
+bool decode_record (std::vector<uint8_t> const & payload_a, ysu::confirmation_log_entry & entry_a)
+{
+	ysu::bufferstream stream (payload_a.data (), payload_a.size ());
+	auto error (ysu::try_read (stream, entry_a.sequence) || ysu::try_read (stream, entry_a.timestamp));
+	if (!error)
+	{
+		entry_a.block = ysu::deserialize_block (stream);
+		error = entry_a.block == nullptr;
+		if (!error)
+		{
+			ysu::block_sideband sideband;
+			error = sideband.deserialize (stream, entry_a.block->type ());
+			if (!error)
+			{
+				entry_a.block->sideband_set (sideband);
+			}
+		}
+	}
+	return error;
+}
+}
+
+ysu::confirmation_log::confirmation_log (boost::filesystem::path const & path_a, ysu::confirmation_log_config const & config_a, ysu::logger_mt & logger_a) :
+path (path_a),
+config (config_a),
+logger (logger_a)
+{
+	boost::filesystem::create_directories (path);
+	recover ();
+	apply_retention_locked ();
+}
+
+ysu::confirmation_log::~confirmation_log ()
+{
+	sync ();
+}
+
+void ysu::confirmation_log::recover ()
+{
+	for (auto const & entry : boost::filesystem::directory_iterator (path))
+	{
+		auto const & file (entry.path ());
+		if (file.extension () == ".log")
+		{
+			uint64_t first (0);
+			if (!boost::conversion::try_lexical_convert (file.stem ().string (), first) || first == 0)
+			{
+				logger.always_log ("Confirmation log: ignoring unexpected file ", file.string ());
+				continue;
+			}
+			segment segment_l;
+			segment_l.path = file;
+			segment_l.first_sequence = first;
+			segment_l.size = boost::filesystem::file_size (file);
+			total_size += segment_l.size;
+			segments.emplace (first, std::move (segment_l));
+		}
+	}
+	if (!segments.empty ())
+	{
+		// Only the last segment can contain a torn record; closed segments are indexed lazily on first read
+		auto & last (segments.rbegin ()->second);
+		index_segment (last, true);
+		sequence = last.first_sequence + last.entry_count - 1;
+		output.open (last.path.string (), std::ios::binary | std::ios::out | std::ios::app);
+	}
+}
+
+void ysu::confirmation_log::index_segment (segment & segment_a, bool truncate_a)
+{
+	std::ifstream input (segment_a.path.string (), std::ios::binary);
+	std::vector<uint8_t> payload;
+	uint64_t offset (0);
+	segment_a.entry_count = 0;
+	segment_a.index.clear ();
+	while (offset < segment_a.size)
+	{
+		if (segment_a.entry_count % index_interval == 0)
+		{
+			segment_a.index.push_back (offset);
+		}
+		// Closed segments were validated when they were last written to, only their headers are read here
+		auto error (false);
+		if (truncate_a)
+		{
+			error = read_record (input, payload);
+		}
+		else
+		{
+			uint32_t size (0);
+			error = !input.read (reinterpret_cast<char *> (&size), sizeof (size)) || !input.seekg (sizeof (uint32_t) + size, std::ios::cur);
+			payload.resize (size);
+		}
+		if (error)
+		{
+			if (segment_a.index.back () == offset)
+			{
+				segment_a.index.pop_back ();
+			}
+			break;
+		}
+		offset += record_header_size + payload.size ();
+		++segment_a.entry_count;
+	}
+	if (truncate_a && offset < segment_a.size)
+	{
+		logger.always_log (boost::str (boost::format ("Confirmation log: truncating %1% bytes of incomplete records from %2%") % (segment_a.size - offset) % segment_a.path.string ()));
+		boost::filesystem::resize_file (segment_a.path, offset);
+		total_size -= segment_a.size - offset;
+		segment_a.size = offset;
+	}
+	segment_a.indexed = true;
+}
+
+boost::filesystem::path ysu::confirmation_log::segment_path (uint64_t first_sequence_a) const
+{
+	return path / boost::str (boost::format ("%020d.log") % first_sequence_a);
+}
+
+void ysu::confirmation_log::open_segment (uint64_t first_sequence_a)
+{
+	if (output.is_open ())
+	{
+		output.close ();
+	}
+	segment segment_l;
+	segment_l.path = segment_path (first_sequence_a);
+	segment_l.first_sequence = first_sequence_a;
+	segment_l.indexed = true;
+	output.open (segment_l.path.string (), std::ios::binary | std::ios::out | std::ios::trunc);
+	segments[first_sequence_a] = std::move (segment_l);
+	segment_created = true;
+}
+
+uint64_t ysu::confirmation_log::append (ysu::block const & block_a)
+{
+	debug_assert (block_a.has_sideband ());
+	ysu::lock_guard<std::mutex> guard (mutex);
+	std::vector<uint8_t> record (record_header_size);
+	{
+		ysu::vectorstream stream (record);
+		ysu::write (stream, sequence + 1);
+		ysu::write (stream, ysu::seconds_since_epoch ());
+		ysu::serialize_block (stream, block_a);
+		block_a.sideband ().serialize (stream, block_a.type ());
+	}
+	uint32_t payload_size (static_cast<uint32_t> (record.size () - record_header_size));
+	debug_assert (payload_size <= max_payload_size);
+	auto checksum (record_checksum (record.data () + record_header_size, payload_size));
+	std::copy_n (reinterpret_cast<uint8_t const *> (&payload_size), sizeof (payload_size), record.begin ());
+	std::copy_n (reinterpret_cast<uint8_t const *> (&checksum), sizeof (checksum), record.begin () + sizeof (payload_size));
+
+	if (segments.empty () || segments.rbegin ()->second.size >= config.segment_size)
+	{
+		sync_locked ();
+		open_segment (sequence + 1);
+		apply_retention_locked ();
+	}
+	auto & current (segments.rbegin ()->second);
+	if (current.entry_count % index_interval == 0)
+	{
+		current.index.push_back (current.size);
+	}
+	output.write (reinterpret_cast<char const *> (record.data ()), record.size ());
+	current.size += record.size ();
+	++current.entry_count;
+	total_size += record.size ();
+	dirty = true;
+	return ++sequence;
+}
+
+std::vector<ysu::confirmation_log_entry> ysu::confirmation_log::read (uint64_t from_sequence_a, size_t count_a)
+{
+	std::vector<ysu::confirmation_log_entry> result;
+	ysu::lock_guard<std::mutex> guard (mutex);
+	flush_locked ();
+	auto existing (segments.upper_bound (from_sequence_a));
+	if (existing != segments.begin ())
+	{
+		--existing;
+	}
+	std::vector<uint8_t> payload;
+	for (; existing != segments.end () && result.size () < count_a; ++existing)
+	{
+		auto & segment_l (existing->second);
+		if (!segment_l.indexed)
+		{
+			index_segment (segment_l, false);
+		}
+		auto start (std::max (from_sequence_a, segment_l.first_sequence));
+		if (start >= segment_l.first_sequence + segment_l.entry_count)
+		{
+			continue;
+		}
+		auto skip (start - segment_l.first_sequence);
+		std::ifstream input (segment_l.path.string (), std::ios::binary);
+		input.seekg (segment_l.index[skip / index_interval]);
+		auto error (false);
+		for (auto i (skip - skip % index_interval); !error && i < skip; ++i)
+		{
+			uint32_t size (0);
+			error = !input.read (reinterpret_cast<char *> (&size), sizeof (size)) || !input.seekg (sizeof (uint32_t) + size, std::ios::cur);
+		}
+		for (auto i (skip); !error && i < segment_l.entry_count && result.size () < count_a; ++i)
+		{
+			ysu::confirmation_log_entry entry;
+			error = read_record (input, payload) || decode_record (payload, entry);
+			if (!error)
+			{
+				debug_assert (entry.sequence == segment_l.first_sequence + i);
+				result.push_back (std::move (entry));
+			}
+			else
+			{
+				logger.always_log ("Confirmation log: unable to read record from ", segment_l.path.string ());
+			}
+		}
+	}
+	return result;
+}
+
+uint64_t ysu::confirmation_log::first_sequence ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return (segments.empty () || sequence < segments.begin ()->first) ? 0 : segments.begin ()->first;
+}
+
+uint64_t ysu::confirmation_log::last_sequence ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return sequence;
+}
+
+void ysu::confirmation_log::flush ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	flush_locked ();
+}
+
+void ysu::confirmation_log::flush_locked ()
+{
+	if (dirty)
+	{
+		output.flush ();
+		dirty = false;
+		unsynced = true;
+	}
+}
+
+void ysu::confirmation_log::sync ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	sync_locked ();
+}
+
+void ysu::confirmation_log::sync_locked ()
+{
+	flush_locked ();
+	if (unsynced && !segments.empty ())
+	{
+		if (ysu::sync_file (segments.rbegin ()->second.path))
+		{
+			logger.always_log ("Confirmation log: unable to sync ", segments.rbegin ()->second.path.string ());
+		}
+		unsynced = false;
+	}
+	// Segments are synced before rolling over to a new one, whose directory entry is only durable once the directory is synced
+	if (segment_created)
+	{
+		if (ysu::sync_file (path))
+		{
+			logger.always_log ("Confirmation log: unable to sync ", path.string ());
+		}
+		segment_created = false;
+	}
+}
+
+void ysu::confirmation_log::apply_retention ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	apply_retention_locked ();
+}
+
+void ysu::confirmation_log::apply_retention_locked ()
+{
+	auto cutoff (std::time (nullptr) - std::chrono::duration_cast<std::chrono::seconds> (config.max_age).count ());
+	while (segments.size () > 1)
+	{
+		auto & oldest (segments.begin ()->second);
+		auto too_large (config.max_size != 0 && total_size > config.max_size);
+		boost::system::error_code ec;
+		auto too_old (config.max_age.count () != 0 && boost::filesystem::last_write_time (oldest.path, ec) < cutoff && !ec);
+		if (!too_large && !too_old)
+		{
+			break;
+		}
+		boost::filesystem::remove (oldest.path, ec);
+		if (ec)
+		{
+			logger.always_log ("Confirmation log: unable to delete segment ", oldest.path.string (), ": ", ec.message ());
+			break;
+		}
+		total_size -= oldest.size;
+		segments.erase (segments.begin ());
+	}
+}
+
+size_t ysu::confirmation_log::segment_count ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return segments.size ();
+}
+
+uint64_t ysu::confirmation_log::size ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return total_size;
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (confirmation_log & confirmation_log, const std::string & name)
+{
+	size_t segments_count;
+	size_t index_count (0);
+	{
+		ysu::lock_guard<std::mutex> guard (confirmation_log.mutex);
+		segments_count = confirmation_log.segments.size ();
+		for (auto const & segment : confirmation_log.segments)
+		{
+			index_count += segment.second.index.size ();
+		}
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "segments", segments_count, sizeof (decltype (confirmation_log.segments)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "index", index_count, sizeof (uint64_t) }));
+	return composite;
+}
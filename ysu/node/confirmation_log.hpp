@@ -0,0 +1,129 @@
+#pragma once
+
+#include <ysu/lib/errors.hpp>
+#include <ysu/lib/utility.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ysu
+{
+class block;
+class logger_mt;
+class tomlconfig;
+
+/** Configuration options for the confirmation log */
+class confirmation_log_config final
+{
+public:
+	ysu::error serialize_toml (ysu::tomlconfig &) const;
+	ysu::error deserialize_toml (ysu::tomlconfig &);
+
+	bool enabled{ false };
+	/** A new segment file is started once the current one reaches this size */
+	uint64_t segment_size{ 64 * 1024 * 1024 };
+	/** Oldest segments are deleted once the log exceeds this size. 0 disables size based retention. */
+	uint64_t max_size{ 4ULL * 1024 * 1024 * 1024 };
+	/** Segments last written to before this age are deleted. 0 disables age based retention. */
+	std::chrono::hours max_age{ 7 * 24 };
+};
+
+class confirmation_log_entry final
+{
+public:
+	uint64_t sequence{ 0 };
+	/** Seconds since epoch at which the block was appended to the log */
+	uint64_t timestamp{ 0 };
+	/** Cemented block, including its sideband */
+	std::shared_ptr<ysu::block> block;
+};
+
+/**
+ * Durable, append-only log of cemented blocks.
+ *
+ * Every cemented block is assigned a monotonic sequence number, starting at 1, which consumers use as a
+ * cursor to resume streaming after a restart. Appended records are durable once sync returns, the node syncs
+ * after each batch of cemented blocks. The log is split into segment files named after the sequence
+ * number of their first record, so that retention only ever deletes whole files. Each record is checksummed;
+ * a torn record at the end of the last segment (e.g. after a crash) is truncated on startup and its sequence
+ * number reused.
+ *
+ * Record layout: [uint32 payload size][uint32 payload checksum][payload], where the payload is
+ * [uint64 sequence][uint64 timestamp][block type + block][sideband].
+ */
+class confirmation_log final
+{
+public:
+	confirmation_log (boost::filesystem::path const &, ysu::confirmation_log_config const &, ysu::logger_mt &);
+	~confirmation_log ();
+	/** Appends a cemented block, which must have a sideband. Returns the sequence number assigned to it. */
+	uint64_t append (ysu::block const &);
+	/** Reads up to \p count_a entries, starting with the oldest retained entry whose sequence number is at least \p from_sequence_a */
+	std::vector<ysu::confirmation_log_entry> read (uint64_t from_sequence_a, size_t count_a);
+	/** Sequence number of the oldest retained entry, 0 if the log is empty */
+	uint64_t first_sequence ();
+	/** Sequence number of the last appended entry, 0 if nothing was appended yet */
+	uint64_t last_sequence ();
+	/** Pushes buffered records to the operating system */
+	void flush ();
+	/** Flushes buffered records and waits until they, and any new segment file, are written to disk */
+	void sync ();
+	/** Deletes the oldest segments exceeding the configured size or age limits. The segment being written is always kept. */
+	void apply_retention ();
+	size_t segment_count ();
+	/** Total size of all segments in bytes */
+	uint64_t size ();
+
+	/** One in this many records of a segment is indexed by file offset */
+	static size_t constexpr index_interval = 256;
+	/** Upper bound on the payload size, used to reject corrupt record headers */
+	static size_t constexpr max_payload_size = 4096;
+	/** How often the node applies retention, so that segments age out even when nothing is appended */
+	static std::chrono::minutes constexpr retention_interval{ 5 };
+
+private:
+	class segment final
+	{
+	public:
+		boost::filesystem::path path;
+		uint64_t first_sequence{ 0 };
+		uint64_t entry_count{ 0 };
+		uint64_t size{ 0 };
+		/** File offsets of every index_interval-th record, built on first read for closed segments */
+		std::vector<uint64_t> index;
+		bool indexed{ false };
+	};
+
+	void recover ();
+	void open_segment (uint64_t);
+	void index_segment (segment &, bool);
+	void flush_locked ();
+	void sync_locked ();
+	void apply_retention_locked ();
+	boost::filesystem::path segment_path (uint64_t) const;
+
+	boost::filesystem::path path;
+	ysu::confirmation_log_config const & config;
+	ysu::logger_mt & logger;
+	std::map<uint64_t, segment> segments;
+	std::ofstream output;
+	uint64_t sequence{ 0 };
+	uint64_t total_size{ 0 };
+	bool dirty{ false };
+	/** Records were flushed since the last sync */
+	bool unsynced{ false };
+	/** A segment file was created since the last sync */
+	bool segment_created{ false };
+	std::mutex mutex;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (confirmation_log &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (confirmation_log & confirmation_log, const std::string & name);
+}
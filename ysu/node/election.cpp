@@ -44,6 +44,7 @@ void ysu::election::confirm_once (ysu::election_status_type type_a)
 		status.block_count = ysu::narrow_cast<decltype (status.block_count)> (last_blocks.size ());
 		status.voter_count = ysu::narrow_cast<decltype (status.voter_count)> (last_votes.size ());
 		status.type = type_a;
+		node.block_tracer.trace (status.winner->hash (), ysu::block_tracer::stage::confirmed);
 		auto status_l (status);
 		auto node_l (node.shared ());
 		auto confirmation_action_l (confirmation_action);
@@ -358,6 +359,11 @@ ysu::election_vote_result ysu::election::vote (ysu::account rep, uint64_t sequen
 		if (should_process)
 		{
 			node.stats.inc (ysu::stat::type::election, ysu::stat::detail::vote_new);
+			if (last_votes.size () == 1)
+			{
+				// Only the placeholder entry for the initial block, this is the first vote from a representative
+				node.block_tracer.trace (block_hash, ysu::block_tracer::stage::first_vote);
+			}
 			last_votes[rep] = { std::chrono::steady_clock::now (), sequence, block_hash };
 			if (!confirmed ())
 			{
@@ -460,7 +466,7 @@ void ysu::election::prioritize_election (ysu::vote_generator_session & generator
 
 std::shared_ptr<ysu::block> ysu::election::winner ()
 {
-	ysu::lock_guard<std::mutex> guard (node.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 	return status.winner;
 }
 
@@ -491,20 +497,20 @@ void ysu::election::remove_votes (ysu::block_hash const & hash_a)
 void ysu::election::force_confirm (ysu::election_status_type type_a)
 {
 	release_assert (node.network_params.network.is_dev_network ());
-	ysu::lock_guard<std::mutex> guard (node.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 	confirm_once (type_a);
 }
 
 std::unordered_map<ysu::block_hash, std::shared_ptr<ysu::block>> ysu::election::blocks ()
 {
 	debug_assert (node.network_params.network.is_dev_network ());
-	ysu::lock_guard<std::mutex> guard (node.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 	return last_blocks;
 }
 
 std::unordered_map<ysu::account, ysu::vote_info> ysu::election::votes ()
 {
 	debug_assert (node.network_params.network.is_dev_network ());
-	ysu::lock_guard<std::mutex> guard (node.active.mutex);
+	ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 	return last_votes;
 }
@@ -0,0 +1,338 @@
+#include <ysu/boost/asio/connect.hpp>
+#include <ysu/boost/asio/post.hpp>
+#include <ysu/boost/beast/core.hpp>
+#include <ysu/boost/beast/http.hpp>
+#include <ysu/lib/logger_mt.hpp>
+#include <ysu/lib/stats.hpp>
+#include <ysu/lib/threading.hpp>
+#include <ysu/node/http_callbacks.hpp>
+#include <ysu/node/nodeconfig.hpp>
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/format.hpp>
+
+class ysu::http_callbacks::connection final
+{
+public:
+	explicit connection (boost::asio::io_context & io_ctx_a) :
+	socket (io_ctx_a),
+	deadline (io_ctx_a)
+	{
+	}
+	boost::asio::ip::tcp::socket socket;
+	/** Closes the socket if connecting or the response to a request takes longer than node_config::callback_timeout */
+	boost::asio::steady_timer deadline;
+	boost::beast::flat_buffer buffer;
+	boost::beast::http::request<boost::beast::http::string_body> request;
+	boost::beast::http::response<boost::beast::http::string_body> response;
+	std::vector<ysu::http_callbacks::entry> entries;
+	bool busy{ false };
+	/** The request is sent over a connection kept alive from an earlier one */
+	bool reused{ false };
+};
+
+ysu::http_callbacks::http_callbacks (ysu::node_config const & config_a, ysu::stat & stats_a, ysu::logger_mt & logger_a) :
+config (config_a),
+stats (stats_a),
+logger (logger_a),
+work (boost::asio::make_work_guard (io_ctx)),
+resolver (io_ctx)
+{
+	for (auto i (0u); i < std::max (config.callback_max_connections, 1u); ++i)
+	{
+		connections.push_back (std::make_shared<connection> (io_ctx));
+	}
+}
+
+ysu::http_callbacks::~http_callbacks ()
+{
+	stop ();
+}
+
+void ysu::http_callbacks::start ()
+{
+	debug_assert (!thread.joinable ());
+	thread = std::thread ([this]() {
+		ysu::thread_role::set (ysu::thread_role::name::http_callbacks);
+		io_ctx.run ();
+	});
+}
+
+void ysu::http_callbacks::stop ()
+{
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		stopped = true;
+		queue.clear ();
+	}
+	work.reset ();
+	io_ctx.stop ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+bool ysu::http_callbacks::add (std::string const & body_a)
+{
+	auto dropped (false);
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		dropped = stopped || queue.size () >= config.callback_max_queued;
+		if (!dropped)
+		{
+			queue.push_back ({ body_a, std::chrono::steady_clock::now () });
+		}
+	}
+	if (!dropped)
+	{
+		boost::asio::post (io_ctx, [this]() {
+			dispatch ();
+		});
+	}
+	else
+	{
+		stats.inc (ysu::stat::type::http_callback, ysu::stat::detail::overflow, ysu::stat::dir::out);
+	}
+	return dropped;
+}
+
+size_t ysu::http_callbacks::size ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return queue.size ();
+}
+
+void ysu::http_callbacks::dispatch ()
+{
+	for (auto const & connection_l : connections)
+	{
+		if (!connection_l->busy)
+		{
+			std::vector<entry> batch;
+			{
+				ysu::lock_guard<std::mutex> guard (mutex);
+				while (!queue.empty () && batch.size () < std::max (config.callback_batch_size, 1u))
+				{
+					batch.push_back (std::move (queue.front ()));
+					queue.pop_front ();
+				}
+			}
+			if (batch.empty ())
+			{
+				break;
+			}
+			send (connection_l, std::move (batch));
+		}
+	}
+}
+
+void ysu::http_callbacks::send (std::shared_ptr<connection> const & connection_a, std::vector<entry> entries_a)
+{
+	connection_a->busy = true;
+	connection_a->entries = std::move (entries_a);
+	auto & request (connection_a->request);
+	request = {};
+	request.method (boost::beast::http::verb::post);
+	request.target (config.callback_target);
+	request.version (11);
+	request.insert (boost::beast::http::field::host, config.callback_address);
+	request.insert (boost::beast::http::field::content_type, "application/json");
+	request.keep_alive (true);
+	if (connection_a->entries.size () == 1)
+	{
+		request.body () = connection_a->entries.front ().body;
+	}
+	else
+	{
+		auto & body (request.body ());
+		body = "{\"blocks\": [";
+		for (auto i (connection_a->entries.begin ()), n (connection_a->entries.end ()); i != n; ++i)
+		{
+			body += (i == connection_a->entries.begin () ? "" : ",") + i->body;
+		}
+		body += "]}";
+	}
+	request.prepare_payload ();
+
+	connection_a->reused = connection_a->socket.is_open ();
+	if (connection_a->reused)
+	{
+		write (connection_a);
+	}
+	else
+	{
+		open (connection_a);
+	}
+}
+
+void ysu::http_callbacks::open (std::shared_ptr<connection> const & connection_a)
+{
+	if (!endpoints.empty ())
+	{
+		connect (connection_a);
+	}
+	else
+	{
+		resolver.async_resolve (config.callback_address, std::to_string (config.callback_port), [this, connection_a](boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::results_type results_a) {
+			if (!ec)
+			{
+				endpoints = results_a;
+				connect (connection_a);
+			}
+			else
+			{
+				complete (connection_a, ec, "Error resolving callback");
+			}
+		});
+	}
+}
+
+void ysu::http_callbacks::connect (std::shared_ptr<connection> const & connection_a)
+{
+	expire (connection_a);
+	boost::asio::async_connect (connection_a->socket, endpoints, [this, connection_a](boost::system::error_code const & ec, boost::asio::ip::tcp::endpoint const &) {
+		if (!ec)
+		{
+			write (connection_a);
+		}
+		else
+		{
+			// The address may have changed, resolve again on the next attempt
+			endpoints = {};
+			complete (connection_a, ec, "Unable to connect to callback address");
+		}
+	});
+}
+
+void ysu::http_callbacks::write (std::shared_ptr<connection> const & connection_a)
+{
+	expire (connection_a);
+	boost::beast::http::async_write (connection_a->socket, connection_a->request, [this, connection_a](boost::system::error_code const & ec, size_t) {
+		if (!ec)
+		{
+			connection_a->response = {};
+			boost::beast::http::async_read (connection_a->socket, connection_a->buffer, connection_a->response, [this, connection_a](boost::system::error_code const & ec, size_t) {
+				if (!reconnect_stale (connection_a, ec))
+				{
+					complete (connection_a, ec, "Unable complete callback");
+				}
+			});
+		}
+		else if (!reconnect_stale (connection_a, ec))
+		{
+			complete (connection_a, ec, "Unable to send callback");
+		}
+	});
+}
+
+void ysu::http_callbacks::expire (std::shared_ptr<connection> const & connection_a)
+{
+	connection_a->deadline.expires_after (config.callback_timeout);
+	connection_a->deadline.async_wait ([connection_a](boost::system::error_code const & ec) {
+		// The deadline may have been moved after this wait already expired
+		if (!ec && connection_a->deadline.expiry () <= std::chrono::steady_clock::now ())
+		{
+			// Aborts the pending connect, write or read
+			boost::system::error_code ignored;
+			connection_a->socket.close (ignored);
+		}
+	});
+}
+
+bool ysu::http_callbacks::reconnect_stale (std::shared_ptr<connection> const & connection_a, boost::system::error_code const & ec)
+{
+	// Receivers may close idle keep-alive connections, which is only noticed once the next request is sent over it
+	auto result (connection_a->reused && (ec == boost::beast::http::error::end_of_stream || ec == boost::asio::error::eof || ec == boost::asio::error::connection_reset || ec == boost::asio::error::broken_pipe));
+	if (result)
+	{
+		connection_a->reused = false;
+		boost::system::error_code ignored;
+		connection_a->socket.close (ignored);
+		connection_a->buffer.consume (connection_a->buffer.size ());
+		open (connection_a);
+	}
+	return result;
+}
+
+void ysu::http_callbacks::complete (std::shared_ptr<connection> const & connection_a, boost::system::error_code const & ec, std::string const & error_text_a)
+{
+	connection_a->deadline.cancel ();
+	auto entries_l (std::move (connection_a->entries));
+	connection_a->entries.clear ();
+	connection_a->busy = false;
+	auto success (!ec && boost::beast::http::to_status_class (connection_a->response.result ()) == boost::beast::http::status_class::successful);
+	if (success)
+	{
+		auto now (std::chrono::steady_clock::now ());
+		for (auto const & entry_l : entries_l)
+		{
+			stats.inc (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out);
+			stats.add (ysu::stat::type::http_callback, ysu::stat::detail::callback_latency, ysu::stat::dir::out, std::chrono::duration_cast<std::chrono::milliseconds> (now - entry_l.queued).count ());
+		}
+		if (entries_l.size () > 1)
+		{
+			stats.inc (ysu::stat::type::http_callback, ysu::stat::detail::callback_batch, ysu::stat::dir::out);
+		}
+		if (!connection_a->response.keep_alive ())
+		{
+			boost::system::error_code ignored;
+			connection_a->socket.close (ignored);
+		}
+	}
+	else
+	{
+		if (config.logging.callback_logging ())
+		{
+			if (!ec)
+			{
+				logger.try_log (boost::str (boost::format ("Callback to %1%:%2% failed with status: %3%") % config.callback_address % config.callback_port % connection_a->response.result ()));
+			}
+			else
+			{
+				logger.try_log (boost::str (boost::format ("%1%: %2%:%3%: %4%") % error_text_a % config.callback_address % config.callback_port % ec.message ()));
+			}
+		}
+		stats.inc (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out);
+		boost::system::error_code ignored;
+		connection_a->socket.close (ignored);
+		connection_a->buffer.consume (connection_a->buffer.size ());
+
+		std::vector<entry> retry;
+		for (auto & entry_l : entries_l)
+		{
+			if (++entry_l.attempts <= config.callback_max_retries)
+			{
+				retry.push_back (std::move (entry_l));
+			}
+		}
+		if (!retry.empty ())
+		{
+			stats.add (ysu::stat::type::http_callback, ysu::stat::detail::callback_retry, ysu::stat::dir::out, retry.size ());
+			auto delay (config.callback_retry_backoff * (1ULL << std::min (retry.front ().attempts - 1, 16u)));
+			auto timer (std::make_shared<boost::asio::steady_timer> (io_ctx, delay));
+			timer->async_wait ([this, timer, retry = std::move (retry)](boost::system::error_code const & ec) mutable {
+				if (!ec)
+				{
+					{
+						ysu::lock_guard<std::mutex> guard (mutex);
+						if (!stopped)
+						{
+							// Retries go ahead of newer confirmations to keep delivery roughly in order
+							queue.insert (queue.begin (), std::make_move_iterator (retry.begin ()), std::make_move_iterator (retry.end ()));
+						}
+					}
+					dispatch ();
+				}
+			});
+		}
+	}
+	dispatch ();
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (http_callbacks & http_callbacks, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queue", http_callbacks.size (), sizeof (decltype (http_callbacks.queue)::value_type) }));
+	return composite;
+}
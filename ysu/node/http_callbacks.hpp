@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ysu/boost/asio/executor_work_guard.hpp>
+#include <ysu/boost/asio/ip/tcp.hpp>
+#include <ysu/lib/utility.hpp>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ysu
+{
+class logger_mt;
+class node_config;
+class stat;
+
+/**
+ * Delivers block confirmations to the configured HTTP callback address.
+ *
+ * Confirmations are queued (bounded by node_config::callback_max_queued) and posted from a dedicated
+ * thread over a small pool of persistent keep-alive connections, so that callbacks neither open a
+ * connection per block nor compete with the node's network I/O. If the receiver opts in through
+ * node_config::callback_batch_size, several confirmations are sent as {"blocks": [...]} in one request.
+ * Failed deliveries are retried with exponential backoff, except for requests on a kept alive connection which the
+ * receiver closed meanwhile. Those are sent again over a new connection right away.
+ */
+class http_callbacks final
+{
+public:
+	http_callbacks (ysu::node_config const &, ysu::stat &, ysu::logger_mt &);
+	~http_callbacks ();
+	void start ();
+	void stop ();
+	/**
+	 * Queue a JSON encoded confirmation for delivery
+	 * @return true if the confirmation was dropped because the queue is full
+	 */
+	bool add (std::string const & body_a);
+	/** Number of confirmations waiting for a connection */
+	size_t size ();
+
+private:
+	class entry final
+	{
+	public:
+		std::string body;
+		std::chrono::steady_clock::time_point queued;
+		unsigned attempts{ 0 };
+	};
+	class connection;
+
+	void dispatch ();
+	void send (std::shared_ptr<connection> const &, std::vector<entry>);
+	/** Connects, resolving the callback address first unless a previous resolution is cached */
+	void open (std::shared_ptr<connection> const &);
+	void connect (std::shared_ptr<connection> const &);
+	void write (std::shared_ptr<connection> const &);
+	/** Starts the deadline for the next connect or request */
+	void expire (std::shared_ptr<connection> const &);
+	/** Returns true if a request failed because a reused connection was closed, and sends it over a new one */
+	bool reconnect_stale (std::shared_ptr<connection> const &, boost::system::error_code const &);
+	void complete (std::shared_ptr<connection> const &, boost::system::error_code const &, std::string const &);
+
+	ysu::node_config const & config;
+	ysu::stat & stats;
+	ysu::logger_mt & logger;
+	boost::asio::io_context io_ctx;
+	boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work;
+	boost::asio::ip::tcp::resolver resolver;
+	/** Cached resolution of the callback address, cleared when connecting fails */
+	boost::asio::ip::tcp::resolver::results_type endpoints;
+	std::vector<std::shared_ptr<connection>> connections;
+	std::deque<entry> queue;
+	std::mutex mutex;
+	bool stopped{ false };
+	std::thread thread;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (http_callbacks &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (http_callbacks & http_callbacks, const std::string & name);
+}
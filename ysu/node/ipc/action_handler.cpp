@@ -2,6 +2,7 @@
 #include <ysu/lib/errors.hpp>
 #include <ysu/lib/numbers.hpp>
 #include <ysu/node/ipc/action_handler.hpp>
+#include <ysu/node/ipc/flatbuffers_util.hpp>
 #include <ysu/node/ipc/ipc_server.hpp>
 #include <ysu/node/node.hpp>
 
@@ -27,6 +28,116 @@ ysu::account parse_account (std::string const & account, bool & out_is_deprecate
 
 	return result;
 }
+ysu::block_hash parse_hash (std::string const & hash)
+{
+	ysu::block_hash result (0);
+	if (result.decode_hex (hash))
+	{
+		throw ysu::error (ysu::error_blocks::bad_hash_number);
+	}
+	return result;
+}
+
+/** Fills in the subtype and counterparty of an account history entry */
+class history_entry_visitor final : public ysu::block_visitor
+{
+public:
+	history_entry_visitor (ysu::ledger & ledger_a, ysu::transaction const & transaction_a, ysuapi::AccountHistoryEntryT & entry_a) :
+	ledger (ledger_a),
+	transaction (transaction_a),
+	entry (entry_a)
+	{
+	}
+	void send_block (ysu::send_block const & block_a) override
+	{
+		entry.subtype = ysuapi::BlockSubType::BlockSubType_send;
+		entry.account = block_a.hashables.destination.to_account ();
+	}
+	void receive_block (ysu::receive_block const & block_a) override
+	{
+		entry.subtype = ysuapi::BlockSubType::BlockSubType_receive;
+		source_account (block_a.source ());
+	}
+	void open_block (ysu::open_block const & block_a) override
+	{
+		entry.subtype = ysuapi::BlockSubType::BlockSubType_receive;
+		if (block_a.hashables.source != ledger.network_params.ledger.genesis_account)
+		{
+			source_account (block_a.source ());
+		}
+		else
+		{
+			entry.account = ledger.network_params.ledger.genesis_account.to_account ();
+		}
+	}
+	void change_block (ysu::change_block const & block_a) override
+	{
+		entry.subtype = ysuapi::BlockSubType::BlockSubType_change;
+		entry.account = block_a.representative ().to_account ();
+	}
+	void state_block (ysu::state_block const & block_a) override
+	{
+		auto const & details (block_a.sideband ().details);
+		if (details.is_send)
+		{
+			entry.subtype = ysuapi::BlockSubType::BlockSubType_send;
+			entry.account = block_a.link ().to_account ();
+		}
+		else if (details.is_receive)
+		{
+			entry.subtype = ysuapi::BlockSubType::BlockSubType_receive;
+			source_account (block_a.link ().as_block_hash ());
+		}
+		else if (details.is_epoch)
+		{
+			entry.subtype = ysuapi::BlockSubType::BlockSubType_epoch;
+			entry.account = ledger.epoch_signer (block_a.link ()).to_account ();
+		}
+		else
+		{
+			entry.subtype = ysuapi::BlockSubType::BlockSubType_change;
+			entry.account = block_a.representative ().to_account ();
+		}
+	}
+
+private:
+	void source_account (ysu::block_hash const & source_a)
+	{
+		bool error_or_pruned (false);
+		auto account (ledger.account_safe (transaction, source_a, error_or_pruned));
+		if (!error_or_pruned)
+		{
+			entry.account = account.to_account ();
+		}
+	}
+
+	ysu::ledger & ledger;
+	ysu::transaction const & transaction;
+	ysuapi::AccountHistoryEntryT & entry;
+};
+
+/** Returns the amount sent or received by \p block_a. The predecessor's balance is looked up unless \p previous_a is already known. */
+boost::optional<ysu::uint128_t> block_amount (ysu::ledger & ledger_a, ysu::transaction const & transaction_a, std::shared_ptr<ysu::block> const & block_a, std::shared_ptr<ysu::block> const & previous_a = nullptr)
+{
+	boost::optional<ysu::uint128_t> result;
+	auto balance (ledger_a.store.block_balance_calculated (block_a));
+	ysu::uint128_t previous_balance (0);
+	bool error_or_pruned (false);
+	if (previous_a != nullptr)
+	{
+		previous_balance = ledger_a.store.block_balance_calculated (previous_a);
+	}
+	else
+	{
+		previous_balance = ledger_a.balance_safe (transaction_a, block_a->previous (), error_or_pruned);
+	}
+	if (!error_or_pruned)
+	{
+		result = balance > previous_balance ? balance - previous_balance : previous_balance - balance;
+	}
+	return result;
+}
+
 /** Returns the message as a Flatbuffers ObjectAPI type, managed by a unique_ptr */
 template <typename T>
 auto get_message (ysuapi::Envelope const & envelope)
@@ -48,6 +159,13 @@ auto ysu::ipc::action_handler::handler_map () -> std::unordered_map<ysuapi::Mess
 		handlers.emplace (ysuapi::Message::Message_IsAlive, &ysu::ipc::action_handler::on_is_alive);
 		handlers.emplace (ysuapi::Message::Message_TopicConfirmation, &ysu::ipc::action_handler::on_topic_confirmation);
 		handlers.emplace (ysuapi::Message::Message_AccountWeight, &ysu::ipc::action_handler::on_account_weight);
+		handlers.emplace (ysuapi::Message::Message_AccountInfo, &ysu::ipc::action_handler::on_account_info);
+		handlers.emplace (ysuapi::Message::Message_AccountsBalances, &ysu::ipc::action_handler::on_accounts_balances);
+		handlers.emplace (ysuapi::Message::Message_BlocksInfo, &ysu::ipc::action_handler::on_blocks_info);
+		handlers.emplace (ysuapi::Message::Message_Pending, &ysu::ipc::action_handler::on_pending);
+		handlers.emplace (ysuapi::Message::Message_AccountHistory, &ysu::ipc::action_handler::on_account_history);
+		handlers.emplace (ysuapi::Message::Message_Frontiers, &ysu::ipc::action_handler::on_frontiers);
+		handlers.emplace (ysuapi::Message::Message_ConfirmationLog, &ysu::ipc::action_handler::on_confirmation_log);
 		handlers.emplace (ysuapi::Message::Message_ServiceRegister, &ysu::ipc::action_handler::on_service_register);
 		handlers.emplace (ysuapi::Message::Message_ServiceStop, &ysu::ipc::action_handler::on_service_stop);
 		handlers.emplace (ysuapi::Message::Message_TopicServiceStop, &ysu::ipc::action_handler::on_topic_service_stop);
@@ -116,6 +234,261 @@ void ysu::ipc::action_handler::on_account_weight (ysuapi::Envelope const & envel
 	create_response (response);
 }
 
+void ysu::ipc::action_handler::on_account_info (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_account_info, ysu::ipc::access_permission::account_query });
+	bool is_deprecated_format{ false };
+	auto query (get_message<ysuapi::AccountInfo> (envelope_a));
+	auto account (parse_account (query->account, is_deprecated_format));
+
+	auto transaction (node.store.tx_begin_read ());
+	ysu::account_info info;
+	ysu::confirmation_height_info confirmation_height_info;
+	if (node.store.account_get (transaction, account, info) || node.store.confirmation_height_get (transaction, account, confirmation_height_info))
+	{
+		throw ysu::error (ysu::error_common::account_not_found);
+	}
+
+	ysuapi::AccountInfoResponseT response;
+	response.frontier = info.head.to_string ();
+	response.open_block = info.open_block.to_string ();
+	response.representative_block = node.ledger.representative (transaction, info.head).to_string ();
+	response.representative = info.representative.to_account ();
+	response.balance = info.balance.to_string_dec ();
+	response.modified_timestamp = info.modified;
+	response.block_count = info.block_count;
+	response.account_version = ysu::normalized_epoch (info.epoch ());
+	response.confirmation_height = confirmation_height_info.height;
+	response.confirmation_height_frontier = confirmation_height_info.frontier.to_string ();
+	if (query->include_weight)
+	{
+		response.voting_weight = node.ledger.weight (account).convert_to<std::string> ();
+	}
+	if (query->include_pending)
+	{
+		response.pending = node.ledger.account_pending (transaction, account).convert_to<std::string> ();
+	}
+	create_response (response);
+}
+
+void ysu::ipc::action_handler::on_accounts_balances (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_accounts_balances, ysu::ipc::access_permission::account_query });
+	auto query (get_message<ysuapi::AccountsBalances> (envelope_a));
+
+	ysuapi::AccountsBalancesResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & account_text : query->accounts)
+	{
+		bool is_deprecated_format{ false };
+		auto account (parse_account (account_text, is_deprecated_format));
+		auto balance (std::make_unique<ysuapi::AccountBalanceT> ());
+		balance->account = account.to_account ();
+		balance->balance = node.ledger.account_balance (transaction, account).convert_to<std::string> ();
+		balance->pending = node.ledger.account_pending (transaction, account).convert_to<std::string> ();
+		response.balances.push_back (std::move (balance));
+	}
+	create_response (response);
+}
+
+void ysu::ipc::action_handler::on_blocks_info (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_blocks_info, ysu::ipc::access_permission::account_query });
+	auto query (get_message<ysuapi::BlocksInfo> (envelope_a));
+
+	ysuapi::BlocksInfoResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & hash_text : query->hashes)
+	{
+		auto hash (parse_hash (hash_text));
+		auto block (node.store.block_get (transaction, hash));
+		if (block != nullptr)
+		{
+			auto const & sideband (block->sideband ());
+			auto amount (block_amount (node.ledger, transaction, block));
+			auto entry (std::make_unique<ysuapi::BlockInfoEntryT> ());
+			entry->hash = hash.to_string ();
+			entry->account = (block->account ().is_zero () ? sideband.account : block->account ()).to_account ();
+			entry->amount = amount.value_or (0).convert_to<std::string> ();
+			entry->balance = node.store.block_balance_calculated (block).convert_to<std::string> ();
+			entry->height = sideband.height;
+			entry->local_timestamp = sideband.timestamp;
+			entry->confirmed = node.ledger.block_confirmed (transaction, hash);
+			entry->block = ysu::ipc::flatbuffers_builder::block_to_union (*block, amount.value_or (0), sideband.details.is_send);
+			response.blocks.push_back (std::move (entry));
+		}
+		else if (query->include_not_found)
+		{
+			response.blocks_not_found.push_back (hash.to_string ());
+		}
+		else
+		{
+			throw ysu::error (ysu::error_blocks::not_found);
+		}
+	}
+	create_response (response);
+}
+
+void ysu::ipc::action_handler::on_pending (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_pending, ysu::ipc::access_permission::account_query });
+	bool is_deprecated_format{ false };
+	auto query (get_message<ysuapi::Pending> (envelope_a));
+	auto account (parse_account (query->account, is_deprecated_format));
+	ysu::uint128_union threshold (0);
+	if (!query->threshold.empty () && threshold.decode_dec (query->threshold))
+	{
+		throw ysu::error (ysu::error_common::bad_threshold);
+	}
+	auto max_count (node.config.ipc_config.flatbuffers.max_count);
+	auto count (query->count == 0 ? max_count : std::min (query->count, max_count));
+
+	ysuapi::PendingResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto i (node.store.pending_begin (transaction, ysu::pending_key (account, 0))), n (node.store.pending_end ()); i != n && ysu::pending_key (i->first).account == account && response.blocks.size () < count; ++i)
+	{
+		ysu::pending_key const & key (i->first);
+		ysu::pending_info const & info (i->second);
+		if (info.amount.number () >= threshold.number () && (!query->include_only_confirmed || node.ledger.block_confirmed (transaction, key.hash)))
+		{
+			auto entry (std::make_unique<ysuapi::PendingEntryT> ());
+			entry->hash = key.hash.to_string ();
+			entry->amount = info.amount.to_string_dec ();
+			entry->source = info.source.to_account ();
+			entry->min_version = ysu::normalized_epoch (info.epoch);
+			response.blocks.push_back (std::move (entry));
+		}
+	}
+	create_response (response);
+}
+
+void ysu::ipc::action_handler::on_account_history (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_account_history, ysu::ipc::access_permission::account_query });
+	auto query (get_message<ysuapi::AccountHistory> (envelope_a));
+
+	auto transaction (node.store.tx_begin_read ());
+	ysu::account account (0);
+	ysu::block_hash hash (0);
+	if (!query->head.empty ())
+	{
+		hash = parse_hash (query->head);
+		if (!node.store.block_exists (transaction, hash))
+		{
+			throw ysu::error (ysu::error_blocks::not_found);
+		}
+		account = node.ledger.account (transaction, hash);
+	}
+	else
+	{
+		bool is_deprecated_format{ false };
+		account = parse_account (query->account, is_deprecated_format);
+		ysu::account_info info;
+		if (node.store.account_get (transaction, account, info))
+		{
+			throw ysu::error (ysu::error_common::account_not_found);
+		}
+		hash = query->reverse ? info.open_block : info.head;
+	}
+
+	ysu::confirmation_height_info confirmation_height_info;
+	node.store.confirmation_height_get (transaction, account, confirmation_height_info);
+
+	ysuapi::AccountHistoryResponseT response;
+	response.account = account.to_account ();
+	// Walking towards the open block, the next block to visit is also the predecessor needed to calculate
+	// the amount of the current one. Walking towards the frontier, the last visited block is the predecessor.
+	auto block (node.store.block_get (transaction, hash));
+	std::shared_ptr<ysu::block> previous;
+	for (auto count (std::min (query->count, node.config.ipc_config.flatbuffers.max_count)); block != nullptr && count > 0; --count)
+	{
+		auto const & sideband (block->sideband ());
+		auto next_hash (query->reverse ? sideband.successor : block->previous ());
+		auto next (next_hash.is_zero () ? nullptr : node.store.block_get (transaction, next_hash));
+		if (!query->reverse)
+		{
+			previous = next;
+		}
+
+		auto entry (std::make_unique<ysuapi::AccountHistoryEntryT> ());
+		history_entry_visitor visitor (node.ledger, transaction, *entry);
+		block->visit (visitor);
+		auto amount (block_amount (node.ledger, transaction, block, block->previous ().is_zero () ? nullptr : previous));
+		if (amount)
+		{
+			entry->amount = amount->convert_to<std::string> ();
+		}
+		entry->hash = hash.to_string ();
+		entry->height = sideband.height;
+		entry->local_timestamp = sideband.timestamp;
+		entry->confirmed = sideband.height <= confirmation_height_info.height;
+		response.history.push_back (std::move (entry));
+
+		if (query->reverse)
+		{
+			previous = block;
+		}
+		hash = next_hash;
+		block = next;
+	}
+	if (block != nullptr)
+	{
+		response.next = hash.to_string ();
+	}
+	create_response (response);
+}
+
+void ysu::ipc::action_handler::on_frontiers (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_frontiers, ysu::ipc::access_permission::account_query });
+	bool is_deprecated_format{ false };
+	auto query (get_message<ysuapi::Frontiers> (envelope_a));
+	auto start (parse_account (query->start, is_deprecated_format));
+
+	auto count (std::min (query->count, node.config.ipc_config.flatbuffers.max_count));
+
+	ysuapi::FrontiersResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto i (node.store.accounts_begin (transaction, start)), n (node.store.accounts_end ()); i != n && response.frontiers.size () < count; ++i)
+	{
+		auto frontier (std::make_unique<ysuapi::FrontierT> ());
+		frontier->account = i->first.to_account ();
+		frontier->hash = i->second.head.to_string ();
+		response.frontiers.push_back (std::move (frontier));
+	}
+	create_response (response);
+}
+
+void ysu::ipc::action_handler::on_confirmation_log (ysuapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { ysu::ipc::access_permission::api_confirmation_log, ysu::ipc::access_permission::account_query });
+	auto query (get_message<ysuapi::ConfirmationLog> (envelope_a));
+	if (node.confirmation_log == nullptr)
+	{
+		throw ysu::error (ysu::error_rpc::confirmation_log_disabled);
+	}
+
+	ysuapi::ConfirmationLogResponseT response;
+	auto entries (node.confirmation_log->read (query->from_seq, query->count));
+	for (auto const & entry : entries)
+	{
+		auto const & block (*entry.block);
+		auto const & sideband (block.sideband ());
+		auto entry_l (std::make_unique<ysuapi::ConfirmationLogEntryT> ());
+		entry_l->sequence = entry.sequence;
+		entry_l->timestamp = entry.timestamp;
+		entry_l->account = (block.account ().is_zero () ? sideband.account : block.account ()).to_account ();
+		entry_l->height = sideband.height;
+		entry_l->local_timestamp = sideband.timestamp;
+		entry_l->block = ysu::ipc::flatbuffers_builder::block_to_union (block, 0, sideband.details.is_send);
+		response.entries.push_back (std::move (entry_l));
+	}
+	response.first_seq = node.confirmation_log->first_sequence ();
+	response.last_seq = node.confirmation_log->last_sequence ();
+	response.next_seq = entries.empty () ? std::max (query->from_seq, response.last_seq + 1) : entries.back ().sequence + 1;
+	create_response (response);
+}
+
 void ysu::ipc::action_handler::on_is_alive (ysuapi::Envelope const & envelope)
 {
 	ysuapi::IsAliveT alive;
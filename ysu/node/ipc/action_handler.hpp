@@ -40,6 +40,14 @@ namespace ipc
 		action_handler (ysu::node & node, ysu::ipc::ipc_server & server, std::weak_ptr<ysu::ipc::subscriber> const & subscriber, std::shared_ptr<flatbuffers::FlatBufferBuilder> const & builder);
 
 		void on_account_weight (ysuapi::Envelope const & envelope);
+		void on_account_info (ysuapi::Envelope const & envelope);
+		void on_accounts_balances (ysuapi::Envelope const & envelope);
+		void on_blocks_info (ysuapi::Envelope const & envelope);
+		void on_pending (ysuapi::Envelope const & envelope);
+		/** Returns a page of account history. The response contains a cursor for the next page. */
+		void on_account_history (ysuapi::Envelope const & envelope);
+		void on_frontiers (ysuapi::Envelope const & envelope);
+		void on_confirmation_log (ysuapi::Envelope const & envelope);
 		void on_is_alive (ysuapi::Envelope const & envelope);
 		void on_topic_confirmation (ysuapi::Envelope const & envelope);
 
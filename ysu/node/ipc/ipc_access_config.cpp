@@ -20,6 +20,20 @@ ysu::ipc::access_permission from_string (std::string permission)
 		return ysu::ipc::access_permission::api_topic_service_stop;
 	if (permission == "api_topic_confirmation")
 		return ysu::ipc::access_permission::api_topic_confirmation;
+	if (permission == "api_account_info")
+		return ysu::ipc::access_permission::api_account_info;
+	if (permission == "api_accounts_balances")
+		return ysu::ipc::access_permission::api_accounts_balances;
+	if (permission == "api_blocks_info")
+		return ysu::ipc::access_permission::api_blocks_info;
+	if (permission == "api_pending")
+		return ysu::ipc::access_permission::api_pending;
+	if (permission == "api_account_history")
+		return ysu::ipc::access_permission::api_account_history;
+	if (permission == "api_frontiers")
+		return ysu::ipc::access_permission::api_frontiers;
+	if (permission == "api_confirmation_log")
+		return ysu::ipc::access_permission::api_confirmation_log;
 	if (permission == "account_query")
 		return ysu::ipc::access_permission::account_query;
 	if (permission == "epoch_upgrade")
@@ -88,6 +102,13 @@ void ysu::ipc::access::clear ()
 	// The default set of permissions. A new insert should be made as new safe
 	// api's or resource permissions are made.
 	default_user.permissions.insert (ysu::ipc::access_permission::api_account_weight);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_account_info);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_accounts_balances);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_blocks_info);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_pending);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_account_history);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_frontiers);
+	default_user.permissions.insert (ysu::ipc::access_permission::api_confirmation_log);
 }
 
 ysu::error ysu::ipc::access::deserialize_toml (ysu::tomlconfig & toml)
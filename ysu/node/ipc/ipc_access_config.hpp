@@ -54,6 +54,13 @@ namespace ipc
 		api_service_stop,
 		api_topic_service_stop,
 		api_topic_confirmation,
+		api_account_info,
+		api_accounts_balances,
+		api_blocks_info,
+		api_pending,
+		api_account_history,
+		api_frontiers,
+		api_confirmation_log,
 		/** Query account information */
 		account_query,
 		/** Epoch upgrade */
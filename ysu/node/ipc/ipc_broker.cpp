@@ -21,6 +21,20 @@ std::shared_ptr<flatbuffers::Parser> ysu::ipc::subscriber::get_parser (ysu::ipc:
 
 void ysu::ipc::broker::start ()
 {
+	auto const & shared_memory_config (node.config.ipc_config.shared_memory);
+	if (shared_memory_config.enabled)
+	{
+		try
+		{
+			confirmation_ring = std::make_unique<ysu::ipc::ring_writer> (shared_memory_config.confirmation_ring_name, shared_memory_config.capacity);
+			node.logger.always_log ("IPC: publishing confirmations to shared memory ring ", shared_memory_config.confirmation_ring_name);
+		}
+		catch (std::exception const & ex)
+		{
+			node.logger.always_log ("IPC: could not create shared memory ring: ", ex.what ());
+		}
+	}
+
 	node.observers.blocks.add ([this](ysu::election_status const & status_a, ysu::account const & account_a, ysu::amount const & amount_a, bool is_state_send_a) {
 		debug_assert (status_a.type != ysu::election_status_type::ongoing);
 
@@ -28,12 +42,13 @@ void ysu::ipc::broker::start ()
 		{
 			// The subscriber(s) may be gone after the count check, but the only consequence
 			// is that broadcast is called only to not find any live sessions.
-			if (confirmation_subscriber_count () > 0)
+			if (confirmation_subscriber_count () > 0 || confirmation_ring != nullptr)
 			{
 				auto confirmation (std::make_shared<ysuapi::EventConfirmationT> ());
 
 				confirmation->account = account_a.to_account ();
 				confirmation->amount = amount_a.to_string_dec ();
+				confirmation->hash = status_a.winner->hash ().to_string ();
 				switch (status_a.type)
 				{
 					case ysu::election_status_type::active_confirmed_quorum:
@@ -59,7 +74,14 @@ void ysu::ipc::broker::start ()
 				confirmation->election_info->voter_count = status_a.voter_count;
 				confirmation->election_info->request_count = status_a.confirmation_request_count;
 
-				broadcast (confirmation);
+				if (confirmation_ring != nullptr)
+				{
+					publish (*confirmation);
+				}
+				if (confirmation_subscriber_count () > 0)
+				{
+					broadcast (confirmation);
+				}
 			}
 		}
 		catch (ysu::error const & err)
@@ -220,6 +242,28 @@ void ysu::ipc::broker::broadcast (std::shared_ptr<ysuapi::EventConfirmationT> co
 	}
 }
 
+void ysu::ipc::broker::publish (ysuapi::EventConfirmationT const & confirmation_a)
+{
+	auto fb (ysu::ipc::flatbuffer_producer::make_buffer (confirmation_a));
+	if (!confirmation_ring->write (fb->GetBufferPointer (), fb->GetSize ()))
+	{
+		node.stats.inc (ysu::stat::type::ipc, ysu::stat::detail::shared_memory_publish, ysu::stat::dir::out);
+		if (confirmation_ring->last_overwritten_readers () > 0)
+		{
+			node.stats.add (ysu::stat::type::ipc, ysu::stat::detail::shared_memory_overwrite, ysu::stat::dir::out, confirmation_ring->last_overwritten_readers ());
+		}
+	}
+	else
+	{
+		node.logger.always_log ("IPC: confirmation event too large for shared memory ring");
+	}
+}
+
+ysu::ipc::ring_writer * ysu::ipc::broker::get_confirmation_ring () const
+{
+	return confirmation_ring.get ();
+}
+
 size_t ysu::ipc::broker::confirmation_subscriber_count () const
 {
 	return confirmation_subscribers->size ();
@@ -2,6 +2,7 @@
 
 #include <ysu/ipc_flatbuffers_lib/generated/flatbuffers/ysuapi_generated.h>
 #include <ysu/lib/ipc.hpp>
+#include <ysu/lib/ipc_ring.hpp>
 #include <ysu/lib/locks.hpp>
 #include <ysu/node/ipc/ipc_broker.hpp>
 #include <ysu/node/node_rpc_config.hpp>
@@ -85,6 +86,8 @@ namespace ipc
 		/** Subscribe to EventServiceStop notifications for \p subscriber_a. The subscriber must first have called ServiceRegister. */
 		void subscribe (std::weak_ptr<ysu::ipc::subscriber> const & subscriber_a, std::shared_ptr<ysuapi::TopicServiceStopT> const & service_stop_a);
 
+		/** Returns the shared memory ring confirmations are published to, or nullptr if the transport is disabled */
+		ysu::ipc::ring_writer * get_confirmation_ring () const;
 		/** Returns the number of confirmation subscribers */
 		size_t confirmation_subscriber_count () const;
 		/** Associate the service name with the subscriber */
@@ -96,7 +99,11 @@ namespace ipc
 		/** Broadcast block confirmations */
 		void broadcast (std::shared_ptr<ysuapi::EventConfirmationT> const & confirmation_a);
 
+		/** Publish block confirmations into the shared memory ring. The full event is written once; readers apply their own filters. */
+		void publish (ysuapi::EventConfirmationT const & confirmation_a);
+
 		ysu::node & node;
+		std::unique_ptr<ysu::ipc::ring_writer> confirmation_ring;
 		mutable ysu::locked<std::vector<subscription<ysuapi::TopicConfirmationT>>> confirmation_subscribers;
 		mutable ysu::locked<std::vector<subscription<ysuapi::TopicServiceStopT>>> service_stop_subscribers;
 	};
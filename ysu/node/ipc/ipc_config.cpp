@@ -29,8 +29,15 @@ ysu::error ysu::ipc::ipc_config::serialize_toml (ysu::tomlconfig & toml) const
 	ysu::tomlconfig flatbuffers_l;
 	flatbuffers_l.put ("skip_unexpected_fields_in_json", flatbuffers.skip_unexpected_fields_in_json, "Allow client to send unknown fields in json messages. These will be ignored.\ntype:bool");
 	flatbuffers_l.put ("verify_buffers", flatbuffers.verify_buffers, "Verify that the buffer is valid before parsing. This is recommended when receiving data from untrusted sources.\ntype:bool");
+	flatbuffers_l.put ("max_count", flatbuffers.max_count, "Maximum number of entries returned by the Pending, AccountHistory and Frontiers queries. Larger counts, and Pending queries without a count, are limited to this.\ntype:uint64");
 	toml.put_child ("flatbuffers", flatbuffers_l);
 
+	ysu::tomlconfig shared_memory_l;
+	shared_memory_l.put ("enable", shared_memory.enabled, "Publish confirmation events into a shared memory ring which local processes can poll without syscalls. Experimental.\ntype:bool");
+	shared_memory_l.put ("confirmation_ring_name", shared_memory.confirmation_ring_name, "Name of the shared memory object holding confirmation events.\ntype:string");
+	shared_memory_l.put ("capacity", shared_memory.capacity, "Size of the ring in bytes, rounded up to a power of two. Readers which fall behind by more than this are overrun.\ntype:uint64");
+	toml.put_child ("shared_memory", shared_memory_l);
+
 	return toml.get_error ();
 }
 
@@ -61,6 +68,15 @@ ysu::error ysu::ipc::ipc_config::deserialize_toml (ysu::tomlconfig & toml)
 	{
 		flatbuffers_l->get<bool> ("skip_unexpected_fields_in_json", flatbuffers.skip_unexpected_fields_in_json);
 		flatbuffers_l->get<bool> ("verify_buffers", flatbuffers.verify_buffers);
+		flatbuffers_l->get<uint64_t> ("max_count", flatbuffers.max_count);
+	}
+
+	auto shared_memory_l (toml.get_optional_child ("shared_memory"));
+	if (shared_memory_l)
+	{
+		shared_memory_l->get<bool> ("enable", shared_memory.enabled);
+		shared_memory_l->get<std::string> ("confirmation_ring_name", shared_memory.confirmation_ring_name);
+		shared_memory_l->get<size_t> ("capacity", shared_memory.capacity);
 	}
 
 	return toml.get_error ();
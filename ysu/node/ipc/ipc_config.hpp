@@ -30,6 +30,8 @@ namespace ipc
 	public:
 		bool skip_unexpected_fields_in_json{ true };
 		bool verify_buffers{ true };
+		/** Upper bound on the entries returned by the Pending, AccountHistory and Frontiers queries */
+		uint64_t max_count{ 10000 };
 	};
 
 	/** Domain socket specific transport config */
@@ -61,6 +63,17 @@ namespace ipc
 		uint16_t port;
 	};
 
+	/** Shared memory ring transport for broker topics. Local consumers poll the ring instead of subscribing over a socket. */
+	class ipc_config_shared_memory final
+	{
+	public:
+		bool enabled{ false };
+		/** Name of the shared memory object holding confirmation events */
+		std::string confirmation_ring_name{ "ysu_confirmations" };
+		/** Size of the ring data area in bytes, rounded up to a power of two */
+		size_t capacity{ 16 * 1024 * 1024 };
+	};
+
 	/** IPC configuration */
 	class ipc_config
 	{
@@ -72,6 +85,7 @@ namespace ipc
 		ipc_config_domain_socket transport_domain;
 		ipc_config_tcp_socket transport_tcp;
 		ipc_config_flatbuffers flatbuffers;
+		ipc_config_shared_memory shared_memory;
 	};
 }
 }
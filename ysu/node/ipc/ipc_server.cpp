@@ -612,7 +612,7 @@ broker (node_a)
 
 		node.logger.always_log ("IPC: server started");
 
-		if (!transports.empty ())
+		if (!transports.empty () || node_a.config.ipc_config.shared_memory.enabled)
 		{
 			broker.start ();
 		}
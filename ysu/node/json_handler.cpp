@@ -901,7 +901,10 @@ void ysu::json_handler::accounts_pending ()
 		if (!ec)
 		{
 			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending_begin (transaction, ysu::pending_key (account, 0))), n (node.store.pending_end ()); i != n && ysu::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			// Accounts whose largest pending amount is below the threshold are not scanned
+			auto summary (node.store.pending_summary_get (transaction, account));
+			auto any (summary.count != 0 && summary.max.number () >= threshold.number ());
+			for (auto i (node.store.pending_begin (transaction, ysu::pending_key (account, 0))), n (node.store.pending_end ()); any && i != n && ysu::pending_key (i->first).account == account && peers_l.size () < count; ++i)
 			{
 				ysu::pending_key const & key (i->first);
 				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
@@ -1061,7 +1064,7 @@ void ysu::json_handler::block_confirm ()
 				// Add record in confirmation history for confirmed block
 				ysu::election_status status{ block_l, 0, std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::system_clock::now ().time_since_epoch ()), std::chrono::duration_values<std::chrono::milliseconds>::zero (), 0, 1, 0, ysu::election_status_type::active_confirmation_height };
 				{
-					ysu::lock_guard<std::mutex> lock (node.active.mutex);
+					ysu::lock_guard<ysu::mutex> lock (node.active.mutex);
 					node.active.add_recently_cemented (status);
 				}
 				// Trigger callback for confirmed block
@@ -1255,7 +1258,7 @@ void ysu::json_handler::block_account ()
 void ysu::json_handler::block_count ()
 {
 	response_l.put ("count", std::to_string (node.ledger.cache.block_count));
-	response_l.put ("unchecked", std::to_string (node.store.unchecked_count (node.store.tx_begin_read ())));
+	response_l.put ("unchecked", std::to_string (node.ledger.cache.unchecked_count));
 	response_l.put ("cemented", std::to_string (node.ledger.cache.cemented_count));
 	response_errors ();
 }
@@ -1615,6 +1618,28 @@ void ysu::json_handler::block_hash ()
 	response_errors ();
 }
 
+void ysu::json_handler::block_trace ()
+{
+	if (!node.block_tracer.enabled ())
+	{
+		ec = ysu::error_rpc::block_tracing_disabled;
+	}
+	if (!ec)
+	{
+		// The trace-event format needs numeric fields, which the property tree would write as strings
+		auto trace (node.block_tracer.export_json ());
+		if (request.get<bool> ("clear", false))
+		{
+			node.block_tracer.clear ();
+		}
+		response (trace);
+	}
+	else
+	{
+		response_errors ();
+	}
+}
+
 void ysu::json_handler::bootstrap ()
 {
 	std::string address_text = request.get<std::string> ("address");
@@ -1703,6 +1728,9 @@ void ysu::json_handler::bootstrap_status ()
 		connections.put ("idle", std::to_string (node.bootstrap_initiator.connections->idle.size ()));
 		connections.put ("target_connections", std::to_string (node.bootstrap_initiator.connections->target_connections (node.bootstrap_initiator.connections->pulls.size (), attempts_count)));
 		connections.put ("pulls", std::to_string (node.bootstrap_initiator.connections->pulls.size ()));
+		connections.put ("pool_scale", std::to_string (node.bootstrap_initiator.connections->pool_scale.load ()));
+		connections.put ("drain_rate", std::to_string (static_cast<uint64_t> (node.bootstrap_initiator.connections->drain_rate.load ())));
+		connections.put ("scored_peers", std::to_string (node.bootstrap_initiator.connections->peer_scores.size ()));
 	}
 	response_l.add_child ("connections", connections);
 	boost::property_tree::ptree attempts;
@@ -1775,7 +1803,7 @@ void ysu::json_handler::confirmation_active ()
 	}
 	boost::property_tree::ptree elections;
 	{
-		ysu::lock_guard<std::mutex> lock (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> lock (node.active.mutex);
 		for (auto i (node.active.roots.begin ()), n (node.active.roots.end ()); i != n; ++i)
 		{
 			if (i->election->confirmation_request_count >= announcements)
@@ -1854,6 +1882,61 @@ void ysu::json_handler::confirmation_history ()
 	response_errors ();
 }
 
+void ysu::json_handler::confirmation_log ()
+{
+	uint64_t from_seq (0);
+	boost::optional<std::string> from_seq_text (request.get_optional<std::string> ("from_seq"));
+	if (from_seq_text.is_initialized () && decode_unsigned (from_seq_text.get (), from_seq))
+	{
+		ec = ysu::error_rpc::invalid_offset;
+	}
+	auto count (count_optional_impl (1000));
+	const bool json_block_l = request.get<bool> ("json_block", false);
+	if (!ec && node.confirmation_log == nullptr)
+	{
+		ec = ysu::error_rpc::confirmation_log_disabled;
+	}
+	if (!ec)
+	{
+		auto entries (node.confirmation_log->read (from_seq, count));
+		boost::property_tree::ptree entries_l;
+		for (auto const & entry : entries)
+		{
+			auto const & block (*entry.block);
+			boost::property_tree::ptree entry_l;
+			entry_l.put ("sequence", std::to_string (entry.sequence));
+			entry_l.put ("timestamp", std::to_string (entry.timestamp));
+			entry_l.put ("hash", block.hash ().to_string ());
+			entry_l.put ("account", (block.account ().is_zero () ? block.sideband ().account : block.account ()).to_account ());
+			entry_l.put ("height", std::to_string (block.sideband ().height));
+			entry_l.put ("local_timestamp", std::to_string (block.sideband ().timestamp));
+			if (block.type () == ysu::block_type::state)
+			{
+				entry_l.put ("subtype", ysu::state_subtype (block.sideband ().details));
+			}
+			if (json_block_l)
+			{
+				boost::property_tree::ptree block_node_l;
+				block.serialize_json (block_node_l);
+				entry_l.add_child ("contents", block_node_l);
+			}
+			else
+			{
+				std::string contents;
+				block.serialize_json (contents);
+				entry_l.put ("contents", contents);
+			}
+			entries_l.push_back (std::make_pair ("", entry_l));
+		}
+		auto last (node.confirmation_log->last_sequence ());
+		response_l.put ("first_seq", std::to_string (node.confirmation_log->first_sequence ()));
+		response_l.put ("last_seq", std::to_string (last));
+		response_l.put ("next_seq", std::to_string (entries.empty () ? std::max (from_seq, last + 1) : entries.back ().sequence + 1));
+		response_l.add_child ("entries", entries_l);
+	}
+	response_errors ();
+}
+
 void ysu::json_handler::confirmation_info ()
 {
 	const bool representatives = request.get<bool> ("representatives", false);
@@ -1864,7 +1947,7 @@ void ysu::json_handler::confirmation_info ()
 	if (!root.decode_hex (root_text))
 	{
 		auto election (node.active.election (root));
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		if (election != nullptr && !election->confirmed ())
 		{
 			response_l.put ("announcements", std::to_string (election->confirmation_request_count));
@@ -2324,6 +2407,24 @@ public:
 	ysu::network_params network_params;
 	std::vector<ysu::public_key> const & accounts_filter;
 };
+
+/** Blocks read from the ledger at a time while building history */
+size_t constexpr history_batch_size = 256;
+
+/** History cursors are opaque to clients, they hold the account and the height of the next block to return */
+std::string history_cursor (ysu::account const & account_a, uint64_t height_a)
+{
+	return account_a.to_string () + ysu::to_string_hex (height_a);
+}
+
+bool history_cursor_decode (std::string const & text_a, ysu::account & account_a, uint64_t & height_a)
+{
+	auto account_size (sizeof (account_a.bytes) * 2);
+	auto error (text_a.size () != account_size + 16);
+	error = error || account_a.decode_hex (text_a.substr (0, account_size));
+	error = error || ysu::from_string_hex (text_a.substr (account_size), height_a);
+	return error || height_a == 0;
+}
 }
 
 void ysu::json_handler::account_history ()
@@ -2346,19 +2447,30 @@ void ysu::json_handler::account_history ()
 		}
 	}
 	ysu::account account;
-	ysu::block_hash hash;
+	uint64_t height (0);
 	bool reverse (request.get_optional<bool> ("reverse") == true);
 	auto head_str (request.get_optional<std::string> ("head"));
+	auto cursor_str (request.get_optional<std::string> ("cursor"));
 	auto transaction (node.store.tx_begin_read ());
 	auto count (count_impl ());
 	auto offset (offset_optional_impl (0));
-	if (head_str)
+	if (cursor_str)
 	{
+		if (history_cursor_decode (*cursor_str, account, height))
+		{
+			ec = ysu::error_rpc::bad_cursor;
+		}
+	}
+	else if (head_str)
+	{
+		ysu::block_hash hash;
 		if (!hash.decode_hex (*head_str))
 		{
-			if (node.store.block_exists (transaction, hash))
+			auto block (node.store.block_get (transaction, hash));
+			if (block != nullptr)
 			{
 				account = node.ledger.account (transaction, hash);
+				height = block->sideband ().height;
 			}
 			else
 			{
@@ -2377,32 +2489,45 @@ void ysu::json_handler::account_history ()
 		{
 			if (reverse)
 			{
-				auto info (account_info_impl (transaction, account));
-				if (!ec)
-				{
-					hash = info.open_block;
-				}
+				account_info_impl (transaction, account);
+				height = 1;
 			}
 			else
 			{
-				hash = node.ledger.latest (transaction, account);
+				ysu::account_info info;
+				if (!node.store.account_get (transaction, account, info))
+				{
+					height = info.block_count;
+				}
 			}
 		}
 	}
 	if (!ec)
 	{
+		// Offsets are applied by seeking in the height index instead of reading the skipped blocks
+		if (reverse)
+		{
+			// Nothing is returned past the head of the account, which also keeps large offsets from wrapping around
+			ysu::account_info info;
+			auto exists (!node.store.account_get (transaction, account, info));
+			height = exists && height <= info.block_count && offset <= info.block_count - height ? height + offset : 0;
+		}
+		else
+		{
+			height -= std::min (height, offset);
+		}
 		boost::property_tree::ptree history;
 		bool output_raw (request.get_optional<bool> ("raw") == true);
 		response_l.put ("account", account.to_account ());
-		auto block (node.store.block_get (transaction, hash));
-		while (block != nullptr && count > 0)
+		for (auto more (height != 0); more && count > 0;)
 		{
-			if (offset > 0)
-			{
-				--offset;
-			}
-			else
+			auto requested (static_cast<size_t> (std::min<uint64_t> (count, history_batch_size)));
+			auto blocks (node.ledger.account_blocks (transaction, account, height, requested, reverse));
+			more = blocks.size () == requested;
+			for (auto i (blocks.begin ()), n (blocks.end ()); i != n && count > 0; ++i)
 			{
+				auto const & block (*i);
+				auto hash (block->hash ());
 				boost::property_tree::ptree entry;
 				history_visitor visitor (*this, output_raw, transaction, entry, hash, accounts_to_filter);
 				block->visit (visitor);
@@ -2419,14 +2544,15 @@ void ysu::json_handler::account_history ()
 					history.push_back (std::make_pair ("", entry));
 					--count;
 				}
+				height = reverse ? height + 1 : height - 1;
 			}
-			hash = reverse ? node.store.block_successor (transaction, hash) : block->previous ();
-			block = node.store.block_get (transaction, hash);
 		}
 		response_l.add_child ("history", history);
-		if (!hash.is_zero ())
+		auto next (height != 0 ? node.store.account_height_get (transaction, account, height) : ysu::block_hash (0));
+		if (!next.is_zero ())
 		{
-			response_l.put (reverse ? "next" : "previous", hash.to_string ());
+			response_l.put (reverse ? "next" : "previous", next.to_string ());
+			response_l.put ("cursor", history_cursor (account, height));
 		}
 	}
 	response_errors ();
@@ -2506,42 +2632,64 @@ void ysu::json_handler::ledger ()
 		const bool pending = request.get<bool> ("pending", false);
 		boost::property_tree::ptree accounts;
 		auto transaction (node.store.tx_begin_read ());
+		auto add_account = [&](ysu::account const & account, ysu::account_info const & info) {
+			if (pending || info.balance.number () >= threshold.number ())
+			{
+				boost::property_tree::ptree response_a;
+				if (pending)
+				{
+					auto account_pending (node.ledger.account_pending (transaction, account));
+					if (info.balance.number () + account_pending < threshold.number ())
+					{
+						return;
+					}
+					response_a.put ("pending", account_pending.convert_to<std::string> ());
+				}
+				response_a.put ("frontier", info.head.to_string ());
+				response_a.put ("open_block", info.open_block.to_string ());
+				response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+				std::string balance;
+				ysu::uint128_union (info.balance).encode_dec (balance);
+				response_a.put ("balance", balance);
+				response_a.put ("modified_timestamp", std::to_string (info.modified));
+				response_a.put ("block_count", std::to_string (info.block_count));
+				if (representative)
+				{
+					response_a.put ("representative", info.representative.to_account ());
+				}
+				if (weight)
+				{
+					auto account_weight (node.ledger.weight (account));
+					response_a.put ("weight", account_weight.convert_to<std::string> ());
+				}
+				accounts.push_back (std::make_pair (account.to_account (), response_a));
+			}
+		};
 		if (!ec && !sorting) // Simple
 		{
 			for (auto i (node.store.accounts_begin (transaction, start)), n (node.store.accounts_end ()); i != n && accounts.size () < count; ++i)
 			{
 				ysu::account_info const & info (i->second);
-				if (info.modified >= modified_since && (pending || info.balance.number () >= threshold.number ()))
+				if (info.modified >= modified_since)
 				{
-					ysu::account const & account (i->first);
-					boost::property_tree::ptree response_a;
-					if (pending)
-					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
-						{
-							continue;
-						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
-					std::string balance;
-					ysu::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						response_a.put ("representative", info.representative.to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					add_account (i->first, info);
+				}
+			}
+		}
+		else if (!ec && node.ledger.balance_index) // Sorting with the balance index
+		{
+			for (auto i (node.store.account_balance_begin (transaction)), n (node.store.account_balance_end ()); i != n && accounts.size () < count; ++i)
+			{
+				if (!pending && i->first.balance ().number () < threshold.number ())
+				{
+					// All following accounts have lower balances
+					break;
+				}
+				ysu::account const & account (i->first.account ());
+				ysu::account_info info;
+				if (i->second >= modified_since && !(account < start) && !node.store.account_get (transaction, account, info))
+				{
+					add_account (account, info);
 				}
 			}
 		}
@@ -2563,38 +2711,7 @@ void ysu::json_handler::ledger ()
 			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
 			{
 				node.store.account_get (transaction, i->second, info);
-				if (pending || info.balance.number () >= threshold.number ())
-				{
-					ysu::account const & account (i->second);
-					boost::property_tree::ptree response_a;
-					if (pending)
-					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
-						{
-							continue;
-						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
-					std::string balance;
-					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						response_a.put ("representative", info.representative.to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
-				}
+				add_account (i->second, info);
 			}
 		}
 		response_l.add_child ("accounts", accounts);
@@ -2602,6 +2719,62 @@ void ysu::json_handler::ledger ()
 	response_errors ();
 }
 
+void ysu::json_handler::lock_contention ()
+{
+	auto enable (request.get_optional<bool> ("enable"));
+	const bool reset = request.get<bool> ("reset", false);
+	if (enable.is_initialized ())
+	{
+		ysu::lock_profiler::enable (enable.get ());
+	}
+	auto profiles (ysu::lock_profiler::collect ());
+	if (reset)
+	{
+		ysu::lock_profiler::clear ();
+	}
+	// Most contended call sites first
+	std::stable_sort (profiles.begin (), profiles.end (), [](ysu::lock_profile const & lhs, ysu::lock_profile const & rhs) {
+		return lhs.stats.wait_total > rhs.stats.wait_total;
+	});
+	auto histogram = [](ysu::lock_histogram const & histogram_a) {
+		// Keyed by the lower bound of each non-empty bucket in microseconds
+		boost::property_tree::ptree histogram_l;
+		for (size_t i (0); i < histogram_a.buckets.size (); ++i)
+		{
+			if (histogram_a.buckets[i] != 0)
+			{
+				histogram_l.put (std::to_string (i == 0 ? 0 : 1ULL << i), std::to_string (histogram_a.buckets[i]));
+			}
+		}
+		return histogram_l;
+	};
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+	boost::property_tree::ptree mutexes;
+	for (auto const & profile : profiles)
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("site", profile.file + ":" + std::to_string (profile.line));
+		entry.put ("acquisitions", std::to_string (profile.stats.acquisitions));
+		entry.put ("contended", std::to_string (profile.stats.contended));
+		entry.put ("wait_total_us", std::to_string (duration_cast<microseconds> (profile.stats.wait_total).count ()));
+		entry.put ("wait_max_us", std::to_string (duration_cast<microseconds> (profile.stats.wait_max).count ()));
+		entry.put ("hold_total_us", std::to_string (duration_cast<microseconds> (profile.stats.hold_total).count ()));
+		entry.put ("hold_max_us", std::to_string (duration_cast<microseconds> (profile.stats.hold_max).count ()));
+		entry.add_child ("wait_histogram", histogram (profile.stats.wait));
+		entry.add_child ("hold_histogram", histogram (profile.stats.hold));
+		auto existing (mutexes.to_iterator (mutexes.find (profile.mutex_name)));
+		if (existing == mutexes.end ())
+		{
+			existing = mutexes.push_back (std::make_pair (profile.mutex_name, boost::property_tree::ptree ()));
+		}
+		existing->second.push_back (std::make_pair ("", entry));
+	}
+	response_l.put ("enabled", ysu::lock_profiler::enabled () ? "true" : "false");
+	response_l.add_child ("mutexes", mutexes);
+	response_errors ();
+}
+
 void ysu::json_handler::mysu_from_raw (ysu::uint128_t ratio)
 {
 	auto amount (amount_impl ());
@@ -3160,6 +3333,28 @@ void ysu::json_handler::process ()
 	}));
 }
 
+void ysu::json_handler::pruning_status ()
+{
+	if (node.ledger_pruning == nullptr)
+	{
+		ec = ysu::error_rpc::pruning_disabled;
+	}
+	if (!ec)
+	{
+		auto status (node.ledger_pruning->status ());
+		response_l.put ("active", status.active);
+		response_l.put ("passes", std::to_string (status.passes));
+		response_l.put ("targets", std::to_string (status.targets));
+		response_l.put ("targets_pruned", std::to_string (status.targets_pruned));
+		response_l.put ("blocks_pruned", std::to_string (status.blocks_pruned));
+		response_l.put ("bytes_reclaimed", std::to_string (status.bytes_reclaimed));
+		response_l.put ("pauses", std::to_string (status.pauses));
+		response_l.put ("last_pass", std::to_string (status.last_pass));
+		response_l.put ("pruned_count", std::to_string (node.ledger.cache.pruned_count));
+	}
+	response_errors ();
+}
+
 void ysu::json_handler::receive ()
 {
 	auto wallet (wallet_impl ());
@@ -3303,9 +3498,10 @@ void ysu::json_handler::representatives ()
 				auto const & amount (rep_amount.second);
 				representation.emplace_back (amount, account.to_account ());
 			}
-			std::sort (representation.begin (), representation.end ());
-			std::reverse (representation.begin (), representation.end ());
-			for (auto i (representation.begin ()), n (representation.end ()); i != n && representatives.size () < count; ++i)
+			// Only the requested number of representatives is ordered
+			auto sorted (std::min<size_t> (count, representation.size ()));
+			std::partial_sort (representation.begin (), representation.begin () + sorted, representation.end (), std::greater<> ());
+			for (auto i (representation.begin ()), n (representation.begin () + sorted); i != n; ++i)
 			{
 				representatives.put (i->second, (i->first).convert_to<std::string> ());
 			}
@@ -3764,7 +3960,7 @@ void ysu::json_handler::telemetry ()
 					if (address.is_loopback () && port == rpc_l->node.network.endpoint ().port ())
 					{
 						// Requesting telemetry metrics locally
-						auto telemetry_data = ysu::local_telemetry_data (rpc_l->node.store, rpc_l->node.ledger.cache, rpc_l->node.network, rpc_l->node.config.bandwidth_limit, rpc_l->node.network_params, rpc_l->node.startup_time, rpc_l->node.active.active_difficulty (), rpc_l->node.node_id);
+						auto telemetry_data = ysu::local_telemetry_data (rpc_l->node.ledger.cache, rpc_l->node.network, rpc_l->node.config.bandwidth_limit, rpc_l->node.network_params, rpc_l->node.startup_time, rpc_l->node.active.active_difficulty (), rpc_l->node.node_id);
 
 						ysu::jsonconfig config_l;
 						auto const should_ignore_identification_metrics = false;
@@ -3936,8 +4132,8 @@ void ysu::json_handler::unchecked ()
 void ysu::json_handler::unchecked_clear ()
 {
 	node.worker.push_task (create_worker_task ([](std::shared_ptr<ysu::json_handler> const & rpc_l) {
-		auto transaction (rpc_l->node.store.tx_begin_write ({ tables::unchecked }));
-		rpc_l->node.store.unchecked_clear (transaction);
+		auto transaction (rpc_l->node.store.tx_begin_write ({ tables::unchecked, tables::unchecked_time }));
+		rpc_l->node.ledger.unchecked_clear (transaction);
 		rpc_l->response_l.put ("success", "");
 		rpc_l->response_errors ();
 	}));
@@ -4037,48 +4233,17 @@ void ysu::json_handler::unopened ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto iterator (node.store.pending_begin (transaction, ysu::pending_key (start, 0)));
-		auto end (node.store.pending_end ());
-		ysu::account current_account (start);
-		ysu::uint128_t current_account_sum{ 0 };
 		boost::property_tree::ptree accounts;
-		while (iterator != end && accounts.size () < count)
+		// Each account with pending entries has a summary holding their total
+		for (auto i (node.store.pending_summary_begin (transaction, start)), n (node.store.pending_summary_end ()); i != n && accounts.size () < count; ++i)
 		{
-			ysu::pending_key key (iterator->first);
-			ysu::account account (key.account);
-			ysu::pending_info info (iterator->second);
-			if (node.store.account_exists (transaction, account))
-			{
-				if (account.number () == std::numeric_limits<ysu::uint256_t>::max ())
-				{
-					break;
-				}
-				// Skip existing accounts
-				iterator = node.store.pending_begin (transaction, ysu::pending_key (account.number () + 1, 0));
-			}
-			else
+			ysu::account const & account (i->first);
+			ysu::pending_summary const & summary (i->second);
+			if (!summary.total.is_zero () && summary.total.number () >= threshold.number () && !node.store.account_exists (transaction, account))
 			{
-				if (account != current_account)
-				{
-					if (current_account_sum > 0)
-					{
-						if (current_account_sum >= threshold.number ())
-						{
-							accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
-						}
-						current_account_sum = 0;
-					}
-					current_account = account;
-				}
-				current_account_sum += info.amount.number ();
-				++iterator;
+				accounts.put (account.to_account (), summary.total.number ().convert_to<std::string> ());
 			}
 		}
-		// last one after iterator reaches end
-		if (accounts.size () < count && current_account_sum > 0 && current_account_sum >= threshold.number ())
-		{
-			accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
-		}
 		response_l.add_child ("accounts", accounts);
 	}
 	response_errors ();
@@ -4409,16 +4574,22 @@ void ysu::json_handler::wallet_history ()
 		{
 			ysu::account const & account (i->first);
 			ysu::account_info info;
-			if (!node.store.account_get (block_transaction, account, info))
+			if (!node.store.account_get (block_transaction, account, info) && info.modified >= modified_since)
 			{
-				auto timestamp (info.modified);
-				auto hash (info.head);
-				while (timestamp >= modified_since && !hash.is_zero ())
+				auto height (info.block_count);
+				for (auto more (true); more;)
 				{
-					auto block (node.store.block_get (block_transaction, hash));
-					timestamp = block->sideband ().timestamp;
-					if (block != nullptr && timestamp >= modified_since)
+					auto blocks (node.ledger.account_blocks (block_transaction, account, height, history_batch_size, false));
+					more = blocks.size () == history_batch_size;
+					for (auto const & block : blocks)
 					{
+						auto timestamp (block->sideband ().timestamp);
+						if (timestamp < modified_since)
+						{
+							more = false;
+							break;
+						}
+						auto hash (block->hash ());
 						boost::property_tree::ptree entry;
 						std::vector<ysu::public_key> no_filter;
 						history_visitor visitor (*this, false, block_transaction, entry, hash, no_filter);
@@ -4430,12 +4601,8 @@ void ysu::json_handler::wallet_history ()
 							entry.put ("local_timestamp", std::to_string (timestamp));
 							entries.insert (std::make_pair (timestamp, entry));
 						}
-						hash = block->previous ();
-					}
-					else
-					{
-						hash.clear ();
 					}
+					height -= blocks.size ();
 				}
 			}
 		}
@@ -4550,7 +4717,9 @@ void ysu::json_handler::wallet_pending ()
 		{
 			ysu::account const & account (i->first);
 			boost::property_tree::ptree peers_l;
-			for (auto ii (node.store.pending_begin (block_transaction, ysu::pending_key (account, 0))), nn (node.store.pending_end ()); ii != nn && ysu::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
+			auto summary (node.store.pending_summary_get (block_transaction, account));
+			auto any (summary.count != 0 && summary.max.number () >= threshold.number ());
+			for (auto ii (node.store.pending_begin (block_transaction, ysu::pending_key (account, 0))), nn (node.store.pending_end ()); any && ii != nn && ysu::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
 			{
 				ysu::pending_key key (ii->first);
 				if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
@@ -5055,6 +5224,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("block_count", &ysu::json_handler::block_count);
 	no_arg_funcs.emplace ("block_create", &ysu::json_handler::block_create);
 	no_arg_funcs.emplace ("block_hash", &ysu::json_handler::block_hash);
+	no_arg_funcs.emplace ("block_trace", &ysu::json_handler::block_trace);
 	no_arg_funcs.emplace ("bootstrap", &ysu::json_handler::bootstrap);
 	no_arg_funcs.emplace ("bootstrap_any", &ysu::json_handler::bootstrap_any);
 	no_arg_funcs.emplace ("bootstrap_lazy", &ysu::json_handler::bootstrap_lazy);
@@ -5062,6 +5232,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("confirmation_active", &ysu::json_handler::confirmation_active);
 	no_arg_funcs.emplace ("confirmation_height_currently_processing", &ysu::json_handler::confirmation_height_currently_processing);
 	no_arg_funcs.emplace ("confirmation_history", &ysu::json_handler::confirmation_history);
+	no_arg_funcs.emplace ("confirmation_log", &ysu::json_handler::confirmation_log);
 	no_arg_funcs.emplace ("confirmation_info", &ysu::json_handler::confirmation_info);
 	no_arg_funcs.emplace ("confirmation_quorum", &ysu::json_handler::confirmation_quorum);
 	no_arg_funcs.emplace ("database_txn_tracker", &ysu::json_handler::database_txn_tracker);
@@ -5075,6 +5246,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("key_create", &ysu::json_handler::key_create);
 	no_arg_funcs.emplace ("key_expand", &ysu::json_handler::key_expand);
 	no_arg_funcs.emplace ("ledger", &ysu::json_handler::ledger);
+	no_arg_funcs.emplace ("lock_contention", &ysu::json_handler::lock_contention);
 	no_arg_funcs.emplace ("node_id", &ysu::json_handler::node_id);
 	no_arg_funcs.emplace ("node_id_delete", &ysu::json_handler::node_id_delete);
 	no_arg_funcs.emplace ("password_change", &ysu::json_handler::password_change);
@@ -5088,6 +5260,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("pending", &ysu::json_handler::pending);
 	no_arg_funcs.emplace ("pending_exists", &ysu::json_handler::pending_exists);
 	no_arg_funcs.emplace ("process", &ysu::json_handler::process);
+	no_arg_funcs.emplace ("pruning_status", &ysu::json_handler::pruning_status);
 	no_arg_funcs.emplace ("receive", &ysu::json_handler::receive);
 	no_arg_funcs.emplace ("receive_minimum", &ysu::json_handler::receive_minimum);
 	no_arg_funcs.emplace ("receive_minimum_set", &ysu::json_handler::receive_minimum_set);
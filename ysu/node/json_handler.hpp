@@ -53,6 +53,7 @@ public:
 	void block_count ();
 	void block_create ();
 	void block_hash ();
+	void block_trace ();
 	void bootstrap ();
 	void bootstrap_any ();
 	void bootstrap_lazy ();
@@ -61,6 +62,7 @@ public:
 	void confirmation_active ();
 	void confirmation_history ();
 	void confirmation_info ();
+	void confirmation_log ();
 	void confirmation_quorum ();
 	void confirmation_height_currently_processing ();
 	void database_txn_tracker ();
@@ -73,6 +75,7 @@ public:
 	void key_create ();
 	void key_expand ();
 	void ledger ();
+	void lock_contention ();
 	void mysu_to_raw (ysu::uint128_t = ysu::Mxrb_ratio);
 	void mysu_from_raw (ysu::uint128_t = ysu::Mxrb_ratio);
 	void node_id ();
@@ -88,6 +91,7 @@ public:
 	void pending ();
 	void pending_exists ();
 	void process ();
+	void pruning_status ();
 	void receive ();
 	void receive_minimum ();
 	void receive_minimum_set ();
@@ -0,0 +1,175 @@
+#include <ysu/lib/threading.hpp>
+#include <ysu/node/ledger_pruning.hpp>
+#include <ysu/node/node.hpp>
+
+#include <boost/format.hpp>
+
+constexpr uint64_t ysu::ledger_pruning::batch_size;
+
+ysu::ledger_pruning::ledger_pruning (ysu::node & node_a) :
+node (node_a)
+{
+}
+
+ysu::ledger_pruning::~ledger_pruning ()
+{
+	stop ();
+}
+
+void ysu::ledger_pruning::start ()
+{
+	debug_assert (!thread.joinable ());
+	thread = std::thread ([this]() {
+		ysu::thread_role::set (ysu::thread_role::name::ledger_pruning);
+		run ();
+	});
+}
+
+void ysu::ledger_pruning::stop ()
+{
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+void ysu::ledger_pruning::trigger ()
+{
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		triggered = true;
+	}
+	condition.notify_all ();
+}
+
+ysu::ledger_pruning_status ysu::ledger_pruning::status ()
+{
+	ysu::lock_guard<ysu::mutex> guard (mutex);
+	return status_m;
+}
+
+void ysu::ledger_pruning::run ()
+{
+	ysu::unique_lock<ysu::mutex> lock (mutex);
+	while (!stopped)
+	{
+		triggered = false;
+		lock.unlock ();
+		pass ();
+		lock.lock ();
+		// Age isn't considered while bootstrapping, so passes are repeated sooner to keep up with the blocks coming in
+		auto bootstrap_weight_reached (node.ledger.cache.block_count >= node.ledger.bootstrap_weight_max_blocks);
+		auto interval (bootstrap_weight_reached ? node.config.max_pruning_age : std::min (node.config.max_pruning_age, std::chrono::seconds (15 * 60)));
+		condition.wait_for (lock, interval, [this]() { return stopped || triggered; });
+	}
+}
+
+void ysu::ledger_pruning::pass ()
+{
+	auto bootstrap_weight_reached (node.ledger.cache.block_count >= node.ledger.bootstrap_weight_max_blocks);
+	uint64_t const max_depth (node.config.max_pruning_depth != 0 ? node.config.max_pruning_depth : std::numeric_limits<uint64_t>::max ());
+	uint64_t const cutoff_time (bootstrap_weight_reached ? ysu::seconds_since_epoch () - node.config.max_pruning_age.count () : std::numeric_limits<uint64_t>::max ());
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		status_m.active = true;
+		status_m.targets = 0;
+		status_m.targets_pruned = 0;
+	}
+	auto targets (collect_targets (max_depth, cutoff_time));
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		status_m.targets = targets.size ();
+	}
+	uint64_t pruned_count (0);
+	while (!targets.empty () && !stopped)
+	{
+		// Pruning shares the write lock with block processing, which takes priority
+		{
+			ysu::unique_lock<ysu::mutex> lock (mutex);
+			if (node.block_processor.half_full ())
+			{
+				++status_m.pauses;
+			}
+			while (node.block_processor.half_full () && !stopped)
+			{
+				condition.wait_for (lock, std::chrono::seconds (1), [this]() { return stopped.load (); });
+			}
+		}
+		uint64_t transaction_pruned (0);
+		uint64_t transaction_bytes (0);
+		uint64_t transaction_targets (0);
+		{
+			auto scoped_write_guard = node.write_database_queue.wait (ysu::writer::pruning);
+			auto transaction (node.store.tx_begin_write ({ tables::account_height, tables::blocks, tables::pruned }));
+			while (!targets.empty () && transaction_pruned < batch_size && !stopped)
+			{
+				transaction_pruned += node.ledger.pruning_action (transaction, targets.front (), batch_size, &transaction_bytes);
+				targets.pop_front ();
+				++transaction_targets;
+			}
+		}
+		pruned_count += transaction_pruned;
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		status_m.targets_pruned += transaction_targets;
+		status_m.blocks_pruned += transaction_pruned;
+		status_m.bytes_reclaimed += transaction_bytes;
+	}
+	{
+		ysu::lock_guard<ysu::mutex> guard (mutex);
+		status_m.active = false;
+		++status_m.passes;
+		status_m.last_pass = ysu::seconds_since_epoch ();
+	}
+	if (pruned_count != 0)
+	{
+		node.logger.always_log (boost::str (boost::format ("Pruned %1% blocks, %2% blocks pruned in total") % pruned_count % node.ledger.cache.pruned_count));
+	}
+}
+
+std::deque<ysu::block_hash> ysu::ledger_pruning::collect_targets (uint64_t max_depth_a, uint64_t cutoff_time_a)
+{
+	std::deque<ysu::block_hash> result;
+	std::mutex result_mutex;
+	node.store.confirmation_height_for_each_par ([this, &result, &result_mutex, max_depth_a, cutoff_time_a](ysu::read_transaction const & transaction_a, ysu::store_iterator<ysu::account, ysu::confirmation_height_info> i, ysu::store_iterator<ysu::account, ysu::confirmation_height_info> n) {
+		std::vector<ysu::block_hash> targets_l;
+		for (; i != n && !stopped; ++i)
+		{
+			ysu::block_hash hash (i->second.frontier);
+			uint64_t depth (0);
+			while (!hash.is_zero () && depth < max_depth_a)
+			{
+				auto block (node.store.block_get (transaction_a, hash));
+				if (block != nullptr)
+				{
+					if (depth == 0 || block->sideband ().timestamp > cutoff_time_a)
+					{
+						hash = block->previous ();
+					}
+					else
+					{
+						break;
+					}
+				}
+				else
+				{
+					// The rest of the chain is pruned already
+					release_assert (depth != 0);
+					hash.clear ();
+				}
+				++depth;
+			}
+			if (!hash.is_zero ())
+			{
+				targets_l.push_back (hash);
+			}
+		}
+		std::lock_guard<std::mutex> guard (result_mutex);
+		result.insert (result.end (), targets_l.begin (), targets_l.end ());
+	});
+	return result;
+}
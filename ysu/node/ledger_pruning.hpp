@@ -0,0 +1,66 @@
+#pragma once
+
+#include <ysu/lib/locks.hpp>
+#include <ysu/lib/numbers.hpp>
+
+#include <atomic>
+#include <deque>
+#include <thread>
+
+namespace ysu
+{
+class node;
+
+class ledger_pruning_status final
+{
+public:
+	/** A pass is collecting or pruning targets */
+	bool active{ false };
+	uint64_t passes{ 0 };
+	/** Chains selected for pruning by the current or last pass, and how many of them were pruned so far */
+	uint64_t targets{ 0 };
+	uint64_t targets_pruned{ 0 };
+	/** Blocks pruned since the node started */
+	uint64_t blocks_pruned{ 0 };
+	/** Size of the pruned block records less the records marking them as pruned, not counting database overhead */
+	uint64_t bytes_reclaimed{ 0 };
+	/** Number of times pruning waited for the block processor */
+	uint64_t pauses{ 0 };
+	/** Seconds since epoch when the last pass completed, 0 if none did */
+	uint64_t last_pass{ 0 };
+};
+
+/**
+ * Prunes cemented blocks in the background for nodes started with --enable_pruning.
+ *
+ * Each pass walks the confirmation heights in parallel read transactions. The walk for an account starts at its confirmed
+ * frontier, which is always kept, and stops at the first block older than node_config::max_pruning_age, or after
+ * node_config::max_pruning_depth blocks if that is set. The block it stopped at and all blocks below it are pruned.
+ * Until the ledger reaches the block count the bootstrap weights were sampled at, block age is not considered.
+ * Blocks are pruned in write transactions of about batch_size blocks, waiting while the block processor is half full.
+ */
+class ledger_pruning final
+{
+public:
+	explicit ledger_pruning (ysu::node &);
+	~ledger_pruning ();
+	void start ();
+	void stop ();
+	/** Starts the next pass now instead of after the pass interval */
+	void trigger ();
+	ysu::ledger_pruning_status status ();
+	static uint64_t constexpr batch_size = 2 * 1024;
+
+private:
+	void run ();
+	void pass ();
+	std::deque<ysu::block_hash> collect_targets (uint64_t max_depth_a, uint64_t cutoff_time_a);
+	ysu::node & node;
+	ysu::ledger_pruning_status status_m;
+	std::atomic<bool> stopped{ false };
+	bool triggered{ false };
+	ysu::mutex mutex{ "ledger_pruning" };
+	ysu::condition_variable condition;
+	std::thread thread;
+};
+}
@@ -11,6 +11,7 @@
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <cstring>
 #include <queue>
 
 namespace ysu
@@ -101,6 +102,31 @@ txn_tracking_enabled (txn_tracking_config_a.enable)
 			open_databases (error, transaction, 0);
 		}
 	}
+	if (!error)
+	{
+		// Databases are all opened, so read transactions no longer need to commit
+		env.read_txn_cache->enabled = true;
+		error = cold_init (path_a.string () + "-cold");
+	}
+	if (!error)
+	{
+		auto check (block_filter_check ());
+		block_filter_open (path_a.string () + "-filter", check, check, false);
+	}
+}
+
+ysu::mdb_store::~mdb_store ()
+{
+	if (!error)
+	{
+		block_filter_close (block_filter_check ());
+	}
+}
+
+uint64_t ysu::mdb_store::block_filter_check ()
+{
+	auto transaction (tx_begin_read ());
+	return count (transaction, tables::blocks) + count (transaction, tables::pruned);
 }
 
 bool ysu::mdb_store::vacuum_after_upgrade (boost::filesystem::path const & path_a, ysu::lmdb_config const & lmdb_config_a)
@@ -112,12 +138,11 @@ bool ysu::mdb_store::vacuum_after_upgrade (boost::filesystem::path const & path_
 	if (vacuum_success)
 	{
 		// Need to close the database to release the file handle
-		mdb_env_sync (env.environment, true);
-		mdb_env_close (env.environment);
-		env.environment = nullptr;
+		env.close ();
 
-		// Replace the ledger file with the vacuumed one
+		// Replace the ledger file with the vacuumed one, the cold tier of the original stays in place
 		boost::filesystem::rename (vacuum_path, path_a);
+		boost::filesystem::remove_all (vacuum_path.string () + "-cold");
 
 		// Set up the environment again
 		auto options = ysu::mdb_env::options::make ()
@@ -134,6 +159,7 @@ bool ysu::mdb_store::vacuum_after_upgrade (boost::filesystem::path const & path_
 	{
 		// The vacuum file can be in an inconsistent state if there wasn't enough space to create it
 		boost::filesystem::remove (vacuum_path);
+		boost::filesystem::remove_all (vacuum_path.string () + "-cold");
 	}
 	return vacuum_success;
 }
@@ -158,12 +184,12 @@ void ysu::mdb_store::serialize_memory_stats (boost::property_tree::ptree & json)
 
 ysu::write_transaction ysu::mdb_store::tx_begin_write (std::vector<ysu::tables> const &, std::vector<ysu::tables> const &)
 {
-	return env.tx_begin_write (create_txn_callbacks ());
+	return env.tx_begin_write (create_txn_callbacks (), &cache);
 }
 
 ysu::read_transaction ysu::mdb_store::tx_begin_read ()
 {
-	return env.tx_begin_read (create_txn_callbacks ());
+	return env.tx_begin_read (create_txn_callbacks (), &cache);
 }
 
 std::string ysu::mdb_store::vendor_get () const
@@ -190,12 +216,16 @@ void ysu::mdb_store::open_databases (bool & error_a, ysu::transaction const & tr
 {
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "frontiers", flags, &frontiers) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "unchecked", flags, &unchecked) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "unchecked_time", flags, &unchecked_time) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "vote", flags, &vote) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "online_weight", flags, &online_weight) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "meta", flags, &meta) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "peers", flags, &peers) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pruned", flags, &pruned) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "confirmation_height", flags, &confirmation_height) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "account_height", flags, &account_height) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "account_balance", flags, &account_balance) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending_summary", flags, &pending_summary) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "accounts", flags, &accounts_v0) != 0;
 	accounts = accounts_v0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending", flags, &pending_v0) != 0;
@@ -276,6 +306,17 @@ bool ysu::mdb_store::do_upgrades (ysu::write_transaction & transaction_a, bool &
 		case 19:
 			upgrade_v19_to_v20 (transaction_a);
 		case 20:
+			upgrade_v20_to_v21 (transaction_a);
+		case 21:
+			upgrade_v21_to_v22 (transaction_a);
+		case 22:
+			upgrade_v22_to_v23 (transaction_a);
+		case 23:
+			upgrade_v23_to_v24 (transaction_a);
+		case 24:
+			upgrade_v24_to_v25 (transaction_a);
+			needs_vacuuming = true;
+		case 25:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -737,6 +778,97 @@ void ysu::mdb_store::upgrade_v19_to_v20 (ysu::write_transaction const & transact
 	logger.always_log ("Finished creating new pruned table");
 }
 
+void ysu::mdb_store::upgrade_v20_to_v21 (ysu::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v20 to v21 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "unchecked_time", MDB_CREATE, &unchecked_time);
+	for (auto i (unchecked_begin (transaction_a)), n (unchecked_end ()); i != n; ++i)
+	{
+		auto status (put_key (transaction_a, tables::unchecked_time, ysu::unchecked_time_key (i->second.modified, i->first)));
+		release_assert (success (status));
+	}
+	version_put (transaction_a, 21);
+	logger.always_log ("Finished indexing unchecked blocks by time");
+}
+
+void ysu::mdb_store::upgrade_v21_to_v22 (ysu::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v21 to v22 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "account_height", MDB_CREATE, &account_height);
+	account_height_build (transaction_a);
+	version_put (transaction_a, 22);
+	logger.always_log ("Finished indexing account chains by height");
+}
+
+void ysu::mdb_store::upgrade_v22_to_v23 (ysu::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v22 to v23 database upgrade...");
+	// The balance index is only filled by nodes which enable it
+	mdb_dbi_open (env.tx (transaction_a), "account_balance", MDB_CREATE, &account_balance);
+	version_put (transaction_a, 23);
+	logger.always_log ("Finished creating the account balance index");
+}
+
+void ysu::mdb_store::upgrade_v23_to_v24 (ysu::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v23 to v24 database upgrade...");
+	mdb_dbi_open (env.tx (transaction_a), "pending_summary", MDB_CREATE, &pending_summary);
+	pending_summary_build (transaction_a);
+	version_put (transaction_a, 24);
+	logger.always_log ("Finished summarizing pending entries");
+}
+
+void ysu::mdb_store::upgrade_v24_to_v25 (ysu::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v24 to v25 database upgrade...");
+	auto count_pre (count (transaction_a, blocks));
+	// Blocks are read in batches and written once the cursor is closed, as writes would move a cursor open on the same table
+	size_t const batch_size (64 * 1024);
+	ysu::block_hash start (0);
+	auto done (false);
+	uint64_t num (0);
+	while (!done)
+	{
+		std::vector<std::pair<ysu::block_hash, std::vector<uint8_t>>> batch;
+		size_t read (0);
+		{
+			ysu::mdb_iterator<ysu::block_hash, ysu::mdb_val> i (transaction_a, blocks, ysu::mdb_val (start)), n{};
+			for (; i != n && read < batch_size; ++i, ++read)
+			{
+				auto data (reinterpret_cast<uint8_t const *> (i->second.data ()));
+				// Values already encoded were written by an upgrade which was interrupted
+				if (!ysu::block_value_compact (data))
+				{
+					auto block (ysu::deserialize_block_value (data, i->second.size ()));
+					release_assert (block != nullptr);
+					batch.emplace_back (ysu::block_hash (i->first), std::vector<uint8_t>{});
+					ysu::vectorstream stream (batch.back ().second);
+					ysu::serialize_block_value (stream, *block);
+				}
+			}
+			done = i == n;
+			if (!done)
+			{
+				start = ysu::block_hash (i->first);
+			}
+		}
+		for (auto const & entry : batch)
+		{
+			auto status (mdb_put (env.tx (transaction_a), blocks, ysu::mdb_val (entry.first), ysu::mdb_val (entry.second.size (), const_cast<uint8_t *> (entry.second.data ())), 0));
+			release_assert (success (status));
+		}
+		num += read;
+		if (!done)
+		{
+			logger.always_log (boost::str (boost::format ("Encoded %1% blocks") % num));
+		}
+	}
+	auto count_post (count (transaction_a, blocks));
+	release_assert (count_pre == count_post);
+	version_put (transaction_a, 25);
+	logger.always_log ("Finished encoding blocks compactly");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void ysu::mdb_store::create_backup_file (ysu::mdb_env & env_a, boost::filesystem::path const & filepath_a, ysu::logger_mt & logger_a)
 {
@@ -839,14 +971,22 @@ MDB_dbi ysu::mdb_store::table_to_dbi (tables table_a) const
 	{
 		case tables::frontiers:
 			return frontiers;
+		case tables::account_balance:
+			return account_balance;
+		case tables::account_height:
+			return account_height;
 		case tables::accounts:
 			return accounts;
 		case tables::blocks:
 			return blocks;
 		case tables::pending:
 			return pending;
+		case tables::pending_summary:
+			return pending_summary;
 		case tables::unchecked:
 			return unchecked;
+		case tables::unchecked_time:
+			return unchecked_time;
 		case tables::vote:
 			return vote;
 		case tables::online_weight:
@@ -882,7 +1022,37 @@ int ysu::mdb_store::status_code_not_found () const
 
 bool ysu::mdb_store::copy_db (boost::filesystem::path const & destination_file)
 {
-	return !mdb_env_copy2 (env.environment, destination_file.string ().c_str (), MDB_CP_COMPACT);
+	return !mdb_env_copy2 (env.environment, destination_file.string ().c_str (), MDB_CP_COMPACT) && !cold_copy (destination_file.string () + "-cold");
+}
+
+void ysu::mdb_store::put_sorted (ysu::write_transaction const & transaction_a, ysu::tables table_a, ysu::sorted_records const & records_a)
+{
+	block_filter_insert (table_a, records_a);
+	if (!records_a.empty ())
+	{
+		auto dbi (table_to_dbi (table_a));
+		MDB_cursor * cursor;
+		auto status (mdb_cursor_open (env.tx (transaction_a), dbi, &cursor));
+		release_assert (success (status));
+		// Appending fills pages completely without searching the tree, which requires every key to sort after the last one stored
+		MDB_val last_key;
+		MDB_val last_value;
+		auto const & first_key (records_a.front ().first);
+		auto append (mdb_cursor_get (cursor, &last_key, &last_value, MDB_LAST) == MDB_NOTFOUND);
+		if (!append)
+		{
+			auto compare (std::memcmp (first_key.data (), last_key.mv_data, std::min (first_key.size (), last_key.mv_size)));
+			append = compare > 0 || (compare == 0 && first_key.size () > last_key.mv_size);
+		}
+		for (auto const & record : records_a)
+		{
+			MDB_val key{ record.first.size (), const_cast<uint8_t *> (record.first.data ()) };
+			MDB_val value{ record.second.size (), const_cast<uint8_t *> (record.second.data ()) };
+			status = mdb_cursor_put (cursor, &key, &value, append ? MDB_APPEND : 0);
+			release_assert (success (status));
+		}
+		mdb_cursor_close (cursor);
+	}
 }
 
 void ysu::mdb_store::rebuild_db (ysu::write_transaction const & transaction_a)
@@ -38,6 +38,7 @@ public:
 	using block_store_partial::unchecked_put;
 
 	mdb_store (ysu::logger_mt &, boost::filesystem::path const &, ysu::txn_tracking_config const & txn_tracking_config_a = ysu::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), ysu::lmdb_config const & lmdb_config_a = ysu::lmdb_config{}, bool backup_before_upgrade = false);
+	~mdb_store ();
 	ysu::write_transaction tx_begin_write (std::vector<ysu::tables> const & tables_requiring_lock = {}, std::vector<ysu::tables> const & tables_no_lock = {}) override;
 	ysu::read_transaction tx_begin_read () override;
 
@@ -156,6 +157,30 @@ public:
 	 */
 	MDB_dbi unchecked{ 0 };
 
+	/**
+	 * Index of unchecked blocks ordered by the time they were last modified.
+	 * ysu::unchecked_time_key (big endian uint64_t, ysu::unchecked_key) -> none
+	 */
+	MDB_dbi unchecked_time{ 0 };
+
+	/**
+	 * Index of account chains by height.
+	 * ysu::account_height_key (ysu::account, big endian uint64_t) -> ysu::block_hash
+	 */
+	MDB_dbi account_height{ 0 };
+
+	/**
+	 * Index of accounts by balance, only maintained with --enable_balance_index.
+	 * ysu::account_balance_key (ysu::uint128_t, ysu::account) -> uint64_t
+	 */
+	MDB_dbi account_balance{ 0 };
+
+	/**
+	 * Aggregate of the pending entries of each account.
+	 * ysu::account -> uint64_t, ysu::amount, ysu::amount, ysu::block_hash, uint64_t
+	 */
+	MDB_dbi pending_summary{ 0 };
+
 	/**
 	 * Highest vote observed for account.
 	 * ysu::account -> uint64_t
@@ -207,6 +232,7 @@ public:
 
 	bool copy_db (boost::filesystem::path const & destination_file) override;
 	void rebuild_db (ysu::write_transaction const & transaction_a) override;
+	void put_sorted (ysu::write_transaction const & transaction_a, ysu::tables table_a, ysu::sorted_records const & records_a) override;
 
 	template <typename Key, typename Value>
 	ysu::store_iterator<Key, Value> make_iterator (ysu::transaction const & transaction_a, tables table_a) const
@@ -239,6 +265,11 @@ private:
 	void upgrade_v17_to_v18 (ysu::write_transaction const &);
 	void upgrade_v18_to_v19 (ysu::write_transaction const &);
 	void upgrade_v19_to_v20 (ysu::write_transaction const &);
+	void upgrade_v20_to_v21 (ysu::write_transaction const &);
+	void upgrade_v21_to_v22 (ysu::write_transaction const &);
+	void upgrade_v22_to_v23 (ysu::write_transaction const &);
+	void upgrade_v23_to_v24 (ysu::write_transaction const &);
+	void upgrade_v24_to_v25 (ysu::write_transaction const &);
 
 	std::shared_ptr<ysu::block> block_get_v18 (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const;
 	ysu::mdb_val block_raw_get_v18 (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a, ysu::block_type & type_a) const;
@@ -263,6 +294,8 @@ private:
 	uint64_t count (ysu::transaction const & transaction_a, tables table_a) const override;
 
 	bool vacuum_after_upgrade (boost::filesystem::path const & path_a, ysu::lmdb_config const & lmdb_config_a);
+	/** Other processes can write to the same environment, so a persisted block filter is only used if the number of stored hashes didn't change */
+	uint64_t block_filter_check ();
 
 	class upgrade_counters
 	{
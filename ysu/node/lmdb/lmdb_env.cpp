@@ -1,7 +1,142 @@
+#include <ysu/lib/locks.hpp>
 #include <ysu/node/lmdb/lmdb_env.hpp>
+#include <ysu/secure/store_cache.hpp>
 
 #include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
+
+namespace
+{
+/** Slots of the read transaction caches used by a thread, which are released when it exits */
+class thread_read_txn_slots final
+{
+public:
+	class entry final
+	{
+	public:
+		ysu::mdb_read_txn_cache const * cache_raw;
+		std::weak_ptr<ysu::mdb_read_txn_cache> cache;
+		/** Null if the cache had no slot left for this thread */
+		std::shared_ptr<ysu::mdb_read_txn_cache::slot> slot;
+	};
+
+	~thread_read_txn_slots ()
+	{
+		for (auto & entry : entries)
+		{
+			auto cache (entry.cache.lock ());
+			if (cache != nullptr && entry.slot != nullptr)
+			{
+				cache->release (entry.slot);
+			}
+		}
+	}
+
+	std::vector<entry> entries;
+};
+
+thread_local thread_read_txn_slots thread_slots;
+}
+
+ysu::mdb_read_txn_cache::slot * ysu::mdb_read_txn_cache::local_slot ()
+{
+	auto & entries (thread_slots.entries);
+	for (auto const & entry : entries)
+	{
+		// A cache destroyed since can leave an entry with the same address behind
+		if (entry.cache_raw == this && !entry.cache.expired ())
+		{
+			return entry.slot.get ();
+		}
+	}
+	entries.erase (std::remove_if (entries.begin (), entries.end (), [](auto const & entry_a) { return entry_a.cache.expired (); }), entries.end ());
+	std::shared_ptr<slot> result;
+	{
+		ysu::lock_guard<std::mutex> guard (mutex);
+		if (!closed && slots.size () < max_slots)
+		{
+			result = std::make_shared<slot> ();
+			slots.push_back (result);
+		}
+	}
+	entries.push_back ({ this, shared_from_this (), result });
+	return result.get ();
+}
+
+MDB_txn * ysu::mdb_read_txn_cache::take ()
+{
+	MDB_txn * result (nullptr);
+	if (enabled)
+	{
+		auto slot_l (local_slot ());
+		if (slot_l != nullptr)
+		{
+			result = slot_l->handle.exchange (nullptr);
+		}
+	}
+	return result;
+}
+
+bool ysu::mdb_read_txn_cache::put (MDB_txn * handle_a)
+{
+	auto result (false);
+	auto slot_l (enabled ? local_slot () : nullptr);
+	if (slot_l != nullptr)
+	{
+		// Checked under the lock, as a handle cached after close drained the slots would outlive the environment
+		ysu::lock_guard<std::mutex> guard (mutex);
+		if (!closed)
+		{
+			mdb_txn_reset (handle_a);
+			// Nested read transactions on the same thread leave one handle cached
+			auto existing (slot_l->handle.exchange (handle_a));
+			if (existing != nullptr)
+			{
+				mdb_txn_abort (existing);
+			}
+			result = true;
+		}
+	}
+	return result;
+}
+
+void ysu::mdb_read_txn_cache::close ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	enabled = false;
+	closed = true;
+	for (auto const & slot_l : slots)
+	{
+		auto handle (slot_l->handle.exchange (nullptr));
+		if (handle != nullptr)
+		{
+			mdb_txn_abort (handle);
+		}
+	}
+	slots.clear ();
+}
+
+void ysu::mdb_read_txn_cache::release (std::shared_ptr<slot> const & slot_a)
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	if (!closed)
+	{
+		auto handle (slot_a->handle.exchange (nullptr));
+		if (handle != nullptr)
+		{
+			mdb_txn_abort (handle);
+		}
+		slots.erase (std::remove (slots.begin (), slots.end (), slot_a), slots.end ());
+	}
+}
+
+size_t ysu::mdb_read_txn_cache::size ()
+{
+	ysu::lock_guard<std::mutex> guard (mutex);
+	return slots.size ();
+}
+
 ysu::mdb_env::mdb_env (bool & error_a, boost::filesystem::path const & path_a, ysu::mdb_env::options options_a)
 {
 	init (error_a, path_a, options_a);
@@ -9,6 +144,7 @@ ysu::mdb_env::mdb_env (bool & error_a, boost::filesystem::path const & path_a, y
 
 void ysu::mdb_env::init (bool & error_a, boost::filesystem::path const & path_a, ysu::mdb_env::options options_a)
 {
+	read_txn_cache = std::make_shared<ysu::mdb_read_txn_cache> ();
 	boost::system::error_code error_mkdir, error_chmod;
 	if (path_a.has_parent_path ())
 	{
@@ -29,6 +165,9 @@ void ysu::mdb_env::init (bool & error_a, boost::filesystem::path const & path_a,
 			}
 			auto status3 (mdb_env_set_mapsize (environment, map_size));
 			release_assert (status3 == 0);
+			// Cached read transactions keep their reader slots, which would otherwise run out sooner
+			auto status5 (mdb_env_set_maxreaders (environment, ysu::mdb_read_txn_cache::default_max_readers + ysu::mdb_read_txn_cache::max_slots));
+			release_assert (status5 == 0);
 			// It seems if there's ever more threads than mdb_env_set_maxreaders has read slots available, we get failures on transaction creation unless MDB_NOTLS is specified
 			// This can happen if something like 256 io_threads are specified in the node config
 			// MDB_NORDAHEAD will allow platforms that support it to load the DB in memory as needed.
@@ -79,12 +218,19 @@ void ysu::mdb_env::init (bool & error_a, boost::filesystem::path const & path_a,
 }
 
 ysu::mdb_env::~mdb_env ()
+{
+	close ();
+}
+
+void ysu::mdb_env::close ()
 {
 	if (environment != nullptr)
 	{
+		read_txn_cache->close ();
 		// Make sure the commits are flushed. This is a no-op unless MDB_NOSYNC is used.
 		mdb_env_sync (environment, true);
 		mdb_env_close (environment);
+		environment = nullptr;
 	}
 }
 
@@ -93,14 +239,17 @@ ysu::mdb_env::operator MDB_env * () const
 	return environment;
 }
 
-ysu::read_transaction ysu::mdb_env::tx_begin_read (mdb_txn_callbacks mdb_txn_callbacks) const
+ysu::read_transaction ysu::mdb_env::tx_begin_read (mdb_txn_callbacks mdb_txn_callbacks, ysu::store_cache * cache_a) const
 {
-	return ysu::read_transaction{ std::make_unique<ysu::read_mdb_txn> (*this, mdb_txn_callbacks) };
+	auto cache_epoch (cache_a != nullptr ? cache_a->epoch_get () : 0);
+	return ysu::read_transaction{ std::make_unique<ysu::read_mdb_txn> (*this, mdb_txn_callbacks), cache_a, cache_epoch };
 }
 
-ysu::write_transaction ysu::mdb_env::tx_begin_write (mdb_txn_callbacks mdb_txn_callbacks) const
+ysu::write_transaction ysu::mdb_env::tx_begin_write (mdb_txn_callbacks mdb_txn_callbacks, ysu::store_cache * cache_a) const
 {
-	return ysu::write_transaction{ std::make_unique<ysu::write_mdb_txn> (*this, mdb_txn_callbacks) };
+	// Read before waiting for the write lock, which only makes the cache more conservative for this transaction
+	auto cache_epoch (cache_a != nullptr ? cache_a->epoch_get () : 0);
+	return ysu::write_transaction{ std::make_unique<ysu::write_mdb_txn> (*this, mdb_txn_callbacks), cache_a, cache_epoch };
 }
 
 MDB_txn * ysu::mdb_env::tx (ysu::transaction const & transaction_a) const
@@ -4,8 +4,51 @@
 #include <ysu/node/lmdb/lmdb_txn.hpp>
 #include <ysu/secure/blockstore.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace ysu
 {
+/**
+ * Keeps a reset read transaction handle per thread, so that starting a read transaction renews it instead of allocating
+ * a new one and taking the reader table lock. Renewing takes a new snapshot, so reads never see stale data.
+ * Reset handles keep their reader slot, so only up to max_slots threads cache one, and the environment has max_slots
+ * reader slots more than the LMDB default. Caching has to be enabled once
+ * databases are opened, as databases opened within a read transaction are discarded unless it commits.
+ */
+class mdb_read_txn_cache final : public std::enable_shared_from_this<mdb_read_txn_cache>
+{
+public:
+	class slot final
+	{
+	public:
+		std::atomic<MDB_txn *> handle{ nullptr };
+	};
+
+	/** Returns the reset handle cached by this thread, or nullptr */
+	MDB_txn * take ();
+	/** Resets and caches \p handle_a for this thread. Returns false if it was not cached and has to be ended by the caller */
+	bool put (MDB_txn * handle_a);
+	/** Aborts the handles cached by every thread, has to be called before the environment is closed */
+	void close ();
+	/** Aborts the handle cached in \p slot_a, called when its thread exits */
+	void release (std::shared_ptr<slot> const & slot_a);
+	size_t size ();
+	std::atomic<bool> enabled{ false };
+	/** Threads caching a handle at most. mdb_env adds as many reader slots to the LMDB default, so other readers keep theirs */
+	static size_t constexpr max_slots = 63;
+	/** Reader slots of an LMDB environment unless set otherwise */
+	static size_t constexpr default_max_readers = 126;
+
+private:
+	slot * local_slot ();
+	std::mutex mutex;
+	std::vector<std::shared_ptr<slot>> slots;
+	bool closed{ false };
+};
+
 /**
  * RAII wrapper for MDB_env
  */
@@ -57,10 +100,13 @@ public:
 	mdb_env (bool &, boost::filesystem::path const &, ysu::mdb_env::options options_a = ysu::mdb_env::options::make ());
 	void init (bool &, boost::filesystem::path const &, ysu::mdb_env::options options_a = ysu::mdb_env::options::make ());
 	~mdb_env ();
+	/** Closes the environment after aborting the cached read transactions */
+	void close ();
 	operator MDB_env * () const;
-	ysu::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
-	ysu::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
+	ysu::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}, ysu::store_cache * cache_a = nullptr) const;
+	ysu::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}, ysu::store_cache * cache_a = nullptr) const;
 	MDB_txn * tx (ysu::transaction const & transaction_a) const;
 	MDB_env * environment;
+	std::shared_ptr<ysu::mdb_read_txn_cache> read_txn_cache;
 };
 }
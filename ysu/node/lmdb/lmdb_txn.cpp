@@ -50,18 +50,31 @@ private:
 }
 
 ysu::read_mdb_txn::read_mdb_txn (ysu::mdb_env const & environment_a, ysu::mdb_txn_callbacks txn_callbacks_a) :
+read_txn_cache (environment_a.read_txn_cache),
 txn_callbacks (txn_callbacks_a)
 {
-	auto status (mdb_txn_begin (environment_a, nullptr, MDB_RDONLY, &handle));
-	release_assert (status == 0);
+	handle = read_txn_cache->take ();
+	if (handle != nullptr && mdb_txn_renew (handle) != MDB_SUCCESS)
+	{
+		mdb_txn_abort (handle);
+		handle = nullptr;
+	}
+	if (handle == nullptr)
+	{
+		auto status (mdb_txn_begin (environment_a, nullptr, MDB_RDONLY, &handle));
+		release_assert (status == 0);
+	}
 	txn_callbacks.txn_start (this);
 }
 
 ysu::read_mdb_txn::~read_mdb_txn ()
 {
-	// This uses commit rather than abort, as it is needed when opening databases with a read only transaction
-	auto status (mdb_txn_commit (handle));
-	release_assert (status == MDB_SUCCESS);
+	if (!read_txn_cache->put (handle))
+	{
+		// This uses commit rather than abort, as it is needed when opening databases with a read only transaction
+		auto status (mdb_txn_commit (handle));
+		release_assert (status == MDB_SUCCESS);
+	}
 	txn_callbacks.txn_end (this);
 }
 
@@ -7,6 +7,7 @@
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <boost/stacktrace/stacktrace_fwd.hpp>
 
+#include <memory>
 #include <mutex>
 
 #include <lmdb/libraries/liblmdb/lmdb.h>
@@ -16,6 +17,7 @@ namespace ysu
 class transaction_impl;
 class logger_mt;
 class mdb_env;
+class mdb_read_txn_cache;
 
 class mdb_txn_callbacks
 {
@@ -33,6 +35,7 @@ public:
 	void renew () override;
 	void * get_handle () const override;
 	MDB_txn * handle;
+	std::shared_ptr<ysu::mdb_read_txn_cache> read_txn_cache;
 	mdb_txn_callbacks txn_callbacks;
 };
 
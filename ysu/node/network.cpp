@@ -408,6 +408,10 @@ public:
 			node.logger.try_log (boost::str (boost::format ("Publish message from %1% for %2%") % channel->to_string () % message_a.block->hash ().to_string ()));
 		}
 		node.stats.inc (ysu::stat::type::message, ysu::stat::detail::publish, ysu::stat::dir::in);
+		if (node.block_tracer.enabled ())
+		{
+			node.block_tracer.trace (message_a.block->hash (), ysu::block_tracer::stage::arrival);
+		}
 		if (!node.block_processor.full ())
 		{
 			node.process_active (message_a.block);
@@ -508,7 +512,7 @@ public:
 		ysu::telemetry_ack telemetry_ack;
 		if (!node.flags.disable_providing_telemetry_metrics)
 		{
-			auto telemetry_data = ysu::local_telemetry_data (node.store, node.ledger.cache, node.network, node.config.bandwidth_limit, node.network_params, node.startup_time, node.active.active_difficulty (), node.node_id);
+			auto telemetry_data = ysu::local_telemetry_data (node.ledger.cache, node.network, node.config.bandwidth_limit, node.network_params, node.startup_time, node.active.active_difficulty (), node.node_id);
 			telemetry_ack = ysu::telemetry_ack (telemetry_data);
 		}
 		channel->send (telemetry_ack, nullptr, ysu::buffer_drop_policy::no_socket_drop);
@@ -10,12 +10,14 @@
 #include <ysu/node/websocket.hpp>
 #include <ysu/rpc/rpc.hpp>
 #include <ysu/secure/buffer.hpp>
+#include <ysu/secure/store_cache.hpp>
 
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #include <algorithm>
 #include <cstdlib>
+#include <fstream>
 #include <future>
 #include <sstream>
 
@@ -90,6 +92,7 @@ io_ctx (io_ctx_a),
 node_initialized_latch (1),
 config (config_a),
 stats (config.stat_config),
+block_tracer (config.diagnostics_config.block_tracing),
 flags (flags_a),
 alarm (alarm_a),
 work (work_a),
@@ -121,6 +124,11 @@ block_processor_thread ([this]() {
 online_reps (ledger, network_params, config.online_weight_minimum.number ()),
 vote_uniquer (block_uniquer),
 confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, config.logging, logger, node_initialized_latch, flags.confirmation_height_processor_mode),
+confirmation_log (config.confirmation_log_config.enabled && !flags.read_only && !flags.inactive_node ? std::make_unique<ysu::confirmation_log> (application_path_a / "confirmation_log", config.confirmation_log_config, logger) : nullptr),
+http_callbacks (!config.callback_address.empty () ? std::make_unique<ysu::http_callbacks> (config, stats, logger) : nullptr),
+openmetrics (config.openmetrics_config.enabled ? std::make_unique<ysu::openmetrics_server> (*this, config.openmetrics_config) : nullptr),
+ledger_pruning (flags.enable_pruning && !flags.read_only && !flags.inactive_node ? std::make_unique<ysu::ledger_pruning> (*this) : nullptr),
+cold_storage (config.cold_storage_depth != 0 && !flags.enable_pruning && !flags.read_only && !flags.inactive_node ? std::make_unique<ysu::cold_storage> (*this) : nullptr),
 active (*this, confirmation_height_processor),
 aggregator (network_params.network, config, stats, active.generator, history, ledger, wallets, active),
 payment_observer_processor (observers.blocks),
@@ -135,10 +143,32 @@ node_seq (seq)
 		if (config.websocket_config.enabled)
 		{
 			auto endpoint_l (ysu::tcp_endpoint (boost::asio::ip::make_address_v6 (config.websocket_config.address), config.websocket_config.port));
-			websocket_server = std::make_shared<ysu::websocket::listener> (logger, wallets, io_ctx, endpoint_l);
+			websocket_server = std::make_shared<ysu::websocket::listener> (logger, wallets, io_ctx, endpoint_l, confirmation_log.get ());
 			this->websocket_server->run ();
 		}
 
+		if (openmetrics)
+		{
+			openmetrics->start ();
+		}
+
+		if (confirmation_log)
+		{
+			confirmation_height_processor.add_cemented_observer ([this](std::shared_ptr<ysu::block> block_a) {
+				this->confirmation_log->append (*block_a);
+			});
+			// One sync per batch keeps the log durable without a sync for every block
+			confirmation_height_processor.add_cemented_batch_observer ([this]() {
+				this->confirmation_log->sync ();
+			});
+		}
+		if (block_tracer.enabled ())
+		{
+			confirmation_height_processor.add_cemented_observer ([this](std::shared_ptr<ysu::block> block_a) {
+				this->block_tracer.trace (block_a->hash (), ysu::block_tracer::stage::cemented);
+			});
+		}
+
 		wallets.observer = [this](bool active) {
 			observers.wallet.notify (active);
 		};
@@ -149,8 +179,9 @@ node_seq (seq)
 		network.disconnect_observer = [this]() {
 			observers.disconnect.notify ();
 		};
-		if (!config.callback_address.empty ())
+		if (http_callbacks)
 		{
+			http_callbacks->start ();
 			observers.blocks.add ([this](ysu::election_status const & status_a, ysu::account const & account_a, ysu::amount const & amount_a, bool is_state_send_a) {
 				auto block_a (status_a.winner);
 				if ((status_a.type == ysu::election_status_type::active_confirmed_quorum || status_a.type == ysu::election_status_type::active_confirmation_height) && this->block_arrival.recent (block_a->hash ()))
@@ -188,25 +219,7 @@ node_seq (seq)
 						std::stringstream ostream;
 						boost::property_tree::write_json (ostream, event);
 						ostream.flush ();
-						auto body (std::make_shared<std::string> (ostream.str ()));
-						auto address (node_l->config.callback_address);
-						auto port (node_l->config.callback_port);
-						auto target (std::make_shared<std::string> (node_l->config.callback_target));
-						auto resolver (std::make_shared<boost::asio::ip::tcp::resolver> (node_l->io_ctx));
-						resolver->async_resolve (boost::asio::ip::tcp::resolver::query (address, std::to_string (port)), [node_l, address, port, target, body, resolver](boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::iterator i_a) {
-							if (!ec)
-							{
-								node_l->do_rpc_callback (i_a, address, port, target, body, resolver);
-							}
-							else
-							{
-								if (node_l->config.logging.callback_logging ())
-								{
-									node_l->logger.always_log (boost::str (boost::format ("Error resolving callback: %1%:%2%: %3%") % address % port % ec.message ()));
-								}
-								node_l->stats.inc (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out);
-							}
-						});
+						node_l->http_callbacks->add (ostream.str ());
 					});
 				}
 			});
@@ -361,7 +374,7 @@ node_seq (seq)
 		ysu::genesis genesis;
 		if (!is_initialized && !flags.read_only)
 		{
-			auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers }));
+			auto transaction (store.tx_begin_write ({ tables::account_height, tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers }));
 			// Store was empty meaning we just created it, add the genesis block
 			store.initialize (transaction, genesis, ledger.cache);
 		}
@@ -419,14 +432,20 @@ node_seq (seq)
 			// Drop unchecked blocks if initial bootstrap is completed
 			if (!flags.disable_unchecked_drop && !use_bootstrap_weight && !flags.read_only)
 			{
-				auto transaction (store.tx_begin_write ({ tables::unchecked }));
-				store.unchecked_clear (transaction);
+				auto transaction (store.tx_begin_write ({ tables::unchecked, tables::unchecked_time }));
+				ledger.unchecked_clear (transaction);
 				logger.always_log ("Dropping unchecked blocks");
 			}
 		}
 
 		ledger.pruning = flags.enable_pruning || store.pruned_count (store.tx_begin_read ()) > 0;
 
+		if (!flags.read_only)
+		{
+			auto transaction (store.tx_begin_write ({ tables::account_balance, tables::accounts }));
+			ledger.balance_index_set (transaction, flags.enable_balance_index);
+		}
+
 		if (ledger.pruning)
 		{
 			if (config.enable_voting && !flags.inactive_node)
@@ -444,6 +463,15 @@ node_seq (seq)
 				std::exit (1);
 			}
 		}
+
+		// Pruning deletes blocks from the database, which doesn't reach blocks moved to cold storage
+		if ((flags.enable_pruning || ledger.pruning) && (config.cold_storage_depth != 0 || store.get_cold_store () != nullptr) && !flags.inactive_node)
+		{
+			std::string str = "Incompatibility detected between pruning and config node.experimental.cold_storage_depth or existing cold storage";
+			logger.always_log (str);
+			std::cerr << str << std::endl;
+			std::exit (1);
+		}
 	}
 	node_initialized_latch.count_down ();
 }
@@ -457,78 +485,6 @@ ysu::node::~node ()
 	stop ();
 }
 
-void ysu::node::do_rpc_callback (boost::asio::ip::tcp::resolver::iterator i_a, std::string const & address, uint16_t port, std::shared_ptr<std::string> target, std::shared_ptr<std::string> body, std::shared_ptr<boost::asio::ip::tcp::resolver> resolver)
-{
-	if (i_a != boost::asio::ip::tcp::resolver::iterator{})
-	{
-		auto node_l (shared_from_this ());
-		auto sock (std::make_shared<boost::asio::ip::tcp::socket> (node_l->io_ctx));
-		sock->async_connect (i_a->endpoint (), [node_l, target, body, sock, address, port, i_a, resolver](boost::system::error_code const & ec) mutable {
-			if (!ec)
-			{
-				auto req (std::make_shared<boost::beast::http::request<boost::beast::http::string_body>> ());
-				req->method (boost::beast::http::verb::post);
-				req->target (*target);
-				req->version (11);
-				req->insert (boost::beast::http::field::host, address);
-				req->insert (boost::beast::http::field::content_type, "application/json");
-				req->body () = *body;
-				req->prepare_payload ();
-				boost::beast::http::async_write (*sock, *req, [node_l, sock, address, port, req, i_a, target, body, resolver](boost::system::error_code const & ec, size_t bytes_transferred) mutable {
-					if (!ec)
-					{
-						auto sb (std::make_shared<boost::beast::flat_buffer> ());
-						auto resp (std::make_shared<boost::beast::http::response<boost::beast::http::string_body>> ());
-						boost::beast::http::async_read (*sock, *sb, *resp, [node_l, sb, resp, sock, address, port, i_a, target, body, resolver](boost::system::error_code const & ec, size_t bytes_transferred) mutable {
-							if (!ec)
-							{
-								if (boost::beast::http::to_status_class (resp->result ()) == boost::beast::http::status_class::successful)
-								{
-									node_l->stats.inc (ysu::stat::type::http_callback, ysu::stat::detail::initiate, ysu::stat::dir::out);
-								}
-								else
-								{
-									if (node_l->config.logging.callback_logging ())
-									{
-										node_l->logger.try_log (boost::str (boost::format ("Callback to %1%:%2% failed with status: %3%") % address % port % resp->result ()));
-									}
-									node_l->stats.inc (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out);
-								}
-							}
-							else
-							{
-								if (node_l->config.logging.callback_logging ())
-								{
-									node_l->logger.try_log (boost::str (boost::format ("Unable complete callback: %1%:%2%: %3%") % address % port % ec.message ()));
-								}
-								node_l->stats.inc (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out);
-							};
-						});
-					}
-					else
-					{
-						if (node_l->config.logging.callback_logging ())
-						{
-							node_l->logger.try_log (boost::str (boost::format ("Unable to send callback: %1%:%2%: %3%") % address % port % ec.message ()));
-						}
-						node_l->stats.inc (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out);
-					}
-				});
-			}
-			else
-			{
-				if (node_l->config.logging.callback_logging ())
-				{
-					node_l->logger.try_log (boost::str (boost::format ("Unable to connect to callback address: %1%:%2%: %3%") % address % port % ec.message ()));
-				}
-				node_l->stats.inc (ysu::stat::type::error, ysu::stat::detail::http_callback, ysu::stat::dir::out);
-				++i_a;
-				node_l->do_rpc_callback (i_a, address, port, target, body, resolver);
-			}
-		});
-	}
-}
-
 bool ysu::node::copy_with_compaction (boost::filesystem::path const & destination)
 {
 	return store.copy_db (destination);
@@ -602,9 +558,22 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (node
 	composite->add_component (collect_container_info (node.block_uniquer, "block_uniquer"));
 	composite->add_component (collect_container_info (node.vote_uniquer, "vote_uniquer"));
 	composite->add_component (collect_container_info (node.confirmation_height_processor, "confirmation_height_processor"));
+	if (node.confirmation_log)
+	{
+		composite->add_component (collect_container_info (*node.confirmation_log, "confirmation_log"));
+	}
+	if (node.http_callbacks)
+	{
+		composite->add_component (collect_container_info (*node.http_callbacks, "http_callbacks"));
+	}
 	composite->add_component (collect_container_info (node.worker, "worker"));
 	composite->add_component (collect_container_info (node.distributed_work, "distributed_work"));
 	composite->add_component (collect_container_info (node.aggregator, "request_aggregator"));
+	composite->add_component (ysu::lock_profiler::collect_container_info ("lock_contention"));
+	if (node.block_tracer.enabled ())
+	{
+		composite->add_component (collect_container_info (node.block_tracer, "block_tracer"));
+	}
 	return composite;
 }
 
@@ -616,7 +585,7 @@ void ysu::node::process_active (std::shared_ptr<ysu::block> incoming)
 
 ysu::process_return ysu::node::process (ysu::block & block_a)
 {
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }, { tables::confirmation_height }));
+	auto transaction (store.tx_begin_write ({ tables::account_balance, tables::account_height, tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::pending_summary }, { tables::confirmation_height }));
 	auto result (ledger.process (transaction, block_a));
 	return result;
 }
@@ -631,13 +600,19 @@ ysu::process_return ysu::node::process_local (std::shared_ptr<ysu::block> block_
 	block_processor.wait_write ();
 	// Process block
 	block_post_events events;
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }, { tables::confirmation_height }));
+	auto transaction (store.tx_begin_write ({ tables::account_balance, tables::account_height, tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::pending_summary }, { tables::confirmation_height }));
 	return block_processor.process_one (transaction, events, info, work_watcher_a, ysu::block_origin::local);
 }
 
 void ysu::node::start ()
 {
 	long_inactivity_cleanup ();
+	if (!flags.read_only)
+	{
+		// A missing or unreadable file leaves the scores empty, they are rebuilt by the next bootstrap attempts
+		std::ifstream stream ((application_path / "bootstrap_peer_scores").string (), std::ios::binary);
+		bootstrap_initiator.connections->peer_scores.deserialize (stream);
+	}
 	network.start ();
 	add_initial_peers ();
 	if (!flags.disable_legacy_bootstrap)
@@ -652,6 +627,10 @@ void ysu::node::start ()
 		});
 	}
 	ongoing_store_flush ();
+	if (confirmation_log)
+	{
+		ongoing_confirmation_log_retention ();
+	}
 	if (!flags.disable_rep_crawler)
 	{
 		rep_crawler.start ();
@@ -659,6 +638,14 @@ void ysu::node::start ()
 	ongoing_rep_calculation ();
 	ongoing_peer_store ();
 	ongoing_online_weight_calculation_queue ();
+	if (ledger_pruning)
+	{
+		ledger_pruning->start ();
+	}
+	if (cold_storage && cold_storage->start ())
+	{
+		logger.always_log ("Failed to open cold storage, blocks will not be moved to it");
+	}
 	bool tcp_enabled (false);
 	if (config.tcp_incoming_connections_max > 0 && !(flags.disable_bootstrap_listener && flags.disable_tcp_realtime))
 	{
@@ -705,13 +692,38 @@ void ysu::node::stop ()
 		vote_processor.stop ();
 		active.stop ();
 		confirmation_height_processor.stop ();
+		if (ledger_pruning)
+		{
+			ledger_pruning->stop ();
+		}
+		if (cold_storage)
+		{
+			cold_storage->stop ();
+		}
+		if (confirmation_log)
+		{
+			confirmation_log->sync ();
+		}
+		if (http_callbacks)
+		{
+			http_callbacks->stop ();
+		}
 		network.stop ();
 		telemetry->stop ();
 		if (websocket_server)
 		{
 			websocket_server->stop ();
 		}
+		if (openmetrics)
+		{
+			openmetrics->stop ();
+		}
 		bootstrap_initiator.stop ();
+		if (!flags.read_only)
+		{
+			std::ofstream stream ((application_path / "bootstrap_peer_scores").string (), std::ios::binary | std::ios::trunc);
+			bootstrap_initiator.connections->peer_scores.serialize (stream);
+		}
 		bootstrap.stop ();
 		port_mapping.stop ();
 		checker.stop ();
@@ -840,6 +852,10 @@ void ysu::node::ongoing_bootstrap ()
 		}
 	}
 	bootstrap_initiator.bootstrap ();
+	if (flags.enable_ascending_bootstrap)
+	{
+		bootstrap_initiator.bootstrap_ascending ();
+	}
 	std::weak_ptr<ysu::node> node_w (shared_from_this ());
 	alarm.add (std::chrono::steady_clock::now () + next_wakeup, [node_w]() {
 		if (auto node_l = node_w.lock ())
@@ -855,6 +871,12 @@ void ysu::node::ongoing_store_flush ()
 		auto transaction (store.tx_begin_write ({ tables::vote }));
 		store.flush (transaction);
 	}
+	// Cache lookups are counted with atomics as they are too frequent to take the stats lock each time
+	auto & cache (store.get_store_cache ());
+	stats.add (ysu::stat::type::store_cache, ysu::stat::detail::account_hit, ysu::stat::dir::in, cache.accounts.hits.exchange (0));
+	stats.add (ysu::stat::type::store_cache, ysu::stat::detail::account_miss, ysu::stat::dir::in, cache.accounts.misses.exchange (0));
+	stats.add (ysu::stat::type::store_cache, ysu::stat::detail::confirmation_height_hit, ysu::stat::dir::in, cache.confirmation_heights.hits.exchange (0));
+	stats.add (ysu::stat::type::store_cache, ysu::stat::detail::confirmation_height_miss, ysu::stat::dir::in, cache.confirmation_heights.misses.exchange (0));
 	std::weak_ptr<ysu::node> node_w (shared_from_this ());
 	alarm.add (std::chrono::steady_clock::now () + std::chrono::seconds (5), [node_w]() {
 		if (auto node_l = node_w.lock ())
@@ -866,6 +888,20 @@ void ysu::node::ongoing_store_flush ()
 	});
 }
 
+void ysu::node::ongoing_confirmation_log_retention ()
+{
+	confirmation_log->apply_retention ();
+	std::weak_ptr<ysu::node> node_w (shared_from_this ());
+	alarm.add (std::chrono::steady_clock::now () + ysu::confirmation_log::retention_interval, [node_w]() {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->worker.push_task ([node_l]() {
+				node_l->ongoing_confirmation_log_retention ();
+			});
+		}
+	});
+}
+
 void ysu::node::ongoing_peer_store ()
 {
 	bool stored (network.tcp_channels.store_all (true));
@@ -939,44 +975,27 @@ void ysu::node::bootstrap_wallet ()
 void ysu::node::unchecked_cleanup ()
 {
 	std::vector<ysu::uint128_t> digests;
-	std::deque<ysu::unchecked_key> cleaning_list;
 	auto attempt (bootstrap_initiator.current_attempt ());
 	bool long_attempt (attempt != nullptr && std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - attempt->attempt_start).count () > config.unchecked_cutoff_time.count ());
-	// Collect old unchecked keys
 	if (ledger.cache.block_count >= ledger.bootstrap_weight_max_blocks && !long_attempt)
 	{
-		auto now (ysu::seconds_since_epoch ());
-		auto transaction (store.tx_begin_read ());
-		// Max 1M records to clean, max 2 minutes reading to prevent slow i/o systems issues
-		for (auto i (store.unchecked_begin (transaction)), n (store.unchecked_end ()); i != n && cleaning_list.size () < 1024 * 1024 && ysu::seconds_since_epoch () - now < 120; ++i)
+		auto cutoff (ysu::seconds_since_epoch () - config.unchecked_cutoff_time.count ());
+		// Delete old unchecked blocks in batches, oldest first, until reaching the ones modified after the cutoff
+		size_t constexpr batch_size (2 * 1024);
+		for (auto done (false); !done && !stopped;)
 		{
-			ysu::unchecked_key const & key (i->first);
-			ysu::unchecked_info const & info (i->second);
-			if ((now - info.modified) > static_cast<uint64_t> (config.unchecked_cutoff_time.count ()))
+			auto transaction (store.tx_begin_write ({ tables::unchecked, tables::unchecked_time }));
+			auto deleted (ledger.unchecked_del_before (transaction, cutoff, batch_size));
+			for (auto const & info : deleted)
 			{
 				digests.push_back (network.publish_filter.hash (info.block));
-				cleaning_list.push_back (key);
 			}
+			done = deleted.size () < batch_size;
 		}
 	}
-	if (!cleaning_list.empty ())
+	if (!digests.empty ())
 	{
-		logger.always_log (boost::str (boost::format ("Deleting %1% old unchecked blocks") % cleaning_list.size ()));
-	}
-	// Delete old unchecked keys in batches
-	while (!cleaning_list.empty ())
-	{
-		size_t deleted_count (0);
-		auto transaction (store.tx_begin_write ({ tables::unchecked }));
-		while (deleted_count++ < 2 * 1024 && !cleaning_list.empty ())
-		{
-			auto key (cleaning_list.front ());
-			cleaning_list.pop_front ();
-			if (store.unchecked_exists (transaction, key))
-			{
-				store.unchecked_del (transaction, key);
-			}
-		}
+		logger.always_log (boost::str (boost::format ("Deleted %1% old unchecked blocks") % digests.size ()));
 	}
 	// Delete from the duplicate filter
 	network.publish_filter.clear (digests);
@@ -7,18 +7,24 @@
 #include <ysu/lib/work.hpp>
 #include <ysu/lib/worker.hpp>
 #include <ysu/node/active_transactions.hpp>
+#include <ysu/node/block_tracer.hpp>
 #include <ysu/node/blockprocessor.hpp>
 #include <ysu/node/bootstrap/bootstrap.hpp>
 #include <ysu/node/bootstrap/bootstrap_attempt.hpp>
 #include <ysu/node/bootstrap/bootstrap_server.hpp>
 #include <ysu/node/confirmation_height_processor.hpp>
+#include <ysu/node/confirmation_log.hpp>
 #include <ysu/node/distributed_work_factory.hpp>
 #include <ysu/node/election.hpp>
 #include <ysu/node/gap_cache.hpp>
+#include <ysu/node/http_callbacks.hpp>
+#include <ysu/node/cold_storage.hpp>
+#include <ysu/node/ledger_pruning.hpp>
 #include <ysu/node/network.hpp>
 #include <ysu/node/node_observers.hpp>
 #include <ysu/node/nodeconfig.hpp>
 #include <ysu/node/online_reps.hpp>
+#include <ysu/node/openmetrics.hpp>
 #include <ysu/node/payment_observer_processor.hpp>
 #include <ysu/node/portmapping.hpp>
 #include <ysu/node/repcrawler.hpp>
@@ -127,6 +133,7 @@ public:
 	void ongoing_rep_calculation ();
 	void ongoing_bootstrap ();
 	void ongoing_store_flush ();
+	void ongoing_confirmation_log_retention ();
 	void ongoing_peer_store ();
 	void ongoing_unchecked_cleanup ();
 	void backup_wallet ();
@@ -149,7 +156,6 @@ public:
 	bool block_confirmed (ysu::block_hash const &);
 	bool block_confirmed_or_being_confirmed (ysu::transaction const &, ysu::block_hash const &);
 	void process_fork (ysu::transaction const &, std::shared_ptr<ysu::block>, uint64_t);
-	void do_rpc_callback (boost::asio::ip::tcp::resolver::iterator i_a, std::string const &, uint16_t, std::shared_ptr<std::string>, std::shared_ptr<std::string>, std::shared_ptr<boost::asio::ip::tcp::resolver>);
 	ysu::uint128_t delta () const;
 	void ongoing_online_weight_calculation ();
 	void ongoing_online_weight_calculation_queue ();
@@ -164,6 +170,7 @@ public:
 	ysu::network_params network_params;
 	ysu::node_config config;
 	ysu::stat stats;
+	ysu::block_tracer block_tracer;
 	std::shared_ptr<ysu::websocket::listener> websocket_server;
 	ysu::node_flags flags;
 	ysu::alarm & alarm;
@@ -196,6 +203,11 @@ public:
 	ysu::block_uniquer block_uniquer;
 	ysu::vote_uniquer vote_uniquer;
 	ysu::confirmation_height_processor confirmation_height_processor;
+	std::unique_ptr<ysu::confirmation_log> confirmation_log;
+	std::unique_ptr<ysu::http_callbacks> http_callbacks;
+	std::unique_ptr<ysu::openmetrics_server> openmetrics;
+	std::unique_ptr<ysu::ledger_pruning> ledger_pruning;
+	std::unique_ptr<ysu::cold_storage> cold_storage;
 	ysu::active_transactions active;
 	ysu::request_aggregator aggregator;
 	ysu::payment_observer_processor payment_observer_processor;
@@ -139,12 +139,19 @@ ysu::error ysu::node_config::serialize_toml (ysu::tomlconfig & toml) const
 	}
 	experimental_l.put ("max_pruning_age", max_pruning_age.count (), "Time limit for blocks age after pruning.\ntype:seconds");
 	experimental_l.put ("max_pruning_depth", max_pruning_depth, "Limit for full blocks in chain after pruning.\ntype:uint64");
+	experimental_l.put ("cold_storage_depth", cold_storage_depth, "Blocks cemented more than this many blocks below the confirmed frontier of their account are moved out of the database to cold storage segment files. Cannot be combined with pruning. 0 disables.\ntype:uint64");
 	toml.put_child ("experimental", experimental_l);
 
 	ysu::tomlconfig callback_l;
 	callback_l.put ("address", callback_address, "Callback address.\ntype:string,ip");
 	callback_l.put ("port", callback_port, "Callback port number.\ntype:uint16");
 	callback_l.put ("target", callback_target, "Callback target path.\ntype:string,uri");
+	callback_l.put ("max_connections", callback_max_connections, "Maximum number of concurrent keep-alive connections to the callback address.\ntype:uint32");
+	callback_l.put ("max_queued", callback_max_queued, "Maximum number of confirmations waiting to be delivered. Further confirmations are dropped.\ntype:uint64");
+	callback_l.put ("batch_size", callback_batch_size, "Maximum number of confirmations sent in one request. If larger than 1, the body is an object with a \"blocks\" array of confirmations.\ntype:uint32");
+	callback_l.put ("max_retries", callback_max_retries, "Number of times a failed delivery is retried.\ntype:uint32");
+	callback_l.put ("retry_backoff", callback_retry_backoff.count (), "Delay before retrying a failed delivery, doubled on every further attempt.\ntype:milliseconds");
+	callback_l.put ("timeout", callback_timeout.count (), "Time allowed for connecting to the callback address and for the response to each request, after which the delivery fails.\ntype:milliseconds");
 	toml.put_child ("httpcallback", callback_l);
 
 	ysu::tomlconfig logging_l;
@@ -155,6 +162,10 @@ ysu::error ysu::node_config::serialize_toml (ysu::tomlconfig & toml) const
 	websocket_config.serialize_toml (websocket_l);
 	toml.put_child ("websocket", websocket_l);
 
+	ysu::tomlconfig openmetrics_l;
+	openmetrics_config.serialize_toml (openmetrics_l);
+	toml.put_child ("openmetrics", openmetrics_l);
+
 	ysu::tomlconfig ipc_l;
 	ipc_config.serialize_toml (ipc_l);
 	toml.put_child ("ipc", ipc_l);
@@ -163,6 +174,10 @@ ysu::error ysu::node_config::serialize_toml (ysu::tomlconfig & toml) const
 	diagnostics_config.serialize_toml (diagnostics_l);
 	toml.put_child ("diagnostics", diagnostics_l);
 
+	ysu::tomlconfig confirmation_log_l;
+	confirmation_log_config.serialize_toml (confirmation_log_l);
+	toml.put_child ("confirmation_log", confirmation_log_l);
+
 	ysu::tomlconfig stat_l;
 	stat_config.serialize_toml (stat_l);
 	toml.put_child ("statistics", stat_l);
@@ -188,6 +203,16 @@ ysu::error ysu::node_config::deserialize_toml (ysu::tomlconfig & toml)
 			callback_l.get<std::string> ("address", callback_address);
 			callback_l.get<uint16_t> ("port", callback_port);
 			callback_l.get<std::string> ("target", callback_target);
+			callback_l.get<unsigned> ("max_connections", callback_max_connections);
+			callback_l.get<size_t> ("max_queued", callback_max_queued);
+			callback_l.get<unsigned> ("batch_size", callback_batch_size);
+			callback_l.get<unsigned> ("max_retries", callback_max_retries);
+			auto callback_retry_backoff_l (callback_retry_backoff.count ());
+			callback_l.get ("retry_backoff", callback_retry_backoff_l);
+			callback_retry_backoff = std::chrono::milliseconds (callback_retry_backoff_l);
+			auto callback_timeout_l (callback_timeout.count ());
+			callback_l.get ("timeout", callback_timeout_l);
+			callback_timeout = std::chrono::milliseconds (callback_timeout_l);
 		}
 
 		if (toml.has_key ("logging"))
@@ -202,6 +227,12 @@ ysu::error ysu::node_config::deserialize_toml (ysu::tomlconfig & toml)
 			websocket_config.deserialize_toml (websocket_config_l);
 		}
 
+		if (toml.has_key ("openmetrics"))
+		{
+			auto openmetrics_config_l (toml.get_required_child ("openmetrics"));
+			openmetrics_config.deserialize_toml (openmetrics_config_l);
+		}
+
 		if (toml.has_key ("ipc"))
 		{
 			auto ipc_config_l (toml.get_required_child ("ipc"));
@@ -214,6 +245,12 @@ ysu::error ysu::node_config::deserialize_toml (ysu::tomlconfig & toml)
 			diagnostics_config.deserialize_toml (diagnostics_config_l);
 		}
 
+		if (toml.has_key ("confirmation_log"))
+		{
+			auto confirmation_log_config_l (toml.get_required_child ("confirmation_log"));
+			confirmation_log_config.deserialize_toml (confirmation_log_config_l);
+		}
+
 		if (toml.has_key ("statistics"))
 		{
 			auto stat_config_l (toml.get_required_child ("statistics"));
@@ -395,6 +432,7 @@ ysu::error ysu::node_config::deserialize_toml (ysu::tomlconfig & toml)
 			experimental_config_l.get ("max_pruning_age", max_pruning_age_l);
 			max_pruning_age = std::chrono::seconds (max_pruning_age_l);
 			experimental_config_l.get<uint64_t> ("max_pruning_depth", max_pruning_depth);
+			experimental_config_l.get<uint64_t> ("cold_storage_depth", cold_storage_depth);
 		}
 
 		// Validate ranges
@@ -415,6 +453,10 @@ ysu::error ysu::node_config::deserialize_toml (ysu::tomlconfig & toml)
 		{
 			toml.get_error ().set ("io_threads must be non-zero");
 		}
+		if (callback_max_connections == 0 || callback_batch_size == 0 || callback_timeout.count () <= 0)
+		{
+			toml.get_error ().set ("httpcallback max_connections, batch_size and timeout must be non-zero");
+		}
 		if (active_elections_size <= 250 && !network.is_dev_network ())
 		{
 			toml.get_error ().set ("active_elections_size must be greater than 250");
@@ -8,8 +8,10 @@
 #include <ysu/lib/numbers.hpp>
 #include <ysu/lib/rocksdbconfig.hpp>
 #include <ysu/lib/stats.hpp>
+#include <ysu/node/confirmation_log.hpp>
 #include <ysu/node/ipc/ipc_config.hpp>
 #include <ysu/node/logging.hpp>
+#include <ysu/node/openmetrics.hpp>
 #include <ysu/node/websocketconfig.hpp>
 #include <ysu/secure/common.hpp>
 
@@ -68,11 +70,24 @@ public:
 	unsigned bootstrap_connections_max{ 64 };
 	unsigned bootstrap_initiator_threads{ 1 };
 	ysu::websocket::config websocket_config;
+	ysu::openmetrics_config openmetrics_config;
 	ysu::diagnostics_config diagnostics_config;
 	size_t confirmation_history_size{ 2048 };
+	ysu::confirmation_log_config confirmation_log_config;
 	std::string callback_address;
 	uint16_t callback_port{ 0 };
 	std::string callback_target;
+	/** Maximum number of concurrent keep-alive connections to the callback receiver */
+	unsigned callback_max_connections{ 4 };
+	/** Confirmations queued beyond this are dropped */
+	size_t callback_max_queued{ 64 * 1024 };
+	/** Maximum number of confirmations per POST. Values above 1 require the receiver to accept {"blocks": [...]} bodies. */
+	unsigned callback_batch_size{ 1 };
+	unsigned callback_max_retries{ 3 };
+	/** Delay before the first retry, doubled for every further attempt */
+	std::chrono::milliseconds callback_retry_backoff{ 500 };
+	/** Deadline for connecting to the callback address and for the response to each request */
+	std::chrono::milliseconds callback_timeout{ 10000 };
 	int deprecated_lmdb_max_dbs{ 128 };
 	bool allow_local_peers{ !(network_params.network.is_live_network () || network_params.network.is_test_network ()) }; // disable by default for live network
 	ysu::stat_config stat_config;
@@ -102,6 +117,7 @@ public:
 	uint32_t max_queued_requests{ 512 };
 	std::chrono::seconds max_pruning_age{ !network_params.network.is_beta_network () ? std::chrono::seconds (24 * 60 * 60) : std::chrono::seconds (5 * 60) }; // 1 day; 5 minutes for beta network
 	uint64_t max_pruning_depth{ 0 };
+	uint64_t cold_storage_depth{ 0 };
 	ysu::rocksdb_config rocksdb_config;
 	ysu::lmdb_config lmdb_config;
 	ysu::frontiers_confirmation_mode frontiers_confirmation{ ysu::frontiers_confirmation_mode::automatic };
@@ -143,6 +159,8 @@ public:
 	bool force_use_write_database_queue{ false }; // For testing only. RocksDB does not use the database queue, but some tests rely on it being used.
 	bool disable_search_pending{ false }; // For testing only
 	bool enable_pruning{ false };
+	bool enable_ascending_bootstrap{ false };
+	bool enable_balance_index{ false };
 	bool fast_bootstrap{ false };
 	bool read_only{ false };
 	ysu::confirmation_height_mode confirmation_height_processor_mode{ ysu::confirmation_height_mode::automatic };
@@ -0,0 +1,215 @@
+#include <ysu/boost/asio/ip/address_v6.hpp>
+#include <ysu/boost/beast/core.hpp>
+#include <ysu/boost/beast/http.hpp>
+#include <ysu/lib/threading.hpp>
+#include <ysu/lib/tomlconfig.hpp>
+#include <ysu/node/node.hpp>
+#include <ysu/node/openmetrics.hpp>
+
+#include <boost/format.hpp>
+
+#include <sstream>
+#include <unordered_set>
+
+namespace
+{
+/** Writes one sample per leaf of the container info tree, labelled by its path. Leaves whose path was already written are skipped. */
+void write_containers (std::ostream & stream_a, char const * metric_a, bool bytes_a, ysu::container_info_component const & component_a, std::string const & path_a, std::unordered_set<std::string> & series_a)
+{
+	if (component_a.is_composite ())
+	{
+		auto const & composite (static_cast<ysu::container_info_composite const &> (component_a));
+		auto path (path_a.empty () ? composite.get_name () : path_a + "/" + composite.get_name ());
+		for (auto const & child : composite.get_children ())
+		{
+			write_containers (stream_a, metric_a, bytes_a, *child, path, series_a);
+		}
+	}
+	else
+	{
+		auto const & info (static_cast<ysu::container_info_leaf const &> (component_a).get_info ());
+		auto series (boost::str (boost::format ("%1%{container=\"%2%/%3%\"}") % metric_a % path_a % info.name));
+		if (series_a.insert (series).second)
+		{
+			stream_a << series << ' ' << (bytes_a ? info.count * info.sizeof_element : info.count) << '\n';
+		}
+	}
+}
+}
+
+ysu::openmetrics_config::openmetrics_config () :
+address (boost::asio::ip::address_v6::loopback ().to_string ()),
+port (network_constants.default_openmetrics_port)
+{
+}
+
+ysu::error ysu::openmetrics_config::serialize_toml (ysu::tomlconfig & toml) const
+{
+	toml.put ("enable", enabled, "Enable or disable the OpenMetrics (Prometheus) endpoint.\ntype:bool");
+	toml.put ("address", address, "OpenMetrics endpoint bind address.\ntype:string,ip");
+	toml.put ("port", port, "OpenMetrics endpoint listening port.\ntype:uint16");
+	toml.put ("containers", containers, "Include container sizes in the metrics. Collecting them locks each container on every scrape, so this is disabled by default.\ntype:bool");
+	return toml.get_error ();
+}
+
+ysu::error ysu::openmetrics_config::deserialize_toml (ysu::tomlconfig & toml)
+{
+	toml.get<bool> ("enable", enabled);
+	boost::asio::ip::address_v6 address_l;
+	toml.get_optional<boost::asio::ip::address_v6> ("address", address_l, boost::asio::ip::address_v6::loopback ());
+	address = address_l.to_string ();
+	toml.get<uint16_t> ("port", port);
+	toml.get<bool> ("containers", containers);
+	return toml.get_error ();
+}
+
+class ysu::openmetrics_server::session final
+{
+public:
+	explicit session (boost::asio::io_context & io_ctx_a) :
+	socket (io_ctx_a)
+	{
+	}
+	boost::asio::ip::tcp::socket socket;
+	boost::beast::flat_buffer buffer;
+	boost::beast::http::request<boost::beast::http::empty_body> request;
+	boost::beast::http::response<boost::beast::http::string_body> response;
+};
+
+ysu::openmetrics_server::openmetrics_server (ysu::node & node_a, ysu::openmetrics_config const & config_a) :
+node (node_a),
+config (config_a),
+acceptor (io_ctx)
+{
+}
+
+ysu::openmetrics_server::~openmetrics_server ()
+{
+	stop ();
+}
+
+void ysu::openmetrics_server::start ()
+{
+	debug_assert (!thread.joinable ());
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::make_address_v6 (config.address), config.port);
+	boost::system::error_code ec;
+	acceptor.open (endpoint.protocol (), ec);
+	if (!ec)
+	{
+		acceptor.set_option (boost::asio::ip::tcp::acceptor::reuse_address (true), ec);
+		acceptor.bind (endpoint, ec);
+	}
+	if (!ec)
+	{
+		acceptor.listen (boost::asio::socket_base::max_listen_connections, ec);
+	}
+	if (!ec)
+	{
+		accept ();
+		thread = std::thread ([this]() {
+			ysu::thread_role::set (ysu::thread_role::name::openmetrics);
+			io_ctx.run ();
+		});
+	}
+	else
+	{
+		node.logger.always_log (boost::str (boost::format ("Error while binding OpenMetrics endpoint on port %1%: %2%") % config.port % ec.message ()));
+	}
+}
+
+void ysu::openmetrics_server::stop ()
+{
+	io_ctx.stop ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+uint16_t ysu::openmetrics_server::listening_port ()
+{
+	return acceptor.local_endpoint ().port ();
+}
+
+void ysu::openmetrics_server::accept ()
+{
+	auto session_l (std::make_shared<session> (io_ctx));
+	acceptor.async_accept (session_l->socket, [this, session_l](boost::system::error_code const & ec) {
+		if (!ec)
+		{
+			read (session_l);
+		}
+		if (ec != boost::asio::error::operation_aborted)
+		{
+			accept ();
+		}
+	});
+}
+
+void ysu::openmetrics_server::read (std::shared_ptr<session> const & session_a)
+{
+	session_a->request = {};
+	boost::beast::http::async_read (session_a->socket, session_a->buffer, session_a->request, [this, session_a](boost::system::error_code const & ec, size_t) {
+		if (!ec)
+		{
+			auto & response (session_a->response);
+			response = {};
+			response.version (session_a->request.version ());
+			response.keep_alive (session_a->request.keep_alive ());
+			if (session_a->request.method () != boost::beast::http::verb::get)
+			{
+				response.result (boost::beast::http::status::method_not_allowed);
+			}
+			else if (session_a->request.target () != "/metrics")
+			{
+				response.result (boost::beast::http::status::not_found);
+			}
+			else
+			{
+				response.result (boost::beast::http::status::ok);
+				response.set (boost::beast::http::field::content_type, "application/openmetrics-text; version=1.0.0; charset=utf-8");
+				response.body () = render ();
+			}
+			response.prepare_payload ();
+			boost::beast::http::async_write (session_a->socket, response, [this, session_a](boost::system::error_code const & ec, size_t) {
+				if (!ec && session_a->response.keep_alive ())
+				{
+					read (session_a);
+				}
+			});
+		}
+	});
+}
+
+std::string ysu::openmetrics_server::render ()
+{
+	std::ostringstream stream;
+	// Every series written, so that none is repeated
+	std::unordered_set<std::string> series;
+	node.stats.write_openmetrics (stream, series);
+
+	auto & cache (node.ledger.cache);
+	stream << "# TYPE ysu_ledger_blocks gauge\n";
+	stream << "ysu_ledger_blocks " << cache.block_count << '\n';
+	stream << "# TYPE ysu_ledger_cemented_blocks gauge\n";
+	stream << "ysu_ledger_cemented_blocks " << cache.cemented_count << '\n';
+	stream << "# TYPE ysu_ledger_pruned_blocks gauge\n";
+	stream << "ysu_ledger_pruned_blocks " << cache.pruned_count << '\n';
+	stream << "# TYPE ysu_ledger_accounts gauge\n";
+	stream << "ysu_ledger_accounts " << cache.account_count << '\n';
+	stream << "# TYPE ysu_ledger_unchecked_blocks gauge\n";
+	stream << "ysu_ledger_unchecked_blocks " << cache.unchecked_count << '\n';
+
+	if (config.containers)
+	{
+		auto containers (ysu::collect_container_info (node, "node"));
+		stream << "# TYPE ysu_container_count gauge\n";
+		stream << "# HELP ysu_container_count Number of elements in a node container\n";
+		write_containers (stream, "ysu_container_count", false, *containers, "", series);
+		stream << "# TYPE ysu_container_bytes gauge\n";
+		stream << "# HELP ysu_container_bytes Estimated memory used by the elements of a node container\n";
+		write_containers (stream, "ysu_container_bytes", true, *containers, "", series);
+	}
+	stream << "# EOF\n";
+	return stream.str ();
+}
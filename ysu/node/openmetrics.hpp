@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ysu/boost/asio/ip/tcp.hpp>
+#include <ysu/lib/config.hpp>
+#include <ysu/lib/errors.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace ysu
+{
+class node;
+class tomlconfig;
+
+class openmetrics_config final
+{
+public:
+	openmetrics_config ();
+	ysu::error serialize_toml (ysu::tomlconfig &) const;
+	ysu::error deserialize_toml (ysu::tomlconfig &);
+
+	ysu::network_constants network_constants;
+	bool enabled{ false };
+	std::string address;
+	uint16_t port;
+	/** Include the sizes of the node's containers, which requires taking each container's lock on every scrape */
+	bool containers{ false };
+};
+
+/**
+ * Serves node metrics to Prometheus compatible scrapers in the OpenMetrics text format.
+ *
+ * Scrapes are answered from a dedicated thread and port, so they neither go through the RPC server nor
+ * build a property tree. Labels of statistics counters are rendered once when a counter is created.
+ */
+class openmetrics_server final
+{
+public:
+	openmetrics_server (ysu::node &, ysu::openmetrics_config const &);
+	~openmetrics_server ();
+	void start ();
+	void stop ();
+	/** The current metrics as an OpenMetrics text exposition */
+	std::string render ();
+	uint16_t listening_port ();
+
+private:
+	class session;
+	void accept ();
+	void read (std::shared_ptr<session> const &);
+
+	ysu::node & node;
+	ysu::openmetrics_config const & config;
+	boost::asio::io_context io_ctx;
+	boost::asio::ip::tcp::acceptor acceptor;
+	std::thread thread;
+};
+}
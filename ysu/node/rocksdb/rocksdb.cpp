@@ -5,6 +5,7 @@
 #include <ysu/node/rocksdb/rocksdb_txn.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -12,6 +13,7 @@
 #include <rocksdb/merge_operator.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/utilities/backupable_db.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
@@ -91,9 +93,13 @@ std::unordered_map<const char *, ysu::tables> ysu::rocksdb_store::create_cf_name
 	std::unordered_map<const char *, ysu::tables> map{ { rocksdb::kDefaultColumnFamilyName.c_str (), tables::default_unused },
 		{ "frontiers", tables::frontiers },
 		{ "accounts", tables::accounts },
+		{ "account_height", tables::account_height },
+		{ "account_balance", tables::account_balance },
 		{ "blocks", tables::blocks },
 		{ "pending", tables::pending },
+		{ "pending_summary", tables::pending_summary },
 		{ "unchecked", tables::unchecked },
+		{ "unchecked_time", tables::unchecked_time },
 		{ "vote", tables::vote },
 		{ "online_weight", tables::online_weight },
 		{ "meta", tables::meta },
@@ -146,14 +152,86 @@ void ysu::rocksdb_store::open (bool & error_a, boost::filesystem::path const & p
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
 		}
 	}
+
+	if (!error_a && !open_read_only_a)
+	{
+		index_unchecked ();
+		index_account_heights ();
+		index_pending_summaries ();
+	}
+
+	if (!error_a)
+	{
+		error_a = cold_init (path_a / "cold");
+	}
+
+	if (!error_a)
+	{
+		uint64_t blocks_estimate (0);
+		db->GetIntProperty (table_to_column_family (tables::blocks), "rocksdb.estimate-num-keys", &blocks_estimate);
+		// The database is locked against other writers, so a persisted filter matches unless the node didn't shut down cleanly, in which case it was removed
+		block_filter_open (path_a / "block_filter", 0, blocks_estimate, open_read_only_a);
+	}
+}
+
+ysu::rocksdb_store::~rocksdb_store ()
+{
+	if (!error)
+	{
+		block_filter_close (0);
+	}
+}
+
+void ysu::rocksdb_store::index_pending_summaries ()
+{
+	// Ledgers written before the summaries existed have pending entries without one
+	auto transaction (tx_begin_write ({ tables::pending, tables::pending_summary }));
+	if (pending_summary_begin (transaction) == pending_summary_end () && pending_begin (transaction) != pending_end ())
+	{
+		logger.always_log ("Summarizing pending entries...");
+		pending_summary_build (transaction);
+		logger.always_log ("Finished summarizing pending entries");
+	}
+}
+
+void ysu::rocksdb_store::index_account_heights ()
+{
+	// Ledgers written before the height index existed have blocks without index entries
+	auto transaction (tx_begin_write ({ tables::account_height, tables::accounts, tables::blocks }));
+	if (account_height_begin (transaction) == account_height_end () && blocks_begin (transaction) != blocks_end ())
+	{
+		logger.always_log ("Indexing account chains by height...");
+		account_height_build (transaction);
+		logger.always_log ("Finished indexing account chains by height");
+	}
+}
+
+void ysu::rocksdb_store::index_unchecked ()
+{
+	// Ledgers written before the time index existed have unchecked blocks without index entries
+	auto transaction (tx_begin_write ({ tables::unchecked, tables::unchecked_time }));
+	auto index_empty (make_iterator<ysu::unchecked_time_key, ysu::no_value> (transaction, tables::unchecked_time) == ysu::store_iterator<ysu::unchecked_time_key, ysu::no_value> (nullptr));
+	if (index_empty && unchecked_begin (transaction) != unchecked_end ())
+	{
+		logger.always_log ("Indexing unchecked blocks by time...");
+		for (auto i (unchecked_begin (transaction)), n (unchecked_end ()); i != n; ++i)
+		{
+			auto status (put_key (transaction, tables::unchecked_time, ysu::unchecked_time_key (i->second.modified, i->first)));
+			release_assert (success (status));
+		}
+		logger.always_log ("Finished indexing unchecked blocks by time");
+	}
 }
 
 void ysu::rocksdb_store::generate_tombstone_map ()
 {
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::unchecked), std::forward_as_tuple (0, 50000));
+	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::unchecked_time), std::forward_as_tuple (0, 50000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::blocks), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::accounts), std::forward_as_tuple (0, 25000));
+	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::account_balance), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::pending), std::forward_as_tuple (0, 25000));
+	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (ysu::tables::pending_summary), std::forward_as_tuple (0, 25000));
 }
 
 rocksdb::ColumnFamilyOptions ysu::rocksdb_store::get_common_cf_options (std::shared_ptr<rocksdb::TableFactory> const & table_factory_a, unsigned long long memtable_size_bytes_a) const
@@ -209,6 +287,18 @@ rocksdb::ColumnFamilyOptions ysu::rocksdb_store::get_cf_options (std::string con
 		// L1 size, compaction is triggered for L0 at this size (2 SST files in L1)
 		cf_options.max_bytes_for_level_base = memtable_size_bytes * 2;
 	}
+	else if (cf_name_a == "unchecked_time")
+	{
+		// Small keys written and deleted along with unchecked, which are read from the start when expired entries are cleaned up
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+
+		// Number of files in level 0 which triggers compaction. Size of L0 and L1 should be kept similar as this is the only compaction which is single threaded
+		cf_options.level0_file_num_compaction_trigger = 2;
+
+		// L1 size, compaction is triggered for L0 at this size (2 SST files in L1)
+		cf_options.max_bytes_for_level_base = memtable_size_bytes * 2;
+	}
 	else if (cf_name_a == "blocks")
 	{
 		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 4)));
@@ -244,6 +334,12 @@ rocksdb::ColumnFamilyOptions ysu::rocksdb_store::get_cf_options (std::string con
 		// L1 size, compaction is triggered for L0 at this size (2 SST files in L1)
 		cf_options.max_bytes_for_level_base = memtable_size_bytes * 2;
 	}
+	else if (cf_name_a == "pending_summary")
+	{
+		// Rewritten with every pending entry added or removed
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
 	else if (cf_name_a == "frontiers")
 	{
 		// Frontiers is only needed during bootstrap for legacy blocks
@@ -256,6 +352,18 @@ rocksdb::ColumnFamilyOptions ysu::rocksdb_store::get_cf_options (std::string con
 		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
+	else if (cf_name_a == "account_height")
+	{
+		// Written along with blocks and only deleted by rollbacks and pruning
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
+	else if (cf_name_a == "account_balance")
+	{
+		// Every balance change moves an entry, like the accounts table
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
 	else if (cf_name_a == "vote")
 	{
 		// No deletes it seems, only overwrites.
@@ -294,6 +402,7 @@ ysu::write_transaction ysu::rocksdb_store::tx_begin_write (std::vector<ysu::tabl
 {
 	std::unique_ptr<ysu::write_rocksdb_txn> txn;
 	release_assert (optimistic_db != nullptr);
+	auto cache_epoch (cache.epoch_get ());
 	if (tables_requiring_locks_a.empty () && tables_no_locks_a.empty ())
 	{
 		// Use all tables if none are specified
@@ -307,12 +416,13 @@ ysu::write_transaction ysu::rocksdb_store::tx_begin_write (std::vector<ysu::tabl
 	// Tables must be kept in alphabetical order. These can be used for mutex locking, so order is important to prevent deadlocking
 	debug_assert (std::is_sorted (tables_requiring_locks_a.begin (), tables_requiring_locks_a.end ()));
 
-	return ysu::write_transaction{ std::move (txn) };
+	return ysu::write_transaction{ std::move (txn), &cache, cache_epoch };
 }
 
 ysu::read_transaction ysu::rocksdb_store::tx_begin_read ()
 {
-	return ysu::read_transaction{ std::make_unique<ysu::read_rocksdb_txn> (db.get ()) };
+	auto cache_epoch (cache.epoch_get ());
+	return ysu::read_transaction{ std::make_unique<ysu::read_rocksdb_txn> (db.get ()), &cache, cache_epoch };
 }
 
 std::string ysu::rocksdb_store::vendor_get () const
@@ -335,14 +445,22 @@ rocksdb::ColumnFamilyHandle * ysu::rocksdb_store::table_to_column_family (tables
 	{
 		case tables::frontiers:
 			return get_handle ("frontiers");
+		case tables::account_balance:
+			return get_handle ("account_balance");
+		case tables::account_height:
+			return get_handle ("account_height");
 		case tables::accounts:
 			return get_handle ("accounts");
 		case tables::blocks:
 			return get_handle ("blocks");
 		case tables::pending:
 			return get_handle ("pending");
+		case tables::pending_summary:
+			return get_handle ("pending_summary");
 		case tables::unchecked:
 			return get_handle ("unchecked");
+		case tables::unchecked_time:
+			return get_handle ("unchecked_time");
 		case tables::vote:
 			return get_handle ("vote");
 		case tables::online_weight:
@@ -487,10 +605,14 @@ uint64_t ysu::rocksdb_store::count (ysu::transaction const & transaction_a, tabl
 			++sum;
 		}
 	}
-	// This is only an estimation
+	// The key estimate of the unchecked table can be far off after many deletions, so the smaller time index is iterated instead.
+	// This should be correct at node start, later only cache should be used
 	else if (table_a == tables::unchecked)
 	{
-		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
+		for (auto i (make_iterator<ysu::unchecked_time_key, ysu::no_value> (transaction_a, tables::unchecked_time)), n (ysu::store_iterator<ysu::unchecked_time_key, ysu::no_value> (nullptr)); i != n; ++i)
+		{
+			++sum;
+		}
 	}
 	// This should be correct at node start, later only cache should be used
 	else if (table_a == tables::pruned)
@@ -513,6 +635,14 @@ uint64_t ysu::rocksdb_store::count (ysu::transaction const & transaction_a, tabl
 			++sum;
 		}
 	}
+	// Counts blocks when some were moved to the cold tier
+	else if (table_a == tables::account_height)
+	{
+		for (auto i (account_height_begin (transaction_a)), n (account_height_end ()); i != n; ++i)
+		{
+			++sum;
+		}
+	}
 	else if (table_a == tables::confirmation_height)
 	{
 		debug_assert (network_constants ().is_dev_network ());
@@ -740,7 +870,7 @@ void ysu::rocksdb_store::on_flush (rocksdb::FlushJobInfo const & flush_job_info_
 
 std::vector<ysu::tables> ysu::rocksdb_store::all_tables () const
 {
-	return std::vector<ysu::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::unchecked, tables::vote };
+	return std::vector<ysu::tables>{ tables::account_balance, tables::account_height, tables::accounts, tables::blocks, tables::confirmation_height, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pending_summary, tables::pruned, tables::unchecked, tables::unchecked_time, tables::vote };
 }
 
 bool ysu::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
@@ -808,7 +938,7 @@ bool ysu::rocksdb_store::copy_db (boost::filesystem::path const & destination_pa
 	if (status.ok ())
 	{
 		ysu::rocksdb_store rocksdb_store (logger, destination_path.string (), rocksdb_config, false);
-		return !rocksdb_store.init_error ();
+		return !rocksdb_store.init_error () && !cold_copy (destination_path / "cold");
 	}
 	return false;
 }
@@ -818,6 +948,35 @@ void ysu::rocksdb_store::rebuild_db (ysu::write_transaction const & transaction_
 	// Not available for RocksDB
 }
 
+void ysu::rocksdb_store::put_sorted (ysu::write_transaction const & transaction_a, ysu::tables table_a, ysu::sorted_records const & records_a)
+{
+	block_filter_insert (table_a, records_a);
+	if (!records_a.empty ())
+	{
+		// Records are written to a table file which is moved into the database as is, skipping the memtable and write ahead log.
+		// The records are not part of the transaction and are visible as soon as they are ingested
+		auto column_family (table_to_column_family (table_a));
+		auto file (boost::filesystem::unique_path (boost::filesystem::path (db->GetName ()) / "bulk-%%%%-%%%%-%%%%.sst").string ());
+		rocksdb::SstFileWriter writer (rocksdb::EnvOptions (), db->GetOptions (column_family), column_family);
+		auto status (writer.Open (file));
+		for (auto i (records_a.begin ()), n (records_a.end ()); status.ok () && i != n; ++i)
+		{
+			status = writer.Put (rocksdb::Slice (reinterpret_cast<char const *> (i->first.data ()), i->first.size ()), rocksdb::Slice (reinterpret_cast<char const *> (i->second.data ()), i->second.size ()));
+		}
+		if (status.ok ())
+		{
+			status = writer.Finish ();
+		}
+		if (status.ok ())
+		{
+			rocksdb::IngestExternalFileOptions options;
+			options.move_files = true;
+			status = db->IngestExternalFile (column_family, { file }, options);
+		}
+		release_assert (status.ok ());
+	}
+}
+
 bool ysu::rocksdb_store::init_error () const
 {
 	return error;
@@ -27,6 +27,7 @@ class rocksdb_store : public block_store_partial<rocksdb::Slice, rocksdb_store>
 {
 public:
 	rocksdb_store (ysu::logger_mt &, boost::filesystem::path const &, ysu::rocksdb_config const & = ysu::rocksdb_config{}, bool open_read_only = false);
+	~rocksdb_store ();
 	ysu::write_transaction tx_begin_write (std::vector<ysu::tables> const & tables_requiring_lock = {}, std::vector<ysu::tables> const & tables_no_lock = {}) override;
 	ysu::read_transaction tx_begin_read () override;
 
@@ -45,6 +46,7 @@ public:
 
 	bool copy_db (boost::filesystem::path const & destination) override;
 	void rebuild_db (ysu::write_transaction const & transaction_a) override;
+	void put_sorted (ysu::write_transaction const & transaction_a, ysu::tables table_a, ysu::sorted_records const & records_a) override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -97,6 +99,9 @@ private:
 	int clear (rocksdb::ColumnFamilyHandle * column_family);
 
 	void open (bool & error_a, boost::filesystem::path const & path_a, bool open_read_only_a);
+	void index_unchecked ();
+	void index_account_heights ();
+	void index_pending_summaries ();
 
 	void construct_column_family_mutexes ();
 	rocksdb::Options get_db_options ();
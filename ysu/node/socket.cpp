@@ -68,6 +68,33 @@ void ysu::socket::async_read (std::shared_ptr<std::vector<uint8_t>> buffer_a, si
 	}
 }
 
+void ysu::socket::async_read_some (std::shared_ptr<std::vector<uint8_t>> buffer_a, size_t offset_a, size_t size_a, std::function<void(boost::system::error_code const &, size_t)> callback_a)
+{
+	if (size_a != 0 && offset_a + size_a <= buffer_a->size ())
+	{
+		auto this_l (shared_from_this ());
+		if (!closed)
+		{
+			start_timer ();
+			boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback_a, offset_a, size_a, this_l]() {
+				this_l->tcp_socket.async_read_some (boost::asio::buffer (buffer_a->data () + offset_a, size_a),
+				boost::asio::bind_executor (this_l->strand,
+				[this_l, buffer_a, callback_a](boost::system::error_code const & ec, size_t size_a) {
+					this_l->node.stats.add (ysu::stat::type::traffic_tcp, ysu::stat::dir::in, size_a);
+					this_l->stop_timer ();
+					callback_a (ec, size_a);
+				}));
+			}));
+		}
+	}
+	else
+	{
+		debug_assert (false && "ysu::socket::async_read_some called with incorrect buffer size");
+		boost::system::error_code ec_buffer = boost::system::errc::make_error_code (boost::system::errc::no_buffer_space);
+		callback_a (ec_buffer, 0);
+	}
+}
+
 void ysu::socket::async_write (ysu::shared_const_buffer const & buffer_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a)
 {
 	if (!closed)
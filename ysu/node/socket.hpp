@@ -43,6 +43,8 @@ public:
 	virtual ~socket ();
 	void async_connect (boost::asio::ip::tcp::endpoint const &, std::function<void(boost::system::error_code const &)>);
 	void async_read (std::shared_ptr<std::vector<uint8_t>>, size_t, std::function<void(boost::system::error_code const &, size_t)>);
+	/** Reads whatever is available, at most \p size_a bytes, into the buffer starting at \p offset_a */
+	void async_read_some (std::shared_ptr<std::vector<uint8_t>>, size_t offset_a, size_t size_a, std::function<void(boost::system::error_code const &, size_t)>);
 	void async_write (ysu::shared_const_buffer const &, std::function<void(boost::system::error_code const &, size_t)> const & = nullptr);
 
 	void close ();
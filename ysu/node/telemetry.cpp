@@ -628,7 +628,7 @@ ysu::telemetry_data ysu::consolidate_telemetry_data (std::vector<ysu::telemetry_
 	return consolidated_data;
 }
 
-ysu::telemetry_data ysu::local_telemetry_data (ysu::block_store & store_a, ysu::ledger_cache const & ledger_cache_a, ysu::network & network_a, uint64_t bandwidth_limit_a, ysu::network_params const & network_params_a, std::chrono::steady_clock::time_point statup_time_a, uint64_t active_difficulty_a, ysu::keypair const & node_id_a)
+ysu::telemetry_data ysu::local_telemetry_data (ysu::ledger_cache const & ledger_cache_a, ysu::network & network_a, uint64_t bandwidth_limit_a, ysu::network_params const & network_params_a, std::chrono::steady_clock::time_point statup_time_a, uint64_t active_difficulty_a, ysu::keypair const & node_id_a)
 {
 	ysu::telemetry_data telemetry_data;
 	telemetry_data.node_id = node_id_a.pub;
@@ -637,7 +637,7 @@ ysu::telemetry_data ysu::local_telemetry_data (ysu::block_store & store_a, ysu::
 	telemetry_data.bandwidth_cap = bandwidth_limit_a;
 	telemetry_data.protocol_version = network_params_a.protocol.protocol_version;
 	telemetry_data.uptime = std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - statup_time_a).count ();
-	telemetry_data.unchecked_count = store_a.unchecked_count (store_a.tx_begin_read ());
+	telemetry_data.unchecked_count = ledger_cache_a.unchecked_count;
 	telemetry_data.genesis_block = network_params_a.ledger.genesis_hash;
 	telemetry_data.peer_count = ysu::narrow_cast<decltype (telemetry_data.peer_count)> (network_a.size ());
 	telemetry_data.account_count = ledger_cache_a.account_count;
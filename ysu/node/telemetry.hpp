@@ -150,5 +150,5 @@ private:
 std::unique_ptr<ysu::container_info_component> collect_container_info (telemetry & telemetry, const std::string & name);
 
 ysu::telemetry_data consolidate_telemetry_data (std::vector<telemetry_data> const & telemetry_data);
-ysu::telemetry_data local_telemetry_data (ysu::block_store &, ysu::ledger_cache const &, ysu::network &, uint64_t, ysu::network_params const &, std::chrono::steady_clock::time_point, uint64_t, ysu::keypair const &);
+ysu::telemetry_data local_telemetry_data (ysu::ledger_cache const &, ysu::network &, uint64_t, ysu::network_params const &, std::chrono::steady_clock::time_point, uint64_t, ysu::keypair const &);
 }
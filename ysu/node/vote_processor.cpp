@@ -34,7 +34,7 @@ thread ([this]() {
 	process_loop ();
 })
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	condition.wait (lock, [& started = started] { return started; });
 }
 
@@ -43,7 +43,7 @@ void ysu::vote_processor::process_loop ()
 	ysu::timer<std::chrono::milliseconds> elapsed;
 	bool log_this_iteration;
 
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	started = true;
 
 	lock.unlock ();
@@ -93,7 +93,7 @@ bool ysu::vote_processor::vote (std::shared_ptr<ysu::vote> vote_a, std::shared_p
 {
 	debug_assert (channel_a != nullptr);
 	bool process (false);
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	if (!stopped)
 	{
 		// Level 0 (< 0.1%)
@@ -204,7 +204,7 @@ ysu::vote_code ysu::vote_processor::vote_blocking (std::shared_ptr<ysu::vote> vo
 void ysu::vote_processor::stop ()
 {
 	{
-		ysu::lock_guard<std::mutex> lock (mutex);
+		ysu::lock_guard<ysu::mutex> lock (mutex);
 		stopped = true;
 	}
 	condition.notify_all ();
@@ -216,7 +216,7 @@ void ysu::vote_processor::stop ()
 
 void ysu::vote_processor::flush ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	while (is_active || !votes.empty ())
 	{
 		condition.wait (lock);
@@ -225,7 +225,7 @@ void ysu::vote_processor::flush ()
 
 void ysu::vote_processor::flush_active ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	while (is_active)
 	{
 		condition.wait (lock);
@@ -234,13 +234,13 @@ void ysu::vote_processor::flush_active ()
 
 size_t ysu::vote_processor::size ()
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return votes.size ();
 }
 
 bool ysu::vote_processor::empty ()
 {
-	ysu::lock_guard<std::mutex> guard (mutex);
+	ysu::lock_guard<ysu::mutex> guard (mutex);
 	return votes.empty ();
 }
 
@@ -251,7 +251,7 @@ bool ysu::vote_processor::half_full ()
 
 void ysu::vote_processor::calculate_weights ()
 {
-	ysu::unique_lock<std::mutex> lock (mutex);
+	ysu::unique_lock<ysu::mutex> lock (mutex);
 	if (!stopped)
 	{
 		representatives_1.clear ();
@@ -287,7 +287,7 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (vote
 	size_t representatives_3_count;
 
 	{
-		ysu::lock_guard<std::mutex> guard (vote_processor.mutex);
+		ysu::lock_guard<ysu::mutex> guard (vote_processor.mutex);
 		votes_count = vote_processor.votes.size ();
 		representatives_1_count = vote_processor.representatives_1.size ();
 		representatives_2_count = vote_processor.representatives_2.size ();
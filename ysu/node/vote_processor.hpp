@@ -69,7 +69,7 @@ private:
 	std::unordered_set<ysu::account> representatives_2;
 	std::unordered_set<ysu::account> representatives_3;
 	ysu::condition_variable condition;
-	std::mutex mutex;
+	ysu::mutex mutex{ "vote_processor" };
 	bool started;
 	bool stopped;
 	bool is_active;
@@ -2,6 +2,7 @@
 #include <ysu/boost/asio/dispatch.hpp>
 #include <ysu/boost/asio/strand.hpp>
 #include <ysu/lib/work.hpp>
+#include <ysu/node/confirmation_log.hpp>
 #include <ysu/node/election.hpp>
 #include <ysu/node/transport/transport.hpp>
 #include <ysu/node/wallet.hpp>
@@ -86,6 +87,16 @@ logger (logger_a)
 		}
 	}
 	check_filter_empty ();
+
+	auto from_sequence_text_l (options_a.get_optional<std::string> ("from_seq"));
+	if (from_sequence_text_l)
+	{
+		from_sequence = options_a.get_optional<uint64_t> ("from_seq");
+		if (!from_sequence)
+		{
+			logger_a.always_log ("Websocket: invalid confirmation log sequence number provided: ", from_sequence_text_l.get ());
+		}
+	}
 }
 
 bool ysu::websocket::confirmation_options::should_filter (ysu::websocket::message const & message_a) const
@@ -105,6 +116,11 @@ bool ysu::websocket::confirmation_options::should_filter (ysu::websocket::messag
 	{
 		should_filter_conf_type_l = false;
 	}
+	else if (type_text_l == "replay")
+	{
+		// Replays are explicitly requested through the "from_seq" option
+		should_filter_conf_type_l = false;
+	}
 
 	bool should_filter_account (has_account_filtering_options);
 	auto destination_opt_l (message_a.contents.get_optional<std::string> ("message.block.link_as_account"));
@@ -315,6 +331,10 @@ void ysu::websocket::session::write_queued_messages ()
 			{
 				this_l->write_queued_messages ();
 			}
+			else
+			{
+				this_l->replay_page ();
+			}
 		}
 	}));
 }
@@ -466,6 +486,7 @@ void ysu::websocket::session::handle_message (boost::property_tree::ptree const
 	auto ack_l (message_a.get<bool> ("ack", false));
 	auto id_l (message_a.get<std::string> ("id", ""));
 	auto action_succeeded (false);
+	boost::optional<uint64_t> replay_from;
 	if (action == "subscribe" && topic_l != ysu::websocket::topic::invalid)
 	{
 		auto options_text_l (message_a.get_child_optional ("options"));
@@ -473,7 +494,9 @@ void ysu::websocket::session::handle_message (boost::property_tree::ptree const
 		std::unique_ptr<ysu::websocket::options> options_l{ nullptr };
 		if (options_text_l && topic_l == ysu::websocket::topic::confirmation)
 		{
-			options_l = std::make_unique<ysu::websocket::confirmation_options> (options_text_l.get (), ws_listener.get_wallets (), ws_listener.get_logger ());
+			auto confirmation_options_l (std::make_unique<ysu::websocket::confirmation_options> (options_text_l.get (), ws_listener.get_wallets (), ws_listener.get_logger ()));
+			replay_from = confirmation_options_l->get_from_sequence ();
+			options_l = std::move (confirmation_options_l);
 		}
 		else if (options_text_l && topic_l == ysu::websocket::topic::vote)
 		{
@@ -530,6 +553,68 @@ void ysu::websocket::session::handle_message (boost::property_tree::ptree const
 	{
 		send_ack (action, id_l);
 	}
+	if (replay_from && ws_listener.get_confirmation_log () != nullptr)
+	{
+		replay_confirmations (replay_from.get ());
+	}
+}
+
+void ysu::websocket::session::replay_confirmations (uint64_t from_sequence_a)
+{
+	auto & confirmation_log_l (*ws_listener.get_confirmation_log ());
+	// Entries which were deleted by retention are skipped
+	auto next_l (std::max (from_sequence_a, confirmation_log_l.first_sequence ()));
+	auto last_l (confirmation_log_l.last_sequence ());
+	if (next_l <= last_l)
+	{
+		last_l = std::min (last_l, next_l + max_replay - 1);
+	}
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l, next_l, last_l]() {
+		// Replaces a replay which is still in progress
+		this_l->replay_next = next_l;
+		this_l->replay_last = last_l;
+		if (this_l->send_queue.empty ())
+		{
+			this_l->replay_page ();
+		}
+	});
+}
+
+void ysu::websocket::session::replay_page ()
+{
+	debug_assert (send_queue.empty ());
+	ysu::websocket::message_builder builder;
+	// Pages whose messages were all filtered out leave nothing to wait for
+	while (send_queue.empty () && replay_next <= replay_last)
+	{
+		auto entries (ws_listener.get_confirmation_log ()->read (replay_next, std::min<uint64_t> (replay_page_size, replay_last - replay_next + 1)));
+		replay_next = entries.empty () ? replay_last + 1 : entries.back ().sequence + 1;
+		ysu::lock_guard<std::mutex> lk (subscriptions_mutex);
+		auto subscription (subscriptions.find (ysu::websocket::topic::confirmation));
+		if (subscription == subscriptions.end ())
+		{
+			// Unsubscribed while replaying
+			replay_next = replay_last + 1;
+		}
+		else
+		{
+			auto conf_options (dynamic_cast<ysu::websocket::confirmation_options *> (subscription->second.get ()));
+			auto include_block (conf_options == nullptr || conf_options->get_include_block ());
+			for (auto const & entry : entries)
+			{
+				auto message_l (builder.block_replayed (entry, include_block));
+				if (!subscription->second->should_filter (message_l))
+				{
+					send_queue.push_back (std::move (message_l));
+				}
+			}
+		}
+	}
+	if (!send_queue.empty ())
+	{
+		write_queued_messages ();
+	}
 }
 
 void ysu::websocket::listener::stop ()
@@ -549,9 +634,10 @@ void ysu::websocket::listener::stop ()
 	sessions.clear ();
 }
 
-ysu::websocket::listener::listener (ysu::logger_mt & logger_a, ysu::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a) :
+ysu::websocket::listener::listener (ysu::logger_mt & logger_a, ysu::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a, ysu::confirmation_log * confirmation_log_a) :
 logger (logger_a),
 wallets (wallets_a),
+confirmation_log (confirmation_log_a),
 acceptor (io_ctx_a),
 socket (io_ctx_a)
 {
@@ -909,6 +995,36 @@ ysu::websocket::message ysu::websocket::message_builder::new_block_arrived (ysu:
 	return message_l;
 }
 
+ysu::websocket::message ysu::websocket::message_builder::block_replayed (ysu::confirmation_log_entry const & entry_a, bool include_block_a)
+{
+	ysu::websocket::message message_l (ysu::websocket::topic::confirmation);
+	set_common_fields (message_l);
+
+	auto const & block_l (*entry_a.block);
+	auto const & sideband_l (block_l.sideband ());
+	boost::property_tree::ptree message_node_l;
+	message_node_l.add ("account", (block_l.account ().is_zero () ? sideband_l.account : block_l.account ()).to_account ());
+	message_node_l.add ("hash", block_l.hash ().to_string ());
+	message_node_l.add ("confirmation_type", "replay");
+	message_node_l.add ("sequence", std::to_string (entry_a.sequence));
+	message_node_l.add ("height", std::to_string (sideband_l.height));
+	message_node_l.add ("local_timestamp", std::to_string (sideband_l.timestamp));
+
+	if (include_block_a)
+	{
+		boost::property_tree::ptree block_node_l;
+		block_l.serialize_json (block_node_l);
+		if (block_l.type () == ysu::block_type::state)
+		{
+			block_node_l.add ("subtype", ysu::state_subtype (sideband_l.details));
+		}
+		message_node_l.add_child ("block", block_node_l);
+	}
+
+	message_l.contents.add_child ("message", message_node_l);
+	return message_l;
+}
+
 void ysu::websocket::message_builder::set_common_fields (ysu::websocket::message & message_a)
 {
 	using namespace std::chrono;
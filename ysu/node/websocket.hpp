@@ -32,6 +32,8 @@ namespace ysu
 {
 class wallets;
 class logger_mt;
+class confirmation_log;
+class confirmation_log_entry;
 class vote;
 class election_status;
 class telemetry_data;
@@ -102,6 +104,7 @@ namespace websocket
 		message bootstrap_exited (std::string const & id_a, std::string const & mode_a, std::chrono::steady_clock::time_point const start_time_a, uint64_t const total_blocks_a);
 		message telemetry_received (ysu::telemetry_data const &, ysu::endpoint const &);
 		message new_block_arrived (ysu::block const & block_a);
+		message block_replayed (ysu::confirmation_log_entry const & entry_a, bool include_block_a);
 
 	private:
 		/** Set the common fields for messages: timestamp and topic. */
@@ -140,6 +143,9 @@ namespace websocket
 	 * Options for block confirmation subscriptions
 	 * Non-filtering options:
 	 * - "include_block" (bool, default true) - if false, do not include block contents. Only account, amount and hash will be included.
+	 * - "from_seq" (uint64) - replay blocks from the confirmation log, starting at this sequence number, before live confirmations.
+	 *   Replayed messages have confirmation_type "replay" and carry their "sequence"; they may overlap with live messages.
+	 *   At most session::max_replay entries are replayed per subscription, subscribe again to continue after the last one.
 	 * Filtering options:
 	 * - "all_local_accounts" (bool) - will only not filter blocks that have local wallet accounts as source/destination
 	 * - "accounts" (array of std::strings) - will only not filter blocks that have these accounts as source/destination
@@ -180,6 +186,12 @@ namespace websocket
 			return include_election_info;
 		}
 
+		/** Returns the confirmation log sequence number to replay from, if requested */
+		boost::optional<uint64_t> get_from_sequence () const
+		{
+			return from_sequence;
+		}
+
 		static constexpr const uint8_t type_active_quorum = 1;
 		static constexpr const uint8_t type_active_confirmation_height = 2;
 		static constexpr const uint8_t type_inactive = 4;
@@ -197,6 +209,7 @@ namespace websocket
 		bool all_local_accounts{ false };
 		uint8_t confirmation_types{ type_all };
 		std::unordered_set<std::string> accounts;
+		boost::optional<uint64_t> from_sequence;
 	};
 
 	/**
@@ -244,6 +257,10 @@ namespace websocket
 		/** Enqueue \p message_a for writing to the websockets */
 		void write (ysu::websocket::message message_a);
 
+		/** Confirmation log entries read at once while replaying */
+		static size_t constexpr replay_page_size = 256;
+		static uint64_t constexpr max_replay = 64 * 1024;
+
 	private:
 		/** The owning listener */
 		ysu::websocket::listener & ws_listener;
@@ -275,13 +292,20 @@ namespace websocket
 		void send_ack (std::string action_a, std::string id_a);
 		/** Send all queued messages. This must be called from the write strand. */
 		void write_queued_messages ();
+		/** Replays confirmation log entries starting at \p from_sequence_a, up to the last entry at the time of the call and at most max_replay */
+		void replay_confirmations (uint64_t from_sequence_a);
+		/** Queue the next page of replayed entries once the queued messages were written. This must be called from the write strand. */
+		void replay_page ();
+		/** Next entry to replay and the last one, the replay is done once they cross. Only accessed through the strand */
+		uint64_t replay_next{ 1 };
+		uint64_t replay_last{ 0 };
 	};
 
 	/** Creates a new session for each incoming connection */
 	class listener final : public std::enable_shared_from_this<listener>
 	{
 	public:
-		listener (ysu::logger_mt & logger_a, ysu::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a);
+		listener (ysu::logger_mt & logger_a, ysu::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a, ysu::confirmation_log * confirmation_log_a = nullptr);
 
 		/** Start accepting connections */
 		void run ();
@@ -307,6 +331,12 @@ namespace websocket
 			return wallets;
 		}
 
+		/** Returns the confirmation log used for replays, or nullptr if it is disabled */
+		ysu::confirmation_log * get_confirmation_log () const
+		{
+			return confirmation_log;
+		}
+
 		/**
 		 * Per-topic subscribers check. Relies on all sessions correctly increasing and
 		 * decreasing the subscriber counts themselves.
@@ -332,6 +362,7 @@ namespace websocket
 
 		ysu::logger_mt & logger;
 		ysu::wallets & wallets;
+		ysu::confirmation_log * confirmation_log;
 		boost::asio::ip::tcp::acceptor acceptor;
 		socket_type socket;
 		std::mutex sessions_mutex;
@@ -161,6 +161,7 @@ std::unordered_set<std::string> create_rpc_control_impls ()
 	set.emplace ("epoch_upgrade");
 	set.emplace ("keepalive");
 	set.emplace ("ledger");
+	set.emplace ("lock_contention");
 	set.emplace ("node_id");
 	set.emplace ("password_change");
 	set.emplace ("receive");
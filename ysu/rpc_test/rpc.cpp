@@ -1532,6 +1532,89 @@ TEST (rpc, account_history)
 	}
 }
 
+TEST (rpc, account_history_cursor)
+{
+	ysu::system system;
+	auto node = add_ipc_enabled_node (system);
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	ysu::genesis genesis;
+	std::vector<ysu::block_hash> hashes{ genesis.hash () };
+	for (auto i (0); i < 4; ++i)
+	{
+		auto send (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, ysu::dev_genesis_key.pub, node->config.receive_minimum.number ()));
+		ASSERT_NE (nullptr, send);
+		hashes.push_back (send->hash ());
+	}
+	scoped_io_thread_name_change scoped_thread_name_io;
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	ysu::rpc_config rpc_config (ysu::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	ysu::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	ysu::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	// Page through the history two blocks at a time, newest first
+	std::vector<std::string> history_l;
+	boost::property_tree::ptree request;
+	request.put ("action", "account_history");
+	request.put ("account", ysu::genesis_account.to_account ());
+	request.put ("count", 2);
+	for (auto pages (0); pages < 3; ++pages)
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		for (auto & entry : response.json.get_child ("history"))
+		{
+			history_l.push_back (entry.second.get<std::string> ("hash"));
+		}
+		auto cursor (response.json.get_optional<std::string> ("cursor"));
+		ASSERT_EQ (pages < 2, cursor.is_initialized ());
+		if (cursor)
+		{
+			request.put ("cursor", *cursor);
+		}
+	}
+	ASSERT_EQ (hashes.size (), history_l.size ());
+	for (size_t i (0); i < hashes.size (); ++i)
+	{
+		ASSERT_EQ (hashes[hashes.size () - i - 1].to_string (), history_l[i]);
+	}
+	// Cursors keep pointing at the same block after new blocks are added to the account
+	request.put ("cursor", ysu::genesis_account.to_string () + ysu::to_string_hex (2));
+	request.put ("count", 1);
+	scoped_thread_name_io.reset ();
+	ASSERT_NE (nullptr, system.wallet (0)->send_action (ysu::dev_genesis_key.pub, ysu::dev_genesis_key.pub, node->config.receive_minimum.number ()));
+	scoped_thread_name_io.renew ();
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ (1, response.json.get_child ("history").size ());
+		ASSERT_EQ (hashes[1].to_string (), response.json.get_child ("history").front ().second.get<std::string> ("hash"));
+		ASSERT_EQ (genesis.hash ().to_string (), response.json.get<std::string> ("previous"));
+	}
+	// Offsets past the head don't wrap around to the start of the account
+	request.put ("reverse", true);
+	request.put ("offset", std::numeric_limits<uint64_t>::max ());
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_TRUE (response.json.get_child ("history").empty ());
+		ASSERT_FALSE (response.json.get_optional<std::string> ("cursor").is_initialized ());
+	}
+	request.erase ("reverse");
+	request.erase ("offset");
+	request.put ("cursor", "1234");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (10s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ (std::error_code (ysu::error_rpc::bad_cursor).message (), response.json.get<std::string> ("error"));
+	}
+}
+
 TEST (rpc, history_count)
 {
 	ysu::system system;
@@ -1673,7 +1756,7 @@ TEST (rpc, process_block_with_work_watcher)
 	double updated_multiplier;
 	while (!updated)
 	{
-		ysu::unique_lock<std::mutex> lock (node1.active.mutex);
+		ysu::unique_lock<ysu::mutex> lock (node1.active.mutex);
 		//fill multipliers_cb and update active difficulty;
 		for (auto i (0); i < node1.active.multipliers_cb.size (); i++)
 		{
@@ -1992,11 +2075,11 @@ TEST (rpc, process_difficulty_update_flood)
 
 	// Ensure the difficulty update occurs in both nodes
 	ASSERT_NO_ERROR (system.poll_until_true (5s, [&node, &node_passive, &send, expected_multiplier] {
-		ysu::lock_guard<std::mutex> guard (node.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 		auto const existing (node.active.roots.find (send.qualified_root ()));
 		EXPECT_NE (existing, node.active.roots.end ());
 
-		ysu::lock_guard<std::mutex> guard_passive (node_passive.active.mutex);
+		ysu::lock_guard<ysu::mutex> guard_passive (node_passive.active.mutex);
 		auto const existing_passive (node_passive.active.roots.find (send.qualified_root ()));
 		EXPECT_NE (existing_passive, node_passive.active.roots.end ());
 
@@ -5223,6 +5306,61 @@ TEST (rpc, ledger)
 	}
 }
 
+TEST (rpc, ledger_balance_index)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	ysu::node_flags node_flags;
+	node_flags.enable_balance_index = true;
+	auto node = add_ipc_enabled_node (system, node_config, node_flags);
+	ASSERT_TRUE (node->ledger.balance_index);
+	ysu::keypair key;
+	ysu::genesis genesis;
+	ysu::state_block send (ysu::genesis_account, genesis.hash (), ysu::genesis_account, ysu::genesis_amount - 100, key.pub, ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub, *node->work_generate_blocking (genesis.hash ()));
+	ASSERT_EQ (ysu::process_result::progress, node->process (send).code);
+	ysu::state_block open (key.pub, 0, key.pub, 100, send.hash (), key.prv, key.pub, *node->work_generate_blocking (key.pub));
+	ASSERT_EQ (ysu::process_result::progress, node->process (open).code);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	ysu::rpc_config rpc_config (ysu::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	ysu::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	ysu::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "ledger");
+	request.put ("sorting", true);
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		std::vector<std::pair<std::string, std::string>> accounts_l;
+		for (auto & account : response.json.get_child ("accounts"))
+		{
+			accounts_l.emplace_back (account.first, account.second.get<std::string> ("balance"));
+		}
+		std::vector<std::pair<std::string, std::string>> expected{ { ysu::genesis_account.to_account (), (ysu::genesis_amount - 100).convert_to<std::string> () }, { key.pub.to_account (), "100" } };
+		ASSERT_EQ (expected, accounts_l);
+	}
+	// Accounts below the threshold end the scan
+	request.put ("threshold", "101");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		auto & accounts (response.json.get_child ("accounts"));
+		ASSERT_EQ (1, accounts.size ());
+		ASSERT_EQ (ysu::genesis_account.to_account (), accounts.begin ()->first);
+	}
+	request.erase ("threshold");
+	request.put ("modified_since", std::to_string (ysu::seconds_since_epoch () + 3600));
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (0, response.json.get_child ("accounts").size ());
+	}
+}
+
 TEST (rpc, accounts_create)
 {
 	ysu::system system;
@@ -6061,6 +6199,101 @@ TEST (rpc, confirmation_history)
 	system.stop ();
 }
 
+TEST (rpc, confirmation_log)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.confirmation_log_config.enabled = true;
+	auto node = add_ipc_enabled_node (system, node_config);
+	ysu::keypair key;
+	system.wallet (0)->insert_adhoc (ysu::dev_genesis_key.prv);
+	auto block (system.wallet (0)->send_action (ysu::dev_genesis_key.pub, key.pub, ysu::Gxrb_ratio));
+	scoped_io_thread_name_change scoped_thread_name_io;
+	ASSERT_TIMELY (10s, node->confirmation_log->last_sequence () == 1);
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	ysu::rpc_config rpc_config (ysu::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	ysu::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	ysu::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "confirmation_log");
+	request.put ("from_seq", "0");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ ("1", response.json.get<std::string> ("first_seq"));
+		ASSERT_EQ ("1", response.json.get<std::string> ("last_seq"));
+		ASSERT_EQ ("2", response.json.get<std::string> ("next_seq"));
+		auto entries (response.json.get_child ("entries"));
+		ASSERT_EQ (1, entries.size ());
+		auto const & entry (entries.begin ()->second);
+		ASSERT_EQ ("1", entry.get<std::string> ("sequence"));
+		ASSERT_EQ (block->hash ().to_string (), entry.get<std::string> ("hash"));
+		ASSERT_EQ (ysu::dev_genesis_key.pub.to_account (), entry.get<std::string> ("account"));
+		ASSERT_EQ ("2", entry.get<std::string> ("height"));
+		ASSERT_EQ ("send", entry.get<std::string> ("subtype"));
+	}
+	// Resuming from the returned cursor yields no entries until something new is cemented
+	request.put ("from_seq", "2");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_TRUE (response.json.get_child ("entries").empty ());
+		ASSERT_EQ ("2", response.json.get<std::string> ("next_seq"));
+	}
+}
+
+TEST (rpc, lock_contention)
+{
+	ysu::system system;
+	auto node = add_ipc_enabled_node (system);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	ysu::rpc_config rpc_config (ysu::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	ysu::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	ysu::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "lock_contention");
+	request.put ("enable", "true");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ ("true", response.json.get<std::string> ("enabled"));
+	}
+	{
+		ysu::lock_guard<ysu::mutex> guard (node->active.mutex);
+	}
+	request.put ("enable", "false");
+	request.put ("reset", "true");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_EQ ("false", response.json.get<std::string> ("enabled"));
+		auto sites (response.json.get_child ("mutexes").get_child ("active_transactions"));
+		ASSERT_FALSE (sites.empty ());
+		auto const & site (sites.begin ()->second);
+		ASSERT_NE (0, site.get<uint64_t> ("acquisitions"));
+		ASSERT_FALSE (site.get_child ("hold_histogram").empty ());
+	}
+	request.erase ("enable");
+	request.erase ("reset");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		ASSERT_TRUE (response.json.get_child ("mutexes").empty ());
+	}
+}
+
 TEST (rpc, confirmation_history_hash)
 {
 	ysu::system system;
@@ -6876,7 +7109,7 @@ TEST (rpc, active_difficulty)
 	rpc.start ();
 	boost::property_tree::ptree request;
 	request.put ("action", "active_difficulty");
-	ysu::unique_lock<std::mutex> lock (node->active.mutex);
+	ysu::unique_lock<ysu::mutex> lock (node->active.mutex);
 	node->active.multipliers_cb.push_front (1.5);
 	node->active.multipliers_cb.push_front (4.2);
 	// Also pushes 1.0 to the front of multipliers_cb
@@ -7775,3 +8008,94 @@ TEST (rpc, confirmation_info)
 		ASSERT_EQ (0, response.json.get<unsigned> ("total_tally"));
 	}
 }
+
+TEST (rpc, block_trace)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.diagnostics_config.block_tracing.enable = true;
+	node_config.diagnostics_config.block_tracing.sample_rate = 1;
+	auto node = add_ipc_enabled_node (system, node_config);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	ysu::rpc_config rpc_config (ysu::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	ysu::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	ysu::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	ysu::block_hash hash (1);
+	node->block_tracer.trace (hash, ysu::block_tracer::stage::arrival);
+	boost::property_tree::ptree request;
+	request.put ("action", "block_trace");
+	request.put ("clear", "true");
+	{
+		test_response response (request, rpc.config.port, system.io_ctx);
+		ASSERT_TIMELY (5s, response.status != 0);
+		ASSERT_EQ (200, response.status);
+		auto const & events (response.json.get_child ("traceEvents"));
+		ASSERT_NE (events.end (), std::find_if (events.begin (), events.end (), [&hash](auto const & event) {
+			return event.second.get ("id", "") == hash.to_string ();
+		}));
+	}
+	ASSERT_EQ (0, node->block_tracer.size ());
+}
+
+TEST (rpc, pruning_status)
+{
+	ysu::system system;
+	ysu::node_config node_config (ysu::get_available_port (), system.logging);
+	node_config.enable_voting = false;
+	node_config.max_pruning_depth = 1;
+	ysu::node_flags node_flags;
+	node_flags.enable_pruning = true;
+	auto node = add_ipc_enabled_node (system, node_config, node_flags);
+	ASSERT_NE (nullptr, node->ledger_pruning);
+	ysu::genesis genesis;
+	ysu::state_block_builder builder;
+	auto send1 = builder.make_block ()
+	             .account (ysu::dev_genesis_key.pub)
+	             .previous (genesis.hash ())
+	             .representative (ysu::dev_genesis_key.pub)
+	             .balance (ysu::genesis_amount - ysu::Gxrb_ratio)
+	             .link (ysu::dev_genesis_key.pub)
+	             .sign (ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub)
+	             .work (*system.work.generate (genesis.hash ()))
+	             .build ();
+	auto send2 = builder.make_block ()
+	             .account (ysu::dev_genesis_key.pub)
+	             .previous (send1->hash ())
+	             .representative (ysu::dev_genesis_key.pub)
+	             .balance (ysu::genesis_amount - 2 * ysu::Gxrb_ratio)
+	             .link (ysu::dev_genesis_key.pub)
+	             .sign (ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub)
+	             .work (*system.work.generate (send1->hash ()))
+	             .build ();
+	ASSERT_EQ (ysu::process_result::progress, node->process (*send1).code);
+	ASSERT_EQ (ysu::process_result::progress, node->process (*send2).code);
+	{
+		auto transaction (node->store.tx_begin_write ());
+		node->store.confirmation_height_put (transaction, ysu::dev_genesis_key.pub, { 3, send2->hash () });
+	}
+	// Only the confirmed frontier is within the depth limit, the genesis block itself is never pruned
+	node->ledger_pruning->trigger ();
+	ASSERT_TIMELY (5s, node->ledger_pruning->status ().blocks_pruned == 1);
+	ASSERT_TRUE (node->store.pruned_exists (node->store.tx_begin_read (), send1->hash ()));
+	scoped_io_thread_name_change scoped_thread_name_io;
+	ysu::node_rpc_config node_rpc_config;
+	ysu::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	ysu::rpc_config rpc_config (ysu::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	ysu::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	ysu::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request;
+	request.put ("action", "pruning_status");
+	test_response response (request, rpc.config.port, system.io_ctx);
+	ASSERT_TIMELY (5s, response.status != 0);
+	ASSERT_EQ (200, response.status);
+	ASSERT_EQ ("1", response.json.get<std::string> ("blocks_pruned"));
+	ASSERT_EQ ("1", response.json.get<std::string> ("pruned_count"));
+	ASSERT_EQ (std::to_string (ysu::block_value_size (*send1)), response.json.get<std::string> ("bytes_reclaimed"));
+	ASSERT_LE (1, response.json.get<uint64_t> ("passes"));
+}
@@ -0,0 +1,350 @@
+#include <ysu/lib/utility.hpp>
+#include <ysu/secure/block_encoding.hpp>
+#include <ysu/secure/buffer.hpp>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/polymorphic_cast.hpp>
+
+#include <algorithm>
+
+namespace
+{
+uint8_t constexpr previous_zero = 1 << 0;
+uint8_t constexpr representative_account = 1 << 1;
+uint8_t constexpr link_zero = 1 << 2;
+
+void write_varint (ysu::stream & stream_a, uint64_t value_a)
+{
+	while (value_a >= 0x80)
+	{
+		ysu::write (stream_a, static_cast<uint8_t> (value_a | 0x80));
+		value_a >>= 7;
+	}
+	ysu::write (stream_a, static_cast<uint8_t> (value_a));
+}
+
+uint64_t read_varint (ysu::stream & stream_a)
+{
+	uint64_t result (0);
+	uint8_t byte (0x80);
+	for (unsigned shift (0); (byte & 0x80) != 0; shift += 7)
+	{
+		if (shift >= 64)
+		{
+			throw std::runtime_error ("Variable length integer is too long");
+		}
+		ysu::read (stream_a, byte);
+		result |= static_cast<uint64_t> (byte & 0x7f) << shift;
+	}
+	return result;
+}
+
+void write_amount (ysu::stream & stream_a, ysu::amount const & amount_a)
+{
+	auto leading (std::find_if (amount_a.bytes.begin (), amount_a.bytes.end (), [](uint8_t byte_a) { return byte_a != 0; }) - amount_a.bytes.begin ());
+	auto size (static_cast<uint8_t> (amount_a.bytes.size () - leading));
+	ysu::write (stream_a, size);
+	stream_a.sputn (amount_a.bytes.data () + leading, size);
+}
+
+ysu::amount read_amount (ysu::stream & stream_a)
+{
+	uint8_t size (0);
+	ysu::read (stream_a, size);
+	ysu::amount result (0);
+	if (size > result.bytes.size () || stream_a.sgetn (result.bytes.data () + result.bytes.size () - size, size) != size)
+	{
+		throw std::runtime_error ("Failed to read amount");
+	}
+	return result;
+}
+
+void write_work (ysu::stream & stream_a, uint64_t work_a)
+{
+	ysu::write (stream_a, boost::endian::native_to_big (work_a));
+}
+
+uint64_t read_work (ysu::stream & stream_a)
+{
+	uint64_t result (0);
+	ysu::read (stream_a, result);
+	return boost::endian::big_to_native (result);
+}
+
+template <typename T>
+void write_optional (ysu::stream & stream_a, T const & value_a, uint8_t flags_a, uint8_t flag_a)
+{
+	if ((flags_a & flag_a) == 0)
+	{
+		ysu::write (stream_a, value_a.bytes);
+	}
+}
+
+template <typename T>
+void read_optional (ysu::stream & stream_a, T & value_a, uint8_t flags_a, uint8_t flag_a)
+{
+	if ((flags_a & flag_a) == 0)
+	{
+		ysu::read (stream_a, value_a.bytes);
+	}
+	else
+	{
+		value_a.bytes.fill (0);
+	}
+}
+
+std::shared_ptr<ysu::block> deserialize_compact (ysu::stream & stream_a, ysu::block_type type_a, bool sideband_a)
+{
+	std::shared_ptr<ysu::block> result;
+	uint8_t flags (0);
+	ysu::read (stream_a, flags);
+	switch (type_a)
+	{
+		case ysu::block_type::send:
+		{
+			auto block (std::make_shared<ysu::send_block> ());
+			read_optional (stream_a, block->hashables.previous, flags, previous_zero);
+			ysu::read (stream_a, block->hashables.destination.bytes);
+			block->hashables.balance = read_amount (stream_a);
+			ysu::read (stream_a, block->signature.bytes);
+			block->work = read_work (stream_a);
+			result = block;
+			break;
+		}
+		case ysu::block_type::receive:
+		{
+			auto block (std::make_shared<ysu::receive_block> ());
+			read_optional (stream_a, block->hashables.previous, flags, previous_zero);
+			ysu::read (stream_a, block->hashables.source.bytes);
+			ysu::read (stream_a, block->signature.bytes);
+			block->work = read_work (stream_a);
+			result = block;
+			break;
+		}
+		case ysu::block_type::open:
+		{
+			auto block (std::make_shared<ysu::open_block> ());
+			ysu::read (stream_a, block->hashables.source.bytes);
+			ysu::read (stream_a, block->hashables.account.bytes);
+			read_optional (stream_a, block->hashables.representative, flags, representative_account);
+			if ((flags & representative_account) != 0)
+			{
+				block->hashables.representative = block->hashables.account;
+			}
+			ysu::read (stream_a, block->signature.bytes);
+			block->work = read_work (stream_a);
+			result = block;
+			break;
+		}
+		case ysu::block_type::change:
+		{
+			auto block (std::make_shared<ysu::change_block> ());
+			read_optional (stream_a, block->hashables.previous, flags, previous_zero);
+			ysu::read (stream_a, block->hashables.representative.bytes);
+			ysu::read (stream_a, block->signature.bytes);
+			block->work = read_work (stream_a);
+			result = block;
+			break;
+		}
+		case ysu::block_type::state:
+		{
+			auto block (std::make_shared<ysu::state_block> ());
+			ysu::read (stream_a, block->hashables.account.bytes);
+			read_optional (stream_a, block->hashables.previous, flags, previous_zero);
+			read_optional (stream_a, block->hashables.representative, flags, representative_account);
+			if ((flags & representative_account) != 0)
+			{
+				block->hashables.representative = block->hashables.account;
+			}
+			block->hashables.balance = read_amount (stream_a);
+			read_optional (stream_a, block->hashables.link, flags, link_zero);
+			ysu::read (stream_a, block->signature.bytes);
+			block->work = read_work (stream_a);
+			result = block;
+			break;
+		}
+		case ysu::block_type::invalid:
+		case ysu::block_type::not_a_block:
+			break;
+	}
+	if (result != nullptr && sideband_a)
+	{
+		// Fields are set to what the legacy sideband would have held for the type
+		ysu::block_sideband sideband;
+		if (type_a != ysu::block_type::state && type_a != ysu::block_type::open)
+		{
+			ysu::read (stream_a, sideband.account.bytes);
+		}
+		sideband.height = type_a != ysu::block_type::open ? read_varint (stream_a) : 1;
+		if (type_a == ysu::block_type::receive || type_a == ysu::block_type::change || type_a == ysu::block_type::open)
+		{
+			sideband.balance = read_amount (stream_a);
+		}
+		sideband.timestamp = read_varint (stream_a);
+		if (type_a == ysu::block_type::state)
+		{
+			if (sideband.details.deserialize (stream_a))
+			{
+				throw std::runtime_error ("Failed to read block details");
+			}
+			uint8_t source_epoch (0);
+			ysu::read (stream_a, source_epoch);
+			sideband.source_epoch = static_cast<ysu::epoch> (source_epoch);
+		}
+		ysu::read (stream_a, sideband.successor.bytes);
+		result->sideband_set (sideband);
+	}
+	return result;
+}
+}
+
+void ysu::serialize_block_value (ysu::stream & stream_a, ysu::block const & block_a)
+{
+	auto type (block_a.type ());
+	ysu::write (stream_a, static_cast<uint8_t> (block_value_compact_flag | static_cast<uint8_t> (type)));
+	uint8_t flags (0);
+	if (block_a.previous ().is_zero ())
+	{
+		flags |= previous_zero;
+	}
+	if ((type == ysu::block_type::open || type == ysu::block_type::state) && block_a.representative () == block_a.account ())
+	{
+		flags |= representative_account;
+	}
+	if (type == ysu::block_type::state && block_a.link ().is_zero ())
+	{
+		flags |= link_zero;
+	}
+	ysu::write (stream_a, flags);
+	switch (type)
+	{
+		case ysu::block_type::send:
+		{
+			auto const & block (*boost::polymorphic_downcast<ysu::send_block const *> (&block_a));
+			write_optional (stream_a, block.hashables.previous, flags, previous_zero);
+			ysu::write (stream_a, block.hashables.destination.bytes);
+			write_amount (stream_a, block.hashables.balance);
+			break;
+		}
+		case ysu::block_type::receive:
+		{
+			auto const & block (*boost::polymorphic_downcast<ysu::receive_block const *> (&block_a));
+			write_optional (stream_a, block.hashables.previous, flags, previous_zero);
+			ysu::write (stream_a, block.hashables.source.bytes);
+			break;
+		}
+		case ysu::block_type::open:
+		{
+			auto const & block (*boost::polymorphic_downcast<ysu::open_block const *> (&block_a));
+			ysu::write (stream_a, block.hashables.source.bytes);
+			ysu::write (stream_a, block.hashables.account.bytes);
+			write_optional (stream_a, block.hashables.representative, flags, representative_account);
+			break;
+		}
+		case ysu::block_type::change:
+		{
+			auto const & block (*boost::polymorphic_downcast<ysu::change_block const *> (&block_a));
+			write_optional (stream_a, block.hashables.previous, flags, previous_zero);
+			ysu::write (stream_a, block.hashables.representative.bytes);
+			break;
+		}
+		case ysu::block_type::state:
+		{
+			auto const & block (*boost::polymorphic_downcast<ysu::state_block const *> (&block_a));
+			ysu::write (stream_a, block.hashables.account.bytes);
+			write_optional (stream_a, block.hashables.previous, flags, previous_zero);
+			write_optional (stream_a, block.hashables.representative, flags, representative_account);
+			write_amount (stream_a, block.hashables.balance);
+			write_optional (stream_a, block.hashables.link, flags, link_zero);
+			break;
+		}
+		case ysu::block_type::invalid:
+		case ysu::block_type::not_a_block:
+			release_assert (false);
+			break;
+	}
+	ysu::write (stream_a, block_a.block_signature ().bytes);
+	write_work (stream_a, block_a.block_work ());
+	auto const & sideband (block_a.sideband ());
+	if (type != ysu::block_type::state && type != ysu::block_type::open)
+	{
+		ysu::write (stream_a, sideband.account.bytes);
+	}
+	if (type != ysu::block_type::open)
+	{
+		write_varint (stream_a, sideband.height);
+	}
+	if (type == ysu::block_type::receive || type == ysu::block_type::change || type == ysu::block_type::open)
+	{
+		write_amount (stream_a, sideband.balance);
+	}
+	write_varint (stream_a, sideband.timestamp);
+	if (type == ysu::block_type::state)
+	{
+		sideband.details.serialize (stream_a);
+		ysu::write (stream_a, static_cast<uint8_t> (sideband.source_epoch));
+	}
+	ysu::write (stream_a, sideband.successor.bytes);
+}
+
+size_t ysu::block_value_size (ysu::block const & block_a)
+{
+	std::vector<uint8_t> value;
+	{
+		ysu::vectorstream stream (value);
+		ysu::serialize_block_value (stream, block_a);
+	}
+	return value.size ();
+}
+
+std::shared_ptr<ysu::block> ysu::deserialize_block_value (uint8_t const * data_a, size_t size_a, bool sideband_a)
+{
+	std::shared_ptr<ysu::block> result;
+	ysu::bufferstream stream (data_a, size_a);
+	auto type (block_value_type (data_a));
+	try
+	{
+		uint8_t type_byte (0);
+		ysu::read (stream, type_byte);
+		if (block_value_compact (data_a))
+		{
+			result = deserialize_compact (stream, type, sideband_a);
+		}
+		else
+		{
+			result = ysu::deserialize_block (stream, type);
+			if (result != nullptr && sideband_a)
+			{
+				ysu::block_sideband sideband;
+				if (sideband.deserialize (stream, type))
+				{
+					result = nullptr;
+				}
+				else
+				{
+					result->sideband_set (sideband);
+				}
+			}
+		}
+	}
+	catch (std::runtime_error const &)
+	{
+		result = nullptr;
+	}
+	return result;
+}
+
+ysu::block_type ysu::block_value_type (uint8_t const * data_a)
+{
+	return static_cast<ysu::block_type> (data_a[0] & ~block_value_compact_flag);
+}
+
+bool ysu::block_value_compact (uint8_t const * data_a)
+{
+	return (data_a[0] & block_value_compact_flag) != 0;
+}
+
+size_t ysu::block_value_successor_offset (uint8_t const * data_a, size_t size_a)
+{
+	return size_a - (block_value_compact (data_a) ? sizeof (ysu::block_hash) : ysu::block_sideband::size (block_value_type (data_a)));
+}
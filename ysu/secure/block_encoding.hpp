@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ysu/lib/blocks.hpp>
+
+#include <memory>
+
+namespace ysu
+{
+/**
+ * Values of the blocks table hold a block along with its sideband. Ledgers up to version 24 store the network
+ * serialization of the block followed by the full sideband, which starts with the block type.
+ *
+ * The compact encoding written since sets the high bit of the type byte and is followed by a byte of flags marking
+ * fields which are left out: a zero previous or link, and a representative equal to the account. Balances drop their
+ * leading zero bytes, heights and timestamps are variable length integers. The successor is kept as the last 32 bytes
+ * so that it can still be changed in place. Block hashes are unaffected as blocks are rebuilt field by field.
+ */
+uint8_t constexpr block_value_compact_flag = 0x80;
+
+/** Writes \p block_a and its sideband in the compact encoding */
+void serialize_block_value (ysu::stream & stream_a, ysu::block const & block_a);
+/** Size of the compact encoding of \p block_a */
+size_t block_value_size (ysu::block const & block_a);
+/** Reads a value in either encoding, returning nullptr if it is malformed. The sideband is only set if \p sideband_a is true */
+std::shared_ptr<ysu::block> deserialize_block_value (uint8_t const * data_a, size_t size_a, bool sideband_a = true);
+ysu::block_type block_value_type (uint8_t const * data_a);
+bool block_value_compact (uint8_t const * data_a);
+/** Offset of the successor in a value of \p size_a bytes */
+size_t block_value_successor_offset (uint8_t const * data_a, size_t size_a);
+}
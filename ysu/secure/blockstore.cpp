@@ -1,5 +1,6 @@
 #include <ysu/lib/threading.hpp>
 #include <ysu/secure/blockstore.hpp>
+#include <ysu/secure/store_cache.hpp>
 
 ysu::representative_visitor::representative_visitor (ysu::transaction const & transaction_a, ysu::block_store & store_a) :
 transaction (transaction_a),
@@ -44,7 +45,19 @@ void ysu::representative_visitor::state_block (ysu::state_block const & block_a)
 	result = block_a.hash ();
 }
 
-ysu::read_transaction::read_transaction (std::unique_ptr<ysu::read_transaction_impl> read_transaction_impl) :
+ysu::transaction::transaction (ysu::store_cache * cache_a, uint64_t cache_epoch_a) :
+cache (cache_a),
+cache_epoch_m (cache_epoch_a)
+{
+}
+
+uint64_t ysu::transaction::cache_epoch () const
+{
+	return cache_epoch_m;
+}
+
+ysu::read_transaction::read_transaction (std::unique_ptr<ysu::read_transaction_impl> read_transaction_impl, ysu::store_cache * cache_a, uint64_t cache_epoch_a) :
+transaction (cache_a, cache_epoch_a),
 impl (std::move (read_transaction_impl))
 {
 }
@@ -61,6 +74,10 @@ void ysu::read_transaction::reset () const
 
 void ysu::read_transaction::renew () const
 {
+	if (cache != nullptr)
+	{
+		cache_epoch_m = cache->epoch_get ();
+	}
 	impl->renew ();
 }
 
@@ -70,7 +87,8 @@ void ysu::read_transaction::refresh () const
 	renew ();
 }
 
-ysu::write_transaction::write_transaction (std::unique_ptr<ysu::write_transaction_impl> write_transaction_impl) :
+ysu::write_transaction::write_transaction (std::unique_ptr<ysu::write_transaction_impl> write_transaction_impl, ysu::store_cache * cache_a, uint64_t cache_epoch_a) :
+transaction (cache_a, cache_epoch_a),
 impl (std::move (write_transaction_impl))
 {
 	/*
@@ -79,6 +97,20 @@ impl (std::move (write_transaction_impl))
 	debug_assert (ysu::thread_role::get () != ysu::thread_role::name::io);
 }
 
+ysu::write_transaction::~write_transaction ()
+{
+	if (impl != nullptr)
+	{
+		auto handle (impl->get_handle ());
+		// Destroying the implementation commits it
+		impl.reset ();
+		if (cache != nullptr)
+		{
+			cache->commit (handle);
+		}
+	}
+}
+
 void * ysu::write_transaction::get_handle () const
 {
 	return impl->get_handle ();
@@ -87,10 +119,18 @@ void * ysu::write_transaction::get_handle () const
 void ysu::write_transaction::commit () const
 {
 	impl->commit ();
+	if (cache != nullptr)
+	{
+		cache->commit (impl->get_handle ());
+	}
 }
 
 void ysu::write_transaction::renew ()
 {
+	if (cache != nullptr)
+	{
+		cache_epoch_m = cache->epoch_get ();
+	}
 	impl->renew ();
 }
 
@@ -6,6 +6,7 @@
 #include <ysu/lib/logger_mt.hpp>
 #include <ysu/lib/memory.hpp>
 #include <ysu/lib/rocksdbconfig.hpp>
+#include <ysu/secure/block_encoding.hpp>
 #include <ysu/secure/buffer.hpp>
 #include <ysu/secure/common.hpp>
 #include <ysu/secure/versioning.hpp>
@@ -109,6 +110,24 @@ public:
 		static_assert (std::is_standard_layout<ysu::unchecked_key>::value, "Standard layout is required");
 	}
 
+	db_val (ysu::account_balance_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<ysu::account_balance_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<ysu::account_balance_key>::value, "Standard layout is required");
+	}
+
+	db_val (ysu::account_height_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<ysu::account_height_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<ysu::account_height_key>::value, "Standard layout is required");
+	}
+
+	db_val (ysu::unchecked_time_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<ysu::unchecked_time_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<ysu::unchecked_time_key>::value, "Standard layout is required");
+	}
+
 	db_val (ysu::confirmation_height_info const & val_a) :
 	buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -119,6 +138,16 @@ public:
 		convert_buffer_to_value ();
 	}
 
+	db_val (ysu::pending_summary const & val_a) :
+	buffer (std::make_shared<std::vector<uint8_t>> ())
+	{
+		{
+			ysu::vectorstream stream (*buffer);
+			val_a.serialize (stream);
+		}
+		convert_buffer_to_value ();
+	}
+
 	db_val (ysu::block_info const & val_a) :
 	db_val (sizeof (val_a), const_cast<ysu::block_info *> (&val_a))
 	{
@@ -212,6 +241,16 @@ public:
 		return result;
 	}
 
+	explicit operator ysu::pending_summary () const
+	{
+		ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
+		ysu::pending_summary result;
+		bool error (result.deserialize (stream));
+		(void)error;
+		debug_assert (!error);
+		return result;
+	}
+
 	explicit operator ysu::unchecked_info () const
 	{
 		ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
@@ -231,6 +270,33 @@ public:
 		return result;
 	}
 
+	explicit operator ysu::account_balance_key () const
+	{
+		ysu::account_balance_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (ysu::amount) + sizeof (ysu::account) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
+	explicit operator ysu::account_height_key () const
+	{
+		ysu::account_height_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (ysu::account) + sizeof (uint64_t) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
+	explicit operator ysu::unchecked_time_key () const
+	{
+		ysu::unchecked_time_key result;
+		debug_assert (size () == sizeof (result));
+		static_assert (sizeof (uint64_t) + sizeof (ysu::unchecked_key) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	explicit operator ysu::uint128_union () const
 	{
 		return convert<ysu::uint128_union> ();
@@ -320,9 +386,8 @@ public:
 
 	explicit operator std::shared_ptr<ysu::block> () const
 	{
-		ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
-		std::shared_ptr<ysu::block> result (ysu::deserialize_block (stream));
-		return result;
+		// Only used for values of the blocks table
+		return ysu::deserialize_block_value (reinterpret_cast<uint8_t const *> (data ()), size (), false);
 	}
 
 	template <typename Block>
@@ -506,6 +571,8 @@ private:
 // Keep this in alphabetical order
 enum class tables
 {
+	account_balance,
+	account_height,
 	accounts,
 	blocks,
 	confirmation_height,
@@ -515,11 +582,16 @@ enum class tables
 	online_weight,
 	peers,
 	pending,
+	pending_summary,
 	pruned,
 	unchecked,
+	unchecked_time,
 	vote
 };
 
+/** Raw key and value pairs, encoded the way the stores encode them, in ascending key order */
+using sorted_records = std::vector<std::pair<std::vector<uint8_t>, std::vector<uint8_t>>>;
+
 class transaction_impl
 {
 public:
@@ -542,11 +614,20 @@ public:
 	virtual bool contains (ysu::tables table_a) const = 0;
 };
 
+class store_cache;
+
 class transaction
 {
 public:
 	virtual ~transaction () = default;
 	virtual void * get_handle () const = 0;
+	/** Epoch of \p cache read before the current snapshot was taken, see ysu::store_cache */
+	uint64_t cache_epoch () const;
+
+protected:
+	transaction (ysu::store_cache * cache_a, uint64_t cache_epoch_a);
+	ysu::store_cache * cache;
+	mutable uint64_t cache_epoch_m;
 };
 
 /**
@@ -556,7 +637,8 @@ public:
 class read_transaction final : public transaction
 {
 public:
-	explicit read_transaction (std::unique_ptr<ysu::read_transaction_impl> read_transaction_impl);
+	/** \p cache_epoch_a has to be read from \p cache_a before \p read_transaction_impl was started */
+	explicit read_transaction (std::unique_ptr<ysu::read_transaction_impl> read_transaction_impl, ysu::store_cache * cache_a = nullptr, uint64_t cache_epoch_a = 0);
 	void * get_handle () const override;
 	void reset () const;
 	void renew () const;
@@ -573,7 +655,10 @@ private:
 class write_transaction final : public transaction
 {
 public:
-	explicit write_transaction (std::unique_ptr<ysu::write_transaction_impl> write_transaction_impl);
+	/** \p cache_epoch_a has to be read from \p cache_a before \p write_transaction_impl was started */
+	explicit write_transaction (std::unique_ptr<ysu::write_transaction_impl> write_transaction_impl, ysu::store_cache * cache_a = nullptr, uint64_t cache_epoch_a = 0);
+	write_transaction (ysu::write_transaction &&) = default;
+	~write_transaction ();
 	void * get_handle () const override;
 	void commit () const;
 	void renew ();
@@ -584,6 +669,7 @@ private:
 };
 
 class ledger_cache;
+class cold_store;
 
 /**
  * Manages block storage and iteration
@@ -629,17 +715,40 @@ public:
 	virtual ysu::store_iterator<ysu::pending_key, ysu::pending_info> pending_begin (ysu::transaction const &, ysu::pending_key const &) = 0;
 	virtual ysu::store_iterator<ysu::pending_key, ysu::pending_info> pending_begin (ysu::transaction const &) = 0;
 	virtual ysu::store_iterator<ysu::pending_key, ysu::pending_info> pending_end () = 0;
+	/** Aggregate of the pending entries of \p account_a, which has a zero count if there are none */
+	virtual ysu::pending_summary pending_summary_get (ysu::transaction const &, ysu::account const & account_a) const = 0;
+	virtual ysu::store_iterator<ysu::account, ysu::pending_summary> pending_summary_begin (ysu::transaction const &, ysu::account const &) const = 0;
+	virtual ysu::store_iterator<ysu::account, ysu::pending_summary> pending_summary_begin (ysu::transaction const &) const = 0;
+	virtual ysu::store_iterator<ysu::account, ysu::pending_summary> pending_summary_end () const = 0;
+
+	/** Hash of the block of \p account_a at \p height_a, or zero if it is not stored */
+	virtual ysu::block_hash account_height_get (ysu::transaction const &, ysu::account const & account_a, uint64_t height_a) const = 0;
+	virtual ysu::store_iterator<ysu::account_height_key, ysu::block_hash> account_height_begin (ysu::transaction const &, ysu::account_height_key const &) const = 0;
+	virtual ysu::store_iterator<ysu::account_height_key, ysu::block_hash> account_height_begin (ysu::transaction const &) const = 0;
+	virtual ysu::store_iterator<ysu::account_height_key, ysu::block_hash> account_height_end () const = 0;
+
+	/** Entries of the balance index map each account to its modified timestamp */
+	virtual void account_balance_put (ysu::write_transaction const &, ysu::account const &, ysu::account_info const &) = 0;
+	virtual void account_balance_del (ysu::write_transaction const &, ysu::account const &, ysu::amount const &) = 0;
+	virtual void account_balance_clear (ysu::write_transaction const &) = 0;
+	virtual ysu::store_iterator<ysu::account_balance_key, uint64_t> account_balance_begin (ysu::transaction const &, ysu::account_balance_key const &) const = 0;
+	virtual ysu::store_iterator<ysu::account_balance_key, uint64_t> account_balance_begin (ysu::transaction const &) const = 0;
+	virtual ysu::store_iterator<ysu::account_balance_key, uint64_t> account_balance_end () const = 0;
 
 	virtual ysu::uint128_t block_balance (ysu::transaction const &, ysu::block_hash const &) = 0;
 	virtual ysu::uint128_t block_balance_calculated (std::shared_ptr<ysu::block> const &) const = 0;
 	virtual ysu::epoch block_version (ysu::transaction const &, ysu::block_hash const &) = 0;
 
 	virtual void unchecked_clear (ysu::write_transaction const &) = 0;
-	virtual void unchecked_put (ysu::write_transaction const &, ysu::unchecked_key const &, ysu::unchecked_info const &) = 0;
-	virtual void unchecked_put (ysu::write_transaction const &, ysu::block_hash const &, std::shared_ptr<ysu::block> const &) = 0;
+	/** Returns true if the key was not stored before */
+	virtual bool unchecked_put (ysu::write_transaction const &, ysu::unchecked_key const &, ysu::unchecked_info const &) = 0;
+	virtual bool unchecked_put (ysu::write_transaction const &, ysu::block_hash const &, std::shared_ptr<ysu::block> const &) = 0;
 	virtual std::vector<ysu::unchecked_info> unchecked_get (ysu::transaction const &, ysu::block_hash const &) = 0;
 	virtual bool unchecked_exists (ysu::transaction const & transaction_a, ysu::unchecked_key const & unchecked_key_a) = 0;
-	virtual void unchecked_del (ysu::write_transaction const &, ysu::unchecked_key const &) = 0;
+	/** Returns true if the key was stored, deleting a missing key does nothing */
+	virtual bool unchecked_del (ysu::write_transaction const &, ysu::unchecked_key const &) = 0;
+	/** Deletes up to \p count_a entries last modified before \p modified_a, oldest first, and returns them */
+	virtual std::vector<ysu::unchecked_info> unchecked_del_before (ysu::write_transaction const &, uint64_t modified_a, size_t count_a) = 0;
 	virtual ysu::store_iterator<ysu::unchecked_key, ysu::unchecked_info> unchecked_begin (ysu::transaction const &) const = 0;
 	virtual ysu::store_iterator<ysu::unchecked_key, ysu::unchecked_info> unchecked_begin (ysu::transaction const &, ysu::unchecked_key const &) const = 0;
 	virtual ysu::store_iterator<ysu::unchecked_key, ysu::unchecked_info> unchecked_end () const = 0;
@@ -702,11 +811,25 @@ public:
 
 	virtual uint64_t block_account_height (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const = 0;
 	virtual std::mutex & get_cache_mutex () = 0;
+	virtual ysu::store_cache & get_store_cache () = 0;
 
 	virtual unsigned max_block_write_batch_num () const = 0;
 
 	virtual bool copy_db (boost::filesystem::path const & destination) = 0;
 	virtual void rebuild_db (ysu::write_transaction const & transaction_a) = 0;
+	/** Bulk loads records which sort after the ones already in \p table_a. Nothing is validated or indexed, this is meant for restoring copies of a ledger */
+	virtual void put_sorted (ysu::write_transaction const & transaction_a, ysu::tables table_a, ysu::sorted_records const & records_a) = 0;
+
+	/** Opens the cold tier of the blocks table, creating it if needed. Returns true on error */
+	virtual bool cold_open () = 0;
+	/** The cold tier, or nullptr if it was never opened */
+	virtual ysu::cold_store * get_cold_store () = 0;
+	/** Copies the blocks \p hashes_a from the blocks table to a new cold segment, in the order given. Returns true on error */
+	virtual bool cold_put (ysu::transaction const & transaction_a, std::vector<ysu::block_hash> const & hashes_a) = 0;
+	/** Deletes a block copied by cold_put from the blocks table, where it is still found through the cold tier */
+	virtual void cold_release (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a) = 0;
+	/** Returns true if \p hash_a is held by the blocks table rather than the cold tier */
+	virtual bool block_exists_hot (ysu::transaction const &, ysu::block_hash const &) = 0;
 
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
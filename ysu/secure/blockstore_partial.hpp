@@ -1,13 +1,20 @@
 #pragma once
 
+#include <ysu/lib/bloom_filter.hpp>
 #include <ysu/lib/config.hpp>
 #include <ysu/lib/rep_weights.hpp>
 #include <ysu/lib/threading.hpp>
 #include <ysu/secure/blockstore.hpp>
 #include <ysu/secure/buffer.hpp>
+#include <ysu/secure/cold_store.hpp>
+#include <ysu/secure/store_cache.hpp>
 
 #include <crypto/cryptopp/words.h>
 
+#include <boost/filesystem/operations.hpp>
+
+#include <atomic>
+#include <fstream>
 #include <thread>
 
 namespace
@@ -105,13 +112,15 @@ public:
 	void block_put (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a, ysu::block const & block_a) override
 	{
 		debug_assert (block_a.sideband ().successor.is_zero () || block_exists (transaction_a, block_a.sideband ().successor));
+		// Inserted before the write so that every snapshot containing the block finds it in the filter
+		block_filter.insert (hash_a);
 		std::vector<uint8_t> vector;
 		{
 			ysu::vectorstream stream (vector);
-			ysu::serialize_block (stream, block_a);
-			block_a.sideband ().serialize (stream, block_a.type ());
+			ysu::serialize_block_value (stream, block_a);
 		}
 		block_raw_put (transaction_a, vector, hash_a);
+		account_height_put (transaction_a, block_a, hash_a);
 		ysu::block_predecessor_set<Val, Derived_Store> predecessor (transaction_a, *this);
 		block_a.visit (predecessor);
 		debug_assert (block_a.previous ().is_zero () || block_successor (transaction_a, block_a.previous ()) == hash_a);
@@ -130,34 +139,88 @@ public:
 		std::shared_ptr<ysu::block> result;
 		if (value.size () != 0)
 		{
-			ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			ysu::block_type type;
-			auto error (try_read (stream, type));
-			release_assert (!error);
-			result = ysu::deserialize_block (stream, type);
+			result = ysu::deserialize_block_value (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 			release_assert (result != nullptr);
-			ysu::block_sideband sideband;
-			error = (sideband.deserialize (stream, type));
-			release_assert (!error);
-			result->sideband_set (sideband);
 		}
 		return result;
 	}
 
 	bool block_exists (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) override
 	{
+		if (block_filter_excludes (hash_a))
+		{
+			return false;
+		}
 		auto junk = block_raw_get (transaction_a, hash_a);
 		return junk.size () != 0;
 	}
 
+	bool block_exists_hot (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) override
+	{
+		return !block_filter_excludes (hash_a) && exists (transaction_a, tables::blocks, ysu::db_val<Val> (hash_a));
+	}
+
+	bool cold_open () override
+	{
+		std::lock_guard<std::mutex> guard (cold_mutex);
+		auto error (false);
+		if (cold == nullptr)
+		{
+			auto cold_l (std::make_unique<ysu::cold_store> (error, cold_path));
+			if (!error)
+			{
+				cold = cold_l.get ();
+				cold_owner = std::move (cold_l);
+			}
+		}
+		return error;
+	}
+
+	ysu::cold_store * get_cold_store () override
+	{
+		return cold.load ();
+	}
+
+	bool cold_put (ysu::transaction const & transaction_a, std::vector<ysu::block_hash> const & hashes_a) override
+	{
+		auto cold_l (cold.load ());
+		debug_assert (cold_l != nullptr);
+		std::vector<std::pair<ysu::block_hash, std::vector<uint8_t>>> records;
+		records.reserve (hashes_a.size ());
+		for (auto const & hash : hashes_a)
+		{
+			ysu::db_val<Val> value;
+			auto status (get (transaction_a, tables::blocks, hash, value));
+			release_assert (success (status) || not_found (status));
+			if (success (status))
+			{
+				auto data (reinterpret_cast<uint8_t const *> (value.data ()));
+				std::vector<uint8_t> record (data, data + value.size ());
+				// Blocks copied by a move which was interrupted before they were released are not written again, unless they changed since
+				auto existing (cold_l->may_contain (hash) ? cold_l->get (hash) : nullptr);
+				if (existing == nullptr || *existing != record)
+				{
+					records.emplace_back (hash, std::move (record));
+				}
+			}
+		}
+		return !records.empty () && cold_l->put (records);
+	}
+
+	void cold_release (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a) override
+	{
+		debug_assert (cold.load () != nullptr && cold.load ()->get (hash_a) != nullptr);
+		auto status (del (transaction_a, tables::blocks, hash_a));
+		release_assert (success (status) || not_found (status));
+	}
+
 	std::shared_ptr<ysu::block> block_get_no_sideband (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const override
 	{
 		auto value (block_raw_get (transaction_a, hash_a));
 		std::shared_ptr<ysu::block> result;
 		if (value.size () != 0)
 		{
-			ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			result = ysu::deserialize_block (stream);
+			result = ysu::deserialize_block_value (reinterpret_cast<uint8_t const *> (value.data ()), value.size (), false);
 			debug_assert (result != nullptr);
 		}
 		return result;
@@ -218,8 +281,7 @@ public:
 		if (value.size () != 0)
 		{
 			debug_assert (value.size () >= result.bytes.size ());
-			auto type = block_type_from_raw (value.data ());
-			ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + block_successor_offset (transaction_a, value.size (), type), result.bytes.size ());
+			ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + block_successor_offset (value), result.bytes.size ());
 			auto error (ysu::try_read (stream, result.bytes));
 			(void)error;
 			debug_assert (!error);
@@ -235,17 +297,16 @@ public:
 	{
 		auto value (block_raw_get (transaction_a, hash_a));
 		debug_assert (value.size () != 0);
-		auto type = block_type_from_raw (value.data ());
 		std::vector<uint8_t> data (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
-		std::fill_n (data.begin () + block_successor_offset (transaction_a, value.size (), type), sizeof (ysu::block_hash), uint8_t{ 0 });
+		std::fill_n (data.begin () + block_successor_offset (value), sizeof (ysu::block_hash), uint8_t{ 0 });
 		block_raw_put (transaction_a, data, hash_a);
 	}
 
-	void unchecked_put (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a, std::shared_ptr<ysu::block> const & block_a) override
+	bool unchecked_put (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a, std::shared_ptr<ysu::block> const & block_a) override
 	{
 		ysu::unchecked_key key (hash_a, block_a->hash ());
 		ysu::unchecked_info info (block_a, block_a->account (), ysu::seconds_since_epoch (), ysu::signature_verification::unknown);
-		unchecked_put (transaction_a, key, info);
+		return unchecked_put (transaction_a, key, info);
 	}
 
 	std::shared_ptr<ysu::vote> vote_current (ysu::transaction const & transaction_a, ysu::account const & account_a) override
@@ -328,6 +389,11 @@ public:
 		return ysu::store_iterator<ysu::pending_key, ysu::pending_info> (nullptr);
 	}
 
+	ysu::store_iterator<ysu::account, ysu::pending_summary> pending_summary_end () const override
+	{
+		return ysu::store_iterator<ysu::account, ysu::pending_summary> (nullptr);
+	}
+
 	ysu::store_iterator<uint64_t, ysu::amount> online_weight_end () const override
 	{
 		return ysu::store_iterator<uint64_t, ysu::amount> (nullptr);
@@ -343,6 +409,16 @@ public:
 		return ysu::store_iterator<ysu::block_hash, std::shared_ptr<ysu::block>> (nullptr);
 	}
 
+	ysu::store_iterator<ysu::account_height_key, ysu::block_hash> account_height_end () const override
+	{
+		return ysu::store_iterator<ysu::account_height_key, ysu::block_hash> (nullptr);
+	}
+
+	ysu::store_iterator<ysu::account_balance_key, uint64_t> account_balance_end () const override
+	{
+		return ysu::store_iterator<ysu::account_balance_key, uint64_t> (nullptr);
+	}
+
 	ysu::store_iterator<ysu::account, ysu::confirmation_height_info> confirmation_height_end () const override
 	{
 		return ysu::store_iterator<ysu::account, ysu::confirmation_height_info> (nullptr);
@@ -353,10 +429,29 @@ public:
 		return cache_mutex;
 	}
 
+	ysu::store_cache & get_store_cache () override
+	{
+		return cache;
+	}
+
 	void block_del (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a) override
 	{
+		auto block (block_get (transaction_a, hash_a));
+		if (block != nullptr && block->sideband ().height != 0)
+		{
+			ysu::account_height_key key (block_account_index (*block), block->sideband ().height);
+			// Only remove the entry if no other block has since been stored at the same height
+			ysu::db_val<Val> value;
+			auto status (get (transaction_a, tables::account_height, ysu::db_val<Val> (key), value));
+			if (success (status) && static_cast<ysu::block_hash> (value) == hash_a)
+			{
+				status = del (transaction_a, tables::account_height, key);
+				release_assert (success (status));
+			}
+		}
 		auto status = del (transaction_a, tables::blocks, hash_a);
-		release_assert (success (status));
+		// A block only held by the cold tier is masked there by the removal of its height index entry above
+		release_assert (success (status) || (not_found (status) && block != nullptr && cold.load () != nullptr));
 	}
 
 	int version_get (ysu::transaction const & transaction_a) const override
@@ -394,15 +489,36 @@ public:
 
 	void pending_put (ysu::write_transaction const & transaction_a, ysu::pending_key const & key_a, ysu::pending_info const & pending_info_a) override
 	{
+		ysu::pending_info existing;
+		auto replaced (!pending_get (transaction_a, key_a, existing));
 		ysu::db_val<Val> pending (pending_info_a);
 		auto status = put (transaction_a, tables::pending, key_a, pending);
 		release_assert (success (status));
+		if (replaced)
+		{
+			pending_summary_remove (transaction_a, key_a, existing);
+		}
+		pending_summary_add (transaction_a, key_a, pending_info_a);
 	}
 
 	void pending_del (ysu::write_transaction const & transaction_a, ysu::pending_key const & key_a) override
 	{
+		ysu::pending_info existing;
+		auto exists (!pending_get (transaction_a, key_a, existing));
 		auto status = del (transaction_a, tables::pending, key_a);
 		release_assert (success (status));
+		if (exists)
+		{
+			pending_summary_remove (transaction_a, key_a, existing);
+		}
+	}
+
+	ysu::pending_summary pending_summary_get (ysu::transaction const & transaction_a, ysu::account const & account_a) const override
+	{
+		ysu::db_val<Val> value;
+		auto status (get (transaction_a, tables::pending_summary, ysu::db_val<Val> (account_a), value));
+		release_assert (success (status) || not_found (status));
+		return success (status) ? static_cast<ysu::pending_summary> (value) : ysu::pending_summary{};
 	}
 
 	bool pending_get (ysu::transaction const & transaction_a, ysu::pending_key const & key_a, ysu::pending_info & pending_a) override
@@ -446,17 +562,66 @@ public:
 		release_assert (success (status));
 	}
 
-	void unchecked_put (ysu::write_transaction const & transaction_a, ysu::unchecked_key const & key_a, ysu::unchecked_info const & info_a) override
+	bool unchecked_put (ysu::write_transaction const & transaction_a, ysu::unchecked_key const & key_a, ysu::unchecked_info const & info_a) override
 	{
+		ysu::db_val<Val> existing;
+		auto result (not_found (get (transaction_a, tables::unchecked, ysu::db_val<Val> (key_a), existing)));
+		if (!result)
+		{
+			// Move the entry to its new position in the time index
+			auto modified (static_cast<ysu::unchecked_info> (existing).modified);
+			if (modified != info_a.modified)
+			{
+				auto status (del (transaction_a, tables::unchecked_time, ysu::unchecked_time_key (modified, key_a)));
+				release_assert (success (status));
+			}
+		}
 		ysu::db_val<Val> info (info_a);
 		auto status (put (transaction_a, tables::unchecked, key_a, info));
 		release_assert (success (status));
+		status = put_key (transaction_a, tables::unchecked_time, ysu::unchecked_time_key (info_a.modified, key_a));
+		release_assert (success (status));
+		return result;
 	}
 
-	void unchecked_del (ysu::write_transaction const & transaction_a, ysu::unchecked_key const & key_a) override
+	bool unchecked_del (ysu::write_transaction const & transaction_a, ysu::unchecked_key const & key_a) override
 	{
-		auto status (del (transaction_a, tables::unchecked, key_a));
-		release_assert (success (status));
+		ysu::db_val<Val> value;
+		auto status (get (transaction_a, tables::unchecked, ysu::db_val<Val> (key_a), value));
+		release_assert (success (status) || not_found (status));
+		auto result (success (status));
+		if (result)
+		{
+			status = del (transaction_a, tables::unchecked_time, ysu::unchecked_time_key (static_cast<ysu::unchecked_info> (value).modified, key_a));
+			release_assert (success (status));
+			status = del (transaction_a, tables::unchecked, key_a);
+			release_assert (success (status));
+		}
+		return result;
+	}
+
+	std::vector<ysu::unchecked_info> unchecked_del_before (ysu::write_transaction const & transaction_a, uint64_t modified_a, size_t count_a) override
+	{
+		// Expired entries form a prefix of the time index, so nothing newer than the cutoff is read
+		std::vector<ysu::unchecked_time_key> keys;
+		for (auto i (make_iterator<ysu::unchecked_time_key, ysu::no_value> (transaction_a, tables::unchecked_time)), n (ysu::store_iterator<ysu::unchecked_time_key, ysu::no_value> (nullptr)); i != n && keys.size () < count_a && i->first.modified () < modified_a; ++i)
+		{
+			keys.push_back (i->first);
+		}
+		std::vector<ysu::unchecked_info> result;
+		result.reserve (keys.size ());
+		for (auto const & key : keys)
+		{
+			ysu::db_val<Val> value;
+			auto status (get (transaction_a, tables::unchecked, ysu::db_val<Val> (key.key ()), value));
+			release_assert (success (status));
+			result.push_back (static_cast<ysu::unchecked_info> (value));
+			status = del (transaction_a, tables::unchecked_time, key);
+			release_assert (success (status));
+			status = del (transaction_a, tables::unchecked, key.key ());
+			release_assert (success (status));
+		}
+		return result;
 	}
 
 	std::shared_ptr<ysu::vote> vote_get (ysu::transaction const & transaction_a, ysu::account const & account_a) override
@@ -511,18 +676,25 @@ public:
 		// Check we are still in sync with other tables
 		debug_assert (confirmation_height_exists (transaction_a, account_a));
 		ysu::db_val<Val> info (info_a);
+		cache.account_put (transaction_a, account_a, info_a);
 		auto status = put (transaction_a, tables::accounts, account_a, info);
 		release_assert (success (status));
 	}
 
 	void account_del (ysu::write_transaction const & transaction_a, ysu::account const & account_a) override
 	{
+		cache.account_del (transaction_a, account_a);
 		auto status = del (transaction_a, tables::accounts, account_a);
 		release_assert (success (status));
 	}
 
 	bool account_get (ysu::transaction const & transaction_a, ysu::account const & account_a, ysu::account_info & info_a) override
 	{
+		if (auto cached = cache.accounts.get (transaction_a.cache_epoch (), account_a))
+		{
+			info_a = *cached;
+			return false;
+		}
 		ysu::db_val<Val> value;
 		ysu::db_val<Val> account (account_a);
 		auto status1 (get (transaction_a, tables::accounts, account, value));
@@ -533,6 +705,10 @@ public:
 			ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 			result = info_a.deserialize (stream);
 		}
+		if (!result)
+		{
+			cache.accounts.fill (transaction_a.cache_epoch (), account_a, info_a);
+		}
 		return result;
 	}
 
@@ -540,6 +716,8 @@ public:
 	{
 		auto status = drop (transaction_a, tables::unchecked);
 		release_assert (success (status));
+		status = drop (transaction_a, tables::unchecked_time);
+		release_assert (success (status));
 	}
 
 	size_t online_weight_count (ysu::transaction const & transaction_a) const override
@@ -555,6 +733,7 @@ public:
 
 	void pruned_put (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a) override
 	{
+		block_filter.insert (hash_a);
 		auto status = put_key (transaction_a, tables::pruned, hash_a);
 		release_assert (success (status));
 	}
@@ -567,12 +746,12 @@ public:
 
 	bool pruned_exists (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const override
 	{
-		return exists (transaction_a, tables::pruned, ysu::db_val<Val> (hash_a));
+		return !block_filter_excludes (hash_a) && exists (transaction_a, tables::pruned, ysu::db_val<Val> (hash_a));
 	}
 
 	bool block_or_pruned_exists (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) override
 	{
-		return block_exists (transaction_a, hash_a) || pruned_exists (transaction_a, hash_a);
+		return !block_filter_excludes (hash_a) && (block_exists (transaction_a, hash_a) || pruned_exists (transaction_a, hash_a));
 	}
 
 	size_t pruned_count (ysu::transaction const & transaction_a) const override
@@ -621,7 +800,9 @@ public:
 
 	uint64_t block_count (ysu::transaction const & transaction_a) override
 	{
-		return count (transaction_a, tables::blocks);
+		auto cold_l (cold.load ());
+		// Every stored block has one entry in the height index, while the tiers together hold blocks twice after an interrupted move and still hold masked blocks
+		return cold_l != nullptr && cold_l->size () != 0 ? count (transaction_a, tables::account_height) : count (transaction_a, tables::blocks);
 	}
 
 	size_t account_count (ysu::transaction const & transaction_a) override
@@ -664,12 +845,18 @@ public:
 	void confirmation_height_put (ysu::write_transaction const & transaction_a, ysu::account const & account_a, ysu::confirmation_height_info const & confirmation_height_info_a) override
 	{
 		ysu::db_val<Val> confirmation_height_info (confirmation_height_info_a);
+		cache.confirmation_height_put (transaction_a, account_a, confirmation_height_info_a);
 		auto status = put (transaction_a, tables::confirmation_height, account_a, confirmation_height_info);
 		release_assert (success (status));
 	}
 
 	bool confirmation_height_get (ysu::transaction const & transaction_a, ysu::account const & account_a, ysu::confirmation_height_info & confirmation_height_info_a) override
 	{
+		if (auto cached = cache.confirmation_heights.get (transaction_a.cache_epoch (), account_a))
+		{
+			confirmation_height_info_a = *cached;
+			return false;
+		}
 		ysu::db_val<Val> value;
 		auto status = get (transaction_a, tables::confirmation_height, ysu::db_val<Val> (account_a), value);
 		release_assert (success (status) || not_found (status));
@@ -679,11 +866,16 @@ public:
 			ysu::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 			result = confirmation_height_info_a.deserialize (stream);
 		}
+		if (!result)
+		{
+			cache.confirmation_heights.fill (transaction_a.cache_epoch (), account_a, confirmation_height_info_a);
+		}
 		return result;
 	}
 
 	void confirmation_height_del (ysu::write_transaction const & transaction_a, ysu::account const & account_a) override
 	{
+		cache.confirmation_height_del (transaction_a, account_a);
 		auto status (del (transaction_a, tables::confirmation_height, ysu::db_val<Val> (account_a)));
 		release_assert (success (status));
 	}
@@ -708,6 +900,52 @@ public:
 		return make_iterator<ysu::block_hash, std::shared_ptr<ysu::block>> (transaction_a, tables::blocks);
 	}
 
+	ysu::block_hash account_height_get (ysu::transaction const & transaction_a, ysu::account const & account_a, uint64_t height_a) const override
+	{
+		ysu::db_val<Val> value;
+		auto status (get (transaction_a, tables::account_height, ysu::db_val<Val> (ysu::account_height_key (account_a, height_a)), value));
+		release_assert (success (status) || not_found (status));
+		return success (status) ? static_cast<ysu::block_hash> (value) : ysu::block_hash (0);
+	}
+
+	ysu::store_iterator<ysu::account_height_key, ysu::block_hash> account_height_begin (ysu::transaction const & transaction_a, ysu::account_height_key const & key_a) const override
+	{
+		return make_iterator<ysu::account_height_key, ysu::block_hash> (transaction_a, tables::account_height, ysu::db_val<Val> (key_a));
+	}
+
+	ysu::store_iterator<ysu::account_height_key, ysu::block_hash> account_height_begin (ysu::transaction const & transaction_a) const override
+	{
+		return make_iterator<ysu::account_height_key, ysu::block_hash> (transaction_a, tables::account_height);
+	}
+
+	void account_balance_put (ysu::write_transaction const & transaction_a, ysu::account const & account_a, ysu::account_info const & info_a) override
+	{
+		auto status (put (transaction_a, tables::account_balance, ysu::account_balance_key (info_a.balance, account_a), info_a.modified));
+		release_assert (success (status));
+	}
+
+	void account_balance_del (ysu::write_transaction const & transaction_a, ysu::account const & account_a, ysu::amount const & balance_a) override
+	{
+		auto status (del (transaction_a, tables::account_balance, ysu::account_balance_key (balance_a, account_a)));
+		release_assert (success (status));
+	}
+
+	void account_balance_clear (ysu::write_transaction const & transaction_a) override
+	{
+		auto status (drop (transaction_a, tables::account_balance));
+		release_assert (success (status));
+	}
+
+	ysu::store_iterator<ysu::account_balance_key, uint64_t> account_balance_begin (ysu::transaction const & transaction_a, ysu::account_balance_key const & key_a) const override
+	{
+		return make_iterator<ysu::account_balance_key, uint64_t> (transaction_a, tables::account_balance, ysu::db_val<Val> (key_a));
+	}
+
+	ysu::store_iterator<ysu::account_balance_key, uint64_t> account_balance_begin (ysu::transaction const & transaction_a) const override
+	{
+		return make_iterator<ysu::account_balance_key, uint64_t> (transaction_a, tables::account_balance);
+	}
+
 	ysu::store_iterator<ysu::pending_key, ysu::pending_info> pending_begin (ysu::transaction const & transaction_a, ysu::pending_key const & key_a) override
 	{
 		return make_iterator<ysu::pending_key, ysu::pending_info> (transaction_a, tables::pending, ysu::db_val<Val> (key_a));
@@ -718,6 +956,16 @@ public:
 		return make_iterator<ysu::pending_key, ysu::pending_info> (transaction_a, tables::pending);
 	}
 
+	ysu::store_iterator<ysu::account, ysu::pending_summary> pending_summary_begin (ysu::transaction const & transaction_a, ysu::account const & account_a) const override
+	{
+		return make_iterator<ysu::account, ysu::pending_summary> (transaction_a, tables::pending_summary, ysu::db_val<Val> (account_a));
+	}
+
+	ysu::store_iterator<ysu::account, ysu::pending_summary> pending_summary_begin (ysu::transaction const & transaction_a) const override
+	{
+		return make_iterator<ysu::account, ysu::pending_summary> (transaction_a, tables::pending_summary);
+	}
+
 	ysu::store_iterator<ysu::unchecked_key, ysu::unchecked_info> unchecked_begin (ysu::transaction const & transaction_a) const override
 	{
 		return make_iterator<ysu::unchecked_key, ysu::unchecked_info> (transaction_a, tables::unchecked);
@@ -795,7 +1043,9 @@ protected:
 	ysu::network_params network_params;
 	std::unordered_map<ysu::account, std::shared_ptr<ysu::vote>> vote_cache_l1;
 	std::unordered_map<ysu::account, std::shared_ptr<ysu::vote>> vote_cache_l2;
-	int const version{ 20 };
+	/** Account and confirmation height records, consistent with every transaction started by tx_begin_read and tx_begin_write */
+	ysu::store_cache cache;
+	int const version{ 25 };
 
 	template <typename Key, typename Value>
 	ysu::store_iterator<Key, Value> make_iterator (ysu::transaction const & transaction_a, tables table_a) const
@@ -814,18 +1064,303 @@ protected:
 		ysu::db_val<Val> result;
 		auto status = get (transaction_a, tables::blocks, hash_a, result);
 		release_assert (success (status) || not_found (status));
+		auto cold_l (cold.load ());
+		if (not_found (status) && cold_l != nullptr)
+		{
+			auto buffer (cold_l->get (hash_a));
+			if (buffer != nullptr && cold_visible (transaction_a, hash_a, *buffer))
+			{
+				result.buffer = buffer;
+				result.convert_buffer_to_value ();
+			}
+		}
 		return result;
 	}
 
-	size_t block_successor_offset (ysu::transaction const & transaction_a, size_t entry_size_a, ysu::block_type type_a) const
+	/** Account of a block for the height index. Unlike block_account_calculated this allows blocks without a real sideband, which are not indexed */
+	ysu::account block_account_index (ysu::block const & block_a) const
+	{
+		auto result (block_a.account ());
+		return result.is_zero () ? block_a.sideband ().account : result;
+	}
+
+	void account_height_put (ysu::write_transaction const & transaction_a, ysu::block const & block_a, ysu::block_hash const & hash_a)
+	{
+		// Heights start at 1, a zero height means the block was stored without a real sideband
+		if (block_a.sideband ().height != 0)
+		{
+			auto status (put (transaction_a, tables::account_height, ysu::account_height_key (block_account_index (block_a), block_a.sideband ().height), hash_a));
+			release_assert (success (status));
+		}
+	}
+
+	/** Local timestamp of the send \p hash_a, sends which are no longer stored count as the oldest */
+	uint64_t pending_timestamp (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const
+	{
+		auto block (block_get (transaction_a, hash_a));
+		return block != nullptr ? block->sideband ().timestamp : 0;
+	}
+
+	void pending_summary_put (ysu::write_transaction const & transaction_a, ysu::account const & account_a, ysu::pending_summary const & summary_a)
+	{
+		auto status (put (transaction_a, tables::pending_summary, account_a, summary_a));
+		release_assert (success (status));
+	}
+
+	void pending_summary_add (ysu::write_transaction const & transaction_a, ysu::pending_key const & key_a, ysu::pending_info const & info_a)
+	{
+		auto summary (pending_summary_get (transaction_a, key_a.account));
+		auto timestamp (pending_timestamp (transaction_a, key_a.hash));
+		if (summary.count == 0 || timestamp < summary.oldest_timestamp)
+		{
+			summary.oldest = key_a.hash;
+			summary.oldest_timestamp = timestamp;
+		}
+		++summary.count;
+		summary.total = summary.total.number () + info_a.amount.number ();
+		summary.max = std::max (summary.max.number (), info_a.amount.number ());
+		pending_summary_put (transaction_a, key_a.account, summary);
+	}
+
+	void pending_summary_remove (ysu::write_transaction const & transaction_a, ysu::pending_key const & key_a, ysu::pending_info const & info_a)
+	{
+		auto summary (pending_summary_get (transaction_a, key_a.account));
+		debug_assert (summary.count > 0 && summary.total.number () >= info_a.amount.number ());
+		if (summary.count <= 1)
+		{
+			auto status (del (transaction_a, tables::pending_summary, key_a.account));
+			release_assert (success (status));
+		}
+		else
+		{
+			--summary.count;
+			summary.total = summary.total.number () - info_a.amount.number ();
+			if (info_a.amount == summary.max || key_a.hash == summary.oldest)
+			{
+				// The remaining entries of the account are read again, for entries removed in random order this is needed once per entry on average
+				pending_summary_rescan (transaction_a, key_a.account, summary);
+			}
+			pending_summary_put (transaction_a, key_a.account, summary);
+		}
+	}
+
+	/** Recomputes the largest and the oldest entry of \p summary_a from the pending entries of \p account_a */
+	void pending_summary_rescan (ysu::transaction const & transaction_a, ysu::account const & account_a, ysu::pending_summary & summary_a)
+	{
+		summary_a.max = 0;
+		summary_a.oldest_timestamp = std::numeric_limits<uint64_t>::max ();
+		for (auto i (pending_begin (transaction_a, ysu::pending_key (account_a, 0))), n (pending_end ()); i != n && ysu::pending_key (i->first).account == account_a; ++i)
+		{
+			summary_a.max = std::max (summary_a.max.number (), i->second.amount.number ());
+			auto timestamp (pending_timestamp (transaction_a, i->first.hash));
+			if (timestamp < summary_a.oldest_timestamp)
+			{
+				summary_a.oldest = i->first.hash;
+				summary_a.oldest_timestamp = timestamp;
+			}
+		}
+	}
+
+	/** Fills the pending summaries from the pending entries, for ledgers written before they existed */
+	void pending_summary_build (ysu::write_transaction const & transaction_a)
+	{
+		ysu::account account (0);
+		ysu::pending_summary summary;
+		for (auto i (pending_begin (transaction_a)), n (pending_end ()); i != n; ++i)
+		{
+			if (summary.count != 0 && i->first.account != account)
+			{
+				pending_summary_put (transaction_a, account, summary);
+				summary = ysu::pending_summary{};
+			}
+			account = i->first.account;
+			auto timestamp (pending_timestamp (transaction_a, i->first.hash));
+			if (summary.count == 0 || timestamp < summary.oldest_timestamp)
+			{
+				summary.oldest = i->first.hash;
+				summary.oldest_timestamp = timestamp;
+			}
+			++summary.count;
+			summary.total = summary.total.number () + i->second.amount.number ();
+			summary.max = std::max (summary.max.number (), i->second.amount.number ());
+		}
+		if (summary.count != 0)
+		{
+			pending_summary_put (transaction_a, account, summary);
+		}
+	}
+
+	/** Fills the height index from the account chains, for ledgers written before it existed */
+	void account_height_build (ysu::write_transaction const & transaction_a)
+	{
+		for (auto i (accounts_begin (transaction_a)), n (accounts_end ()); i != n; ++i)
+		{
+			// Walking stops at the first pruned block
+			for (auto block (block_get (transaction_a, i->second.head)); block != nullptr; block = block_get (transaction_a, block->previous ()))
+			{
+				account_height_put (transaction_a, *block, block->hash ());
+			}
+		}
+	}
+
+	/**
+	 * Every block and pruned hash ever written, so that lookups of hashes which were never stored skip the database. Hashes are
+	 * not removed when blocks are rolled back or pruned entries deleted, which only costs a database lookup
+	 */
+	ysu::bloom_filter block_filter;
+	/** Set once the filter holds every stored hash, until then all lookups go to the database */
+	std::atomic<bool> block_filter_ready{ false };
+	std::atomic<bool> block_filter_stopped{ false };
+	std::thread block_filter_thread;
+	boost::filesystem::path block_filter_path;
+	bool block_filter_persist{ false };
+
+	bool block_filter_excludes (ysu::block_hash const & hash_a) const
+	{
+		// Rebuilding the filter only reads the database, so blocks moved to the cold tier are checked separately
+		auto cold_l (cold.load ());
+		return block_filter_ready.load () && !block_filter.may_contain (hash_a) && (cold_l == nullptr || !cold_l->may_contain (hash_a));
+	}
+
+	/**
+	 * Loads the filter from \p path_a and removes the file, so that it is rebuilt if the store is not closed cleanly. It is rebuilt in the
+	 * background, sized for about \p count_a hashes, if the file is missing or was written for a different \p check_a.
+	 * Has to be called after upgrades, before the store is used
+	 */
+	void block_filter_open (boost::filesystem::path const & path_a, uint64_t check_a, size_t count_a, bool read_only_a)
+	{
+		block_filter_path = path_a;
+		block_filter_persist = !read_only_a;
+		auto error (true);
+		{
+			std::ifstream stream (path_a.string (), std::ios::binary);
+			uint64_t check;
+			if (stream.read (reinterpret_cast<char *> (&check), sizeof (check)) && check == check_a)
+			{
+				error = block_filter.deserialize (stream);
+			}
+		}
+		if (!read_only_a)
+		{
+			boost::system::error_code ec;
+			boost::filesystem::remove (path_a, ec);
+		}
+		auto empty (false);
+		if (error)
+		{
+			// Leave room to grow before another segment has to be added
+			block_filter.reset (std::max (count_a * 2, ysu::bloom_filter::default_capacity));
+			auto transaction (tx_begin_read ());
+			ysu::store_iterator<ysu::block_hash, ysu::no_value> end (nullptr);
+			empty = make_iterator<ysu::block_hash, ysu::no_value> (transaction, tables::blocks) == end && make_iterator<ysu::block_hash, ysu::no_value> (transaction, tables::pruned) == end;
+		}
+		if (!error || empty)
+		{
+			block_filter_ready = true;
+		}
+		else
+		{
+			block_filter_thread = std::thread ([this]() {
+				ysu::thread_role::set (ysu::thread_role::name::block_filter);
+				block_filter_build ();
+			});
+		}
+	}
+
+	/** Stops a rebuild in progress and writes a complete filter along with \p check_a, which has to be called while the store is still open */
+	void block_filter_close (uint64_t check_a)
+	{
+		block_filter_stopped = true;
+		if (block_filter_thread.joinable ())
+		{
+			block_filter_thread.join ();
+		}
+		if (block_filter_persist && block_filter_ready)
+		{
+			std::ofstream stream (block_filter_path.string (), std::ios::binary | std::ios::trunc);
+			stream.write (reinterpret_cast<char const *> (&check_a), sizeof (check_a));
+			block_filter.serialize (stream);
+			if (!stream)
+			{
+				stream.close ();
+				boost::system::error_code ec;
+				boost::filesystem::remove (block_filter_path, ec);
+			}
+		}
+	}
+
+	/** Adds hashes bulk loaded into \p table_a, which bypass block_put and pruned_put */
+	void block_filter_insert (ysu::tables table_a, ysu::sorted_records const & records_a)
+	{
+		if (table_a == tables::blocks || table_a == tables::pruned)
+		{
+			for (auto const & record : records_a)
+			{
+				debug_assert (record.first.size () == sizeof (ysu::block_hash));
+				ysu::block_hash hash;
+				std::copy (record.first.begin (), record.first.end (), hash.bytes.begin ());
+				block_filter.insert (hash);
+			}
+		}
+	}
+
+	void block_filter_build ()
+	{
+		// Hashes written after the traversal started are inserted by block_put and pruned_put
+		parallel_traversal<ysu::uint256_t> (
+		[this](ysu::uint256_t const & start, ysu::uint256_t const & end, bool const is_last) {
+			auto transaction (this->tx_begin_read ());
+			for (auto table : { tables::blocks, tables::pruned })
+			{
+				ysu::store_iterator<ysu::block_hash, ysu::no_value> n (nullptr);
+				if (!is_last)
+				{
+					n = this->make_iterator<ysu::block_hash, ysu::no_value> (transaction, table, ysu::db_val<Val> (ysu::block_hash (end)));
+				}
+				for (auto i (this->make_iterator<ysu::block_hash, ysu::no_value> (transaction, table, ysu::db_val<Val> (ysu::block_hash (start)))); i != n && !block_filter_stopped; ++i)
+				{
+					block_filter.insert (i->first);
+				}
+			}
+		});
+		if (!block_filter_stopped)
+		{
+			block_filter_ready = true;
+		}
+	}
+
+	/** Blocks missing from the blocks table are looked up in the cold tier once it is open */
+	std::atomic<ysu::cold_store *> cold{ nullptr };
+	std::unique_ptr<ysu::cold_store> cold_owner;
+	std::mutex cold_mutex;
+	boost::filesystem::path cold_path;
+
+	/** Opens the cold tier at \p path_a if blocks were moved to it before, otherwise it is created by cold_open. Returns true on error */
+	bool cold_init (boost::filesystem::path const & path_a)
+	{
+		cold_path = path_a;
+		return boost::filesystem::exists (path_a) && cold_open ();
+	}
+
+	/** Segments are immutable, so a block deleted after being moved is masked by the height index, which no longer points to it */
+	bool cold_visible (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a, std::vector<uint8_t> const & value_a) const
+	{
+		auto block (ysu::deserialize_block_value (value_a.data (), value_a.size ()));
+		release_assert (block != nullptr);
+		return account_height_get (transaction_a, block_account_index (*block), block->sideband ().height) == hash_a;
+	}
+
+	/** Copies the cold tier next to a copy of the database in \p destination_a. Returns true on error */
+	bool cold_copy (boost::filesystem::path const & destination_a)
 	{
-		return entry_size_a - ysu::block_sideband::size (type_a);
+		auto cold_l (cold.load ());
+		return cold_l != nullptr && cold_l->copy (destination_a);
 	}
 
-	static ysu::block_type block_type_from_raw (void * data_a)
+	/** Values written before the compact encoding are updated in place, so both encodings can be found */
+	static size_t block_successor_offset (ysu::db_val<Val> const & value_a)
 	{
-		// The block type is the first byte
-		return static_cast<ysu::block_type> ((reinterpret_cast<uint8_t const *> (data_a))[0]);
+		return ysu::block_value_successor_offset (reinterpret_cast<uint8_t const *> (value_a.data ()), value_a.size ());
 	}
 
 	uint64_t count (ysu::transaction const & transaction_a, std::initializer_list<tables> dbs_a) const
@@ -884,9 +1419,8 @@ public:
 		auto hash (block_a.hash ());
 		auto value (store.block_raw_get (transaction, block_a.previous ()));
 		debug_assert (value.size () != 0);
-		auto type = store.block_type_from_raw (value.data ());
 		std::vector<uint8_t> data (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
-		std::copy (hash.bytes.begin (), hash.bytes.end (), data.begin () + store.block_successor_offset (transaction, value.size (), type));
+		std::copy (hash.bytes.begin (), hash.bytes.end (), data.begin () + store.block_successor_offset (value));
 		store.block_raw_put (transaction, data, block_a.previous ());
 	}
 	void send_block (ysu::send_block const & block_a) override
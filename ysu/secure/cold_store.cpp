@@ -0,0 +1,349 @@
+#include <ysu/secure/cold_store.hpp>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+
+namespace
+{
+uint64_t constexpr segment_magic = 0x7973752d636f6c64; // "ysu-cold"
+std::string const segment_extension = ".segment";
+std::string const temporary_extension = ".tmp";
+size_t constexpr record_header_size = sizeof (ysu::block_hash) + sizeof (uint32_t);
+size_t constexpr index_entry_size = 2 * sizeof (uint64_t);
+size_t constexpr footer_size = 5 * sizeof (uint64_t);
+
+std::atomic<uint64_t> next_instance{ 0 };
+
+/** Segment and offset following the last record a thread read */
+class read_position final
+{
+public:
+	uint64_t instance{ std::numeric_limits<uint64_t>::max () };
+	uint64_t segment{ 0 };
+	uint64_t offset{ 0 };
+};
+
+thread_local read_position position;
+
+uint64_t index_key (ysu::block_hash const & hash_a)
+{
+	uint64_t result;
+	std::copy_n (hash_a.bytes.begin (), sizeof (result), reinterpret_cast<uint8_t *> (&result));
+	return boost::endian::big_to_native (result);
+}
+
+void write_u64 (std::ostream & stream_a, uint64_t value_a)
+{
+	boost::endian::native_to_big_inplace (value_a);
+	stream_a.write (reinterpret_cast<char const *> (&value_a), sizeof (value_a));
+}
+
+bool read_u64 (std::istream & stream_a, uint64_t & value_a)
+{
+	auto error (!stream_a.read (reinterpret_cast<char *> (&value_a), sizeof (value_a)));
+	boost::endian::big_to_native_inplace (value_a);
+	return error;
+}
+}
+
+ysu::cold_store::segment::segment (uint64_t id_a, boost::filesystem::path const & path_a) :
+id (id_a),
+path (path_a)
+{
+}
+
+bool ysu::cold_store::segment::open ()
+{
+	stream.open (path.string (), std::ios::binary);
+	uint64_t fences_offset (0);
+	uint64_t filter_offset (0);
+	uint64_t magic (0);
+	auto error (!stream.seekg (-static_cast<std::streamoff> (footer_size), std::ios::end));
+	error = error || read_u64 (stream, index_offset) || read_u64 (stream, count) || read_u64 (stream, fences_offset) || read_u64 (stream, filter_offset) || read_u64 (stream, magic) || magic != segment_magic;
+	if (!error)
+	{
+		error = !stream.seekg (fences_offset);
+		fences.resize ((count + fence_interval - 1) / fence_interval);
+		for (auto i (fences.begin ()), n (fences.end ()); i != n && !error; ++i)
+		{
+			error = read_u64 (stream, *i);
+		}
+	}
+	if (!error)
+	{
+		error = !stream.seekg (filter_offset) || filter.deserialize (stream);
+	}
+	stream.clear ();
+	return error;
+}
+
+bool ysu::cold_store::segment::find (ysu::block_hash const & hash_a, uint64_t & offset_a)
+{
+	auto key (index_key (hash_a));
+	// Equal keys can continue from the previous fence's range
+	auto fence (std::lower_bound (fences.begin (), fences.end (), key));
+	auto entry (static_cast<uint64_t> (fence == fences.begin () ? 0 : (fence - fences.begin () - 1) * fence_interval));
+	auto result (false);
+	auto done (false);
+	stream.clear ();
+	stream.seekg (index_offset + entry * index_entry_size);
+	for (; entry < count && !result && !done; ++entry)
+	{
+		uint64_t entry_key (0);
+		uint64_t entry_offset (0);
+		done = read_u64 (stream, entry_key) || read_u64 (stream, entry_offset) || entry_key > key;
+		if (!done && entry_key == key)
+		{
+			// Keys only hold part of the hash, so the record has to be checked
+			auto next (stream.tellg ());
+			ysu::block_hash hash;
+			std::vector<uint8_t> value;
+			result = read (entry_offset, hash, value) != 0 && hash == hash_a;
+			offset_a = entry_offset;
+			stream.clear ();
+			stream.seekg (next);
+		}
+	}
+	return result;
+}
+
+uint64_t ysu::cold_store::segment::read (uint64_t offset_a, ysu::block_hash & hash_a, std::vector<uint8_t> & value_a)
+{
+	uint64_t result (0);
+	if (offset_a + record_header_size <= index_offset)
+	{
+		stream.clear ();
+		uint32_t size (0);
+		if (stream.seekg (offset_a) && stream.read (reinterpret_cast<char *> (hash_a.bytes.data ()), hash_a.bytes.size ()) && stream.read (reinterpret_cast<char *> (&size), sizeof (size)))
+		{
+			boost::endian::big_to_native_inplace (size);
+			value_a.resize (size);
+			if (offset_a + record_header_size + size <= index_offset && stream.read (reinterpret_cast<char *> (value_a.data ()), size))
+			{
+				result = offset_a + record_header_size + size;
+			}
+		}
+	}
+	return result;
+}
+
+ysu::cold_store::cold_store (bool & error_a, boost::filesystem::path const & path_a) :
+path (path_a),
+instance (next_instance++)
+{
+	boost::system::error_code ec;
+	boost::filesystem::create_directories (path, ec);
+	error_a = static_cast<bool> (ec);
+	std::vector<uint64_t> ids;
+	for (boost::filesystem::directory_iterator i (path, ec), n; !error_a && !ec && i != n; i.increment (ec))
+	{
+		auto const & file (i->path ());
+		if (file.extension () == temporary_extension)
+		{
+			// Left behind by a segment which was interrupted while being written
+			boost::filesystem::remove (file, ec);
+		}
+		else if (file.extension () == segment_extension)
+		{
+			ids.push_back (std::stoull (file.stem ().string ()));
+		}
+	}
+	error_a = error_a || static_cast<bool> (ec);
+	std::sort (ids.begin (), ids.end ());
+	for (auto i (ids.begin ()), n (ids.end ()); i != n && !error_a; ++i)
+	{
+		auto segment_l (std::make_unique<segment> (*i, path / (std::to_string (*i) + segment_extension)));
+		error_a = segment_l->open ();
+		segments.push_back (std::move (segment_l));
+		next_id = *i + 1;
+	}
+}
+
+bool ysu::cold_store::put (std::vector<std::pair<ysu::block_hash, std::vector<uint8_t>>> const & records_a)
+{
+	std::lock_guard<std::mutex> guard (put_mutex);
+	auto id (next_id);
+	auto temporary (path / (std::to_string (id) + temporary_extension));
+	auto final (path / (std::to_string (id) + segment_extension));
+	{
+		std::ofstream stream (temporary.string (), std::ios::binary | std::ios::trunc);
+		std::vector<std::pair<uint64_t, uint64_t>> index;
+		index.reserve (records_a.size ());
+		ysu::bloom_filter filter (records_a.size ());
+		uint64_t offset (0);
+		for (auto const & record : records_a)
+		{
+			index.emplace_back (index_key (record.first), offset);
+			filter.insert (record.first);
+			auto size (boost::endian::native_to_big (static_cast<uint32_t> (record.second.size ())));
+			stream.write (reinterpret_cast<char const *> (record.first.bytes.data ()), record.first.bytes.size ());
+			stream.write (reinterpret_cast<char const *> (&size), sizeof (size));
+			stream.write (reinterpret_cast<char const *> (record.second.data ()), record.second.size ());
+			offset += record_header_size + record.second.size ();
+		}
+		std::sort (index.begin (), index.end ());
+		auto index_offset (offset);
+		for (auto const & entry : index)
+		{
+			write_u64 (stream, entry.first);
+			write_u64 (stream, entry.second);
+		}
+		auto fences_offset (index_offset + index.size () * index_entry_size);
+		for (size_t i (0); i < index.size (); i += fence_interval)
+		{
+			write_u64 (stream, index[i].first);
+		}
+		uint64_t filter_offset (stream.tellp ());
+		filter.serialize (stream);
+		write_u64 (stream, index_offset);
+		write_u64 (stream, index.size ());
+		write_u64 (stream, fences_offset);
+		write_u64 (stream, filter_offset);
+		write_u64 (stream, segment_magic);
+		stream.flush ();
+		if (!stream)
+		{
+			return true;
+		}
+	}
+	// The segment has to be durable before the blocks are deleted from the database
+	auto error (ysu::sync_file (temporary));
+	boost::system::error_code ec;
+	if (!error)
+	{
+		boost::filesystem::rename (temporary, final, ec);
+		error = static_cast<bool> (ec) || ysu::sync_file (path);
+	}
+	if (!error)
+	{
+		auto segment_l (std::make_unique<segment> (id, final));
+		error = segment_l->open ();
+		if (!error)
+		{
+			std::unique_lock<std::shared_mutex> lock (segments_mutex);
+			segments.push_back (std::move (segment_l));
+			next_id = id + 1;
+		}
+	}
+	if (error)
+	{
+		boost::filesystem::remove (temporary, ec);
+		boost::filesystem::remove (final, ec);
+	}
+	return error;
+}
+
+std::shared_ptr<std::vector<uint8_t>> ysu::cold_store::get (ysu::block_hash const & hash_a)
+{
+	auto result (std::make_shared<std::vector<uint8_t>> ());
+	auto found (false);
+	std::shared_lock<std::shared_mutex> lock (segments_mutex);
+	if (position.instance == instance)
+	{
+		auto existing (std::lower_bound (segments.begin (), segments.end (), position.segment, [](auto const & segment_a, uint64_t id_a) { return segment_a->id < id_a; }));
+		// A block written again after being masked has its current record in a newer segment
+		if (existing != segments.end () && (*existing)->id == position.segment && std::none_of (existing + 1, segments.end (), [&hash_a](auto const & segment_a) { return segment_a->filter.may_contain (hash_a); }))
+		{
+			auto & segment_l (**existing);
+			ysu::block_hash hash;
+			std::lock_guard<std::mutex> guard (segment_l.mutex);
+			auto end (segment_l.read (position.offset, hash, *result));
+			found = end != 0 && hash == hash_a;
+			if (found)
+			{
+				position.offset = end;
+				++sequential_hits;
+			}
+		}
+	}
+	for (auto i (segments.rbegin ()), n (segments.rend ()); i != n && !found; ++i)
+	{
+		auto & segment_l (**i);
+		if (segment_l.filter.may_contain (hash_a))
+		{
+			std::lock_guard<std::mutex> guard (segment_l.mutex);
+			uint64_t offset (0);
+			if (segment_l.find (hash_a, offset))
+			{
+				ysu::block_hash hash;
+				auto end (segment_l.read (offset, hash, *result));
+				found = end != 0;
+				if (found)
+				{
+					position = { instance, segment_l.id, end };
+					++index_hits;
+				}
+			}
+		}
+	}
+	return found ? result : nullptr;
+}
+
+bool ysu::cold_store::copy (boost::filesystem::path const & destination_a)
+{
+	// Holding the lock for writes keeps a segment from being added while copying
+	std::lock_guard<std::mutex> guard (put_mutex);
+	boost::system::error_code ec;
+	boost::filesystem::create_directories (destination_a, ec);
+	auto error (static_cast<bool> (ec));
+	std::shared_lock<std::shared_mutex> lock (segments_mutex);
+	for (auto i (segments.begin ()), n (segments.end ()); i != n && !error; ++i)
+	{
+		auto const & source ((*i)->path);
+		auto destination (destination_a / source.filename ());
+		boost::filesystem::remove (destination, ec);
+		// Segments are never modified once written, so the copy can link to the same file
+		boost::filesystem::create_hard_link (source, destination, ec);
+		if (ec)
+		{
+			boost::filesystem::copy_file (source, destination, ec);
+			error = static_cast<bool> (ec) || ysu::sync_file (destination);
+		}
+	}
+	return error || ysu::sync_file (destination_a);
+}
+
+bool ysu::cold_store::may_contain (ysu::block_hash const & hash_a)
+{
+	std::shared_lock<std::shared_mutex> lock (segments_mutex);
+	return std::any_of (segments.begin (), segments.end (), [&hash_a](auto const & segment_a) { return segment_a->filter.may_contain (hash_a); });
+}
+
+uint64_t ysu::cold_store::size ()
+{
+	std::shared_lock<std::shared_mutex> lock (segments_mutex);
+	uint64_t result (0);
+	for (auto const & segment_l : segments)
+	{
+		result += segment_l->count;
+	}
+	return result;
+}
+
+size_t ysu::cold_store::segment_count ()
+{
+	std::shared_lock<std::shared_mutex> lock (segments_mutex);
+	return segments.size ();
+}
+
+size_t ysu::cold_store::memory_usage ()
+{
+	std::shared_lock<std::shared_mutex> lock (segments_mutex);
+	size_t result (0);
+	for (auto const & segment_l : segments)
+	{
+		result += segment_l->fences.size () * sizeof (uint64_t) + segment_l->filter.memory_usage ();
+	}
+	return result;
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (cold_store & cold_store, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "segments", cold_store.segment_count (), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "records", cold_store.size (), 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "index_bytes", cold_store.memory_usage (), 1 }));
+	return composite;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <ysu/lib/bloom_filter.hpp>
+#include <ysu/lib/numbers.hpp>
+#include <ysu/lib/utility.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace ysu
+{
+/**
+ * Cold tier of the blocks table, made of immutable segment files which hold deeply cemented blocks moved out of the
+ * database so that they no longer compete with recent blocks for the page cache.
+ *
+ * A segment is written once, in the order its records were given, followed by an index of the first 8 bytes of each
+ * hash and the offset of its record sorted by hash. Only every fence_interval-th index key is kept in memory, along with
+ * a bloom filter which keeps lookups from reading segments which don't hold a block. Records hold the values of the
+ * blocks table unchanged, which are in the compact block encoding.
+ *
+ * Readers walking an account chain read consecutive records, so each thread remembers where its last record ended and
+ * checks the record there before searching the index.
+ */
+class cold_store final
+{
+public:
+	/** Loads the segments in \p path_a, creating the directory if needed */
+	cold_store (bool & error_a, boost::filesystem::path const & path_a);
+	/** Writes \p records_a to a new segment and makes them visible to get. Returns true on error */
+	bool put (std::vector<std::pair<ysu::block_hash, std::vector<uint8_t>>> const & records_a);
+	/** Returns the value stored for \p hash_a, or nullptr if no segment holds it */
+	std::shared_ptr<std::vector<uint8_t>> get (ysu::block_hash const & hash_a);
+	/** Makes the segments available in \p destination_a, sharing their files where the filesystem allows it. Returns true on error */
+	bool copy (boost::filesystem::path const & destination_a);
+	/** Returns false if no segment holds \p hash_a */
+	bool may_contain (ysu::block_hash const & hash_a);
+	/** Number of records, blocks moved again after an interrupted move are counted twice */
+	uint64_t size ();
+	size_t segment_count ();
+	/** Bytes held in memory for the fences and bloom filters of all segments */
+	size_t memory_usage ();
+
+	static size_t constexpr fence_interval = 64;
+	/** Lookups served by the record following the previous one read on the same thread */
+	std::atomic<uint64_t> sequential_hits{ 0 };
+	std::atomic<uint64_t> index_hits{ 0 };
+
+private:
+	class segment final
+	{
+	public:
+		segment (uint64_t id_a, boost::filesystem::path const & path_a);
+		bool open ();
+		bool find (ysu::block_hash const & hash_a, uint64_t & offset_a);
+		/** Reads the record at \p offset_a, returning its end or 0 on error */
+		uint64_t read (uint64_t offset_a, ysu::block_hash & hash_a, std::vector<uint8_t> & value_a);
+		uint64_t const id;
+		boost::filesystem::path const path;
+		uint64_t count{ 0 };
+		uint64_t index_offset{ 0 };
+		std::vector<uint64_t> fences;
+		/** Replaced by the one stored in the segment */
+		ysu::bloom_filter filter{ 1 };
+		std::mutex mutex;
+		std::ifstream stream;
+	};
+
+	boost::filesystem::path const path;
+	/** Distinguishes stores in the read positions remembered by threads */
+	uint64_t const instance;
+	uint64_t next_id{ 0 };
+	std::shared_mutex segments_mutex;
+	/** Ordered by id, newer segments are searched first */
+	std::vector<std::unique_ptr<segment>> segments;
+	std::mutex put_mutex;
+};
+
+std::unique_ptr<container_info_component> collect_container_info (cold_store & cold_store, const std::string & name);
+}
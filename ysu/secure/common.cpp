@@ -294,6 +294,33 @@ size_t ysu::pending_info::db_size () const
 	return sizeof (source) + sizeof (amount) + sizeof (epoch);
 }
 
+void ysu::pending_summary::serialize (ysu::stream & stream_a) const
+{
+	ysu::write (stream_a, count);
+	ysu::write (stream_a, total.bytes);
+	ysu::write (stream_a, max.bytes);
+	ysu::write (stream_a, oldest);
+	ysu::write (stream_a, oldest_timestamp);
+}
+
+bool ysu::pending_summary::deserialize (ysu::stream & stream_a)
+{
+	auto error (false);
+	try
+	{
+		ysu::read (stream_a, count);
+		ysu::read (stream_a, total.bytes);
+		ysu::read (stream_a, max.bytes);
+		ysu::read (stream_a, oldest);
+		ysu::read (stream_a, oldest_timestamp);
+	}
+	catch (std::runtime_error const &)
+	{
+		error = true;
+	}
+	return error;
+}
+
 bool ysu::pending_info::operator== (ysu::pending_info const & other_a) const
 {
 	return source == other_a.source && amount == other_a.amount && epoch == other_a.epoch;
@@ -852,6 +879,54 @@ ysu::block_hash const & ysu::unchecked_key::key () const
 	return previous;
 }
 
+ysu::account_height_key::account_height_key (ysu::account const & account_a, uint64_t height_a) :
+account_m (account_a),
+height_m (boost::endian::native_to_big (height_a))
+{
+}
+
+ysu::account const & ysu::account_height_key::account () const
+{
+	return account_m;
+}
+
+uint64_t ysu::account_height_key::height () const
+{
+	return boost::endian::big_to_native (height_m);
+}
+
+ysu::account_balance_key::account_balance_key (ysu::amount const & balance_a, ysu::account const & account_a) :
+balance_m (std::numeric_limits<ysu::uint128_t>::max () - balance_a.number ()),
+account_m (account_a)
+{
+}
+
+ysu::amount ysu::account_balance_key::balance () const
+{
+	return std::numeric_limits<ysu::uint128_t>::max () - balance_m.number ();
+}
+
+ysu::account const & ysu::account_balance_key::account () const
+{
+	return account_m;
+}
+
+ysu::unchecked_time_key::unchecked_time_key (uint64_t modified_a, ysu::unchecked_key const & key_a) :
+modified_m (boost::endian::native_to_big (modified_a)),
+key_m (key_a)
+{
+}
+
+uint64_t ysu::unchecked_time_key::modified () const
+{
+	return boost::endian::big_to_native (modified_m);
+}
+
+ysu::unchecked_key const & ysu::unchecked_time_key::key () const
+{
+	return key_m;
+}
+
 void ysu::generate_cache::enable_all ()
 {
 	reps = true;
@@ -135,6 +135,22 @@ public:
 	ysu::block_hash hash{ 0 };
 };
 
+/**
+ * Aggregate of the uncollected sends to an account, kept up to date with its pending entries
+ */
+class pending_summary final
+{
+public:
+	void serialize (ysu::stream &) const;
+	bool deserialize (ysu::stream &);
+	uint64_t count{ 0 };
+	ysu::amount total{ 0 };
+	ysu::amount max{ 0 };
+	/** Send with the lowest local timestamp */
+	ysu::block_hash oldest{ 0 };
+	uint64_t oldest_timestamp{ 0 };
+};
+
 class endpoint_key final
 {
 public:
@@ -179,6 +195,58 @@ public:
 	ysu::block_hash hash{ 0 };
 };
 
+/**
+ * Key of the index of account chains, mapping each height of an account to the hash of its block
+ */
+class account_height_key final
+{
+public:
+	account_height_key () = default;
+	account_height_key (ysu::account const &, uint64_t);
+	ysu::account const & account () const;
+	uint64_t height () const;
+
+private:
+	ysu::account account_m{ 0 };
+	// Stored in big endian so that keys of an account sort by height
+	uint64_t height_m{ 0 };
+};
+
+/**
+ * Key of the index of accounts ordered by balance, highest balance first
+ */
+class account_balance_key final
+{
+public:
+	account_balance_key () = default;
+	account_balance_key (ysu::amount const &, ysu::account const &);
+	ysu::amount balance () const;
+	ysu::account const & account () const;
+
+private:
+	// Stored as the difference to the maximum balance so that higher balances sort first
+	ysu::uint128_union balance_m{ 0 };
+	ysu::account account_m{ 0 };
+};
+
+/**
+ * Key of the unchecked index ordered by the time entries were last modified
+ */
+class unchecked_time_key final
+{
+public:
+	unchecked_time_key () = default;
+	unchecked_time_key (uint64_t, ysu::unchecked_key const &);
+	/** Seconds since posix epoch */
+	uint64_t modified () const;
+	ysu::unchecked_key const & key () const;
+
+private:
+	// Stored in big endian so that keys sort by time
+	uint64_t modified_m{ 0 };
+	ysu::unchecked_key key_m;
+};
+
 /**
  * Tag for block signature verification result
  */
@@ -347,7 +415,7 @@ class protocol_constants
 {
 public:
 	/** Current protocol version */
-	uint8_t const protocol_version = 0x12;
+	uint8_t const protocol_version = 0x13;
 
 	/** Minimum accepted protocol version */
 	uint8_t protocol_version_min (bool epoch_2_started) const;
@@ -355,6 +423,9 @@ public:
 	/** Do not request telemetry metrics to nodes older than this version */
 	uint8_t const telemetry_protocol_version_min = 0x12;
 
+	/** Older nodes ignore the ascending flag of bulk_pull and reply newest first */
+	uint8_t const bulk_pull_ascending_protocol_version_min = 0x13;
+
 private:
 	/* Minimum protocol version before an epoch 2 block is seen */
 	uint8_t const protocol_version_min_pre_epoch_2 = 0x11;
@@ -507,6 +578,7 @@ public:
 	std::atomic<uint64_t> block_count{ 0 };
 	std::atomic<uint64_t> pruned_count{ 0 };
 	std::atomic<uint64_t> account_count{ 0 };
+	std::atomic<uint64_t> unchecked_count{ 0 };
 	std::atomic<bool> epoch_2_started{ false };
 };
 
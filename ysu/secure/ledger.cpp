@@ -3,11 +3,15 @@
 #include <ysu/lib/utility.hpp>
 #include <ysu/lib/work.hpp>
 #include <ysu/secure/blockstore.hpp>
+#include <ysu/secure/cold_store.hpp>
 #include <ysu/secure/common.hpp>
 #include <ysu/secure/ledger.hpp>
+#include <ysu/secure/store_cache.hpp>
 
 #include <crypto/cryptopp/words.h>
 
+#include <numeric>
+
 namespace
 {
 /**
@@ -790,6 +794,10 @@ void ysu::ledger::initialize (ysu::generate_cache const & generate_cache_a)
 
 	auto transaction (store.tx_begin_read ());
 	cache.pruned_count = store.pruned_count (transaction);
+	if (generate_cache_a.unchecked_count)
+	{
+		cache.unchecked_count = store.unchecked_count (transaction);
+	}
 }
 
 // Balance for account containing hash
@@ -828,14 +836,7 @@ ysu::uint128_t ysu::ledger::account_balance (ysu::transaction const & transactio
 
 ysu::uint128_t ysu::ledger::account_pending (ysu::transaction const & transaction_a, ysu::account const & account_a)
 {
-	ysu::uint128_t result (0);
-	ysu::account end (account_a.number () + 1);
-	for (auto i (store.pending_begin (transaction_a, ysu::pending_key (account_a, 0))), n (store.pending_begin (transaction_a, ysu::pending_key (end, 0))); i != n; ++i)
-	{
-		ysu::pending_info const & info (i->second);
-		result += info.amount.number ();
-	}
-	return result;
+	return store.pending_summary_get (transaction_a, account_a).total.number ();
 }
 
 ysu::process_return ysu::ledger::process (ysu::write_transaction const & transaction_a, ysu::block & block_a, ysu::signature_verification verification)
@@ -1053,6 +1054,51 @@ bool ysu::ledger::rollback (ysu::write_transaction const & transaction_a, ysu::b
 	return rollback (transaction_a, block_a, rollback_list);
 }
 
+bool ysu::ledger::unchecked_put (ysu::write_transaction const & transaction_a, ysu::unchecked_key const & key_a, ysu::unchecked_info const & info_a)
+{
+	auto result (store.unchecked_put (transaction_a, key_a, info_a));
+	if (result)
+	{
+		++cache.unchecked_count;
+	}
+	return result;
+}
+
+bool ysu::ledger::unchecked_put (ysu::write_transaction const & transaction_a, ysu::block_hash const & hash_a, std::shared_ptr<ysu::block> const & block_a)
+{
+	auto result (store.unchecked_put (transaction_a, hash_a, block_a));
+	if (result)
+	{
+		++cache.unchecked_count;
+	}
+	return result;
+}
+
+bool ysu::ledger::unchecked_del (ysu::write_transaction const & transaction_a, ysu::unchecked_key const & key_a)
+{
+	auto result (store.unchecked_del (transaction_a, key_a));
+	if (result)
+	{
+		debug_assert (cache.unchecked_count > 0);
+		--cache.unchecked_count;
+	}
+	return result;
+}
+
+std::vector<ysu::unchecked_info> ysu::ledger::unchecked_del_before (ysu::write_transaction const & transaction_a, uint64_t modified_a, size_t count_a)
+{
+	auto result (store.unchecked_del_before (transaction_a, modified_a, count_a));
+	debug_assert (cache.unchecked_count >= result.size ());
+	cache.unchecked_count -= result.size ();
+	return result;
+}
+
+void ysu::ledger::unchecked_clear (ysu::write_transaction const & transaction_a)
+{
+	store.unchecked_clear (transaction_a);
+	cache.unchecked_count = 0;
+}
+
 // Return account containing hash
 ysu::account ysu::ledger::account (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const
 {
@@ -1112,6 +1158,64 @@ ysu::block_hash ysu::ledger::latest (ysu::transaction const & transaction_a, ysu
 	return latest_error ? 0 : info.head;
 }
 
+std::vector<std::shared_ptr<ysu::block>> ysu::ledger::account_blocks (ysu::transaction const & transaction_a, ysu::account const & account_a, uint64_t height_a, size_t count_a, bool ascending_a) const
+{
+	std::vector<ysu::block_hash> hashes;
+	if (height_a != 0 && count_a != 0)
+	{
+		// The index is iterated in ascending order, so descending ranges are read from their lowest height
+		auto low (ascending_a ? height_a : height_a - std::min<uint64_t> (height_a, count_a) + 1);
+		auto high (ascending_a ? height_a + count_a - 1 : height_a);
+		auto last (low - 1);
+		for (auto i (store.account_height_begin (transaction_a, ysu::account_height_key (account_a, low))), n (store.account_height_end ()); i != n && i->first.account () == account_a && i->first.height () <= high; ++i)
+		{
+			if (i->first.height () != last + 1)
+			{
+				// Pruned blocks leave a gap in the index, only the blocks on the side of height_a are kept
+				if (ascending_a)
+				{
+					break;
+				}
+				hashes.clear ();
+			}
+			hashes.push_back (i->second);
+			last = i->first.height ();
+		}
+		if (!ascending_a)
+		{
+			if (last != height_a)
+			{
+				hashes.clear ();
+			}
+			std::reverse (hashes.begin (), hashes.end ());
+		}
+	}
+	std::vector<size_t> order (hashes.size ());
+	if (store.get_cold_store () != nullptr)
+	{
+		// Read from the highest height down, the order blocks of an account are written to cold storage segments in
+		for (size_t index (0); index < order.size (); ++index)
+		{
+			order[index] = ascending_a ? order.size () - index - 1 : index;
+		}
+	}
+	else
+	{
+		// Blocks table lookups in key order touch neighbouring pages
+		std::iota (order.begin (), order.end (), 0);
+		std::sort (order.begin (), order.end (), [&hashes](size_t lhs, size_t rhs) {
+			return hashes[lhs] < hashes[rhs];
+		});
+	}
+	std::vector<std::shared_ptr<ysu::block>> result (hashes.size ());
+	for (auto index : order)
+	{
+		result[index] = store.block_get (transaction_a, hashes[index]);
+		release_assert (result[index] != nullptr);
+	}
+	return result;
+}
+
 // Return latest root for account, account number if there are no blocks for this account.
 ysu::root ysu::ledger::latest_root (ysu::transaction const & transaction_a, ysu::account const & account_a)
 {
@@ -1242,9 +1346,26 @@ void ysu::ledger::update_account (ysu::write_transaction const & transaction_a,
 			store.account_del (transaction_a, account_a);
 		}
 		store.account_put (transaction_a, account_a, new_a);
+		if (balance_index)
+		{
+			if (!old_a.head.is_zero ())
+			{
+				store.account_balance_del (transaction_a, account_a, old_a.balance);
+			}
+			store.account_balance_put (transaction_a, account_a, new_a);
+		}
 	}
 	else
 	{
+		if (balance_index)
+		{
+			// Removed accounts are passed in as empty, the stored balance is needed to find the index entry
+			ysu::account_info info;
+			if (!store.account_get (transaction_a, account_a, info))
+			{
+				store.account_balance_del (transaction_a, account_a, info.balance);
+			}
+		}
 		store.confirmation_height_del (transaction_a, account_a);
 		store.account_del (transaction_a, account_a);
 		debug_assert (cache.account_count > 0);
@@ -1252,6 +1373,24 @@ void ysu::ledger::update_account (ysu::write_transaction const & transaction_a,
 	}
 }
 
+void ysu::ledger::balance_index_set (ysu::write_transaction const & transaction_a, bool enable_a)
+{
+	auto empty (store.account_balance_begin (transaction_a) == store.account_balance_end ());
+	if (enable_a && empty)
+	{
+		for (auto i (store.accounts_begin (transaction_a)), n (store.accounts_end ()); i != n; ++i)
+		{
+			store.account_balance_put (transaction_a, i->first, i->second);
+		}
+	}
+	else if (!enable_a && !empty)
+	{
+		// A disabled index goes stale, it is dropped so that enabling it again rebuilds it
+		store.account_balance_clear (transaction_a);
+	}
+	balance_index = enable_a;
+}
+
 std::shared_ptr<ysu::block> ysu::ledger::successor (ysu::transaction const & transaction_a, ysu::qualified_root const & root_a)
 {
 	ysu::block_hash successor (0);
@@ -1317,7 +1456,7 @@ bool ysu::ledger::block_confirmed (ysu::transaction const & transaction_a, ysu::
 	return confirmed;
 }
 
-uint64_t ysu::ledger::pruning_action (ysu::write_transaction & transaction_a, ysu::block_hash const & hash_a, uint64_t const batch_size_a)
+uint64_t ysu::ledger::pruning_action (ysu::write_transaction & transaction_a, ysu::block_hash const & hash_a, uint64_t const batch_size_a, uint64_t * pruned_bytes_a)
 {
 	uint64_t pruned_count (0);
 	ysu::block_hash hash (hash_a);
@@ -1328,6 +1467,11 @@ uint64_t ysu::ledger::pruning_action (ysu::write_transaction & transaction_a, ys
 		{
 			store.block_del (transaction_a, hash);
 			store.pruned_put (transaction_a, hash);
+			if (pruned_bytes_a != nullptr)
+			{
+				// The stored block and sideband are deleted, the key moves to the pruned table
+				*pruned_bytes_a += ysu::block_value_size (*block);
+			}
 			hash = block->previous ();
 			++pruned_count;
 			++cache.pruned_count;
@@ -1393,5 +1537,11 @@ std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (ledg
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "bootstrap_weights", count, sizeof_element }));
 	composite->add_component (collect_container_info (ledger.cache.rep_weights, "rep_weights"));
+	composite->add_component (collect_container_info (ledger.store.get_store_cache (), "store_cache"));
+	auto cold_store (ledger.store.get_cold_store ());
+	if (cold_store != nullptr)
+	{
+		composite->add_component (collect_container_info (*cold_store, "cold_store"));
+	}
 	return composite;
 }
@@ -41,6 +41,11 @@ public:
 	std::shared_ptr<ysu::block> forked_block (ysu::transaction const &, ysu::block const &);
 	bool block_confirmed (ysu::transaction const & transaction_a, ysu::block_hash const & hash_a) const;
 	ysu::block_hash latest (ysu::transaction const &, ysu::account const &);
+	/**
+	 * Up to \p count_a consecutive blocks of \p account_a starting at \p height_a, towards the open block or towards the frontier if \p ascending_a.
+	 * Hashes are looked up in the height index and the blocks are read from the highest height down, so blocks in cold storage are read sequentially.
+	 */
+	std::vector<std::shared_ptr<ysu::block>> account_blocks (ysu::transaction const &, ysu::account const &, uint64_t height_a, size_t count_a, bool ascending_a) const;
 	ysu::root latest_root (ysu::transaction const &, ysu::account const &);
 	ysu::block_hash representative (ysu::transaction const &, ysu::block_hash const &);
 	ysu::block_hash representative_calculated (ysu::transaction const &, ysu::block_hash const &);
@@ -57,7 +62,17 @@ public:
 	bool rollback (ysu::write_transaction const &, ysu::block_hash const &, std::vector<std::shared_ptr<ysu::block>> &);
 	bool rollback (ysu::write_transaction const &, ysu::block_hash const &);
 	void update_account (ysu::write_transaction const &, ysu::account const &, ysu::account_info const &, ysu::account_info const &);
-	uint64_t pruning_action (ysu::write_transaction &, ysu::block_hash const &, uint64_t const);
+	/** Writes to the unchecked table which keep cache.unchecked_count exact. Returns true if the key was new */
+	bool unchecked_put (ysu::write_transaction const &, ysu::unchecked_key const &, ysu::unchecked_info const &);
+	bool unchecked_put (ysu::write_transaction const &, ysu::block_hash const &, std::shared_ptr<ysu::block> const &);
+	/** Returns true if the key was stored */
+	bool unchecked_del (ysu::write_transaction const &, ysu::unchecked_key const &);
+	std::vector<ysu::unchecked_info> unchecked_del_before (ysu::write_transaction const &, uint64_t modified_a, size_t count_a);
+	void unchecked_clear (ysu::write_transaction const &);
+	/** Starts maintaining the balance index, building it from the accounts if it is empty, or stops and drops it */
+	void balance_index_set (ysu::write_transaction const &, bool enable_a);
+	/** Prunes \p hash_a and the blocks below it. The size of the pruned block records is added to \p pruned_bytes_a if given */
+	uint64_t pruning_action (ysu::write_transaction &, ysu::block_hash const &, uint64_t const, uint64_t * pruned_bytes_a = nullptr);
 	void dump_account_chain (ysu::account const &, std::ostream & = std::cout);
 	bool could_fit (ysu::transaction const &, ysu::block const &) const;
 	bool dependents_confirmed (ysu::transaction const &, ysu::block const &) const;
@@ -76,6 +91,8 @@ public:
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
 	bool pruning{ false };
+	/** Accounts are also written to the balance index by update_account */
+	bool balance_index{ false };
 	std::function<void()> epoch_2_started_cb;
 
 private:
@@ -15,7 +15,7 @@ bool ysu::network_filter::apply (uint8_t const * bytes_a, size_t count_a, ysu::u
 	// Get hash before locking
 	auto digest (hash (bytes_a, count_a));
 
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	auto & element (get_element (digest));
 	bool existed (element == digest);
 	if (!existed)
@@ -32,7 +32,7 @@ bool ysu::network_filter::apply (uint8_t const * bytes_a, size_t count_a, ysu::u
 
 void ysu::network_filter::clear (ysu::uint128_t const & digest_a)
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	auto & element (get_element (digest_a));
 	if (element == digest_a)
 	{
@@ -42,7 +42,7 @@ void ysu::network_filter::clear (ysu::uint128_t const & digest_a)
 
 void ysu::network_filter::clear (std::vector<ysu::uint128_t> const & digests_a)
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	for (auto const & digest : digests_a)
 	{
 		auto & element (get_element (digest));
@@ -66,7 +66,7 @@ void ysu::network_filter::clear (OBJECT const & object_a)
 
 void ysu::network_filter::clear ()
 {
-	ysu::lock_guard<std::mutex> lock (mutex);
+	ysu::lock_guard<ysu::mutex> lock (mutex);
 	items.assign (items.size (), ysu::uint128_t{ 0 });
 }
 
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <ysu/lib/locks.hpp>
 #include <ysu/lib/numbers.hpp>
 
 #include <crypto/cryptopp/seckey.h>
@@ -80,6 +81,6 @@ private:
 
 	std::vector<ysu::uint128_t> items;
 	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	std::mutex mutex;
+	ysu::mutex mutex{ "network_filter" };
 };
 }
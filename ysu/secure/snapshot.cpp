@@ -0,0 +1,516 @@
+#include <ysu/crypto/blake2/blake2.h>
+#include <ysu/lib/stream.hpp>
+#include <ysu/secure/block_encoding.hpp>
+#include <ysu/secure/buffer.hpp>
+#include <ysu/secure/cold_store.hpp>
+#include <ysu/secure/common.hpp>
+#include <ysu/secure/snapshot.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <fstream>
+#include <future>
+#include <map>
+#include <sstream>
+
+namespace
+{
+unsigned constexpr snapshot_version = 1;
+/** Representative weights are not a store table, they are only used to verify the accounts */
+std::string const rep_weights_table = "rep_weights";
+
+bool table_from_name (std::string const & name_a, ysu::tables & table_a)
+{
+	static std::map<std::string, ysu::tables> const tables{ { "accounts", ysu::tables::accounts }, { "blocks", ysu::tables::blocks }, { "pending", ysu::tables::pending }, { "confirmation_height", ysu::tables::confirmation_height }, { "account_height", ysu::tables::account_height }, { "pending_summary", ysu::tables::pending_summary } };
+	auto existing (tables.find (name_a));
+	auto result (existing != tables.end ());
+	if (result)
+	{
+		table_a = existing->second;
+	}
+	return result;
+}
+
+ysu::uint256_union hash_bytes (std::vector<uint8_t> const & bytes_a)
+{
+	ysu::uint256_union result;
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (result.bytes));
+	blake2b_update (&hash, bytes_a.data (), bytes_a.size ());
+	blake2b_final (&hash, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
+
+/** Returns false if \p value_a isn't exactly one \p T as serialized by the stores */
+template <typename T>
+bool decodes (std::vector<uint8_t> const & value_a)
+{
+	T decoded;
+	ysu::bufferstream stream (value_a.data (), value_a.size ());
+	uint8_t trailing;
+	return !decoded.deserialize (stream) && ysu::try_read (stream, trailing);
+}
+
+/** Checks the sizes of a record before it is handed to put_sorted, which asserts on malformed keys */
+bool valid_record (std::string const & table_a, std::vector<uint8_t> const & key_a, std::vector<uint8_t> const & value_a)
+{
+	auto result (false);
+	if (table_a == "accounts")
+	{
+		result = key_a.size () == sizeof (ysu::account) && value_a.size () == ysu::account_info ().db_size ();
+	}
+	else if (table_a == rep_weights_table)
+	{
+		result = key_a.size () == sizeof (ysu::account) && value_a.size () == sizeof (ysu::uint128_union);
+	}
+	else if (table_a == "blocks")
+	{
+		result = key_a.size () == sizeof (ysu::block_hash) && !value_a.empty () && ysu::deserialize_block_value (value_a.data (), value_a.size ()) != nullptr;
+	}
+	else if (table_a == "pending")
+	{
+		result = key_a.size () == sizeof (ysu::pending_key) && value_a.size () == ysu::pending_info ().db_size ();
+	}
+	else if (table_a == "confirmation_height")
+	{
+		result = key_a.size () == sizeof (ysu::account) && decodes<ysu::confirmation_height_info> (value_a);
+	}
+	else if (table_a == "account_height")
+	{
+		result = key_a.size () == sizeof (ysu::account_height_key) && value_a.size () == sizeof (ysu::block_hash);
+	}
+	else if (table_a == "pending_summary")
+	{
+		result = key_a.size () == sizeof (ysu::account) && decodes<ysu::pending_summary> (value_a);
+	}
+	return result;
+}
+
+bool read_file (boost::filesystem::path const & path_a, std::vector<uint8_t> & bytes_a)
+{
+	std::ifstream stream (path_a.string (), std::ios::binary);
+	auto error (!stream.is_open ());
+	if (!error)
+	{
+		bytes_a.assign (std::istreambuf_iterator<char> (stream), std::istreambuf_iterator<char> ());
+		error = stream.bad ();
+	}
+	return error;
+}
+
+/** Splits the output into chunks of roughly equal size, each holding records of one table */
+class chunk_writer final
+{
+public:
+	chunk_writer (boost::filesystem::path const & path_a, size_t chunk_size_a) :
+	path (path_a),
+	chunk_size (chunk_size_a)
+	{
+	}
+
+	void begin_table (std::string const & name_a)
+	{
+		flush ();
+		table = name_a;
+		counts.put (table, 0);
+	}
+
+	void add (void const * key_a, size_t key_size_a, void const * value_a, size_t value_size_a)
+	{
+		{
+			ysu::vectorstream stream (buffer);
+			ysu::write (stream, ysu::narrow_cast<uint32_t> (key_size_a));
+			stream.sputn (static_cast<uint8_t const *> (key_a), key_size_a);
+			ysu::write (stream, ysu::narrow_cast<uint32_t> (value_size_a));
+			stream.sputn (static_cast<uint8_t const *> (value_a), value_size_a);
+		}
+		++records;
+		counts.put (table, counts.get<uint64_t> (table) + 1);
+		if (buffer.size () >= chunk_size)
+		{
+			flush ();
+		}
+	}
+
+	void flush ()
+	{
+		if (records != 0 && !error)
+		{
+			auto name (boost::str (boost::format ("%1$06d.chunk") % chunks.size ()));
+			std::ofstream stream ((path / name).string (), std::ios::binary | std::ios::trunc);
+			stream.write (reinterpret_cast<char const *> (buffer.data ()), buffer.size ());
+			stream.close ();
+			if (!stream.fail ())
+			{
+				boost::property_tree::ptree entry;
+				entry.put ("file", name);
+				entry.put ("table", table);
+				entry.put ("records", records);
+				entry.put ("hash", hash_bytes (buffer).to_string ());
+				chunks.push_back (std::make_pair ("", entry));
+			}
+			else
+			{
+				error.set (boost::str (boost::format ("Could not write %1%") % (path / name).string ()));
+			}
+		}
+		buffer.clear ();
+		records = 0;
+	}
+
+	ysu::error error;
+	boost::property_tree::ptree chunks;
+	boost::property_tree::ptree counts;
+
+private:
+	boost::filesystem::path path;
+	size_t chunk_size;
+	std::string table;
+	std::vector<uint8_t> buffer;
+	uint64_t records{ 0 };
+};
+
+class chunk_entry final
+{
+public:
+	std::string file;
+	std::string table;
+	uint64_t records;
+	ysu::uint256_union hash;
+};
+
+class loaded_chunk final
+{
+public:
+	ysu::error error;
+	ysu::sorted_records records;
+};
+
+/** Reads and verifies a chunk, run ahead of the writer by the import threads */
+loaded_chunk load_chunk (boost::filesystem::path const & path_a, chunk_entry const & entry_a)
+{
+	loaded_chunk result;
+	std::vector<uint8_t> bytes;
+	if (read_file (path_a / entry_a.file, bytes))
+	{
+		result.error.set (boost::str (boost::format ("Could not read chunk %1%") % entry_a.file));
+	}
+	else if (hash_bytes (bytes) != entry_a.hash)
+	{
+		result.error.set (boost::str (boost::format ("Chunk %1% does not match the hash in the manifest") % entry_a.file));
+	}
+	else
+	{
+		result.records.reserve (entry_a.records);
+		ysu::bufferstream stream (bytes.data (), bytes.size ());
+		auto error (false);
+		for (uint64_t i (0); !error && i < entry_a.records; ++i)
+		{
+			uint32_t key_size;
+			uint32_t value_size;
+			std::vector<uint8_t> key;
+			std::vector<uint8_t> value;
+			error = ysu::try_read (stream, key_size);
+			if (!error)
+			{
+				key.resize (key_size);
+				error = stream.sgetn (key.data (), key_size) != key_size || ysu::try_read (stream, value_size);
+			}
+			if (!error)
+			{
+				value.resize (value_size);
+				error = stream.sgetn (value.data (), value_size) != value_size;
+			}
+			if (!error)
+			{
+				// Stores expect each batch to be sorted
+				error = !result.records.empty () && !(result.records.back ().first < key);
+				result.records.emplace_back (std::move (key), std::move (value));
+			}
+		}
+		uint8_t trailing;
+		if (error || !ysu::try_read (stream, trailing))
+		{
+			result.error.set (boost::str (boost::format ("Chunk %1% is malformed") % entry_a.file));
+		}
+	}
+	return result;
+}
+}
+
+ysu::error ysu::snapshot_export (ysu::block_store & store_a, boost::filesystem::path const & path_a, size_t chunk_size_a)
+{
+	ysu::error error;
+	auto transaction (store_a.tx_begin_read ());
+	boost::system::error_code ec;
+	boost::filesystem::create_directories (path_a, ec);
+	if (ec)
+	{
+		error = ec;
+	}
+	else if (boost::filesystem::exists (path_a / ysu::snapshot_manifest_name))
+	{
+		error.set (boost::str (boost::format ("A snapshot already exists in %1%") % path_a.string ()));
+	}
+	else if (store_a.pruned_count (transaction) != 0)
+	{
+		error.set ("Pruned ledgers cannot be exported");
+	}
+	else if (store_a.get_cold_store () != nullptr && store_a.get_cold_store ()->size () != 0)
+	{
+		error.set ("Ledgers with blocks in cold storage cannot be exported");
+	}
+	if (!error)
+	{
+		chunk_writer writer (path_a, chunk_size_a);
+		std::map<ysu::account, ysu::uint128_t> weights;
+		writer.begin_table ("accounts");
+		for (auto i (store_a.accounts_begin (transaction)), n (store_a.accounts_end ()); i != n && !writer.error; ++i)
+		{
+			ysu::account_info const & info (i->second);
+			writer.add (i->first.bytes.data (), sizeof (i->first.bytes), &info, info.db_size ());
+			weights[info.representative] += info.balance.number ();
+		}
+		writer.begin_table (rep_weights_table);
+		for (auto const & weight : weights)
+		{
+			ysu::uint128_union amount (weight.second);
+			writer.add (weight.first.bytes.data (), sizeof (weight.first.bytes), amount.bytes.data (), sizeof (amount.bytes));
+		}
+		writer.begin_table ("blocks");
+		std::vector<uint8_t> value;
+		for (auto i (store_a.blocks_begin (transaction)), n (store_a.blocks_end ()); i != n && !writer.error; ++i)
+		{
+			// The iterator does not decode sidebands, blocks are written in the compact encoding whichever one they are stored in
+			auto block (store_a.block_get (transaction, i->first));
+			value.clear ();
+			{
+				ysu::vectorstream stream (value);
+				ysu::serialize_block_value (stream, *block);
+			}
+			writer.add (i->first.bytes.data (), sizeof (i->first.bytes), value.data (), value.size ());
+		}
+		writer.begin_table ("pending");
+		for (auto i (store_a.pending_begin (transaction)), n (store_a.pending_end ()); i != n && !writer.error; ++i)
+		{
+			ysu::pending_key const & key (i->first);
+			ysu::pending_info const & info (i->second);
+			writer.add (&key, sizeof (key), &info, info.db_size ());
+		}
+		writer.begin_table ("confirmation_height");
+		for (auto i (store_a.confirmation_height_begin (transaction)), n (store_a.confirmation_height_end ()); i != n && !writer.error; ++i)
+		{
+			value.clear ();
+			{
+				ysu::vectorstream stream (value);
+				i->second.serialize (stream);
+			}
+			writer.add (i->first.bytes.data (), sizeof (i->first.bytes), value.data (), value.size ());
+		}
+		writer.begin_table ("account_height");
+		for (auto i (store_a.account_height_begin (transaction)), n (store_a.account_height_end ()); i != n && !writer.error; ++i)
+		{
+			ysu::account_height_key const & key (i->first);
+			writer.add (&key, sizeof (key), i->second.bytes.data (), sizeof (i->second.bytes));
+		}
+		writer.begin_table ("pending_summary");
+		for (auto i (store_a.pending_summary_begin (transaction)), n (store_a.pending_summary_end ()); i != n && !writer.error; ++i)
+		{
+			value.clear ();
+			{
+				ysu::vectorstream stream (value);
+				i->second.serialize (stream);
+			}
+			writer.add (i->first.bytes.data (), sizeof (i->first.bytes), value.data (), value.size ());
+		}
+		writer.flush ();
+		error = writer.error;
+		if (!error)
+		{
+			ysu::network_params network_params;
+			boost::property_tree::ptree manifest;
+			manifest.put ("version", snapshot_version);
+			manifest.put ("store_version", store_a.version_get (transaction));
+			manifest.put ("genesis", network_params.ledger.genesis_hash.to_string ());
+			manifest.add_child ("counts", writer.counts);
+			manifest.add_child ("chunks", writer.chunks);
+			try
+			{
+				boost::property_tree::write_json ((path_a / ysu::snapshot_manifest_name).string (), manifest);
+			}
+			catch (std::exception const & ex)
+			{
+				error = ex;
+			}
+		}
+	}
+	return error;
+}
+
+ysu::error ysu::snapshot_import (ysu::block_store & store_a, boost::filesystem::path const & path_a, ysu::uint256_union const & expected_hash_a, unsigned threads_a)
+{
+	ysu::error error;
+	boost::property_tree::ptree manifest;
+	std::vector<chunk_entry> chunks;
+	std::vector<uint8_t> manifest_bytes;
+	if (read_file (path_a / ysu::snapshot_manifest_name, manifest_bytes))
+	{
+		error.set ("Could not read the snapshot manifest");
+	}
+	else if (hash_bytes (manifest_bytes) != expected_hash_a)
+	{
+		error.set (boost::str (boost::format ("The snapshot manifest hash %1% does not match the expected one") % hash_bytes (manifest_bytes).to_string ()));
+	}
+	if (!error)
+	{
+		try
+		{
+			// Parse the bytes which were hashed, the file could be replaced in the meantime
+			std::stringstream stream (std::string (manifest_bytes.begin (), manifest_bytes.end ()));
+			boost::property_tree::read_json (stream, manifest);
+			ysu::network_params network_params;
+			auto transaction (store_a.tx_begin_read ());
+			if (manifest.get<unsigned> ("version") != snapshot_version)
+			{
+				error.set ("Unsupported snapshot version");
+			}
+			else if (manifest.get<int> ("store_version") != store_a.version_get (transaction))
+			{
+				error.set ("The snapshot was exported from a different database version");
+			}
+			else if (manifest.get<std::string> ("genesis") != network_params.ledger.genesis_hash.to_string ())
+			{
+				error.set ("The snapshot belongs to a different network");
+			}
+			else if (store_a.block_count (transaction) != 0 || store_a.account_count (transaction) != 0)
+			{
+				error.set ("Snapshots can only be imported into an empty ledger");
+			}
+			for (auto const & child : manifest.get_child ("chunks"))
+			{
+				chunk_entry entry;
+				entry.file = child.second.get<std::string> ("file");
+				entry.table = child.second.get<std::string> ("table");
+				entry.records = child.second.get<uint64_t> ("records");
+				ysu::tables table;
+				if (entry.hash.decode_hex (child.second.get<std::string> ("hash")) || (entry.table != rep_weights_table && !table_from_name (entry.table, table)) || entry.file.find_first_of ("/\\") != std::string::npos)
+				{
+					error.set ("Invalid chunk in manifest");
+				}
+				chunks.push_back (entry);
+			}
+		}
+		catch (std::exception const & ex)
+		{
+			error = ex;
+		}
+	}
+	if (!error)
+	{
+		std::map<ysu::account, ysu::uint128_t> weights_expected;
+		std::map<ysu::account, ysu::uint128_t> weights;
+		std::map<std::string, uint64_t> counts;
+		// Chunks are read and verified ahead by worker threads, the writer loads them in manifest order so each table is appended to
+		std::deque<std::future<loaded_chunk>> ahead;
+		size_t next (0);
+		auto transaction (store_a.tx_begin_write ());
+		for (auto const & entry : chunks)
+		{
+			while (next < chunks.size () && ahead.size () < std::max (threads_a, 1u))
+			{
+				ahead.push_back (std::async (std::launch::async, load_chunk, path_a, chunks[next++]));
+			}
+			auto loaded (ahead.front ().get ());
+			ahead.pop_front ();
+			if (loaded.error)
+			{
+				error = loaded.error;
+				break;
+			}
+			auto valid (true);
+			for (auto & record : loaded.records)
+			{
+				ysu::account account;
+				valid = valid && valid_record (entry.table, record.first, record.second);
+				if (valid && entry.table == "blocks" && !ysu::block_value_compact (record.second.data ()))
+				{
+					// Snapshots written before the compact encoding are converted, so imported ledgers match the ones built by the node
+					auto block (ysu::deserialize_block_value (record.second.data (), record.second.size ()));
+					record.second.clear ();
+					ysu::vectorstream stream (record.second);
+					ysu::serialize_block_value (stream, *block);
+				}
+				if (valid && (entry.table == "accounts" || entry.table == rep_weights_table))
+				{
+					std::copy_n (record.first.begin (), sizeof (account.bytes), account.bytes.begin ());
+					if (entry.table == "accounts")
+					{
+						ysu::account_info info;
+						std::copy (record.second.begin (), record.second.end (), reinterpret_cast<uint8_t *> (&info));
+						weights[info.representative] += info.balance.number ();
+					}
+					else
+					{
+						ysu::uint128_union amount;
+						std::copy (record.second.begin (), record.second.end (), amount.bytes.begin ());
+						weights_expected[account] = amount.number ();
+					}
+				}
+			}
+			if (!valid)
+			{
+				error.set (boost::str (boost::format ("Chunk %1% holds invalid records") % entry.file));
+				break;
+			}
+			ysu::tables table;
+			if (table_from_name (entry.table, table))
+			{
+				store_a.put_sorted (transaction, table, loaded.records);
+				// Bound the size of each write transaction by committing after every chunk
+				transaction.commit ();
+				transaction.renew ();
+			}
+			counts[entry.table] += loaded.records.size ();
+		}
+		if (!error)
+		{
+			for (auto const & count : manifest.get_child ("counts"))
+			{
+				if (counts[count.first] != count.second.get_value<uint64_t> ())
+				{
+					error.set (boost::str (boost::format ("Snapshot is missing %1% records") % count.first));
+				}
+			}
+		}
+		if (!error && weights != weights_expected)
+		{
+			error.set ("Account balances do not add up to the representative weights of the snapshot");
+		}
+		if (!error)
+		{
+			// Frontiers are only kept for accounts whose head is a legacy block
+			for (auto i (store_a.accounts_begin (transaction)), n (store_a.accounts_end ()); i != n; ++i)
+			{
+				auto head (store_a.block_get_no_sideband (transaction, i->second.head));
+				if (head == nullptr)
+				{
+					error.set (boost::str (boost::format ("Head block of account %1% is missing") % i->first.to_account ()));
+					break;
+				}
+				if (head->type () != ysu::block_type::state)
+				{
+					store_a.frontier_put (transaction, i->second.head, i->first);
+				}
+			}
+		}
+	}
+	return error;
+}
+
+ysu::uint256_union ysu::snapshot_hash (boost::filesystem::path const & path_a)
+{
+	std::vector<uint8_t> bytes;
+	return read_file (path_a / ysu::snapshot_manifest_name, bytes) ? ysu::uint256_union (0) : hash_bytes (bytes);
+}
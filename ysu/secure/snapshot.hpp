@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ysu/lib/errors.hpp>
+#include <ysu/secure/blockstore.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+namespace ysu
+{
+/**
+ * Ledger snapshots are directories holding a manifest and a sequence of chunk files, independent of the database backend.
+ *
+ * Each chunk holds records of a single table in the order they are stored, encoded the same way the stores encode them,
+ * so that importing amounts to appending to empty tables. The manifest lists the Blake2b hash of every chunk, which is
+ * checked before a chunk is loaded. Representative weights are included so an import can check that the accounts it
+ * loaded add up to the weights seen by the exporting node. Frontiers are rebuilt from the accounts while importing.
+ */
+std::string const snapshot_manifest_name = "manifest.json";
+size_t constexpr snapshot_chunk_size = 32 * 1024 * 1024;
+
+/** Writes the ledger tables of \p store_a to the directory \p path_a from a single read transaction */
+ysu::error snapshot_export (ysu::block_store & store_a, boost::filesystem::path const & path_a, size_t chunk_size_a = ysu::snapshot_chunk_size);
+/**
+ * Loads the snapshot in \p path_a into \p store_a, which has to be empty. Nothing is written unless the manifest hashes to
+ * \p expected_hash_a. Up to \p threads_a chunks are read and verified ahead of the one being written.
+ * @note Chunks are committed as they are loaded, a store which failed to import has to be discarded
+ */
+ysu::error snapshot_import (ysu::block_store & store_a, boost::filesystem::path const & path_a, ysu::uint256_union const & expected_hash_a, unsigned threads_a);
+/** Hash of the manifest in \p path_a, to be compared with the one published for a trusted snapshot */
+ysu::uint256_union snapshot_hash (boost::filesystem::path const & path_a);
+}
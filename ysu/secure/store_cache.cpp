@@ -0,0 +1,81 @@
+#include <ysu/secure/blockstore.hpp>
+#include <ysu/secure/store_cache.hpp>
+
+ysu::store_cache::store_cache (size_t capacity_a) :
+accounts (epoch, capacity_a),
+confirmation_heights (epoch, capacity_a)
+{
+}
+
+uint64_t ysu::store_cache::epoch_get () const
+{
+	return epoch.load ();
+}
+
+void ysu::store_cache::account_put (ysu::write_transaction const & transaction_a, ysu::account const & account_a, ysu::account_info const & info_a)
+{
+	auto generation (accounts.modify (account_a));
+	ysu::lock_guard<std::mutex> guard (writes_mutex);
+	writes[transaction_a.get_handle ()].accounts.push_back ({ account_a, generation, info_a });
+}
+
+void ysu::store_cache::account_del (ysu::write_transaction const & transaction_a, ysu::account const & account_a)
+{
+	auto generation (accounts.modify (account_a));
+	ysu::lock_guard<std::mutex> guard (writes_mutex);
+	writes[transaction_a.get_handle ()].accounts.push_back ({ account_a, generation, boost::none });
+}
+
+void ysu::store_cache::confirmation_height_put (ysu::write_transaction const & transaction_a, ysu::account const & account_a, ysu::confirmation_height_info const & confirmation_height_info_a)
+{
+	auto generation (confirmation_heights.modify (account_a));
+	ysu::lock_guard<std::mutex> guard (writes_mutex);
+	writes[transaction_a.get_handle ()].confirmation_heights.push_back ({ account_a, generation, confirmation_height_info_a });
+}
+
+void ysu::store_cache::confirmation_height_del (ysu::write_transaction const & transaction_a, ysu::account const & account_a)
+{
+	auto generation (confirmation_heights.modify (account_a));
+	ysu::lock_guard<std::mutex> guard (writes_mutex);
+	writes[transaction_a.get_handle ()].confirmation_heights.push_back ({ account_a, generation, boost::none });
+}
+
+void ysu::store_cache::commit (void * handle_a)
+{
+	write_set write_set_l;
+	{
+		ysu::lock_guard<std::mutex> guard (writes_mutex);
+		auto existing (writes.find (handle_a));
+		if (existing == writes.end ())
+		{
+			return;
+		}
+		write_set_l = std::move (existing->second);
+		writes.erase (existing);
+	}
+	// Transactions reading this epoch or a later one were started after the database commit and see every value installed below
+	auto epoch_l (++epoch);
+	for (auto const & write_l : write_set_l.accounts)
+	{
+		accounts.commit (epoch_l, write_l.account, write_l.generation, write_l.value);
+	}
+	for (auto const & write_l : write_set_l.confirmation_heights)
+	{
+		confirmation_heights.commit (epoch_l, write_l.account, write_l.generation, write_l.value);
+	}
+}
+
+size_t ysu::store_cache::pending_size ()
+{
+	ysu::lock_guard<std::mutex> guard (writes_mutex);
+	return writes.size ();
+}
+
+std::unique_ptr<ysu::container_info_component> ysu::collect_container_info (store_cache & store_cache, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "accounts", store_cache.accounts.size (), sizeof (decltype (store_cache.accounts)::entry) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "confirmation_heights", store_cache.confirmation_heights.size (), sizeof (decltype (store_cache.confirmation_heights)::entry) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pending_transactions", store_cache.pending_size (), sizeof (void *) }));
+	return composite;
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <ysu/lib/locks.hpp>
+#include <ysu/lib/utility.hpp>
+#include <ysu/secure/common.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/optional.hpp>
+
+#include <array>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+namespace ysu
+{
+class write_transaction;
+
+/**
+ * Least recently used cache of the records of one table keyed by account, split into shards which are locked independently.
+ *
+ * Each entry remembers the commit epoch it is valid from and is only served to transactions started at or after it,
+ * see ysu::store_cache. Accounts written by a transaction which has not committed yet are marked as modified and
+ * bypass the cache until every such transaction has.
+ */
+template <typename Value>
+class store_cache_table final
+{
+public:
+	store_cache_table (std::atomic<uint64_t> const & epoch_a, size_t capacity_a) :
+	epoch (epoch_a),
+	shard_capacity (std::max<size_t> (capacity_a / shard_count, 1))
+	{
+	}
+
+	/** Returns the value of \p account_a if it is cached and visible to a transaction started at \p epoch_a */
+	boost::optional<Value> get (uint64_t epoch_a, ysu::account const & account_a)
+	{
+		boost::optional<Value> result;
+		auto & shard (shard_get (account_a));
+		{
+			ysu::lock_guard<std::mutex> guard (shard.mutex);
+			if (shard.modified.count (account_a) == 0)
+			{
+				auto & by_account (shard.entries.template get<tag_account> ());
+				auto existing (by_account.find (account_a));
+				if (existing != by_account.end () && existing->epoch <= epoch_a)
+				{
+					result = existing->value;
+					shard.entries.relocate (shard.entries.end (), shard.entries.template project<tag_sequence> (existing));
+				}
+			}
+		}
+		if (result)
+		{
+			++hits;
+		}
+		else
+		{
+			++misses;
+		}
+		return result;
+	}
+
+	/** Caches \p value_a read from the database by a transaction started at \p epoch_a, unless a commit happened since or one is pending for \p account_a */
+	void fill (uint64_t epoch_a, ysu::account const & account_a, Value const & value_a)
+	{
+		auto & shard (shard_get (account_a));
+		ysu::lock_guard<std::mutex> guard (shard.mutex);
+		// The epoch is incremented before modified marks are cleared, so it has to be read while holding the shard lock
+		if (epoch_a == epoch.load () && shard.modified.count (account_a) == 0)
+		{
+			insert (shard, account_a, value_a, epoch_a);
+		}
+	}
+
+	/** Marks \p account_a as being written by an uncommitted transaction. The returned generation is passed to commit */
+	uint64_t modify (ysu::account const & account_a)
+	{
+		auto & shard (shard_get (account_a));
+		ysu::lock_guard<std::mutex> guard (shard.mutex);
+		shard.entries.template get<tag_account> ().erase (account_a);
+		auto & modified_l (shard.modified[account_a]);
+		++modified_l.count;
+		return ++modified_l.generation;
+	}
+
+	/** Installs \p value_a, or removes the entry if it is empty, as committed at \p epoch_a unless \p account_a was written again meanwhile */
+	void commit (uint64_t epoch_a, ysu::account const & account_a, uint64_t generation_a, boost::optional<Value> const & value_a)
+	{
+		auto & shard (shard_get (account_a));
+		ysu::lock_guard<std::mutex> guard (shard.mutex);
+		auto existing (shard.modified.find (account_a));
+		debug_assert (existing != shard.modified.end ());
+		if (existing != shard.modified.end ())
+		{
+			if (existing->second.generation == generation_a)
+			{
+				shard.entries.template get<tag_account> ().erase (account_a);
+				if (value_a)
+				{
+					insert (shard, account_a, *value_a, epoch_a);
+				}
+			}
+			if (--existing->second.count == 0)
+			{
+				shard.modified.erase (existing);
+			}
+		}
+	}
+
+	void clear ()
+	{
+		for (auto & shard : shards)
+		{
+			ysu::lock_guard<std::mutex> guard (shard.mutex);
+			shard.entries.clear ();
+		}
+	}
+
+	size_t size ()
+	{
+		size_t result (0);
+		for (auto & shard : shards)
+		{
+			ysu::lock_guard<std::mutex> guard (shard.mutex);
+			result += shard.entries.size ();
+		}
+		return result;
+	}
+
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+
+	class entry final
+	{
+	public:
+		ysu::account account;
+		Value value;
+		uint64_t epoch;
+	};
+
+	static size_t constexpr shard_count = 16;
+
+private:
+	class modified_account final
+	{
+	public:
+		uint64_t count{ 0 };
+		uint64_t generation{ 0 };
+	};
+
+	// clang-format off
+	class tag_sequence {};
+	class tag_account {};
+	using ordered_entries = boost::multi_index_container<entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+		boost::multi_index::hashed_unique<boost::multi_index::tag<tag_account>,
+			boost::multi_index::member<entry, ysu::account, &entry::account>>>>;
+	// clang-format on
+
+	class table_shard final
+	{
+	public:
+		std::mutex mutex;
+		ordered_entries entries;
+		std::unordered_map<ysu::account, modified_account> modified;
+	};
+
+	table_shard & shard_get (ysu::account const & account_a)
+	{
+		// Accounts are uniformly distributed, so their low bits pick a shard without further hashing
+		return shards[account_a.bytes[account_a.bytes.size () - 1] % shard_count];
+	}
+
+	void insert (table_shard & shard_a, ysu::account const & account_a, Value const & value_a, uint64_t epoch_a)
+	{
+		if (shard_a.entries.push_back (entry{ account_a, value_a, epoch_a }).second && shard_a.entries.size () > shard_capacity)
+		{
+			shard_a.entries.pop_front ();
+		}
+	}
+
+	std::atomic<uint64_t> const & epoch;
+	size_t const shard_capacity;
+	std::array<table_shard, shard_count> shards;
+};
+
+/**
+ * Write-through cache of the account and confirmation height records, shared by every transaction of a store.
+ *
+ * A commit epoch is incremented each time a write transaction which modified cached records commits, after the
+ * database commit and before its values are installed. Transactions read the epoch before their snapshot is taken, so
+ * an entry valid from a given epoch is part of the snapshot of every transaction which started at or after it.
+ * Values read from the database are only cached when no commit happened since the reading transaction started.
+ */
+class store_cache final
+{
+public:
+	explicit store_cache (size_t capacity_a = default_capacity);
+	uint64_t epoch_get () const;
+	void account_put (ysu::write_transaction const &, ysu::account const &, ysu::account_info const &);
+	void account_del (ysu::write_transaction const &, ysu::account const &);
+	void confirmation_height_put (ysu::write_transaction const &, ysu::account const &, ysu::confirmation_height_info const &);
+	void confirmation_height_del (ysu::write_transaction const &, ysu::account const &);
+	/** Called by write transactions once the database commit of \p handle_a completed */
+	void commit (void * handle_a);
+	size_t pending_size ();
+
+	/** Number of entries per table */
+	static size_t constexpr default_capacity = 64 * 1024;
+
+	ysu::store_cache_table<ysu::account_info> accounts;
+	ysu::store_cache_table<ysu::confirmation_height_info> confirmation_heights;
+
+private:
+	template <typename Value>
+	class write final
+	{
+	public:
+		ysu::account account;
+		uint64_t generation;
+		boost::optional<Value> value;
+	};
+
+	class write_set final
+	{
+	public:
+		std::vector<write<ysu::account_info>> accounts;
+		std::vector<write<ysu::confirmation_height_info>> confirmation_heights;
+	};
+
+	/** Starts at one so transactions which were not started by a store, which have an epoch of zero, never use the cache */
+	std::atomic<uint64_t> epoch{ 1 };
+	std::mutex writes_mutex;
+	std::unordered_map<void *, write_set> writes;
+};
+
+std::unique_ptr<container_info_component> collect_container_info (store_cache & store_cache, const std::string & name);
+}
@@ -225,7 +225,7 @@ TEST (node, fork_storm)
 			}
 			else
 			{
-				ysu::unique_lock<std::mutex> lock (node_a->active.mutex);
+				ysu::unique_lock<ysu::mutex> lock (node_a->active.mutex);
 				auto election = node_a->active.roots.begin ()->election;
 				lock.unlock ();
 				if (election->votes ().size () == 1)
@@ -1720,7 +1720,7 @@ TEST (node, mass_block_new)
 		node.block_processor.flush ();
 		// Clear all active
 		{
-			ysu::lock_guard<std::mutex> guard (node.active.mutex);
+			ysu::lock_guard<ysu::mutex> guard (node.active.mutex);
 			node.active.roots.clear ();
 			node.active.blocks.clear ();
 		}
@@ -1818,3 +1818,64 @@ TEST (node, mass_block_new)
 	process_all (receive_blocks);
 	std::cout << "Receive blocks time: " << timer.stop ().count () << " " << timer.unit () << "\n\n";
 }
+
+// Measures how fast a node bootstraps many short account chains from a single peer, which is bound by the pull round trips
+TEST (bootstrap, pull_throughput)
+{
+	ysu::system system;
+	ysu::node_config config (ysu::get_available_port (), system.logging);
+	config.frontiers_confirmation = ysu::frontiers_confirmation_mode::disabled;
+	ysu::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	node_flags.disable_lazy_bootstrap = true;
+	auto node1 (system.add_node (config, node_flags));
+
+#ifndef NDEBUG
+	auto const num_accounts = 1000;
+#else
+	auto const num_accounts = 20000;
+#endif
+	ysu::state_block_builder builder;
+	auto latest (node1->latest (ysu::dev_genesis_key.pub));
+	{
+		auto transaction (node1->store.tx_begin_write ());
+		for (auto i = 0; i < num_accounts; ++i)
+		{
+			ysu::keypair key;
+			auto send = builder.make_block ()
+			            .account (ysu::dev_genesis_key.pub)
+			            .previous (latest)
+			            .representative (ysu::dev_genesis_key.pub)
+			            .balance (ysu::genesis_amount - i - 1)
+			            .link (key.pub)
+			            .sign (ysu::dev_genesis_key.prv, ysu::dev_genesis_key.pub)
+			            .work (*system.work.generate (latest))
+			            .build ();
+			ASSERT_EQ (ysu::process_result::progress, node1->ledger.process (transaction, *send).code);
+			latest = send->hash ();
+			auto open = builder.make_block ()
+			            .account (key.pub)
+			            .previous (0)
+			            .representative (key.pub)
+			            .balance (1)
+			            .link (send->hash ())
+			            .sign (key.prv, key.pub)
+			            .work (*system.work.generate (key.pub))
+			            .build ();
+			ASSERT_EQ (ysu::process_result::progress, node1->ledger.process (transaction, *open).code);
+		}
+	}
+	auto block_count (node1->ledger.cache.block_count.load ());
+	std::cout << "Bootstrapping " << block_count << " blocks in " << num_accounts + 1 << " accounts" << std::endl;
+
+	auto node2 (std::make_shared<ysu::node> (system.io_ctx, ysu::get_available_port (), ysu::unique_path (), system.alarm, system.logging, system.work, node_flags));
+	ASSERT_FALSE (node2->init_error ());
+	node2->start ();
+	ysu::timer<std::chrono::milliseconds> timer;
+	timer.start ();
+	node2->bootstrap_initiator.bootstrap (node1->network.endpoint ());
+	ASSERT_TIMELY (600s, node2->ledger.cache.block_count == block_count);
+	auto elapsed (timer.stop ());
+	std::cout << "Pulled in " << elapsed.count () << " " << timer.unit () << ", " << block_count * 1000 / std::max<uint64_t> (elapsed.count (), 1) << " blocks/s" << std::endl;
+	node2->stop ();
+}